@@ -244,6 +244,12 @@ void DeathSubsystem::render()
         m_debug_camera->apply_debug();
     }
 
+    // pick up meshes whose data has been reloaded
+    for(DeathMesh* mesh : m_meshes)
+    {
+        mesh->update();
+    }
+
     death_scene_render(m_scene);
 
     // // TODO: REMOVE BELOW HERE
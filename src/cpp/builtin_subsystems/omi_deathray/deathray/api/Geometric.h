@@ -52,6 +52,23 @@ DEATH_API_EXPORT DeathError death_geo_remove_vbo(
         DeathGeometricHandle geometric,
         DeathVBOHandle vbo);
 
+/*!
+ * \brief Sets the indices of the vertices of the geometric's triangles.
+ *
+ * Each index refers to a tuple of the geometric's VBOs, so tuples which are
+ * shared by multiple triangles only need to be stored once. If no indices are
+ * set (or they are cleared by passing a size of 0) every three tuples of the
+ * VBOs form a triangle. The indices are copied.
+ *
+ * \param geometric The geometric to set the indices of.
+ * \param size The number of indices, this must be a multiple of 3.
+ * \param indices The indices, this may be null if the size is 0.
+ */
+DEATH_API_EXPORT DeathError death_geo_set_indices(
+        DeathGeometricHandle geometric,
+        DeathSize size,
+        const DeathUInt32* indices);
+
 // TODO: get vbos
 
 //------------------------------------------------------------------------------
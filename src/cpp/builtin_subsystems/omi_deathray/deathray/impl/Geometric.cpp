@@ -40,6 +40,8 @@ private:
 
     // mapping from indices to the associated VBOs
     std::unordered_map<DeathUInt32, death::VBO*> m_vbos;
+    // the indices of the vertices of the triangles
+    std::vector<DeathUInt32> m_indices;
 
     // the debug geometry
     death::GLGeometry* m_debug_geo;
@@ -115,6 +117,39 @@ public:
         return kDeathSuccess;
     }
 
+    const std::vector<DeathUInt32>& get_indices() const
+    {
+        return m_indices;
+    }
+
+    DeathError set_indices(DeathSize size, const DeathUInt32* indices)
+    {
+        // ensure the indices form triangles
+        if(size % 3 != 0)
+        {
+            return kDeathErrorTupleSizeNotAFactor;
+        }
+
+        try
+        {
+            m_indices.assign(indices, indices + size);
+        }
+        catch(std::bad_alloc&)
+        {
+            m_indices.clear();
+            return kDeathErrorOutOfMemory;
+        }
+
+        // the debug geometry is out-of-date
+        // TODO: need a graphics state queue for this
+        if(m_debug_geo != nullptr)
+        {
+            delete m_debug_geo;
+            m_debug_geo = nullptr;
+        }
+        return kDeathSuccess;
+    }
+
     death::GLGeometry* get_debug_geo()
     {
         // already exists?
@@ -130,7 +165,12 @@ public:
         }
 
         // build
-        m_debug_geo = new GLGeometry(vbo->get_data(), vbo->get_size());
+        m_debug_geo = new GLGeometry(
+            vbo->get_data(),
+            vbo->get_size(),
+            m_indices.data(),
+            m_indices.size()
+        );
         return m_debug_geo;
     }
 };
@@ -172,6 +212,16 @@ DeathError Geometric::remove_vbo(death::VBO* vbo)
     return m_impl->remove_vbo(vbo);
 }
 
+const std::vector<DeathUInt32>& Geometric::get_indices() const
+{
+    return m_impl->get_indices();
+}
+
+DeathError Geometric::set_indices(DeathSize size, const DeathUInt32* indices)
+{
+    return m_impl->set_indices(size, indices);
+}
+
 death::GLGeometry* Geometric::get_debug_geo()
 {
     return m_impl->get_debug_geo();
@@ -259,3 +309,16 @@ DEATH_API_EXPORT DeathError death_geo_remove_vbo(
 
     return geometric->impl->remove_vbo(vbo->impl);
 }
+
+DEATH_API_EXPORT DeathError death_geo_set_indices(
+        DeathGeometricHandle geometric,
+        DeathSize size,
+        const DeathUInt32* indices)
+{
+    if(geometric == nullptr || (indices == nullptr && size != 0))
+    {
+        return kDeathErrorNullHandle;
+    }
+
+    return geometric->impl->set_indices(size, indices);
+}
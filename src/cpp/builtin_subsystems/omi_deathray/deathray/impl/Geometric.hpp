@@ -9,6 +9,8 @@
 #ifndef DEATHRAY_IMPL_GEOMETRIC_HPP_
 #define DEATHRAY_IMPL_GEOMETRIC_HPP_
 
+#include <vector>
+
 #include <arcanecore/base/lang/Restrictors.hpp>
 
 #include "deathray/api/API.h"
@@ -67,6 +69,17 @@ public:
      */
     DeathError remove_vbo(death::VBO* vbo);
 
+    /*!
+     * \brief Returns the indices of the vertices of this geometric's
+     *        triangles, or an empty vector if the geometric is not indexed.
+     */
+    const std::vector<DeathUInt32>& get_indices() const;
+
+    /*!
+     * \brief Implementation of the death_geo_set_indices function.
+     */
+    DeathError set_indices(DeathSize size, const DeathUInt32* indices);
+
     /*!
      * \brief Returns the debug GLGeometry for this geometric.
      *
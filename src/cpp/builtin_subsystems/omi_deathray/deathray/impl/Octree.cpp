@@ -9,6 +9,7 @@
 #include "deathray/impl/Octree.hpp"
 
 #include <memory>
+#include <vector>
 
 #include <arcanecore/lx/Alignment.hpp>
 #include <arcanecore/lx/MatrixMath44f.hpp>
@@ -272,29 +273,14 @@ private:
     {
         for(death::Geometric* geometric : m_spatial->get_geometrics())
         {
-            // get the primary VBO from the geometry
-            death::VBO* vbo = geometric->get_vbo(0);
-            // no primary vbo?
-            if(vbo == nullptr)
-            {
-                continue;
-            }
-            // vbo tuple size not 3?
-            if(vbo->get_tuple_size() != 3)
-            {
-                // TODO: should set an error here?
-                continue;
-            }
-            // assume this is position data and traverse it find the spatial
-            // bounds of this entity
-            for(const DeathFloat* src = vbo->get_data();
-                src != vbo->get_data() + vbo->get_size();
-                src += 3)
-            {
-                m_true_bounds.extend(
-                    *reinterpret_cast<const arc::lx::Vector3f*>(src)
-                );
-            }
+            // traverse the positions to find the spatial bounds of this entity
+            for_each_position(
+                geometric,
+                [this](const arc::lx::Vector3f& position)
+                {
+                    m_true_bounds.extend(position);
+                }
+            );
         }
 
         // TODO: pass over volumetric data also
@@ -332,17 +318,66 @@ private:
 
         for(death::Geometric* geometric : m_spatial->get_geometrics())
         {
-            // get the primary VBO from the geometry
-            death::VBO* vbo = geometric->get_vbo(0);
-            // assume this is position data and traverse it find the spatial
-            // bounds of this entity
-            for(const DeathFloat* src = vbo->get_data();
-                src != vbo->get_data() + vbo->get_size();
-                src += 3)
+            for_each_position(
+                geometric,
+                [this](const arc::lx::Vector3f& position)
+                {
+                    set_data_for_octant(position);
+                }
+            );
+        }
+    }
+
+    // calls the given function with each position of the geometric's primary
+    // VBO, if the geometric is indexed only the positions used by its
+    // triangles are visited - and each of them only once, rather than once per
+    // triangle
+    template<typename T_Function>
+    void for_each_position(
+            death::Geometric* geometric,
+            const T_Function& function)
+    {
+        // get the primary VBO from the geometry
+        death::VBO* vbo = geometric->get_vbo(0);
+        // no primary vbo?
+        if(vbo == nullptr)
+        {
+            return;
+        }
+        // vbo tuple size not 3?
+        if(vbo->get_tuple_size() != 3)
+        {
+            // TODO: should set an error here?
+            return;
+        }
+        // assume this is position data
+        const DeathSize count = vbo->get_size() / 3;
+        const arc::lx::Vector3f* positions =
+            reinterpret_cast<const arc::lx::Vector3f*>(vbo->get_data());
+
+        const std::vector<DeathUInt32>& indices = geometric->get_indices();
+        if(indices.empty())
+        {
+            for(DeathSize i = 0; i < count; ++i)
+            {
+                function(positions[i]);
+            }
+            return;
+        }
+
+        std::vector<bool> used(count, false);
+        for(DeathUInt32 index : indices)
+        {
+            if(index < count)
+            {
+                used[index] = true;
+            }
+        }
+        for(DeathSize i = 0; i < count; ++i)
+        {
+            if(used[i])
             {
-                set_data_for_octant(
-                    *reinterpret_cast<const arc::lx::Vector3f*>(src)
-                );
+                function(positions[i]);
             }
         }
     }
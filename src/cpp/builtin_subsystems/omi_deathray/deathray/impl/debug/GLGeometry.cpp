@@ -31,14 +31,21 @@ private:
     GLuint m_vao;
     // the number of points in the geometry
     DeathSize m_number_of_points;
+    // the number of indices in the geometry, or 0 if it is not indexed
+    DeathSize m_number_of_indices;
 
 public:
 
     //--------------------------C O N S T R U C T O R---------------------------
 
-    GLGeometryImpl(const DeathFloat* data, DeathSize size)
-        : m_vao             (0)
-        , m_number_of_points(size / 3)
+    GLGeometryImpl(
+            const DeathFloat* data,
+            DeathSize size,
+            const DeathUInt32* indices,
+            DeathSize index_count)
+        : m_vao              (0)
+        , m_number_of_points (size / 3)
+        , m_number_of_indices(index_count)
     {
         // build that data
         glGenVertexArrays(1, &m_vao);
@@ -65,9 +72,28 @@ public:
             static_cast<void*>(0) // array buffer offset
         );
 
+        // the index buffer binding is stored by the vertex array object
+        GLuint index_buffer = 0;
+        if(index_count > 0)
+        {
+            glGenBuffers(1, &index_buffer);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+            glBufferData(
+                GL_ELEMENT_ARRAY_BUFFER,
+                index_count * sizeof(GLuint),
+                indices,
+                GL_STATIC_DRAW
+            );
+        }
+
         // clean up
         glBindVertexArray(0);
         glDeleteBuffers(1, &position_buffer);
+        if(index_buffer != 0)
+        {
+            glDeleteBuffers(1, &index_buffer);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
@@ -76,6 +102,7 @@ public:
     ~GLGeometryImpl()
     {
         m_number_of_points = 0;
+        m_number_of_indices = 0;
         if(m_vao != 0)
         {
             glDeleteVertexArrays(1, &m_vao);
@@ -88,7 +115,19 @@ public:
     void draw()
     {
         glBindVertexArray(m_vao);
-        glDrawArrays(GL_TRIANGLES, 0, m_number_of_points);
+        if(m_number_of_indices > 0)
+        {
+            glDrawElements(
+                GL_TRIANGLES,
+                static_cast<GLsizei>(m_number_of_indices),
+                GL_UNSIGNED_INT,
+                static_cast<void*>(0)
+            );
+        }
+        else
+        {
+            glDrawArrays(GL_TRIANGLES, 0, m_number_of_points);
+        }
         glBindVertexArray(0);
     }
 };
@@ -97,8 +136,12 @@ public:
 //                                  CONSTRUCTOR
 //------------------------------------------------------------------------------
 
-GLGeometry::GLGeometry(const DeathFloat* data, DeathSize size)
-    : m_impl(new GLGeometryImpl(data, size))
+GLGeometry::GLGeometry(
+        const DeathFloat* data,
+        DeathSize size,
+        const DeathUInt32* indices,
+        DeathSize index_count)
+    : m_impl(new GLGeometryImpl(data, size, indices, index_count))
 {
 }
 
@@ -31,7 +31,21 @@ public:
     //                                CONSTRUCTOR
     //--------------------------------------------------------------------------
 
-    GLGeometry(const DeathFloat* data, DeathSize size);
+    /*!
+     * \brief Creates geometry from the given triangle vertex positions.
+     *
+     * \param data The position data, with a tuple size of 3.
+     * \param size The number of values in the position data.
+     * \param indices The indices of the positions of each triangle vertex,
+     *                if the index count is 0 every three positions form a
+     *                triangle.
+     * \param index_count The number of indices.
+     */
+    GLGeometry(
+            const DeathFloat* data,
+            DeathSize size,
+            const DeathUInt32* indices,
+            DeathSize index_count);
 
     //--------------------------------------------------------------------------
     //                                 DESTRUCTOR
@@ -40,8 +40,10 @@ private:
     DeathSpatialHandle m_spatial;
     // geometric data
     DeathGeometricHandle m_geometric;
-    // VBO for vertex positions
+    // VBO for point positions
     DeathVBOHandle m_position_buffer;
+    // the version of the component's data that has been passed to DeathRay
+    arc::uint64 m_data_version;
 
     // TODO: REMOVE ME
     // the DeathRay geometric representation for this object
@@ -63,6 +65,7 @@ public:
         , m_spatial        (nullptr)
         , m_geometric      (nullptr)
         , m_position_buffer(nullptr)
+        , m_data_version   (component->get_data_version())
         , m_geometry       (nullptr)
         // TODO: REMOVE ME
         , m_vao            (0)
@@ -70,23 +73,13 @@ public:
     {
         // generate vbos
         death_vbo_gen(1, &m_position_buffer);
-
-        // pass positions to the VBO
-        const std::vector<float>& positions =
-            m_component->get_vertex_positions();
-        death_vbo_set_data(
-            m_position_buffer,
-            kDeathFloat,
-            static_cast<DeathSize>(positions.size()),
-            3,
-            &positions[0]
-        );
-
         // generate the geometric
         death_geo_gen(1, &m_geometric);
         // attach vbos to geometric
         death_geo_attach_vbo(m_geometric, 0, m_position_buffer);
 
+        set_data();
+
         // generate the spatial entity
         death_spatial_gen(1, &m_spatial);
         // attach geometric to the spatial
@@ -162,6 +155,22 @@ public:
 
     //-------------P U B L I C    M E M B E R    F U N C T I O N S--------------
 
+    void update()
+    {
+        if(m_component->get_data_version() == m_data_version)
+        {
+            return;
+        }
+        m_data_version = m_component->get_data_version();
+
+        set_data();
+
+        // re-adding the spatial rebuilds its octree from the new data, the
+        // rest of the scene is unaffected
+        death_scene_remove_spatial(m_scene, m_spatial);
+        death_scene_add_spatial(m_scene, m_spatial);
+    }
+
     void render(const arc::lx::Matrix44f& vp_matrix)
     {
         // glBindVertexArray(m_vao);
@@ -174,6 +183,35 @@ public:
         // render debug bounds
         // m_geometry->draw_gl_bounds(vp_matrix);
     }
+
+private:
+
+    //------------P R I V A T E    M E M B E R    F U N C T I O N S-------------
+
+    // passes the component's current data to the DeathRay geometric
+    void set_data()
+    {
+        // pass point positions to the VBO
+        const omi::FloatAttribute::ArrayType& positions =
+            m_component->get_point_positions();
+        death_vbo_set_data(
+            m_position_buffer,
+            kDeathFloat,
+            static_cast<DeathSize>(positions.size()),
+            3,
+            positions.data()
+        );
+
+        // the triangles index the points, the mesh has already checked the
+        // indices are not negative
+        const omi::Int32Attribute::ArrayType& indices =
+            m_component->get_vertex_point_indices();
+        death_geo_set_indices(
+            m_geometric,
+            static_cast<DeathSize>(indices.size()),
+            reinterpret_cast<const DeathUInt32*>(indices.data())
+        );
+    }
 };
 
 //------------------------------------------------------------------------------
@@ -198,6 +236,11 @@ DeathMesh::~DeathMesh()
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
+void DeathMesh::update()
+{
+    m_impl->update();
+}
+
 void DeathMesh::render(const arc::lx::Matrix44f& vp_matrix)
 {
     m_impl->render(vp_matrix);
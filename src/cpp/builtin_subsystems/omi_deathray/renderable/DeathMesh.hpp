@@ -45,6 +45,12 @@ public:
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
+    /*!
+     * \brief Passes the mesh component's data to DeathRay again if it has
+     *        changed since it was last passed.
+     */
+    void update();
+
     // TODO:
     void render(const arc::lx::Matrix44f& vp_matrix);
 
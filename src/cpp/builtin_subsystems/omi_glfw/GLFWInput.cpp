@@ -1,6 +1,7 @@
 #include "omi_glfw/GLFWInput.hpp"
 
 #include <omicron/api/context/EventService.hpp>
+#include <omicron/api/context/InputState.hpp>
 
 #include "omi_glfw/GLFWGlobals.hpp"
 
@@ -17,24 +18,22 @@ namespace input
 void mouse_move_callback(GLFWwindow* window, double pos_x, double pos_y)
 {
     // construct the data
-    omi::Int32Attribute::ArrayType mouse_position = {
-        static_cast<arc::int32>(pos_x),
-        static_cast<arc::int32>(pos_y)
-    };
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataMousePosition,
-            omi::Int32Attribute(mouse_position)
-        }
-    };
+    omi::context::Event::Payload payload = {};
+    payload.x = static_cast<arc::int32>(pos_x);
+    payload.y = static_cast<arc::int32>(pos_y);
+
+    // record the input state
+    omi::context::InputState::instance().set_mouse_position(
+        payload.x,
+        payload.y
+    );
 
-    // construct and broadcast the event to the engine
+    // construct and post the event to the engine
     omi::context::Event event(
-        omi::context::Event::kTypeMouseMove,
-        omi::MapAttribute(data)
+        omi::context::Event::kTypeIdMouseMove,
+        payload
     );
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::EventService::instance().post(event);
 }
 
 void mouse_button_callback(
@@ -44,14 +43,14 @@ void mouse_button_callback(
         int mods)
 {
     // determine the event type
-    arc::str::UTF8String type;
+    omi::context::Event::TypeId type_id;
     switch(action)
     {
         case GLFW_PRESS:
-            type = omi::context::Event::kTypeMouseButtonPress;
+            type_id = omi::context::Event::kTypeIdMouseButtonPress;
             break;
         case GLFW_RELEASE:
-            type = omi::context::Event::kTypeMouseButtonRelease;
+            type_id = omi::context::Event::kTypeIdMouseButtonRelease;
             break;
         default:
             // not interested in this event
@@ -59,65 +58,58 @@ void mouse_button_callback(
     }
 
     // construct the data
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataKeyCode,
-            // can safely cast GLFW mouse buttons to Omicron mouse buttons for
-            // now since they align
-            omi::Int32Attribute(button)
-        },
-        {
-            omi::context::Event::kDataModifiers,
-            // can safely cast GLFW modifier flags to Omicron modifier flags for
-            // now since they align
-            omi::Int32Attribute(mods)
-        }
-    };
-
-    // construct and broadcast the event to the engine
-    omi::context::Event event(type, omi::MapAttribute(data));
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::Event::Payload payload = {};
+    // can safely cast GLFW mouse buttons to Omicron mouse buttons for now
+    // since they align
+    payload.code = button;
+    // can safely cast GLFW modifier flags to Omicron modifier flags for now
+    // since they align
+    payload.modifiers = mods;
+
+    // record the input state
+    omi::context::InputState::instance().set_mouse_button(
+        static_cast<omi::context::Event::MouseButton>(button),
+        action == GLFW_PRESS
+    );
+
+    // construct and post the event to the engine
+    omi::context::Event event(type_id, payload);
+    omi::context::EventService::instance().post(event);
 }
 
 void mouse_scroll_callback(GLFWwindow* window, double amount_x, double amount_y)
 {
     // construct the data
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataMouseScrollAmountX,
-            omi::Int32Attribute(static_cast<arc::int32>(amount_x))
-        },
-        {
-            omi::context::Event::kDataMouseScrollAmountY,
-            omi::Int32Attribute(static_cast<arc::int32>(amount_y))
-        }
-    };
-
-    // construct and broadcast the event to the engine
+    omi::context::Event::Payload payload = {};
+    payload.x = static_cast<arc::int32>(amount_x);
+    payload.y = static_cast<arc::int32>(amount_y);
+
+    // record the input state
+    omi::context::InputState::instance().add_scroll(payload.x, payload.y);
+
+    // construct and post the event to the engine
     omi::context::Event event(
-        omi::context::Event::kTypeMouseScroll,
-        omi::MapAttribute(data)
+        omi::context::Event::kTypeIdMouseScroll,
+        payload
     );
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::EventService::instance().post(event);
 }
 
 void mouse_enter_callback(GLFWwindow* window, int entered)
 {
     // determine the type
-    arc::str::UTF8String type;
+    omi::context::Event::TypeId type_id;
     if(entered)
     {
-        type = omi::context::Event::kTypeMouseEnter;
+        type_id = omi::context::Event::kTypeIdMouseEnter;
     }
     else
     {
-        type = omi::context::Event::kTypeMouseExit;
+        type_id = omi::context::Event::kTypeIdMouseExit;
     }
-    // construct and broadcast the event to the engine
-    omi::context::Event event(type, omi::MapAttribute());
-    omi::context::EventService::instance().broadcast(event);
+    // construct and post the event to the engine
+    omi::context::Event event(type_id, omi::context::Event::Payload());
+    omi::context::EventService::instance().post(event);
 }
 
 void key_callback(
@@ -128,14 +120,14 @@ void key_callback(
         int mods)
 {
     // determine the event type
-    arc::str::UTF8String type;
+    omi::context::Event::TypeId type_id;
     switch(action)
     {
         case GLFW_PRESS:
-            type = omi::context::Event::kTypeKeyPress;
+            type_id = omi::context::Event::kTypeIdKeyPress;
             break;
         case GLFW_RELEASE:
-            type = omi::context::Event::kTypeKeyRelease;
+            type_id = omi::context::Event::kTypeIdKeyRelease;
             break;
         default:
             // not interested in this event
@@ -143,25 +135,23 @@ void key_callback(
     }
 
     // construct the data
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataKeyCode,
-            // can safely cast GLFW keys code to Omicron key codes for now since
-            // they align
-            omi::Int32Attribute(key)
-        },
-        {
-            omi::context::Event::kDataModifiers,
-            // can safely cast GLFW modifier flags to Omicron modifier flags for
-            // now since they align
-            omi::Int32Attribute(mods)
-        }
-    };
-
-    // construct and broadcast the event to the engine
-    omi::context::Event event(type, omi::MapAttribute(data));
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::Event::Payload payload = {};
+    // can safely cast GLFW keys code to Omicron key codes for now since they
+    // align
+    payload.code = key;
+    // can safely cast GLFW modifier flags to Omicron modifier flags for now
+    // since they align
+    payload.modifiers = mods;
+
+    // record the input state
+    omi::context::InputState::instance().set_key(
+        static_cast<omi::context::Event::KeyCode>(key),
+        action == GLFW_PRESS
+    );
+
+    // construct and post the event to the engine
+    omi::context::Event event(type_id, payload);
+    omi::context::EventService::instance().post(event);
 }
 
 } // namespace input
@@ -1,6 +1,7 @@
 #include "omi_glfw/GLFWSurface.hpp"
 
 #include <omicron/api/context/EventService.hpp>
+#include <omicron/api/context/InputState.hpp>
 
 #include "omi_glfw/GLFWInput.hpp"
 
@@ -133,6 +134,11 @@ void GLFWSurface::cycle_end()
     if(m_lock_mouse)
     {
         glfwSetCursorPos(m_glfw_window, m_size(0) / 2, m_size(1) / 2);
+        // so the return to the centre isn't counted as mouse movement
+        omi::context::InputState::instance().warp_mouse_position(
+            m_size(0) / 2,
+            m_size(1) / 2
+        );
     }
 }
 
@@ -153,23 +159,15 @@ void GLFWSurface::resize_callback(GLFWwindow* window, int width, int height)
     );
 
     // construct event data
-    omi::Int32Attribute::ArrayType event_size = {
-        static_cast<arc::int32>(width),
-        static_cast<arc::int32>(height)
-    };
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataWindowSize,
-            omi::Int32Attribute(event_size)
-        }
-    };
-    // construct and broadcast the event to the engine
+    omi::context::Event::Payload payload = {};
+    payload.x = static_cast<arc::int32>(width);
+    payload.y = static_cast<arc::int32>(height);
+    // construct and post the event to the engine
     omi::context::Event event(
-        omi::context::Event::kTypeWindowResize,
-        omi::MapAttribute(data)
+        omi::context::Event::kTypeIdWindowResize,
+        payload
     );
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::EventService::instance().post(event);
 }
 
 void GLFWSurface::move_callback(GLFWwindow* window, int pos_x, int pos_y)
@@ -180,23 +178,15 @@ void GLFWSurface::move_callback(GLFWwindow* window, int pos_x, int pos_y)
     );
 
     // construct event data
-    omi::Int32Attribute::ArrayType event_position = {
-        static_cast<arc::int32>(pos_x),
-        static_cast<arc::int32>(pos_y)
-    };
-    omi::MapAttribute::DataType data =
-    {
-        {
-            omi::context::Event::kDataWindowPosition,
-            omi::Int32Attribute(event_position)
-        }
-    };
-    // construct and broadcast the event to the engine
+    omi::context::Event::Payload payload = {};
+    payload.x = static_cast<arc::int32>(pos_x);
+    payload.y = static_cast<arc::int32>(pos_y);
+    // construct and post the event to the engine
     omi::context::Event event(
-        omi::context::Event::kTypeWindowMove,
-        omi::MapAttribute(data)
+        omi::context::Event::kTypeIdWindowMove,
+        payload
     );
-    omi::context::EventService::instance().broadcast(event);
+    omi::context::EventService::instance().post(event);
 }
 
 //------------------------------------------------------------------------------
@@ -3,7 +3,7 @@
 #include <arcanecore/lx/MatrixMath44f.hpp>
 
 #include <omicron/api/GameInterface.hpp>
-#include <omicron/api/context/Surface.hpp>
+#include <omicron/api/context/InputState.hpp>
 #include <omicron/api/res/ResourceId.hpp>
 #include <omicron/api/scene/Entity.hpp>
 #include <omicron/api/scene/SceneState.hpp>
@@ -127,9 +127,7 @@ public:
         omi::scene::SceneState::instance().set_debug_camera(debug_camera);
 
         // event subscriptions
-        subscribe_to_event(omi::context::Event::kTypeMouseMove);
-        subscribe_to_event(omi::context::Event::kTypeMouseScroll);
-        subscribe_to_event(omi::context::Event::kTypeKeyPress);
+        subscribe_to_event(omi::context::Event::kTypeIdKeyPress);
     }
 
     //--------------------------------------------------------------------------
@@ -148,62 +146,8 @@ private:
 
     virtual void on_event(const omi::context::Event& event) override
     {
-        arc::int32 scroll_amount_x = 0;
-        arc::int32 scroll_amount_y = 0;
         omi::context::Event::KeyCode key_code;
-
-
-        // TODO: utility for this
-        if(event.get_type() == omi::context::Event::kTypeMouseMove)
-        {
-            // get the mouse position
-            omi::Int32Attribute mouse_pos_attr =
-                event.get_data()[omi::context::Event::kDataMousePosition];
-            if(!mouse_pos_attr.is_valid() || mouse_pos_attr.get_size() != 2)
-            {
-                // TODO:
-                return;
-            }
-
-            // get the mouse position
-            arc::lx::Vector2i mouse_pos(
-                mouse_pos_attr.get_values()[0],
-                mouse_pos_attr.get_values()[1]
-            );
-
-            arc::int32 half_width =
-                omi::context::Surface::instance()->get_width() / 2;
-            arc::int32 half_height =
-                omi::context::Surface::instance()->get_height() / 2;
-
-            // move by the difference
-            if(!m_debug_control)
-            {
-                m_spin->angle() += (mouse_pos(0) - half_width) * -0.002F;
-                m_tilt->angle() += (mouse_pos(1) - half_height) * -0.002F;
-            }
-            else
-            {
-                m_debug_spin->angle() += (mouse_pos(0) - half_width) * -0.002F;
-                m_debug_tilt->angle() += (mouse_pos(1) - half_height) * -0.002F;
-            }
-        }
-        else if(omi::context::Event::mouse_scroll(
-            event,
-            scroll_amount_x,
-            scroll_amount_y
-        ))
-        {
-            if(!m_debug_control)
-            {
-                m_zoom->translation()(2) -= scroll_amount_y * 0.1F;
-            }
-            else
-            {
-                m_debug_zoom->translation()(2) -= scroll_amount_y * 0.1F;
-            }
-        }
-        else if(omi::context::Event::key_press(event, key_code))
+        if(omi::context::Event::key_press(event, key_code))
         {
             if(key_code == omi::context::Event::kKeyCodeX)
             {
@@ -214,6 +158,27 @@ private:
 
     virtual void update() override
     {
+        const omi::context::InputState& input =
+            omi::context::InputState::instance();
+
+        // move by how far the mouse has moved from the centre of the window
+        // since the last frame
+        arc::int32 delta_x = input.get_mouse_delta_x();
+        arc::int32 delta_y = input.get_mouse_delta_y();
+        arc::int32 scroll_amount_y = input.get_scroll_y();
+        if(!m_debug_control)
+        {
+            m_spin->angle() += delta_x * -0.002F;
+            m_tilt->angle() += delta_y * -0.002F;
+            m_zoom->translation()(2) -= scroll_amount_y * 0.1F;
+        }
+        else
+        {
+            m_debug_spin->angle() += delta_x * -0.002F;
+            m_debug_tilt->angle() += delta_y * -0.002F;
+            m_debug_zoom->translation()(2) -= scroll_amount_y * 0.1F;
+        }
+
         // rotate the camera
         // m_spin->angle() += arc::math::degrees_to_radians(0.25F);
     }
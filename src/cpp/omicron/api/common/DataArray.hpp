@@ -0,0 +1,872 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_DATAARRAY_HPP_
+#define OMICRON_API_COMMON_DATAARRAY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace omi
+{
+
+/*!
+ * \brief A contiguous array container that stores small arrays inline.
+ *
+ * This provides a subset of the std::vector interface but arrays of up to
+ * kInlineCapacity elements are stored within the DataArray object itself,
+ * meaning that small arrays (e.g. scalar values, vectors, and colours) require
+ * no heap allocations and can be accessed without following a pointer to a
+ * separate block of memory. Once the array grows beyond the inline capacity its
+ * elements are moved to the heap.
+ *
+ * A DataArray may also be created as a read-only view of memory it does not own
+ * (see borrow()), for example a loaded file buffer or a memory-mapped region.
+ * Borrowed memory is never written to: the first time a borrowed array is
+ * modified the elements are copied into memory owned by the array and the
+ * borrowed memory is released.
+ *
+ * \warning Element access (operator[], at(), data(), begin(), end(), front(),
+ *          and back()) is always read-only, even on a non-const array, so that
+ *          reading a borrowed array never copies it. Elements are written
+ *          using set() or through the pointer returned by mutable_data(), which
+ *          (like the other modifying functions) copy borrowed memory first.
+ *
+ * DataArray is the ArrayType of Omicron's data attributes. So that code written
+ * against std::vector continues to work, it converts implicitly to and from
+ * std::vector, compares with std::vector, and provides the commonly used
+ * std::vector members (at(), insert(), erase(), swap(), etc). Unlike
+ * std::vector<bool>, a DataArray<bool> stores one bool per byte so its elements
+ * are real bools which can be referenced and accessed through data().
+ *
+ * \tparam T_DataType The type of the elements of this array.
+ */
+template<typename T_DataType>
+class DataArray
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              TYPE DEFINITIONS
+    //--------------------------------------------------------------------------
+
+    typedef T_DataType value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T_DataType& reference;
+    typedef const T_DataType& const_reference;
+    typedef T_DataType* pointer;
+    typedef const T_DataType* const_pointer;
+    typedef T_DataType* iterator;
+    typedef const T_DataType* const_iterator;
+
+    /*!
+     * \brief Function signature for the callback used to release borrowed
+     *        memory.
+     *
+     * \param user_data The user data that was passed to borrow().
+     */
+    typedef void (ReleaseFunc)(void* user_data);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum number of elements that will be stored inline
+     *        (always at least 1).
+     */
+    static const std::size_t kInlineCapacity =
+        sizeof(T_DataType) >= 32 ? 1 : 32 / sizeof(T_DataType);
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new empty array.
+     */
+    DataArray()
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+    }
+
+    /*!
+     * \brief Creates a new array using a copy of the data described by the
+     *        given iterators.
+     */
+    template<typename T_InputIterator>
+    DataArray(const T_InputIterator& first, const T_InputIterator& last)
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+        assign(first, last);
+    }
+
+    /*!
+     * \brief Creates a new array from the given initializer list.
+     */
+    DataArray(std::initializer_list<T_DataType> values)
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+        assign(values.begin(), values.end());
+    }
+
+    /*!
+     * \brief Creates a new array using a copy of the data in the given vector.
+     */
+    DataArray(const std::vector<T_DataType>& values)
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+        assign(values.begin(), values.end());
+    }
+
+    /*!
+     * \brief Copy constructor.
+     */
+    DataArray(const DataArray& other)
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    /*!
+     * \brief Move constructor.
+     */
+    DataArray(DataArray&& other)
+        : m_data    (inline_data())
+        , m_size    (0)
+        , m_capacity(kInlineCapacity)
+    {
+        steal(other);
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~DataArray()
+    {
+        clear();
+        free_heap();
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new array which is a view of the given memory rather
+     *        than a copy of it.
+     *
+     * The memory must remain valid and unmodified until the release function
+     * has been called (or the array has been destroyed if no release function
+     * is provided). The release function will be called exactly once: when
+     * the array is destroyed, when its contents are replaced, or when it is
+     * copied into owned memory for modification. It may be called from any
+     * thread that the array is released on.
+     *
+     * \param data Pointer to the first element of the memory to borrow.
+     * \param size The number of elements to borrow.
+     * \param release Function that will be called once the memory is no longer
+     *                required by this array, may be null.
+     * \param user_data Pointer that will be passed to the release function.
+     */
+    static DataArray borrow(
+            const T_DataType* data,
+            std::size_t size,
+            ReleaseFunc* release = nullptr,
+            void* user_data = nullptr)
+    {
+        DataArray array;
+        array.m_data = const_cast<T_DataType*>(data);
+        array.m_size = size;
+        array.m_capacity = 0;
+        array.get_borrow_info()->release = release;
+        array.get_borrow_info()->user_data = user_data;
+        return array;
+    }
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Copy assignment operator.
+     */
+    DataArray& operator=(const DataArray& other)
+    {
+        if(this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Move assignment operator.
+     */
+    DataArray& operator=(DataArray&& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            free_heap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Initializer list assignment operator.
+     */
+    DataArray& operator=(std::initializer_list<T_DataType> values)
+    {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    /*!
+     * \brief Vector assignment operator.
+     */
+    DataArray& operator=(const std::vector<T_DataType>& values)
+    {
+        assign(values.begin(), values.end());
+        return *this;
+    }
+
+    /*!
+     * \brief Equality operator.
+     */
+    bool operator==(const DataArray& other) const
+    {
+        return
+            m_size == other.m_size &&
+            std::equal(begin(), end(), other.begin());
+    }
+
+    /*!
+     * \brief Inequality operator.
+     */
+    bool operator!=(const DataArray& other) const
+    {
+        return !((*this) == other);
+    }
+
+    /*!
+     * \brief Lexicographical less than operator.
+     */
+    bool operator<(const DataArray& other) const
+    {
+        return std::lexicographical_compare(
+            begin(),
+            end(),
+            other.begin(),
+            other.end()
+        );
+    }
+
+    /*!
+     * \brief Returns a copy of this array's elements as a std::vector.
+     */
+    operator std::vector<T_DataType>() const
+    {
+        return std::vector<T_DataType>(m_data, m_data + m_size);
+    }
+
+    /*!
+     * \brief Returns whether the given array and vector hold equal elements.
+     */
+    friend bool operator==(
+            const DataArray& array,
+            const std::vector<T_DataType>& vector)
+    {
+        return
+            array.size() == vector.size() &&
+            std::equal(array.cbegin(), array.cend(), vector.begin());
+    }
+
+    friend bool operator==(
+            const std::vector<T_DataType>& vector,
+            const DataArray& array)
+    {
+        return array == vector;
+    }
+
+    friend bool operator!=(
+            const DataArray& array,
+            const std::vector<T_DataType>& vector)
+    {
+        return !(array == vector);
+    }
+
+    friend bool operator!=(
+            const std::vector<T_DataType>& vector,
+            const DataArray& array)
+    {
+        return !(array == vector);
+    }
+
+    /*!
+     * \brief Returns a const reference to the element at the given index (no
+     *        bounds checking is performed).
+     */
+    const T_DataType& operator[](std::size_t index) const
+    {
+        return m_data[index];
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of elements in this array.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether this array has no elements.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns the number of elements this array can hold before it
+     *        needs to allocate more memory.
+     */
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /*!
+     * \brief Returns whether the elements of this array are currently stored
+     *        inline (i.e. not on the heap or borrowed).
+     */
+    bool is_inline() const
+    {
+        return m_data == inline_data();
+    }
+
+    /*!
+     * \brief Returns whether this array is currently a view of borrowed memory.
+     */
+    bool is_borrowed() const
+    {
+        return m_capacity == 0;
+    }
+
+    /*!
+     * \brief Returns a const pointer to the contiguous elements of this array.
+     */
+    const T_DataType* data() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns a pointer to the contiguous elements of this array which
+     *        may be used to modify them.
+     *
+     * \note If this array is borrowed its elements are first copied into owned
+     *       memory, so this should only be used when the elements are going to
+     *       be written to.
+     */
+    T_DataType* mutable_data()
+    {
+        detach();
+        return m_data;
+    }
+
+    const_iterator begin() const
+    {
+        return m_data;
+    }
+
+    const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    const_iterator cbegin() const
+    {
+        return m_data;
+    }
+
+    const_iterator cend() const
+    {
+        return m_data + m_size;
+    }
+
+    /*!
+     * \brief Returns a const reference to the element at the given index.
+     *
+     * \throw std::out_of_range If the index is out of bounds (as
+     *                          std::vector::at()).
+     */
+    const T_DataType& at(std::size_t index) const
+    {
+        check_index(index);
+        return m_data[index];
+    }
+
+    /*!
+     * \brief Returns a const reference to the first element of this array.
+     */
+    const T_DataType& front() const
+    {
+        return m_data[0];
+    }
+
+    /*!
+     * \brief Returns a const reference to the last element of this array.
+     */
+    const T_DataType& back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    /*!
+     * \brief Replaces the element at the given index with a copy of the given
+     *        value (no bounds checking is performed).
+     *
+     * \note If this array is borrowed its elements are first copied into owned
+     *       memory.
+     */
+    void set(std::size_t index, const T_DataType& value)
+    {
+        // copy first in case the value is an element of this array
+        T_DataType copy(value);
+        detach();
+        m_data[index] = std::move(copy);
+    }
+
+    /*!
+     * \brief Removes all elements from this array.
+     *
+     * \note This does not release any heap memory held by this array.
+     */
+    void clear()
+    {
+        if(is_borrowed())
+        {
+            release_borrowed();
+            return;
+        }
+        destroy(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    /*!
+     * \brief Ensures this array has the capacity to hold at least the given
+     *        number of elements.
+     */
+    void reserve(std::size_t capacity)
+    {
+        detach();
+        if(capacity <= m_capacity)
+        {
+            return;
+        }
+
+        T_DataType* data = static_cast<T_DataType*>(
+            ::operator new(capacity * sizeof(T_DataType))
+        );
+        // move the existing elements
+        for(std::size_t i = 0; i < m_size; ++i)
+        {
+            new (data + i) T_DataType(std::move(m_data[i]));
+        }
+        destroy(m_data, m_data + m_size);
+        free_heap();
+
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    /*!
+     * \brief Resizes this array to hold the given number of elements, new
+     *        elements are value-initialised.
+     */
+    void resize(std::size_t size)
+    {
+        detach();
+        if(size < m_size)
+        {
+            destroy(m_data + size, m_data + m_size);
+            m_size = size;
+            return;
+        }
+        reserve(size);
+        for(; m_size < size; ++m_size)
+        {
+            new (m_data + m_size) T_DataType();
+        }
+    }
+
+    /*!
+     * \brief Resizes this array to hold the given number of elements, new
+     *        elements are copies of the given value.
+     */
+    void resize(std::size_t size, const T_DataType& value)
+    {
+        if(size <= m_size)
+        {
+            resize(size);
+            return;
+        }
+        // copy first in case the value is an element of this array
+        T_DataType copy(value);
+        reserve(size);
+        for(; m_size < size; ++m_size)
+        {
+            new (m_data + m_size) T_DataType(copy);
+        }
+    }
+
+    /*!
+     * \brief Appends a copy of the given value to the end of this array.
+     */
+    void push_back(const T_DataType& value)
+    {
+        detach();
+        if(m_size == m_capacity)
+        {
+            // copy first in case the value is an element of this array
+            T_DataType copy(value);
+            reserve(m_capacity * 2);
+            new (m_data + m_size) T_DataType(std::move(copy));
+        }
+        else
+        {
+            new (m_data + m_size) T_DataType(value);
+        }
+        ++m_size;
+    }
+
+    /*!
+     * \brief Moves the given value to the end of this array.
+     */
+    void push_back(T_DataType&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /*!
+     * \brief Constructs a new element at the end of this array from the given
+     *        arguments.
+     */
+    template<typename... T_Args>
+    void emplace_back(T_Args&&... args)
+    {
+        detach();
+        if(m_size == m_capacity)
+        {
+            // construct first in case the arguments refer to this array
+            T_DataType value(std::forward<T_Args>(args)...);
+            reserve(m_capacity * 2);
+            new (m_data + m_size) T_DataType(std::move(value));
+        }
+        else
+        {
+            new (m_data + m_size) T_DataType(std::forward<T_Args>(args)...);
+        }
+        ++m_size;
+    }
+
+    /*!
+     * \brief Removes the last element of this array.
+     */
+    void pop_back()
+    {
+        detach();
+        --m_size;
+        m_data[m_size].~T_DataType();
+    }
+
+    /*!
+     * \brief Replaces the contents of this array with a copy of the data
+     *        described by the given iterators.
+     */
+    template<typename T_InputIterator>
+    void assign(const T_InputIterator& first, const T_InputIterator& last)
+    {
+        clear();
+        reserve(static_cast<std::size_t>(std::distance(first, last)));
+        for(T_InputIterator it = first; it != last; ++it)
+        {
+            new (m_data + m_size) T_DataType(*it);
+            ++m_size;
+        }
+    }
+
+    /*!
+     * \brief Inserts a copy of the given value before the given position.
+     *
+     * \return An iterator to the inserted element.
+     */
+    iterator insert(const_iterator position, const T_DataType& value)
+    {
+        return insert(position, &value, &value + 1);
+    }
+
+    /*!
+     * \brief Inserts a copy of the data described by the given iterators before
+     *        the given position.
+     *
+     * \return An iterator to the first inserted element.
+     */
+    template<typename T_InputIterator>
+    iterator insert(
+            const_iterator position,
+            const T_InputIterator& first,
+            const T_InputIterator& last)
+    {
+        std::size_t index = static_cast<std::size_t>(position - m_data);
+        // copy first in case the elements are from this array
+        DataArray inserted(first, last);
+        std::size_t old_size = m_size;
+        reserve(m_size + inserted.size());
+        T_DataType* values = inserted.mutable_data();
+        for(std::size_t i = 0; i < inserted.size(); ++i)
+        {
+            new (m_data + m_size) T_DataType(std::move(values[i]));
+            ++m_size;
+        }
+        // rotate the new elements into place
+        std::rotate(m_data + index, m_data + old_size, m_data + m_size);
+        return m_data + index;
+    }
+
+    /*!
+     * \brief Removes the element at the given position.
+     *
+     * \return An iterator to the element following the removed element.
+     */
+    iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    /*!
+     * \brief Removes the elements in the given range.
+     *
+     * \return An iterator to the element following the removed elements.
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        std::size_t first_index = static_cast<std::size_t>(first - m_data);
+        std::size_t last_index = static_cast<std::size_t>(last - m_data);
+        detach();
+        std::move(m_data + last_index, m_data + m_size, m_data + first_index);
+        std::size_t size = m_size - (last_index - first_index);
+        destroy(m_data + size, m_data + m_size);
+        m_size = size;
+        return m_data + first_index;
+    }
+
+    /*!
+     * \brief Swaps the contents of this array with the given array.
+     */
+    void swap(DataArray& other)
+    {
+        DataArray temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    // describes how to release borrowed memory, this is stored in the (unused)
+    // inline memory while the array is borrowed
+    struct BorrowInfo
+    {
+        ReleaseFunc* release;
+        void* user_data;
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the elements of this array, points to m_inline when stored inline
+    T_DataType* m_data;
+    // the number of elements in this array
+    std::size_t m_size;
+    // the number of elements that can be held by the current memory, 0 denotes
+    // the memory is borrowed
+    std::size_t m_capacity;
+    // the inline memory (uninitialised)
+    typename std::aligned_storage<
+        sizeof(T_DataType) * kInlineCapacity,
+        std::alignment_of<T_DataType>::value
+    >::type m_inline;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns a pointer to the inline memory
+    T_DataType* inline_data()
+    {
+        return reinterpret_cast<T_DataType*>(&m_inline);
+    }
+
+    // returns a const pointer to the inline memory
+    const T_DataType* inline_data() const
+    {
+        return reinterpret_cast<const T_DataType*>(&m_inline);
+    }
+
+    // returns the borrow info stored in the inline memory
+    BorrowInfo* get_borrow_info()
+    {
+        static_assert(
+            sizeof(m_inline) >= sizeof(BorrowInfo),
+            "Inline memory is too small to hold borrow info"
+        );
+        return reinterpret_cast<BorrowInfo*>(&m_inline);
+    }
+
+    // releases borrowed memory and returns this array to being empty and
+    // inline
+    void release_borrowed()
+    {
+        BorrowInfo info = *get_borrow_info();
+        m_data = inline_data();
+        m_size = 0;
+        m_capacity = kInlineCapacity;
+        if(info.release != nullptr)
+        {
+            info.release(info.user_data);
+        }
+    }
+
+    // if this array is borrowed its elements are copied into owned memory and
+    // the borrowed memory is released
+    void detach()
+    {
+        if(!is_borrowed())
+        {
+            return;
+        }
+
+        BorrowInfo info = *get_borrow_info();
+        const T_DataType* borrowed = m_data;
+        std::size_t size = m_size;
+
+        m_data = inline_data();
+        m_size = 0;
+        m_capacity = kInlineCapacity;
+        reserve(size);
+        for(; m_size < size; ++m_size)
+        {
+            new (m_data + m_size) T_DataType(borrowed[m_size]);
+        }
+
+        if(info.release != nullptr)
+        {
+            info.release(info.user_data);
+        }
+    }
+
+    // throws if the given index is out of bounds
+    void check_index(std::size_t index) const
+    {
+        if(index >= m_size)
+        {
+            throw std::out_of_range("DataArray index out of range");
+        }
+    }
+
+    // destroys the elements in the given range
+    static void destroy(T_DataType* first, T_DataType* last)
+    {
+        for(; first != last; ++first)
+        {
+            first->~T_DataType();
+        }
+    }
+
+    // releases the heap memory of this array (if any) and returns to inline
+    // storage - the elements must have already been destroyed
+    void free_heap()
+    {
+        if(!is_inline() && !is_borrowed())
+        {
+            ::operator delete(m_data);
+            m_data = inline_data();
+            m_capacity = kInlineCapacity;
+        }
+    }
+
+    // takes the contents of the other array, leaving it empty - this array
+    // must be empty and inline
+    void steal(DataArray& other)
+    {
+        if(other.is_borrowed())
+        {
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = 0;
+            *get_borrow_info() = *other.get_borrow_info();
+            other.m_data = other.inline_data();
+            other.m_size = 0;
+            other.m_capacity = kInlineCapacity;
+        }
+        else if(other.is_inline())
+        {
+            for(std::size_t i = 0; i < other.m_size; ++i)
+            {
+                new (m_data + i) T_DataType(std::move(other.m_data[i]));
+            }
+            m_size = other.m_size;
+            other.clear();
+        }
+        else
+        {
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inline_data();
+            other.m_size = 0;
+            other.m_capacity = kInlineCapacity;
+        }
+    }
+};
+
+template<typename T_DataType>
+const std::size_t DataArray<T_DataType>::kInlineCapacity;
+
+} // namespace omi
+
+#endif
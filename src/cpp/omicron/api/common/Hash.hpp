@@ -124,6 +124,31 @@ public:
     {
         return !((*this) == other);
     }
+
+    /*!
+     * \brief Adds the parts of the other hash to the parts of this hash
+     *        (wrapping on overflow).
+     *
+     * This can be used to combine hashes independently of order, and
+     * subtracting a hash will remove its contribution again.
+     */
+    Hash& operator+=(const Hash& other)
+    {
+        part1 += other.part1;
+        part2 += other.part2;
+        return *this;
+    }
+
+    /*!
+     * \brief Subtracts the parts of the other hash from the parts of this hash
+     *        (wrapping on underflow).
+     */
+    Hash& operator-=(const Hash& other)
+    {
+        part1 -= other.part1;
+        part2 -= other.part2;
+        return *this;
+    }
 };
 
 } // namespace omi
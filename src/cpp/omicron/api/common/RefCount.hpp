@@ -0,0 +1,169 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_REFCOUNT_HPP_
+#define OMICRON_API_COMMON_REFCOUNT_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+
+
+namespace omi
+{
+
+/*!
+ * \brief Unsynchronised reference counter.
+ *
+ * This is the default reference counter used by Omicron objects and is only
+ * safe to use when the referenced object is accessed from a single thread.
+ */
+class PlainRefCount
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new reference counter with the given initial count.
+     */
+    PlainRefCount(std::size_t count = 1)
+        : m_count(count)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the current reference count.
+     */
+    std::size_t get() const
+    {
+        return m_count;
+    }
+
+    /*!
+     * \brief Increments the reference count.
+     */
+    void increment()
+    {
+        ++m_count;
+    }
+
+    /*!
+     * \brief Decrements the reference count and returns whether this was the
+     *        last reference (i.e. the referenced object should be destroyed).
+     */
+    bool decrement()
+    {
+        return --m_count == 0;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::size_t m_count;
+};
+
+/*!
+ * \brief Thread-safe reference counter.
+ *
+ * Increments use relaxed ordering since a new reference can only be made from
+ * an existing one, while decrements use acquire-release ordering so that the
+ * thread which releases the last reference observes all writes made through
+ * the other references before destroying the object.
+ */
+class AtomicRefCount
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new reference counter with the given initial count.
+     */
+    AtomicRefCount(std::size_t count = 1)
+        : m_count(count)
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the current reference count.
+     *
+     * \note Uses acquire ordering so that a count of 1 guarantees this thread
+     *       is the sole owner and may safely modify the referenced object.
+     */
+    std::size_t get() const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Increments the reference count.
+     */
+    void increment()
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Decrements the reference count and returns whether this was the
+     *        last reference (i.e. the referenced object should be destroyed).
+     */
+    bool decrement()
+    {
+        return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    std::atomic<std::size_t> m_count;
+};
+
+//------------------------------------------------------------------------------
+//                              REFERENCE COUNT MODE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief The reference counter type used by Omicron's shared objects (e.g.
+ *        Attribute storage).
+ *
+ * By default this is the unsynchronised PlainRefCount, defining
+ * OMI_API_ATOMIC_REF_COUNT at compile time (see the OMI_ATOMIC_REF_COUNT CMake
+ * option) switches to AtomicRefCount so that objects may be shared between
+ * threads.
+ */
+#ifdef OMI_API_ATOMIC_REF_COUNT
+    typedef AtomicRefCount RefCount;
+#else
+    typedef PlainRefCount RefCount;
+#endif
+
+} // namespace omi
+
+#endif
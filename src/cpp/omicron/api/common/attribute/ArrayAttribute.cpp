@@ -1,6 +1,5 @@
 #include "omicron/api/common/attribute/ArrayAttribute.hpp"
 
-#include <cassert>
 #include <cstring>
 
 #include <arcanecore/base/Exceptions.hpp>
@@ -9,6 +8,36 @@
 namespace omi
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns the contribution an element with the given index and hash makes to
+// the hash of an array
+Hash hash_element(std::size_t index, const Hash& hash)
+{
+    Hash ret(index, index);
+    arc::crypt::hash::spooky_128(
+        static_cast<const void*>(&hash),
+        sizeof(hash),
+        ret.part1,
+        ret.part2,
+        ret.part1,
+        ret.part2
+    );
+    // (0, 0) is reserved for elements that need recomputing
+    if(ret.part1 == 0 && ret.part2 == 0)
+    {
+        ret.part1 = 1;
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                               STATIC ATTRIBUTES
 //------------------------------------------------------------------------------
@@ -22,6 +51,28 @@ OMI_API_EXPORT Attribute::Type ArrayAttribute::kTypeArray = 1;
 //----------------------------C O N S T U C T O R S-----------------------------
 
 OMI_API_EXPORT ArrayAttribute::ArrayStorage::ArrayStorage()
+    : Attribute::Storage(true)
+    , m_structure_dirty (true)
+{
+}
+
+OMI_API_EXPORT ArrayAttribute::ArrayStorage::ArrayStorage(DataType&& data)
+    : Attribute::Storage(true)
+    , m_data            (std::move(data))
+    , m_structure_dirty (true)
+{
+    for(const Attribute& element : m_data)
+    {
+        link_entry(element);
+    }
+}
+
+OMI_API_EXPORT ArrayAttribute::ArrayStorage::ArrayStorage(
+        DataType&& data,
+        ArrayStorage* shares_entries_with)
+    : Attribute::Storage(true, shares_entries_with)
+    , m_data            (std::move(data))
+    , m_structure_dirty (true)
 {
 }
 
@@ -50,14 +101,7 @@ OMI_API_EXPORT bool ArrayAttribute::ArrayStorage::equals(
     }
 
     // check entries
-    for(std::size_t i = 0; i < m_data.size(); ++i)
-    {
-        if(m_data[i] != casted->m_data[i])
-        {
-            return false;
-        }
-    }
-    return true;
+    return m_data == casted->m_data;
 }
 
 OMI_API_EXPORT bool ArrayAttribute::ArrayStorage::less_than(
@@ -103,18 +147,17 @@ Attribute::Storage* ArrayAttribute::ArrayStorage::as_pure_immutable()
     // is the data already pure immutable?
     if(is_data_pure_immutable())
     {
-        ++m_ref_count;
+        m_ref_count.increment();
         return this;
     }
 
     // copy data and create new storage
     DataType pure_data;
-    pure_data.reserve(m_data.size());
     for(auto entry : m_data)
     {
         pure_data.push_back(entry.as_pure_immutable());
     }
-    return new ArrayStorage(pure_data.begin(), pure_data.end());
+    return new ArrayStorage(std::move(pure_data));
 
 }
 
@@ -123,46 +166,51 @@ Attribute::Storage* ArrayAttribute::ArrayStorage::as_pure_mutable()
 {
     // copy data and create new storage
     DataType pure_data;
-    pure_data.reserve(m_data.size());
     for(auto entry : m_data)
     {
         pure_data.push_back(entry.as_pure_mutable());
     }
-    return new ArrayStorage(pure_data.begin(), pure_data.end());
+    return new ArrayStorage(std::move(pure_data));
 }
 
 OMI_API_EXPORT Hash ArrayAttribute::ArrayStorage::get_hash(
         arc::uint64 seed) const
 {
-    // iterate the sub hashes to make sure none have gone out of date
-    bool out_of_date = false;
-    if(m_data.size() != m_sub_hashes.size())
+    // the elements only need to be checked if one of them may have been
+    // modified since the hash was computed
+    bool entries_modified = clear_entries_modified();
+    if(!entries_modified &&
+       !m_structure_dirty &&
+       (m_cached_hash.part1 != 0 || m_cached_hash.part2 != 0))
     {
-        out_of_date = true;
-        // clear and rebuild
-        m_sub_hashes.clear();
-        m_sub_hashes.reserve(m_data.size());
-        for(std::size_t i = 0; i < m_data.size(); ++i)
-        {
-            m_sub_hashes.push_back(m_data[i].get_hash());
-        }
+        return m_cached_hash;
     }
-    else
+
+    // rebuild the contributions of every element?
+    if(m_structure_dirty)
     {
-        for(std::size_t i = 0; i < m_sub_hashes.size(); ++i)
-        {
-            Hash attr_hash = m_data[i].get_hash();
-            if(m_sub_hashes[i] != attr_hash)
-            {
-                m_sub_hashes[i] = attr_hash;
-                out_of_date = true;
-            }
-        }
+        m_sub_hashes.assign(m_data.size(), ElementHash());
+        m_hash_sum = Hash();
+        m_structure_dirty = false;
+        m_cached_hash = Hash();
     }
-    if(out_of_date)
+
+    // only recompute the contributions of the elements whose hashes have
+    // changed, elements which haven't been modified return their cached hash
+    // without visiting their own entries
+    std::size_t i = 0;
+    for(auto it = m_data.begin(); it != m_data.end(); ++it, ++i)
     {
-        m_cached_hash.part1 = 0;
-        m_cached_hash.part2 = 0;
+        ElementHash& element_hash = m_sub_hashes[i];
+        Hash hash = it->get_hash();
+        if(element_hash.contribution == Hash() || element_hash.hash != hash)
+        {
+            m_hash_sum -= element_hash.contribution;
+            element_hash.hash = hash;
+            element_hash.contribution = hash_element(i, hash);
+            m_hash_sum += element_hash.contribution;
+            m_cached_hash = Hash();
+        }
     }
 
     // hash needs recomputing?
@@ -172,42 +220,33 @@ OMI_API_EXPORT Hash ArrayAttribute::ArrayStorage::get_hash(
         m_cached_hash.part1 = seed;
         m_cached_hash.part2 = seed;
 
-        // is there actually anything to hash?
-        if(!m_data.empty())
-        {
-            assert(m_sub_hashes.size() == m_data.size());
-
-            // compute the hash
-            for(auto sub_hash : m_sub_hashes)
-            {
-                arc::crypt::hash::spooky_128(
-                    static_cast<const void*>(&sub_hash),
-                    sizeof(sub_hash),
-                    m_cached_hash.part1,
-                    m_cached_hash.part2,
-                    m_cached_hash.part1,
-                    m_cached_hash.part2
-                );
-            }
-        }
+        arc::crypt::hash::spooky_128(
+            static_cast<const void*>(&m_hash_sum),
+            sizeof(m_hash_sum),
+            m_cached_hash.part1,
+            m_cached_hash.part2,
+            m_cached_hash.part1,
+            m_cached_hash.part2
+        );
     }
     return m_cached_hash;
 }
 
 OMI_API_EXPORT void ArrayAttribute::ArrayStorage::invalidate_hash()
 {
-    m_cached_hash.part1 = 0;
-    m_cached_hash.part2 = 0;
+    m_cached_hash = Hash();
     m_sub_hashes.clear();
+    m_structure_dirty = true;
 }
 
 OMI_API_EXPORT
 Attribute::Storage* ArrayAttribute::ArrayStorage::copy_for_overwrite(bool soft)
 {
-    // soft overwrite - so copy everything
+    // soft overwrite - so copy everything, this shares the elements with
+    // this storage
     if(soft)
     {
-        return new ArrayStorage(m_data.begin(), m_data.end());
+        return new ArrayStorage(DataType(m_data), this);
     }
 
     return new ArrayStorage();
@@ -224,17 +263,65 @@ OMI_API_EXPORT void ArrayAttribute::ArrayStorage::string_repr(
     }
     s << "[";
     // values
-    for(std::size_t i = 0; i < m_data.size(); ++i)
+    for(auto it = m_data.begin(); it != m_data.end(); ++it)
     {
-        s << m_data[i];
-        if(i < m_data.size() - 1)
+        if(it != m_data.begin())
         {
             s << ", ";
         }
+        s << *it;
     }
     s << "]";
 }
 
+//------------------------------------------------------------------------------
+//                                    BUILDER
+//------------------------------------------------------------------------------
+
+//---------------------------C O N S T R U C T O R S----------------------------
+
+OMI_API_EXPORT ArrayAttribute::Builder::Builder()
+{
+}
+
+OMI_API_EXPORT ArrayAttribute::Builder::Builder(const ArrayAttribute& array)
+    : m_data(array.get_values().begin(), array.get_values().end())
+{
+}
+
+//-----------------------------D E S T R U C T O R------------------------------
+
+OMI_API_EXPORT ArrayAttribute::Builder::~Builder()
+{
+}
+
+//---------------P U B L I C    M E M B E R    F U N C T I O N S----------------
+
+OMI_API_EXPORT std::size_t ArrayAttribute::Builder::get_size() const
+{
+    return m_data.size();
+}
+
+OMI_API_EXPORT void ArrayAttribute::Builder::reserve(std::size_t size)
+{
+    m_data.reserve(size);
+}
+
+OMI_API_EXPORT ArrayAttribute::Builder& ArrayAttribute::Builder::push_back(
+        const Attribute& attribute)
+{
+    m_data.push_back(attribute);
+    return *this;
+}
+
+OMI_API_EXPORT ArrayAttribute ArrayAttribute::Builder::build(bool immutable)
+{
+    // swap so the builder is guaranteed to be left empty
+    std::vector<Attribute> data;
+    data.swap(m_data);
+    return ArrayAttribute(DataType(data), immutable);
+}
+
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTORS
 //------------------------------------------------------------------------------
@@ -250,11 +337,16 @@ OMI_API_EXPORT ArrayAttribute::ArrayAttribute(
     : Attribute(
         kTypeArray,
         immutable,
-        new ArrayStorage(data.begin(), data.end())
+        new ArrayStorage(DataType(data))
     )
 {
 }
 
+OMI_API_EXPORT ArrayAttribute::ArrayAttribute(DataType&& data, bool immutable)
+    : Attribute(kTypeArray, immutable, new ArrayStorage(std::move(data)))
+{
+}
+
 OMI_API_EXPORT ArrayAttribute::ArrayAttribute(const Attribute& other)
     : Attribute(nullptr)
 {
@@ -267,6 +359,17 @@ OMI_API_EXPORT ArrayAttribute::ArrayAttribute(const ArrayAttribute& other)
     assign(other);
 }
 
+//------------------------------------------------------------------------------
+//                              PRIVATE CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ArrayAttribute::ArrayAttribute(
+        ArrayStorage* storage,
+        bool immutable)
+    : Attribute(kTypeArray, immutable, storage)
+{
+}
+
 //------------------------------------------------------------------------------
 //                                   DESTRUCTOR
 //------------------------------------------------------------------------------
@@ -352,7 +455,7 @@ OMI_API_EXPORT Attribute& ArrayAttribute::get(std::size_t index)
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    return get_storage<ArrayStorage>()->m_data[index];
+    return get_storage<ArrayStorage>()->m_data.get_mutable(index);
 }
 
 OMI_API_EXPORT const Attribute& ArrayAttribute::front() const
@@ -384,7 +487,7 @@ OMI_API_EXPORT Attribute& ArrayAttribute::front()
         );
     }
 
-    return get_storage<ArrayStorage>()->m_data.front();
+    return get_storage<ArrayStorage>()->m_data.get_mutable(0);
 }
 
 OMI_API_EXPORT const Attribute& ArrayAttribute::back() const
@@ -416,7 +519,8 @@ OMI_API_EXPORT Attribute& ArrayAttribute::back()
         );
     }
 
-    return get_storage<ArrayStorage>()->m_data.back();
+    DataType& data = get_storage<ArrayStorage>()->m_data;
+    return data.get_mutable(data.size() - 1);
 }
 
 OMI_API_EXPORT void ArrayAttribute::set(
@@ -437,7 +541,9 @@ OMI_API_EXPORT void ArrayAttribute::set(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    get_storage<ArrayStorage>()->m_data[index] = attribute;
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    storage->link_entry(attribute);
+    storage->m_data.set(index, attribute);
 }
 
 OMI_API_EXPORT void ArrayAttribute::push_back(const Attribute& attribute)
@@ -446,7 +552,9 @@ OMI_API_EXPORT void ArrayAttribute::push_back(const Attribute& attribute)
     check_state("push_back() used on an invalid attribute");
     prepare_modifcation(true);
 
-    get_storage<ArrayStorage>()->m_data.push_back(attribute);
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    storage->link_entry(attribute);
+    storage->m_data.push_back(attribute);
 }
 
 OMI_API_EXPORT void ArrayAttribute::insert(
@@ -467,10 +575,9 @@ OMI_API_EXPORT void ArrayAttribute::insert(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    get_storage<ArrayStorage>()->m_data.insert(
-        get_storage<ArrayStorage>()->m_data.begin() + index,
-        attribute
-    );
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    storage->link_entry(attribute);
+    storage->m_data.insert(index, attribute);
 }
 
 OMI_API_EXPORT void ArrayAttribute::erase(std::size_t index)
@@ -489,8 +596,81 @@ OMI_API_EXPORT void ArrayAttribute::erase(std::size_t index)
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    get_storage<ArrayStorage>()->m_data.erase(
-        get_storage<ArrayStorage>()->m_data.begin() + index
+    get_storage<ArrayStorage>()->m_data.erase(index);
+}
+
+OMI_API_EXPORT ArrayAttribute ArrayAttribute::copy_with(
+        std::size_t index,
+        const Attribute& attribute) const
+{
+    // valid?
+    check_state("copy_with() used on an invalid attribute");
+
+    // within range
+    if(index >= get_size())
+    {
+        arc::str::UTF8String error_message;
+        error_message
+            << "Index: " << index << " greater than or equal to array size "
+            << "of: " << get_size();
+        throw arc::ex::IndexOutOfBoundsError(error_message);
+    }
+
+    // this shares the elements and their links, only the path to the index
+    // is copied
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    ArrayAttribute ret(
+        new ArrayStorage(DataType(storage->m_data), storage),
+        is_immutable()
+    );
+    ArrayStorage* ret_storage = ret.get_storage<ArrayStorage>();
+    ret_storage->link_entry(attribute);
+    // the element is replaced rather than assigned to, since assigning would
+    // mark every array sharing the old element as modified
+    ret_storage->m_data.erase(index);
+    ret_storage->m_data.insert(index, attribute);
+    return ret;
+}
+
+OMI_API_EXPORT ArrayAttribute ArrayAttribute::copy_with_appended(
+        const Attribute& attribute) const
+{
+    // valid?
+    check_state("copy_with_appended() used on an invalid attribute");
+
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    ArrayAttribute ret(
+        new ArrayStorage(DataType(storage->m_data), storage),
+        is_immutable()
+    );
+    ArrayStorage* ret_storage = ret.get_storage<ArrayStorage>();
+    ret_storage->link_entry(attribute);
+    ret_storage->m_data.push_back(attribute);
+    return ret;
+}
+
+OMI_API_EXPORT ArrayAttribute ArrayAttribute::copy_without(
+        std::size_t index) const
+{
+    // valid?
+    check_state("copy_without() used on an invalid attribute");
+
+    // within range
+    if(index >= get_size())
+    {
+        arc::str::UTF8String error_message;
+        error_message
+            << "Index: " << index << " greater than or equal to array size "
+            << "of: " << get_size();
+        throw arc::ex::IndexOutOfBoundsError(error_message);
+    }
+
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    DataType data(storage->m_data);
+    data.erase(index);
+    return ArrayAttribute(
+        new ArrayStorage(std::move(data), storage),
+        is_immutable()
     );
 }
 
@@ -499,7 +679,12 @@ OMI_API_EXPORT void ArrayAttribute::set_values(const DataType& data)
     // valid?
     check_state("set_values() used on an invalid attribute");
     prepare_modifcation();
-    get_storage<ArrayStorage>()->m_data = DataType(data.begin(), data.end());
+    ArrayStorage* storage = get_storage<ArrayStorage>();
+    for(const Attribute& element : data)
+    {
+        storage->link_entry(element);
+    }
+    storage->m_data = data;
 }
 
 OMI_API_EXPORT void ArrayAttribute::clear()
@@ -5,9 +5,11 @@
 #ifndef OMICRON_API_COMMON_ATTRIBUTE_ARRAYATTRIBUTE_HPP_
 #define OMICRON_API_COMMON_ATTRIBUTE_ARRAYATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
 #include "omicron/api/common/attribute/Attribute.hpp"
+#include "omicron/api/common/attribute/AttributeArray.hpp"
 
 
 namespace omi
@@ -29,7 +31,13 @@ public:
     //                              TYPE DEFINITIONS
     //--------------------------------------------------------------------------
 
-    typedef std::vector<Attribute> DataType;
+    /*!
+     * \brief The type used to store ArrayAttribute's data.
+     *
+     * \note See AttributeArray for when references to the elements are
+     *       invalidated.
+     */
+    typedef AttributeArray DataType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -51,6 +59,25 @@ public:
     {
     public:
 
+        //-------------------------S T R U C T U R E S--------------------------
+
+        /*!
+         * \brief The hash contribution of a single element of the array.
+         */
+        struct ElementHash
+        {
+            /*!
+             * \brief The hash of the element when the contribution was
+             *        computed.
+             */
+            Hash hash;
+            /*!
+             * \brief The hash contribution of the element, or (0, 0) if it has
+             *        not been computed.
+             */
+            Hash contribution;
+        };
+
         //------------------P U B L I C    A T T R I B U T E S------------------
 
         /*!
@@ -64,10 +91,26 @@ public:
          */
         mutable Hash m_cached_hash;
         /*!
-         * \brief The last checked hashes of the sub-attributes, these are
-         *        checked to see if the hash is out of date.
+         * \brief The hash contribution of each element of the array.
+         *
+         * The hash of the array is the sum of these contributions. The
+         * elements are only revisited when m_entries_modified is set, in which
+         * case the current hash of each element is compared against the one
+         * its contribution was computed from, so only the contributions of
+         * elements which have since been modified or reassigned are
+         * recomputed.
+         */
+        mutable std::vector<ElementHash> m_sub_hashes;
+        /*!
+         * \brief The sum of the contributions in m_sub_hashes.
+         */
+        mutable Hash m_hash_sum;
+        /*!
+         * \brief Whether the structure of the array has changed since the hash
+         *        was last computed, meaning the contributions of every element
+         *        need to be rebuilt.
          */
-        mutable std::vector<Hash> m_sub_hashes;
+        mutable bool m_structure_dirty;
 
         //-----------------------C O N S T R U C T O R S------------------------
 
@@ -82,11 +125,35 @@ public:
          */
         template<typename T_InputIterator>
         ArrayStorage(const T_InputIterator& first, const T_InputIterator& last)
-            : Attribute::Storage()
+            : Attribute::Storage(true)
             , m_data            (first, last)
+            , m_structure_dirty (true)
         {
+            for(const Attribute& element : m_data)
+            {
+                link_entry(element);
+            }
         }
 
+        /*!
+         * \brief Creates new ArrayStorage which takes ownership of the given
+         *        data.
+         */
+        OMI_API_EXPORT ArrayStorage(DataType&& data);
+
+        /*!
+         * \brief Creates new ArrayStorage which takes ownership of the given
+         *        data, which shares all but a few of its elements with the
+         *        given storage.
+         *
+         * The elements are not linked to the new storage individually,
+         * elements which aren't shared with the given storage need to be
+         * passed to link_entry().
+         */
+        OMI_API_EXPORT ArrayStorage(
+                DataType&& data,
+                ArrayStorage* shares_entries_with);
+
         //-------------------------D E S T R U C T O R--------------------------
 
         OMI_API_EXPORT virtual ~ArrayStorage();
@@ -117,6 +184,90 @@ public:
                 arc::str::UTF8String& s) const override;
     };
 
+    //--------------------------------------------------------------------------
+    //                                  BUILDER
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Accumulates the elements of a new ArrayAttribute.
+     *
+     * Every push_back() on an ArrayAttribute checks whether the storage needs
+     * to be copied and invalidates the hash of the array. A Builder holds its
+     * elements in a plain std::vector instead, which build() turns into the
+     * storage of a new ArrayAttribute in a single step.
+     *
+     * Example usage:
+     *
+     * \code
+     * omi::ArrayAttribute::Builder builder;
+     * builder.reserve(names.size());
+     * for(const arc::str::UTF8String& name : names)
+     * {
+     *     builder.push_back(omi::StringAttribute(name));
+     * }
+     * omi::ArrayAttribute array = builder.build();
+     * \endcode
+     */
+    class Builder
+    {
+    public:
+
+        //-----------------------C O N S T R U C T O R S------------------------
+
+        /*!
+         * \brief Creates a new Builder with no elements.
+         */
+        OMI_API_EXPORT Builder();
+
+        /*!
+         * \brief Creates a new Builder which starts with the elements of the
+         *        given array.
+         *
+         * The elements are shared with the given array rather than copied.
+         *
+         * \throw arc::ex::StateError If the given array is not valid.
+         */
+        OMI_API_EXPORT Builder(const ArrayAttribute& array);
+
+        //-------------------------D E S T R U C T O R--------------------------
+
+        OMI_API_EXPORT ~Builder();
+
+        //-----------P U B L I C    M E M B E R    F U N C T I O N S------------
+
+        /*!
+         * \brief Returns the number of elements in this Builder.
+         */
+        OMI_API_EXPORT std::size_t get_size() const;
+
+        /*!
+         * \brief Reserves memory for at least the given number of elements.
+         */
+        OMI_API_EXPORT void reserve(std::size_t size);
+
+        /*!
+         * \brief Appends the given attribute to the elements of this Builder.
+         *
+         * \return This Builder so that calls can be chained.
+         */
+        OMI_API_EXPORT Builder& push_back(const Attribute& attribute);
+
+        /*!
+         * \brief Returns a new ArrayAttribute which takes the elements of this
+         *        Builder, leaving the Builder empty.
+         *
+         * \param immutable Whether the new attribute is immutable or not.
+         */
+        OMI_API_EXPORT ArrayAttribute build(bool immutable = true);
+
+    private:
+
+        //------------------P R I V A T E    A T T R I B U T E S----------------
+
+        // the accumulated elements
+        std::vector<Attribute> m_data;
+    };
+
     //--------------------------------------------------------------------------
     //                                CONSTRUCTORS
     //--------------------------------------------------------------------------
@@ -154,6 +305,15 @@ public:
      */
     OMI_API_EXPORT ArrayAttribute(const DataType& data, bool immutable = true);
 
+    /*!
+     * \brief Constructs a new ArrayAttribute which takes ownership of the
+     *        given data, leaving it empty.
+     *
+     * \param data The data to move into this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT ArrayAttribute(DataType&& data, bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -318,6 +478,48 @@ public:
      */
     OMI_API_EXPORT void erase(std::size_t index);
 
+    /*!
+     * \brief Returns a copy of this ArrayAttribute, with the same
+     *        immutability, where the element at the given index is replaced
+     *        with the given attribute.
+     *
+     * This array is not modified. The new array shares the elements of this
+     * array and only copies the nodes of the AttributeArray along the path to
+     * the replaced element, so this is logarithmic in the number of elements.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::IndexOutOfBoundsError If the given index is outside of
+     *                                        the range of this array.
+     */
+    OMI_API_EXPORT ArrayAttribute copy_with(
+            std::size_t index,
+            const Attribute& attribute) const;
+
+    /*!
+     * \brief Returns a copy of this ArrayAttribute, with the same
+     *        immutability, with the given attribute appended.
+     *
+     * Like copy_with() this array is not modified and the new array shares
+     * all but the path to its last element with this array.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     */
+    OMI_API_EXPORT ArrayAttribute copy_with_appended(
+            const Attribute& attribute) const;
+
+    /*!
+     * \brief Returns a copy of this ArrayAttribute, with the same
+     *        immutability, without the element at the given index.
+     *
+     * Like copy_with() this array is not modified and the new array shares
+     * all but the path to the removed element with this array.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::IndexOutOfBoundsError If the given index is outside of
+     *                                        the range of this array.
+     */
+    OMI_API_EXPORT ArrayAttribute copy_without(std::size_t index) const;
+
     /*!
      * \brief Replaces the current data of this ArrayAttribute with the given
      *        data.
@@ -361,6 +563,15 @@ protected:
     //--------------------------------------------------------------------------
 
     OMI_API_EXPORT virtual bool check_type(Type type) const override;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    // Creates a new ArrayAttribute which takes ownership of the given storage
+    OMI_API_EXPORT ArrayAttribute(ArrayStorage* storage, bool immutable);
 };
 
 } // namespace omi
@@ -1,11 +1,35 @@
 #include "omicron/api/common/attribute/Attribute.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
 #include <arcanecore/base/Exceptions.hpp>
 
+#include "omicron/api/common/attribute/StoragePool.hpp"
+
 
 namespace omi
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns the lock guarding the links between storages which hold other
+// attributes and the definitions of their entries - this is never destroyed so
+// that attributes can still be destroyed during static destruction
+std::mutex& get_link_mutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                            PUBLIC STATIC ATTRIBUTES
 //------------------------------------------------------------------------------
@@ -13,21 +37,28 @@ namespace omi
 OMI_API_EXPORT Attribute::Type Attribute::kTypeNull = 0;
 
 //------------------------------------------------------------------------------
-//                                    STORAGE
+//                                   LINK GROUP
 //------------------------------------------------------------------------------
 
-//----------------------------C O N S T R U C T O R-----------------------------
-
-OMI_API_EXPORT Attribute::Storage::Storage()
-    : m_ref_count(1)
+class Attribute::LinkGroup
 {
-}
+public:
 
-//-----------------------------D E S T R U C T O R------------------------------
+    //--------------------P U B L I C    A T T R I B U T E S--------------------
 
-OMI_API_EXPORT Attribute::Storage::~Storage()
-{
-}
+    // the storages in this group, this group is deleted once this is empty
+    // and no definitions are linked to it
+    std::vector<Storage*> m_storages;
+    // the number of definitions linked to this group
+    std::size_t m_definition_count;
+
+    //--------------------------C O N S T R U C T O R---------------------------
+
+    LinkGroup()
+        : m_definition_count(0)
+    {
+    }
+};
 
 //------------------------------------------------------------------------------
 //                                   DEFINITION
@@ -39,10 +70,16 @@ public:
 
     //--------------------P U B L I C    A T T R I B U T E S--------------------
 
-    std::size_t m_ref_count;
+    RefCount m_ref_count;
     Type m_type;
     bool m_immutable;
     mutable Storage* m_storage;
+    // the groups of the storages holding this definition as an entry, this is
+    // only accessed while holding the link lock
+    std::vector<LinkGroup*> m_link_groups;
+    // whether this definition has ever been linked to a group, so that
+    // definitions which have never been an entry don't need to take the lock
+    std::atomic<bool> m_linked;
 
     //--------------------------C O N S T R U C T O R---------------------------
 
@@ -53,29 +90,269 @@ public:
         : m_ref_count(1)
         , m_type     (type)
         , m_immutable(immutable)
-        , m_storage  (storage)
+        , m_storage  (nullptr)
+        , m_linked   (false)
     {
+        set_storage(storage);
     }
 
     //---------------------------D E S T R U C T O R----------------------------
 
     ~Definition()
     {
+        if(m_linked)
+        {
+            std::lock_guard<std::mutex> lock(get_link_mutex());
+            for(LinkGroup* group : m_link_groups)
+            {
+                release_group(group);
+            }
+        }
+
         // decrease the reference count of the storage
-        if(m_storage != nullptr)
+        Storage* storage = m_storage;
+        set_storage(nullptr);
+        if(storage != nullptr && storage->m_ref_count.decrement())
+        {
+            delete storage;
+        }
+    }
+
+    //----------------------------O P E R A T O R S-----------------------------
+
+    static void* operator new(std::size_t size)
+    {
+        return StoragePool::allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size)
+    {
+        StoragePool::deallocate(ptr, size);
+    }
+
+    //-------------P U B L I C    M E M B E R    F U N C T I O N S--------------
+
+    /*!
+     * \brief Replaces the storage of this definition, keeping track of the
+     *        owners of storages which hold other attributes.
+     *
+     * \note This does not modify the reference count of either storage.
+     */
+    void set_storage(Storage* storage)
+    {
+        bool old_tracked =
+            m_storage != nullptr && m_storage->m_link_group != nullptr;
+        bool new_tracked =
+            storage != nullptr && storage->m_link_group != nullptr;
+        if(old_tracked || new_tracked)
+        {
+            std::lock_guard<std::mutex> lock(get_link_mutex());
+            if(new_tracked)
+            {
+                storage->m_owners.push_back(this);
+            }
+            if(old_tracked)
+            {
+                std::vector<Definition*>& owners = m_storage->m_owners;
+                owners.erase(std::find(owners.begin(), owners.end(), this));
+            }
+        }
+        m_storage = storage;
+    }
+
+    /*!
+     * \brief Links this definition to the given group.
+     *
+     * \note The link lock must be held.
+     */
+    void link(LinkGroup* group)
+    {
+        if(std::find(m_link_groups.begin(), m_link_groups.end(), group) !=
+           m_link_groups.end())
+        {
+            return;
+        }
+        drop_empty_groups();
+        m_link_groups.push_back(group);
+        ++group->m_definition_count;
+        m_linked = true;
+    }
+
+    /*!
+     * \brief Marks the storages holding this definition, and recursively the
+     *        storages holding those, with Storage::m_entries_modified.
+     *
+     * Storages that are already marked are skipped since the storages
+     * holding them were marked at the same time and haven't been hashed
+     * since, otherwise they would have cleared the mark.
+     *
+     * \note The link lock must be held.
+     */
+    void mark_storages()
+    {
+        for(LinkGroup* group : m_link_groups)
+        {
+            for(Storage* storage : group->m_storages)
+            {
+                if(storage->m_entries_modified.exchange(true))
+                {
+                    continue;
+                }
+                for(Definition* owner : storage->m_owners)
+                {
+                    if(owner->m_linked)
+                    {
+                        owner->mark_storages();
+                    }
+                }
+            }
+        }
+    }
+
+    /*!
+     * \brief Marks the storages holding this definition as modified, if this
+     *        definition has ever been linked.
+     */
+    void notify_modified()
+    {
+        if(m_linked)
+        {
+            std::lock_guard<std::mutex> lock(get_link_mutex());
+            drop_empty_groups();
+            mark_storages();
+        }
+    }
+
+private:
+
+    //------------P R I V A T E    M E M B E R    F U N C T I O N S-------------
+
+    // releases this definition's link to the given group, the link lock must
+    // be held
+    static void release_group(LinkGroup* group)
+    {
+        --group->m_definition_count;
+        if(group->m_definition_count == 0 && group->m_storages.empty())
         {
-            if(m_storage->m_ref_count <= 1)
+            delete group;
+        }
+    }
+
+    // drops the links to groups which no longer have any storages, the link
+    // lock must be held
+    void drop_empty_groups()
+    {
+        auto it = m_link_groups.begin();
+        while(it != m_link_groups.end())
+        {
+            if((*it)->m_storages.empty())
             {
-                delete m_storage;
+                release_group(*it);
+                it = m_link_groups.erase(it);
             }
             else
             {
-                --m_storage->m_ref_count;
+                ++it;
             }
         }
     }
 };
 
+//------------------------------------------------------------------------------
+//                                    STORAGE
+//------------------------------------------------------------------------------
+
+//---------------------------C O N S T R U C T O R S----------------------------
+
+OMI_API_EXPORT Attribute::Storage::Storage()
+    : m_ref_count       (1)
+    , m_link_group      (nullptr)
+    , m_link_index      (0)
+    , m_entries_modified(false)
+{
+}
+
+OMI_API_EXPORT Attribute::Storage::Storage(
+        bool holds_attributes,
+        Storage* shares_entries_with)
+    : m_ref_count       (1)
+    , m_link_group      (nullptr)
+    , m_link_index      (0)
+    , m_entries_modified(false)
+{
+    if(!holds_attributes)
+    {
+        return;
+    }
+
+    if(shares_entries_with != nullptr &&
+       shares_entries_with->m_link_group != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(get_link_mutex());
+        LinkGroup* group = shares_entries_with->m_link_group;
+        group->m_storages.push_back(this);
+        m_link_group = group;
+        m_link_index = group->m_storages.size() - 1;
+    }
+    else
+    {
+        // nothing else can see the new group yet
+        std::unique_ptr<LinkGroup> group(new LinkGroup());
+        group->m_storages.push_back(this);
+        m_link_group = group.release();
+    }
+}
+
+//-----------------------------D E S T R U C T O R------------------------------
+
+OMI_API_EXPORT Attribute::Storage::~Storage()
+{
+    if(m_link_group == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(get_link_mutex());
+    // move the last storage of the group into this storage's place
+    std::vector<Storage*>& storages = m_link_group->m_storages;
+    storages[m_link_index] = storages.back();
+    storages[m_link_index]->m_link_index = m_link_index;
+    storages.pop_back();
+    // definitions still linked to the group drop it the next time their links
+    // are updated
+    if(storages.empty() && m_link_group->m_definition_count == 0)
+    {
+        delete m_link_group;
+    }
+}
+
+//------------------------------O P E R A T O R S-------------------------------
+
+OMI_API_EXPORT void* Attribute::Storage::operator new(std::size_t size)
+{
+    return StoragePool::allocate(size);
+}
+
+OMI_API_EXPORT void Attribute::Storage::operator delete(
+        void* ptr,
+        std::size_t size)
+{
+    StoragePool::deallocate(ptr, size);
+}
+
+//---------------P U B L I C    M E M B E R    F U N C T I O N S----------------
+
+OMI_API_EXPORT void Attribute::Storage::link_entry(const Attribute& entry)
+{
+    std::lock_guard<std::mutex> lock(get_link_mutex());
+    entry.m_def->link(m_link_group);
+}
+
+OMI_API_EXPORT bool Attribute::Storage::clear_entries_modified() const
+{
+    return m_entries_modified.exchange(false);
+}
+
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTORS
 //------------------------------------------------------------------------------
@@ -227,24 +504,59 @@ OMI_API_EXPORT Hash Attribute::get_hash() const
 
 OMI_API_EXPORT void Attribute::assign(const Attribute& other)
 {
-    // decrease the reference of the existing definition
-    if(m_def != nullptr)
+    // self assignment?
+    if(m_def != nullptr && m_def == other.m_def)
     {
-        decrease_ref();
+        return;
     }
 
     // use the other definition if it's not null, and has a valid type
+    Definition* def = nullptr;
     if(other.m_def != nullptr && check_type(other.m_def->m_type))
     {
-        // assign the new definition and increase the reference count
-        m_def = other.m_def;
-        increase_ref();
+        def = other.m_def;
+        def->m_ref_count.increment();
     }
     else
     {
-        // assign new null definition
-        m_def = new Definition(kTypeNull, true, nullptr);
+        // new null definition
+        def = new Definition(kTypeNull, true, nullptr);
+    }
+
+    if(m_def != nullptr)
+    {
+        // this may be an entry of storages which hold other attributes, in
+        // which case the new definition takes over the old definition's links.
+        // Other references to the old definition can't be told apart from
+        // entries, so their links are taken over too, which at worst makes the
+        // storages check their entries when they didn't need to
+        if(m_def->m_linked)
+        {
+            try
+            {
+                std::lock_guard<std::mutex> lock(get_link_mutex());
+                for(LinkGroup* group : m_def->m_link_groups)
+                {
+                    if(!group->m_storages.empty())
+                    {
+                        def->link(group);
+                    }
+                }
+                m_def->mark_storages();
+            }
+            catch(...)
+            {
+                if(def->m_ref_count.decrement())
+                {
+                    delete def;
+                }
+                throw;
+            }
+        }
+        // decrease the reference of the existing definition
+        decrease_ref();
     }
+    m_def = def;
 }
 
 OMI_API_EXPORT Attribute Attribute::as_immutable() const
@@ -261,7 +573,7 @@ OMI_API_EXPORT Attribute Attribute::as_immutable() const
     // increase the reference count of the current storage
     if(m_def->m_storage != nullptr)
     {
-        ++m_def->m_storage->m_ref_count;
+        m_def->m_storage->m_ref_count.increment();
     }
     // create a new definition and return it as an attribute
     return Attribute(new Definition(m_def->m_type, true, m_def->m_storage));
@@ -275,8 +587,8 @@ OMI_API_EXPORT Attribute Attribute::as_mutable() const
     // increase the reference count of the current storage
     if(m_def->m_storage != nullptr)
     {
-        ++m_def->m_storage->m_ref_count;
-    };
+        m_def->m_storage->m_ref_count.increment();
+    }
     // create a new definition and return it as an attribute
     return Attribute(new Definition(m_def->m_type, false, m_def->m_storage));
 }
@@ -354,21 +666,17 @@ OMI_API_EXPORT bool Attribute::check_type(Type type) const
 
 OMI_API_EXPORT void Attribute::increase_ref()
 {
-    ++m_def->m_ref_count;
+    m_def->m_ref_count.increment();
 }
 
 OMI_API_EXPORT void Attribute::decrease_ref()
 {
     // delete?
-    if(m_def->m_ref_count == 1)
+    if(m_def->m_ref_count.decrement())
     {
         delete m_def;
-        m_def = nullptr;
-    }
-    else
-    {
-        --m_def->m_ref_count;
     }
+    m_def = nullptr;
 }
 
 OMI_API_EXPORT void Attribute::prepare_modifcation(bool soft)
@@ -390,16 +698,33 @@ OMI_API_EXPORT void Attribute::prepare_modifcation(bool soft)
     }
 
     // is the storage used by any other definitions?
-    if(m_def->m_storage->m_ref_count > 1)
+    if(m_def->m_storage->m_ref_count.get() > 1)
     {
-        // decrease the current reference count
-        --m_def->m_storage->m_ref_count;
         // need to copy for rewrite
-        m_def->m_storage = m_def->m_storage->copy_for_overwrite(soft);
+        Storage* shared = m_def->m_storage;
+        Storage* copy = shared->copy_for_overwrite(soft);
+        try
+        {
+            m_def->set_storage(copy);
+        }
+        catch(...)
+        {
+            delete copy;
+            throw;
+        }
+        // release our reference to the shared storage - the other references
+        // may have been released while we were copying
+        if(shared->m_ref_count.decrement())
+        {
+            delete shared;
+        }
     }
 
-    // invalidate the current hash
+    // invalidate the current hash and mark the storages holding this
+    // attribute so that they check their entries the next time their hash is
+    // read
     m_def->m_storage->invalidate_hash();
+    m_def->notify_modified();
 }
 
 OMI_API_EXPORT void Attribute::check_state(
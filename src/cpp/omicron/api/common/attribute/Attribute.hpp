@@ -5,7 +5,9 @@
 #ifndef OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTE_HPP_
 #define OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTE_HPP_
 
+#include <atomic>
 #include <cstddef>
+#include <vector>
 
 #include <arcanecore/base/Types.hpp>
 #include <arcanecore/base/lang/Restrictors.hpp>
@@ -13,11 +15,18 @@
 
 #include "omicron/api/API.hpp"
 #include "omicron/api/common/Hash.hpp"
+#include "omicron/api/common/RefCount.hpp"
 
 
 namespace omi
 {
 
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class AttributeCodec;
+
 /*!
  * \brief The is the base class for all Omicron Attributes.
  *
@@ -83,6 +92,27 @@ private:
             arc::str::UTF8String&,
             const Attribute&);
 
+    friend class AttributeCodec;
+
+protected:
+
+    //--------------------------------------------------------------------------
+    //                                 DEFINITION
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The internal definition object of attributes - contains the
+     *        copy-on-write storage object and manages reference counting.
+     */
+    class Definition;
+
+    /*!
+     * \brief A group of storages which hold other attributes and share their
+     *        entries with each other, along with the definitions linked to
+     *        the group.
+     */
+    class LinkGroup;
+
 public:
 
     //--------------------------------------------------------------------------
@@ -125,20 +155,87 @@ public:
 
         /*!
          * \brief The current reference count of the storage.
+         *
+         * \note This is only thread-safe when Omicron is built with
+         *       OMI_API_ATOMIC_REF_COUNT defined.
+         */
+        RefCount m_ref_count;
+
+        /*!
+         * \brief The group of storages this storage shares its entries with,
+         *        or null if this storage doesn't hold other attributes.
+         *
+         * \note This is set on construction and never changes, but the group
+         *       itself is only accessed while holding the link lock.
+         */
+        LinkGroup* m_link_group;
+        /*!
+         * \brief The index of this storage within its group.
+         *
+         * \note This is only accessed while holding the link lock.
          */
-        std::size_t m_ref_count;
+        std::size_t m_link_index;
+        /*!
+         * \brief The definitions using this storage, only tracked when this
+         *        storage holds other attributes.
+         *
+         * \note This is only accessed while holding the link lock.
+         */
+        std::vector<Definition*> m_owners;
+        /*!
+         * \brief Whether an entry of this storage may have been modified since
+         *        clear_entries_modified() was last called.
+         *
+         * When an attribute linked to this storage is modified this is set,
+         * along with the same flag of every storage holding this storage.
+         * Storages which are already marked are not visited again, so
+         * modifying a leaf only visits the path to the root.
+         */
+        mutable std::atomic<bool> m_entries_modified;
 
-        //------------------------C O N S T R U C T O R-------------------------
+        //-----------------------C O N S T R U C T O R S------------------------
 
         /*!
          * \brief Storage super constructor.
          */
         OMI_API_EXPORT Storage();
 
+        /*!
+         * \brief Super constructor for storages which hold other attributes.
+         *
+         * The entries of these storages are passed to link_entry() so that
+         * modifying them marks this storage with m_entries_modified.
+         *
+         * \param holds_attributes Whether this storage holds other attributes,
+         *                         if not this is the same as Storage().
+         * \param shares_entries_with If not null, the new storage shares its
+         *                            entries with the given storage, so joins
+         *                            its group instead of linking every entry
+         *                            again. Entries this storage doesn't have
+         *                            may then mark it too, which only costs an
+         *                            unnecessary check of its entries.
+         */
+        OMI_API_EXPORT Storage(
+                bool holds_attributes,
+                Storage* shares_entries_with = nullptr);
+
         //-------------------------D E S T R U C T O R--------------------------
 
         OMI_API_EXPORT virtual ~Storage();
 
+        //--------------------------O P E R A T O R S---------------------------
+
+        /*!
+         * \brief Storage objects are allocated from the omi::StoragePool.
+         */
+        OMI_API_EXPORT static void* operator new(std::size_t size);
+
+        /*!
+         * \brief Returns the memory of a Storage object to the
+         *        omi::StoragePool.
+         */
+        OMI_API_EXPORT static void operator delete(void* ptr, std::size_t size);
+
         //-----------P U B L I C    M E M B E R    F U N C T I O N S------------
 
         /*!
@@ -186,6 +283,23 @@ public:
          */
         virtual void invalidate_hash() = 0;
 
+        /*!
+         * \brief Links the given entry of this storage so that modifying it,
+         *        or reassigning the attribute holding it, marks this storage
+         *        with m_entries_modified.
+         *
+         * Links are only removed when either side is destroyed, so an entry
+         * that is later removed from this storage may still mark it.
+         *
+         * \note This storage must hold other attributes.
+         */
+        OMI_API_EXPORT void link_entry(const Attribute& entry);
+
+        /*!
+         * \brief Clears m_entries_modified, returning whether it was set.
+         */
+        OMI_API_EXPORT bool clear_entries_modified() const;
+
         /*!
          * \brief Makes a copy of this storage with the intention that the
          *        copy's values will be overwritten.
@@ -380,16 +494,6 @@ public:
 
 protected:
 
-    //--------------------------------------------------------------------------
-    //                                 DEFINITION
-    //--------------------------------------------------------------------------
-
-    /*!
-     * \brief The internal definition object of attributes - contains the
-     *        copy-on-write storage object and manages reference counting.
-     */
-    class Definition;
-
     //--------------------------------------------------------------------------
     //                           PROTECTED CONSTRUCTORS
     //--------------------------------------------------------------------------
@@ -442,6 +546,19 @@ protected:
         return static_cast<T_StorageType*>(get_untyped_storage());
     }
 
+    /*!
+     * \brief Returns the storage object of the given attribute's definition
+     *        casted as a pointer to the given type.
+     *
+     * This allows derived types to access the storage of other attributes
+     * without creating a new reference to them.
+     */
+    template<typename T_StorageType>
+    static T_StorageType* get_storage(const Attribute& attribute)
+    {
+        return static_cast<T_StorageType*>(attribute.get_untyped_storage());
+    }
+
     // TODO: DOC: throws IllegalActionError
     OMI_API_EXPORT void prepare_modifcation(bool soft = false);
 
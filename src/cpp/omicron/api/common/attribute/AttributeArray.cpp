@@ -0,0 +1,885 @@
+#include "omicron/api/common/attribute/AttributeArray.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include "omicron/api/common/attribute/StoragePool.hpp"
+
+
+namespace omi
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the number of elements the first leaf of an array has room for, leaves grow
+// like vectors up to AttributeArray::kNodeCapacity elements
+static const std::size_t kMinLeafCapacity = 4;
+
+// nodes with fewer elements or children than this are merged with a neighbour
+// when possible so that erasing doesn't leave the tree full of small nodes
+static const std::size_t kMergeThreshold = AttributeArray::kNodeCapacity / 4;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                               STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT const std::size_t AttributeArray::kNodeCapacity;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeArray::AttributeArray()
+    : m_size(0)
+    , m_root(nullptr)
+{
+}
+
+OMI_API_EXPORT AttributeArray::AttributeArray(
+        std::initializer_list<value_type> values)
+    : m_size(0)
+    , m_root(nullptr)
+{
+    try
+    {
+        for(const value_type& value : values)
+        {
+            push_back(value);
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+}
+
+OMI_API_EXPORT AttributeArray::AttributeArray(
+        const std::vector<value_type>& values)
+    : m_size(0)
+    , m_root(nullptr)
+{
+    try
+    {
+        for(const value_type& value : values)
+        {
+            push_back(value);
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+}
+
+OMI_API_EXPORT AttributeArray::AttributeArray(const AttributeArray& other)
+    : m_size(other.m_size)
+    , m_root(other.m_root)
+{
+    // share the tree
+    if(m_root != nullptr)
+    {
+        m_root->ref_count.increment();
+    }
+}
+
+OMI_API_EXPORT AttributeArray::AttributeArray(AttributeArray&& other)
+    : m_size(other.m_size)
+    , m_root(other.m_root)
+{
+    other.m_size = 0;
+    other.m_root = nullptr;
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeArray::~AttributeArray()
+{
+    clear();
+}
+
+//------------------------------------------------------------------------------
+//                                   OPERATORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeArray& AttributeArray::operator=(
+        const AttributeArray& other)
+{
+    if(this != &other)
+    {
+        AttributeArray copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+OMI_API_EXPORT AttributeArray& AttributeArray::operator=(
+        AttributeArray&& other)
+{
+    if(this != &other)
+    {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+OMI_API_EXPORT bool AttributeArray::operator==(
+        const AttributeArray& other) const
+{
+    if(m_size != other.m_size)
+    {
+        return false;
+    }
+    // arrays that share their tree are always equal
+    if(m_root == other.m_root)
+    {
+        return true;
+    }
+    return std::equal(begin(), end(), other.begin());
+}
+
+OMI_API_EXPORT bool AttributeArray::operator!=(
+        const AttributeArray& other) const
+{
+    return !((*this) == other);
+}
+
+OMI_API_EXPORT bool AttributeArray::operator<(
+        const AttributeArray& other) const
+{
+    return std::lexicographical_compare(
+        begin(),
+        end(),
+        other.begin(),
+        other.end()
+    );
+}
+
+OMI_API_EXPORT const AttributeArray::value_type& AttributeArray::operator[](
+        std::size_t index) const
+{
+    const Node* node = m_root;
+    while(node->height != 0)
+    {
+        const std::size_t* sizes = node->get_sizes();
+        std::size_t child = 0;
+        while(index >= sizes[child])
+        {
+            index -= sizes[child];
+            ++child;
+        }
+        node = node->get_children()[child];
+    }
+    return node->get_elements()[index];
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeArray::const_iterator AttributeArray::begin() const
+{
+    const_iterator it(this, 0);
+    if(m_size != 0)
+    {
+        seek(it);
+    }
+    return it;
+}
+
+OMI_API_EXPORT const AttributeArray::value_type& AttributeArray::front() const
+{
+    return (*this)[0];
+}
+
+OMI_API_EXPORT const AttributeArray::value_type& AttributeArray::back() const
+{
+    return (*this)[m_size - 1];
+}
+
+OMI_API_EXPORT std::size_t AttributeArray::get_memory_usage() const
+{
+    if(m_root == nullptr)
+    {
+        return sizeof(AttributeArray);
+    }
+    return sizeof(AttributeArray) + get_node_memory_usage(m_root);
+}
+
+OMI_API_EXPORT AttributeArray::value_type& AttributeArray::get_mutable(
+        std::size_t index)
+{
+    // the element and the nodes above it may be shared with copies of this
+    // array
+    Node** node = &m_root;
+    while(true)
+    {
+        make_unique(*node);
+        if((*node)->height == 0)
+        {
+            return (*node)->get_elements()[index];
+        }
+        const std::size_t* sizes = (*node)->get_sizes();
+        std::size_t child = 0;
+        while(index >= sizes[child])
+        {
+            index -= sizes[child];
+            ++child;
+        }
+        node = &(*node)->get_children()[child];
+    }
+}
+
+OMI_API_EXPORT void AttributeArray::set(
+        std::size_t index,
+        const value_type& value)
+{
+    get_mutable(index) = value;
+}
+
+OMI_API_EXPORT void AttributeArray::push_back(const value_type& value)
+{
+    insert(m_size, value);
+}
+
+OMI_API_EXPORT void AttributeArray::insert(
+        std::size_t index,
+        const value_type& value)
+{
+    if(m_root == nullptr)
+    {
+        m_root = make_leaf(kMinLeafCapacity, nullptr, 0, &value, nullptr, 0);
+        m_size = 1;
+        return;
+    }
+
+    // a full root may be split, so allocate the new root up front so that the
+    // array isn't modified if the allocation fails
+    Node* root = nullptr;
+    if(m_root->count == kNodeCapacity)
+    {
+        root = allocate_branch(m_root->height + 1);
+    }
+
+    Node* sibling = nullptr;
+    try
+    {
+        sibling = insert_value(m_root, index, value);
+    }
+    catch(...)
+    {
+        if(root != nullptr)
+        {
+            free_node(root);
+        }
+        throw;
+    }
+
+    if(sibling != nullptr)
+    {
+        std::size_t sibling_size = get_node_size(sibling);
+        root->get_children()[0] = m_root;
+        root->get_children()[1] = sibling;
+        root->get_sizes()[0] = m_size + 1 - sibling_size;
+        root->get_sizes()[1] = sibling_size;
+        root->count = 2;
+        m_root = root;
+    }
+    else if(root != nullptr)
+    {
+        free_node(root);
+    }
+    ++m_size;
+}
+
+OMI_API_EXPORT void AttributeArray::erase(std::size_t index)
+{
+    erase_value(m_root, index);
+    --m_size;
+
+    // remove the levels above the root that only have a single child, the
+    // root was made unique by erasing so its reference is just taken
+    while(m_root != nullptr && m_root->height != 0 && m_root->count == 1)
+    {
+        Node* child = m_root->get_children()[0];
+        free_node(m_root);
+        m_root = child;
+    }
+}
+
+OMI_API_EXPORT void AttributeArray::clear()
+{
+    if(m_root != nullptr)
+    {
+        release_node(m_root);
+        m_root = nullptr;
+    }
+    m_size = 0;
+}
+
+OMI_API_EXPORT void AttributeArray::swap(AttributeArray& other)
+{
+    std::swap(m_size, other.m_size);
+    std::swap(m_root, other.m_root);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void AttributeArray::seek(const_iterator& it) const
+{
+    const Node* node = m_root;
+    std::size_t index = it.m_index;
+    std::size_t leaf_begin = 0;
+    while(node->height != 0)
+    {
+        const std::size_t* sizes = node->get_sizes();
+        std::size_t child = 0;
+        while(index >= sizes[child])
+        {
+            index -= sizes[child];
+            leaf_begin += sizes[child];
+            ++child;
+        }
+        node = node->get_children()[child];
+    }
+    it.m_elements = node->get_elements();
+    it.m_leaf_begin = leaf_begin;
+    it.m_leaf_end = leaf_begin + node->count;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t AttributeArray::get_leaf_size(std::size_t capacity)
+{
+    return sizeof(Node) + capacity * sizeof(Attribute);
+}
+
+std::size_t AttributeArray::get_branch_size()
+{
+    return sizeof(Node) + kNodeCapacity * (sizeof(Node*) + sizeof(std::size_t));
+}
+
+AttributeArray::Node* AttributeArray::allocate_leaf(std::size_t capacity)
+{
+    void* memory = StoragePool::allocate(get_leaf_size(capacity));
+    Node* node = new(memory) Node();
+    node->height = 0;
+    node->count = 0;
+    node->capacity = static_cast<arc::uint32>(capacity);
+    return node;
+}
+
+AttributeArray::Node* AttributeArray::allocate_branch(std::size_t height)
+{
+    void* memory = StoragePool::allocate(get_branch_size());
+    Node* node = new(memory) Node();
+    node->height = static_cast<arc::uint32>(height);
+    node->count = 0;
+    node->capacity = static_cast<arc::uint32>(kNodeCapacity);
+    return node;
+}
+
+void AttributeArray::free_node(Node* node)
+{
+    std::size_t size = get_branch_size();
+    if(node->height == 0)
+    {
+        size = get_leaf_size(node->capacity);
+    }
+    node->~Node();
+    StoragePool::deallocate(node, size);
+}
+
+void AttributeArray::release_node(Node* node)
+{
+    // still used by other arrays?
+    if(!node->ref_count.decrement())
+    {
+        return;
+    }
+
+    if(node->height == 0)
+    {
+        Attribute* elements = node->get_elements();
+        for(std::size_t i = 0; i < node->count; ++i)
+        {
+            elements[i].~Attribute();
+        }
+    }
+    else
+    {
+        Node** children = node->get_children();
+        for(std::size_t i = 0; i < node->count; ++i)
+        {
+            release_node(children[i]);
+        }
+    }
+    free_node(node);
+}
+
+std::size_t AttributeArray::get_node_memory_usage(const Node* node)
+{
+    if(node->height == 0)
+    {
+        return get_leaf_size(node->capacity);
+    }
+    std::size_t bytes = get_branch_size();
+    for(std::size_t i = 0; i < node->count; ++i)
+    {
+        bytes += get_node_memory_usage(node->get_children()[i]);
+    }
+    return bytes;
+}
+
+std::size_t AttributeArray::get_node_size(const Node* node)
+{
+    if(node->height == 0)
+    {
+        return node->count;
+    }
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < node->count; ++i)
+    {
+        size += node->get_sizes()[i];
+    }
+    return size;
+}
+
+AttributeArray::Node* AttributeArray::make_leaf(
+        std::size_t capacity,
+        const Attribute* first,
+        std::size_t first_count,
+        const Attribute* value,
+        const Attribute* second,
+        std::size_t second_count)
+{
+    Node* leaf = allocate_leaf(capacity);
+    Attribute* elements = leaf->get_elements();
+    // the count tracks how many elements have been constructed so that they
+    // can be destroyed if copying an element throws
+    try
+    {
+        for(std::size_t i = 0; i < first_count; ++i)
+        {
+            new(&elements[leaf->count]) Attribute(first[i]);
+            ++leaf->count;
+        }
+        if(value != nullptr)
+        {
+            new(&elements[leaf->count]) Attribute(*value);
+            ++leaf->count;
+        }
+        for(std::size_t i = 0; i < second_count; ++i)
+        {
+            new(&elements[leaf->count]) Attribute(second[i]);
+            ++leaf->count;
+        }
+    }
+    catch(...)
+    {
+        for(std::size_t i = 0; i < leaf->count; ++i)
+        {
+            elements[i].~Attribute();
+        }
+        free_node(leaf);
+        throw;
+    }
+    return leaf;
+}
+
+AttributeArray::Node* AttributeArray::copy_node(const Node* node)
+{
+    if(node->height == 0)
+    {
+        return make_leaf(
+            node->capacity,
+            node->get_elements(),
+            node->count,
+            nullptr,
+            nullptr,
+            0
+        );
+    }
+
+    // the children are shared rather than copied
+    Node* copy = allocate_branch(node->height);
+    for(std::size_t i = 0; i < node->count; ++i)
+    {
+        copy->get_children()[i] = node->get_children()[i];
+        copy->get_children()[i]->ref_count.increment();
+        copy->get_sizes()[i] = node->get_sizes()[i];
+    }
+    copy->count = node->count;
+    return copy;
+}
+
+void AttributeArray::make_unique(Node*& node)
+{
+    if(node->ref_count.get() == 1)
+    {
+        return;
+    }
+    Node* copy = copy_node(node);
+    release_node(node);
+    node = copy;
+}
+
+AttributeArray::Node* AttributeArray::insert_value(
+        Node*& node,
+        std::size_t index,
+        const Attribute& value)
+{
+    if(node->height == 0)
+    {
+        Node* leaf = node;
+        // append in place?
+        if(index == leaf->count && leaf->count < leaf->capacity &&
+           leaf->ref_count.get() == 1)
+        {
+            new(&leaf->get_elements()[leaf->count]) Attribute(value);
+            ++leaf->count;
+            return nullptr;
+        }
+
+        // the leaf is rebuilt rather than shifting its elements, so nothing is
+        // modified if copying an element throws
+        const Attribute* elements = leaf->get_elements();
+        if(leaf->count < kNodeCapacity)
+        {
+            // grow like a vector so that appending is amortised
+            std::size_t capacity = leaf->capacity;
+            if(leaf->count == capacity)
+            {
+                capacity = std::min(capacity * 2, kNodeCapacity);
+            }
+            node = make_leaf(
+                capacity,
+                elements,
+                index,
+                &value,
+                elements + index,
+                leaf->count - index
+            );
+            release_node(leaf);
+            return nullptr;
+        }
+
+        // the value starts a new leaf when it's appended to a full leaf, so
+        // arrays that are built by appending have full leaves
+        if(index == leaf->count)
+        {
+            return make_leaf(kNodeCapacity, nullptr, 0, &value, nullptr, 0);
+        }
+
+        // split the leaf in half
+        std::size_t half = kNodeCapacity / 2;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        if(index < half)
+        {
+            left = make_leaf(
+                kNodeCapacity,
+                elements,
+                index,
+                &value,
+                elements + index,
+                half - index
+            );
+        }
+        else
+        {
+            left = make_leaf(
+                kNodeCapacity,
+                elements,
+                half,
+                nullptr,
+                nullptr,
+                0
+            );
+        }
+        try
+        {
+            if(index < half)
+            {
+                right = make_leaf(
+                    kNodeCapacity,
+                    elements + half,
+                    kNodeCapacity - half,
+                    nullptr,
+                    nullptr,
+                    0
+                );
+            }
+            else
+            {
+                right = make_leaf(
+                    kNodeCapacity,
+                    elements + half,
+                    index - half,
+                    &value,
+                    elements + index,
+                    kNodeCapacity - index
+                );
+            }
+        }
+        catch(...)
+        {
+            release_node(left);
+            throw;
+        }
+        release_node(leaf);
+        node = left;
+        return right;
+    }
+
+    make_unique(node);
+    Node** children = node->get_children();
+    std::size_t* sizes = node->get_sizes();
+
+    // values at the end of a child are appended to it
+    std::size_t child = 0;
+    while(child + 1 < node->count && index > sizes[child])
+    {
+        index -= sizes[child];
+        ++child;
+    }
+
+    // a full branch may be split, so allocate the sibling up front so that
+    // the array isn't modified if the allocation fails
+    Node* sibling = nullptr;
+    if(node->count == kNodeCapacity)
+    {
+        sibling = allocate_branch(node->height);
+    }
+
+    Node* split = nullptr;
+    try
+    {
+        split = insert_value(children[child], index, value);
+    }
+    catch(...)
+    {
+        if(sibling != nullptr)
+        {
+            free_node(sibling);
+        }
+        throw;
+    }
+
+    if(split == nullptr)
+    {
+        ++sizes[child];
+        if(sibling != nullptr)
+        {
+            free_node(sibling);
+        }
+        return nullptr;
+    }
+
+    // the split child's new sibling goes after it
+    std::size_t split_size = get_node_size(split);
+    sizes[child] = sizes[child] + 1 - split_size;
+    Node* target = node;
+    std::size_t position = child + 1;
+
+    if(node->count == kNodeCapacity)
+    {
+        Node** sibling_children = sibling->get_children();
+        std::size_t* sibling_sizes = sibling->get_sizes();
+        // like leaves, a new child at the end starts a new branch
+        if(position == node->count)
+        {
+            sibling_children[0] = split;
+            sibling_sizes[0] = split_size;
+            sibling->count = 1;
+            return sibling;
+        }
+
+        // move the second half of the children into the sibling
+        std::size_t half = kNodeCapacity / 2;
+        for(std::size_t i = half; i < node->count; ++i)
+        {
+            sibling_children[i - half] = children[i];
+            sibling_sizes[i - half] = sizes[i];
+        }
+        sibling->count = node->count - half;
+        node->count = static_cast<arc::uint32>(half);
+        if(position > half)
+        {
+            target = sibling;
+            position -= half;
+        }
+    }
+
+    Node** target_children = target->get_children();
+    std::size_t* target_sizes = target->get_sizes();
+    for(std::size_t i = target->count; i > position; --i)
+    {
+        target_children[i] = target_children[i - 1];
+        target_sizes[i] = target_sizes[i - 1];
+    }
+    target_children[position] = split;
+    target_sizes[position] = split_size;
+    ++target->count;
+    return sibling;
+}
+
+void AttributeArray::erase_value(Node*& node, std::size_t index)
+{
+    if(node->height == 0)
+    {
+        Node* leaf = node;
+        if(leaf->count == 1)
+        {
+            release_node(leaf);
+            node = nullptr;
+            return;
+        }
+
+        // erase the last element in place?
+        if(index + 1 == leaf->count && leaf->ref_count.get() == 1)
+        {
+            --leaf->count;
+            leaf->get_elements()[leaf->count].~Attribute();
+            return;
+        }
+
+        // the leaf is rebuilt rather than shifting its elements, so nothing is
+        // modified if copying an element throws
+        const Attribute* elements = leaf->get_elements();
+        node = make_leaf(
+            leaf->capacity,
+            elements,
+            index,
+            nullptr,
+            elements + index + 1,
+            leaf->count - index - 1
+        );
+        release_node(leaf);
+        return;
+    }
+
+    make_unique(node);
+    Node** children = node->get_children();
+    std::size_t* sizes = node->get_sizes();
+
+    std::size_t child = 0;
+    while(index >= sizes[child])
+    {
+        index -= sizes[child];
+        ++child;
+    }
+    erase_value(children[child], index);
+    --sizes[child];
+
+    // remove the child if it's now empty
+    if(children[child] == nullptr)
+    {
+        for(std::size_t i = child + 1; i < node->count; ++i)
+        {
+            children[i - 1] = children[i];
+            sizes[i - 1] = sizes[i];
+        }
+        --node->count;
+        if(node->count == 0)
+        {
+            free_node(node);
+            node = nullptr;
+        }
+        return;
+    }
+
+    if(children[child]->count < kMergeThreshold)
+    {
+        if(child + 1 < node->count)
+        {
+            merge_children(node, child);
+        }
+        else if(child > 0)
+        {
+            merge_children(node, child - 1);
+        }
+    }
+}
+
+void AttributeArray::merge_children(Node* node, std::size_t index)
+{
+    Node** children = node->get_children();
+    std::size_t* sizes = node->get_sizes();
+    Node* first = children[index];
+    Node* second = children[index + 1];
+    std::size_t count = first->count + second->count;
+    if(count > kNodeCapacity)
+    {
+        return;
+    }
+
+    Node* merged = nullptr;
+    try
+    {
+        if(first->height == 0)
+        {
+            merged = make_leaf(
+                count,
+                first->get_elements(),
+                first->count,
+                nullptr,
+                second->get_elements(),
+                second->count
+            );
+        }
+        else
+        {
+            // the children of the merged branches are shared
+            merged = allocate_branch(first->height);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const Node* from = first;
+                std::size_t from_index = i;
+                if(i >= first->count)
+                {
+                    from = second;
+                    from_index -= first->count;
+                }
+                merged->get_children()[i] = from->get_children()[from_index];
+                merged->get_children()[i]->ref_count.increment();
+                merged->get_sizes()[i] = from->get_sizes()[from_index];
+            }
+            merged->count = static_cast<arc::uint32>(count);
+        }
+    }
+    catch(...)
+    {
+        // merging is only an optimisation, the tree is still valid without it
+        return;
+    }
+
+    release_node(first);
+    release_node(second);
+    children[index] = merged;
+    sizes[index] += sizes[index + 1];
+    for(std::size_t i = index + 2; i < node->count; ++i)
+    {
+        children[i - 1] = children[i];
+        sizes[i - 1] = sizes[i];
+    }
+    --node->count;
+}
+
+} // namespace omi
@@ -0,0 +1,534 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTEARRAY_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTEARRAY_HPP_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <arcanecore/base/Types.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/RefCount.hpp"
+#include "omicron/api/common/attribute/Attribute.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief The container used to store the elements of an ArrayAttribute.
+ *
+ * The elements are stored in the leaves of a shallow tree. Each leaf holds up
+ * to kNodeCapacity consecutive elements and each branch holds up to
+ * kNodeCapacity children along with the number of elements under each child,
+ * so finding the element at an index only visits a few nodes.
+ *
+ * The nodes are reference counted, so copying an AttributeArray only shares
+ * its tree with the copy. Modifying either array afterwards copies just the
+ * nodes along the path to the modified element, which makes updating a copy of
+ * a large array logarithmic in its size rather than linear.
+ *
+ * The interface is a subset of std::vector's, however iteration is read-only:
+ * elements are modified using set() or get_mutable().
+ *
+ * \warning Pointers and references to the elements of an AttributeArray are
+ *          invalidated by any insertion or erasure, and since elements are
+ *          shared between copies, references returned by get_mutable() are
+ *          invalidated when the array is copied and other references to an
+ *          element that is shared with a copy are invalidated when the element
+ *          is modified. Iterators are invalidated by any modification.
+ */
+class AttributeArray
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    // a leaf or branch of the tree
+    struct Node;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                              TYPE DEFINITIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The type of the elements.
+     */
+    typedef Attribute value_type;
+
+    /*!
+     * \brief The type used for the number of elements.
+     */
+    typedef std::size_t size_type;
+
+    class const_iterator;
+
+    /*!
+     * \brief Iteration is always read-only.
+     */
+    typedef const_iterator iterator;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum number of elements of a leaf and children of a
+     *        branch.
+     */
+    static const std::size_t kNodeCapacity = 32;
+
+    //--------------------------------------------------------------------------
+    //                                 ITERATOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Forward iterator over the elements of an AttributeArray.
+     */
+    class const_iterator
+    {
+    public:
+
+        //-----------------T Y P E    D E F I N I T I O N S------------------
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef AttributeArray::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const AttributeArray::value_type* pointer;
+        typedef const AttributeArray::value_type& reference;
+
+        //----------------------C O N S T R U C T O R-----------------------
+
+        /*!
+         * \brief Creates a new iterator which does not refer to any array.
+         */
+        const_iterator()
+            : m_array     (nullptr)
+            , m_index     (0)
+            , m_elements  (nullptr)
+            , m_leaf_begin(0)
+            , m_leaf_end  (0)
+        {
+        }
+
+        //------------------------O P E R A T O R S-------------------------
+
+        reference operator*() const
+        {
+            return m_elements[m_index - m_leaf_begin];
+        }
+
+        pointer operator->() const
+        {
+            return &(**this);
+        }
+
+        const_iterator& operator++()
+        {
+            // move to the next leaf?
+            if(++m_index == m_leaf_end && m_index < m_array->m_size)
+            {
+                m_array->seek(*this);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator ret(*this);
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return !((*this) == other);
+        }
+
+    private:
+
+        //--------------------------F R I E N D S---------------------------
+
+        friend class AttributeArray;
+
+        //-------------P R I V A T E    C O N S T R U C T O R---------------
+
+        const_iterator(const AttributeArray* array, std::size_t index)
+            : m_array     (array)
+            , m_index     (index)
+            , m_elements  (nullptr)
+            , m_leaf_begin(index)
+            , m_leaf_end  (index)
+        {
+        }
+
+        //-------------P R I V A T E    A T T R I B U T E S-----------------
+
+        // the array being iterated over
+        const AttributeArray* m_array;
+        // the index of the current element
+        std::size_t m_index;
+        // the elements of the leaf that holds the current element
+        const Attribute* m_elements;
+        // the index of the first element of the leaf
+        std::size_t m_leaf_begin;
+        // the index one-past-the-last element of the leaf
+        std::size_t m_leaf_end;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new empty array.
+     */
+    OMI_API_EXPORT AttributeArray();
+
+    /*!
+     * \brief Creates a new array containing the elements described by the
+     *        given iterators.
+     */
+    template<typename T_InputIterator>
+    AttributeArray(const T_InputIterator& first, const T_InputIterator& last)
+        : m_size(0)
+        , m_root(nullptr)
+    {
+        try
+        {
+            for(T_InputIterator it = first; it != last; ++it)
+            {
+                push_back(*it);
+            }
+        }
+        catch(...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Creates a new array containing the given elements.
+     */
+    OMI_API_EXPORT AttributeArray(std::initializer_list<value_type> values);
+
+    /*!
+     * \brief Creates a new array containing the elements of the given vector.
+     */
+    OMI_API_EXPORT AttributeArray(const std::vector<value_type>& values);
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * The tree of the other array is shared with the copy rather than copied.
+     */
+    OMI_API_EXPORT AttributeArray(const AttributeArray& other);
+
+    /*!
+     * \brief Move constructor, this leaves the other array empty.
+     */
+    OMI_API_EXPORT AttributeArray(AttributeArray&& other);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~AttributeArray();
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Copy assignment operator.
+     */
+    OMI_API_EXPORT AttributeArray& operator=(const AttributeArray& other);
+
+    /*!
+     * \brief Move assignment operator, this leaves the other array empty.
+     */
+    OMI_API_EXPORT AttributeArray& operator=(AttributeArray&& other);
+
+    /*!
+     * \brief Returns whether this array has the same elements as the given
+     *        array.
+     */
+    OMI_API_EXPORT bool operator==(const AttributeArray& other) const;
+
+    /*!
+     * \brief Returns whether this array does not have the same elements as the
+     *        given array.
+     */
+    OMI_API_EXPORT bool operator!=(const AttributeArray& other) const;
+
+    /*!
+     * \brief Returns whether the elements of this array are lexicographically
+     *        less than the elements of the given array.
+     */
+    OMI_API_EXPORT bool operator<(const AttributeArray& other) const;
+
+    /*!
+     * \brief Returns the element at the given index.
+     *
+     * \note The index is not checked.
+     */
+    OMI_API_EXPORT const value_type& operator[](std::size_t index) const;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns an iterator to the first element of this array.
+     */
+    OMI_API_EXPORT const_iterator begin() const;
+
+    /*!
+     * \brief Returns the iterator one-past-the-end of this array.
+     */
+    const_iterator end() const
+    {
+        return const_iterator(this, m_size);
+    }
+
+    /*!
+     * \brief Returns the number of elements in this array.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether this array has no elements.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns the first element of this array.
+     *
+     * \note This array must not be empty.
+     */
+    OMI_API_EXPORT const value_type& front() const;
+
+    /*!
+     * \brief Returns the last element of this array.
+     *
+     * \note This array must not be empty.
+     */
+    OMI_API_EXPORT const value_type& back() const;
+
+    /*!
+     * \brief Returns the number of bytes used by this array.
+     *
+     * This is the size of the array itself plus the nodes of its tree,
+     * including any that are shared with copies of the array. It does not
+     * include any memory allocated by the elements.
+     */
+    OMI_API_EXPORT std::size_t get_memory_usage() const;
+
+    /*!
+     * \brief Returns the element at the given index so that it can be
+     *        modified.
+     *
+     * \note The index is not checked.
+     */
+    OMI_API_EXPORT value_type& get_mutable(std::size_t index);
+
+    /*!
+     * \brief Replaces the element at the given index with the given attribute.
+     *
+     * \note The index is not checked.
+     */
+    OMI_API_EXPORT void set(std::size_t index, const value_type& value);
+
+    /*!
+     * \brief Appends the given attribute to the end of this array.
+     */
+    OMI_API_EXPORT void push_back(const value_type& value);
+
+    /*!
+     * \brief Inserts the given attribute at the given index, shifting the
+     *        elements at and after the index along by one.
+     *
+     * \note The index is not checked, it must be at most size().
+     */
+    OMI_API_EXPORT void insert(std::size_t index, const value_type& value);
+
+    /*!
+     * \brief Removes the element at the given index.
+     *
+     * \note The index is not checked.
+     */
+    OMI_API_EXPORT void erase(std::size_t index);
+
+    /*!
+     * \brief Removes all elements from this array.
+     */
+    OMI_API_EXPORT void clear();
+
+    /*!
+     * \brief Swaps the elements of this array with the elements of the given
+     *        array.
+     */
+    OMI_API_EXPORT void swap(AttributeArray& other);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    struct Node
+    {
+        // the number of arrays and branches that refer to the node
+        RefCount ref_count;
+        // the number of levels below the node, leaves have a height of 0
+        arc::uint32 height;
+        // the number of elements of a leaf, or children of a branch
+        arc::uint32 count;
+        // the number of elements a leaf has room for, branches always have
+        // room for kNodeCapacity children
+        arc::uint32 capacity;
+
+        // the elements of a leaf are allocated directly after the node
+        Attribute* get_elements()
+        {
+            return reinterpret_cast<Attribute*>(this + 1);
+        }
+
+        const Attribute* get_elements() const
+        {
+            return reinterpret_cast<const Attribute*>(this + 1);
+        }
+
+        // the children of a branch are allocated directly after the node
+        Node** get_children()
+        {
+            return reinterpret_cast<Node**>(this + 1);
+        }
+
+        Node* const* get_children() const
+        {
+            return reinterpret_cast<Node* const*>(this + 1);
+        }
+
+        // followed by the number of elements under each child
+        std::size_t* get_sizes()
+        {
+            return reinterpret_cast<std::size_t*>(
+                get_children() + kNodeCapacity
+            );
+        }
+
+        const std::size_t* get_sizes() const
+        {
+            return reinterpret_cast<const std::size_t*>(
+                get_children() + kNodeCapacity
+            );
+        }
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the number of elements in the array
+    std::size_t m_size;
+    // the root of the tree, or null if the array is empty
+    Node* m_root;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // finds the leaf of the element at the index of the given iterator
+    void seek(const_iterator& it) const;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the number of bytes allocated for a leaf with the given capacity
+    static std::size_t get_leaf_size(std::size_t capacity);
+
+    // returns the number of bytes allocated for a branch
+    static std::size_t get_branch_size();
+
+    // allocates an empty leaf with room for the given number of elements
+    static Node* allocate_leaf(std::size_t capacity);
+
+    // allocates an empty branch with the given height
+    static Node* allocate_branch(std::size_t height);
+
+    // frees the given node without destroying its elements or releasing its
+    // children
+    static void free_node(Node* node);
+
+    // releases a reference to the given node, freeing it and destroying its
+    // elements or releasing its children if this was the last reference
+    static void release_node(Node* node);
+
+    // returns the number of bytes allocated for the given node and all of the
+    // nodes below it
+    static std::size_t get_node_memory_usage(const Node* node);
+
+    // returns the number of elements under the given node
+    static std::size_t get_node_size(const Node* node);
+
+    // returns a new leaf with room for the given number of elements, holding
+    // copies of the given elements followed by the given value (if not null)
+    // and the elements of the other range
+    static Node* make_leaf(
+            std::size_t capacity,
+            const Attribute* first,
+            std::size_t first_count,
+            const Attribute* value,
+            const Attribute* second,
+            std::size_t second_count);
+
+    // returns a copy of the given node, which shares the children of a branch
+    static Node* copy_node(const Node* node);
+
+    // replaces the given node with a copy if it is shared with other arrays
+    static void make_unique(Node*& node);
+
+    // inserts the given value at the given index under the given node, which
+    // is made unique to this array, and returns the new sibling of the node if
+    // it had to be split or null otherwise
+    static Node* insert_value(
+            Node*& node,
+            std::size_t index,
+            const Attribute& value);
+
+    // removes the element at the given index under the given node, which is
+    // made unique to this array, setting the node to null if this leaves it
+    // empty
+    static void erase_value(Node*& node, std::size_t index);
+
+    // merges the children at the given index and the next index of the given
+    // unique branch if they fit in a single node
+    static void merge_children(Node* node, std::size_t index);
+};
+
+} // namespace omi
+
+#endif
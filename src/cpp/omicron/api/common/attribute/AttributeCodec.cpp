@@ -0,0 +1,737 @@
+#include "omicron/api/common/attribute/AttributeCodec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/crypt/hash/FNV.hpp>
+
+#include "omicron/api/common/Attributes.hpp"
+
+
+namespace omi
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// identifies the start of an encoding
+static const char kMagic[8] = {'O', 'M', 'I', 'A', 'T', 'T', 'R', '\0'};
+// written in native byte order to detect encodings from other machines
+static const arc::uint32 kByteOrderMark = 0x01020304;
+// the offset of the total length within the header
+static const std::size_t kLengthOffset = 24;
+// the alignment of each attribute within the encoding
+static const std::size_t kNodeAlignment = 8;
+// flag that is set for immutable attributes
+static const arc::uint32 kFlagImmutable = 1;
+
+// the identifiers of attribute types within the encoding - the attribute type
+// ids are derived from typeid so can't be stored since they differ between
+// builds
+enum Tag
+{
+    kTagNull = 0,
+    kTagBool,
+    kTagByte,
+    kTagInt16,
+    kTagInt32,
+    kTagInt64,
+    kTagFloat,
+    kTagDouble,
+    kTagString,
+    kTagPath,
+    kTagArray,
+    kTagMap
+};
+
+// tracks the number of decoded attributes that are borrowing encoded data
+struct SharedBuffer
+{
+    std::atomic<std::size_t> references;
+    AttributeCodec::ReleaseFunc* release;
+    void* user_data;
+};
+
+// returns a value which identifies the attribute type ids used by this build,
+// since attribute hashes are seeded with type ids, hashes can only be restored
+// if this matches
+arc::uint64 get_type_signature()
+{
+    const Attribute::Type types[] = {
+        BoolAttribute::kTypeBool,
+        ByteAttribute::kTypeByte,
+        Int16Attribute::kTypeInt16,
+        Int32Attribute::kTypeInt32,
+        Int64Attribute::kTypeInt64,
+        FloatAttribute::kTypeFloat,
+        DoubleAttribute::kTypeDouble,
+        StringAttribute::kTypeString,
+        PathAttribute::kTypePath,
+        ArrayAttribute::kTypeArray,
+        MapAttribute::kTypeMap
+    };
+    return arc::crypt::hash::fnv1a_64(
+        static_cast<const void*>(types),
+        sizeof(types)
+    );
+}
+
+// returns the tag of the given attribute
+Tag get_tag(const Attribute& attribute)
+{
+    Attribute::Type type = attribute.get_type();
+    if(type == Attribute::kTypeNull)
+    {
+        return kTagNull;
+    }
+    if(type == BoolAttribute::kTypeBool)
+    {
+        return kTagBool;
+    }
+    if(type == ByteAttribute::kTypeByte)
+    {
+        return kTagByte;
+    }
+    if(type == Int16Attribute::kTypeInt16)
+    {
+        return kTagInt16;
+    }
+    if(type == Int32Attribute::kTypeInt32)
+    {
+        return kTagInt32;
+    }
+    if(type == Int64Attribute::kTypeInt64)
+    {
+        return kTagInt64;
+    }
+    if(type == FloatAttribute::kTypeFloat)
+    {
+        return kTagFloat;
+    }
+    if(type == DoubleAttribute::kTypeDouble)
+    {
+        return kTagDouble;
+    }
+    if(type == StringAttribute::kTypeString)
+    {
+        return kTagString;
+    }
+    if(type == PathAttribute::kTypePath)
+    {
+        return kTagPath;
+    }
+    if(type == ArrayAttribute::kTypeArray)
+    {
+        return kTagArray;
+    }
+    if(type == MapAttribute::kTypeMap)
+    {
+        return kTagMap;
+    }
+
+    arc::str::UTF8String error_message;
+    error_message << "Attribute type " << type << " can not be encoded";
+    throw arc::ex::ValueError(error_message);
+}
+
+// releases a reference to a shared buffer, the encoded data is released once
+// there are no references left
+void release_shared_buffer(void* user_data)
+{
+    SharedBuffer* buffer = static_cast<SharedBuffer*>(user_data);
+    if(buffer->references.fetch_sub(1) == 1)
+    {
+        if(buffer->release != nullptr)
+        {
+            buffer->release(buffer->user_data);
+        }
+        delete buffer;
+    }
+}
+
+// writes attributes to an encoding
+class Encoder
+{
+public:
+
+    Encoder(std::vector<char>& out)
+        : m_out(out)
+    {
+    }
+
+    // writes the given bytes
+    void write(const void* data, std::size_t length)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        m_out.insert(m_out.end(), bytes, bytes + length);
+    }
+
+    // writes the bytes of the given value
+    template<typename T_ValueType>
+    void write_value(const T_ValueType& value)
+    {
+        write(static_cast<const void*>(&value), sizeof(T_ValueType));
+    }
+
+    // writes a size or count as a 64-bit integer
+    void write_size(std::size_t size)
+    {
+        write_value(static_cast<arc::uint64>(size));
+    }
+
+    // writes the length and then the bytes of the given string (excluding the
+    // null terminator)
+    void write_string(const arc::str::UTF8String& s)
+    {
+        std::size_t length = s.get_byte_length() - 1;
+        write_size(length);
+        write(static_cast<const void*>(s.get_raw()), length);
+    }
+
+    // writes zeros until the encoding is a multiple of the given alignment
+    void pad(std::size_t alignment)
+    {
+        m_out.resize(((m_out.size() + alignment - 1) / alignment) * alignment);
+    }
+
+    // writes the given attribute and its descendants
+    void write_node(const Attribute& attribute)
+    {
+        pad(kNodeAlignment);
+
+        Tag tag = get_tag(attribute);
+        Hash hash = attribute.get_hash();
+        write_value(static_cast<arc::uint32>(tag));
+        write_value(attribute.is_immutable() ? kFlagImmutable : 0U);
+        write_value(hash.part1);
+        write_value(hash.part2);
+
+        switch(tag)
+        {
+            case kTagNull:
+            {
+                break;
+            }
+            case kTagBool:
+            {
+                // bools are written as single bytes
+                BoolAttribute typed(attribute);
+                write_size(typed.get_tuple_size());
+                write_size(typed.get_size());
+                for(bool value : typed.get_values())
+                {
+                    write_value(static_cast<arc::uint8>(value ? 1 : 0));
+                }
+                break;
+            }
+            case kTagByte:
+            {
+                write_block<ByteAttribute>(attribute);
+                break;
+            }
+            case kTagInt16:
+            {
+                write_block<Int16Attribute>(attribute);
+                break;
+            }
+            case kTagInt32:
+            {
+                write_block<Int32Attribute>(attribute);
+                break;
+            }
+            case kTagInt64:
+            {
+                write_block<Int64Attribute>(attribute);
+                break;
+            }
+            case kTagFloat:
+            {
+                write_block<FloatAttribute>(attribute);
+                break;
+            }
+            case kTagDouble:
+            {
+                write_block<DoubleAttribute>(attribute);
+                break;
+            }
+            case kTagString:
+            {
+                StringAttribute typed(attribute);
+                write_size(typed.get_tuple_size());
+                write_size(typed.get_size());
+                for(const arc::str::UTF8String& value : typed.get_values())
+                {
+                    write_string(value);
+                }
+                break;
+            }
+            case kTagPath:
+            {
+                // paths are written as their components
+                PathAttribute typed(attribute);
+                write_size(typed.get_tuple_size());
+                write_size(typed.get_size());
+                for(const arc::io::sys::Path& value : typed.get_values())
+                {
+                    write_size(value.get_length());
+                    for(std::size_t i = 0; i < value.get_length(); ++i)
+                    {
+                        write_string(value[i]);
+                    }
+                }
+                break;
+            }
+            case kTagArray:
+            {
+                ArrayAttribute typed(attribute);
+                write_size(typed.get_size());
+                for(const Attribute& entry : typed.get_values())
+                {
+                    write_node(entry);
+                }
+                break;
+            }
+            case kTagMap:
+            {
+                // sort the entries so that equal maps have equal encodings
+                MapAttribute typed(attribute);
+                std::vector<const MapAttribute::DataType::value_type*> entries;
+                for(const auto& entry : typed.get_values())
+                {
+                    entries.push_back(&entry);
+                }
+                std::sort(
+                    entries.begin(),
+                    entries.end(),
+                    [](
+                        const MapAttribute::DataType::value_type* a,
+                        const MapAttribute::DataType::value_type* b)
+                    {
+                        return a->first < b->first;
+                    }
+                );
+
+                write_size(entries.size());
+                for(const MapAttribute::DataType::value_type* entry : entries)
+                {
+                    write_string(entry->first);
+                    write_node(entry->second);
+                }
+                break;
+            }
+        }
+    }
+
+private:
+
+    // the encoding being written to
+    std::vector<char>& m_out;
+
+    // writes the tuple size, size, and then the aligned values of the given
+    // data attribute
+    template<typename T_AttributeType>
+    void write_block(const Attribute& attribute)
+    {
+        T_AttributeType typed(attribute);
+        const typename T_AttributeType::ArrayType& values = typed.get_values();
+        write_size(typed.get_tuple_size());
+        write_size(values.size());
+        pad(AttributeCodec::kBlockAlignment);
+        write(
+            static_cast<const void*>(values.data()),
+            values.size() * sizeof(typename T_AttributeType::DataType)
+        );
+    }
+};
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                    DECODER
+//------------------------------------------------------------------------------
+
+class AttributeCodec::Decoder
+{
+public:
+
+    // shared is null if the decoder should not borrow the data
+    Decoder(const char* data, std::size_t length, SharedBuffer* shared)
+        : m_data          (data)
+        , m_length        (length)
+        , m_offset        (0)
+        , m_shared        (shared)
+        , m_restore_hashes(false)
+    {
+    }
+
+    // reads the header and then the root attribute
+    Attribute decode()
+    {
+        const char* magic = read(sizeof(kMagic));
+        if(std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            throw arc::ex::ParseError("Data is not an encoded attribute");
+        }
+        arc::uint32 version = read_value<arc::uint32>();
+        if(read_value<arc::uint32>() != kByteOrderMark)
+        {
+            throw arc::ex::ParseError(
+                "Encoded attribute was written with a different byte order"
+            );
+        }
+        if(version != AttributeCodec::kVersion)
+        {
+            arc::str::UTF8String error_message;
+            error_message << "Unsupported attribute encoding version: "
+                          << version;
+            throw arc::ex::ParseError(error_message);
+        }
+        m_restore_hashes = read_value<arc::uint64>() == get_type_signature();
+        arc::uint64 length = read_value<arc::uint64>();
+        if(length > m_length)
+        {
+            throw arc::ex::ParseError("Encoded attribute data is truncated");
+        }
+        m_length = static_cast<std::size_t>(length);
+
+        return read_node();
+    }
+
+private:
+
+    // the encoded data
+    const char* m_data;
+    // the length of the encoded data
+    std::size_t m_length;
+    // the current read position
+    std::size_t m_offset;
+    // tracks the attributes borrowing the data, null if not borrowing
+    SharedBuffer* m_shared;
+    // whether the encoded hashes are valid for this build
+    bool m_restore_hashes;
+
+    // returns a pointer to the given number of bytes at the current position
+    // and advances past them
+    const char* read(std::size_t length)
+    {
+        if(length > m_length - m_offset)
+        {
+            throw arc::ex::ParseError("Encoded attribute data is truncated");
+        }
+        const char* ret = m_data + m_offset;
+        m_offset += length;
+        return ret;
+    }
+
+    // reads a value of the given type
+    template<typename T_ValueType>
+    T_ValueType read_value()
+    {
+        T_ValueType ret;
+        std::memcpy(
+            static_cast<void*>(&ret),
+            read(sizeof(T_ValueType)),
+            sizeof(T_ValueType)
+        );
+        return ret;
+    }
+
+    // reads a size or count
+    std::size_t read_size()
+    {
+        return static_cast<std::size_t>(read_value<arc::uint64>());
+    }
+
+    // reads a string
+    arc::str::UTF8String read_string()
+    {
+        std::size_t length = read_size();
+        const char* data = read(length);
+        return arc::str::UTF8String(data, length);
+    }
+
+    // skips padding until the position is a multiple of the given alignment
+    void align(std::size_t alignment)
+    {
+        std::size_t offset =
+            ((m_offset + alignment - 1) / alignment) * alignment;
+        if(offset > m_length)
+        {
+            throw arc::ex::ParseError("Encoded attribute data is truncated");
+        }
+        m_offset = offset;
+    }
+
+    // reads an attribute and its descendants
+    Attribute read_node()
+    {
+        align(kNodeAlignment);
+
+        arc::uint32 tag = read_value<arc::uint32>();
+        arc::uint32 flags = read_value<arc::uint32>();
+        Hash hash;
+        hash.part1 = read_value<arc::uint64>();
+        hash.part2 = read_value<arc::uint64>();
+
+        Attribute attribute(read_contents(tag, (flags & kFlagImmutable) != 0));
+
+        // only data attributes have hashes which don't depend on their entries
+        if(m_restore_hashes &&
+           tag != kTagNull &&
+           tag != kTagArray &&
+           tag != kTagMap &&
+           (hash.part1 != 0 || hash.part2 != 0))
+        {
+            AttributeCodec::restore_hash(attribute, hash);
+        }
+        return attribute;
+    }
+
+    // reads the contents of an attribute with the given tag
+    Attribute read_contents(arc::uint32 tag, bool immutable)
+    {
+        switch(tag)
+        {
+            case kTagNull:
+            {
+                return Attribute();
+            }
+            case kTagBool:
+            {
+                std::size_t tuple_size = read_size();
+                std::size_t size = read_size();
+                const char* block = read(size);
+                BoolAttribute::ArrayType values;
+                values.reserve(size);
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    values.push_back(block[i] != 0);
+                }
+                return BoolAttribute(std::move(values), tuple_size, immutable);
+            }
+            case kTagByte:
+            {
+                return read_block<ByteAttribute>(immutable);
+            }
+            case kTagInt16:
+            {
+                return read_block<Int16Attribute>(immutable);
+            }
+            case kTagInt32:
+            {
+                return read_block<Int32Attribute>(immutable);
+            }
+            case kTagInt64:
+            {
+                return read_block<Int64Attribute>(immutable);
+            }
+            case kTagFloat:
+            {
+                return read_block<FloatAttribute>(immutable);
+            }
+            case kTagDouble:
+            {
+                return read_block<DoubleAttribute>(immutable);
+            }
+            case kTagString:
+            {
+                std::size_t tuple_size = read_size();
+                std::size_t size = read_size();
+                StringAttribute::ArrayType values;
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    values.push_back(read_string());
+                }
+                return StringAttribute(
+                    std::move(values),
+                    tuple_size,
+                    immutable
+                );
+            }
+            case kTagPath:
+            {
+                std::size_t tuple_size = read_size();
+                std::size_t size = read_size();
+                PathAttribute::ArrayType values;
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    std::size_t component_count = read_size();
+                    arc::io::sys::Path path;
+                    for(std::size_t j = 0; j < component_count; ++j)
+                    {
+                        path << read_string();
+                    }
+                    values.push_back(path);
+                }
+                return PathAttribute(std::move(values), tuple_size, immutable);
+            }
+            case kTagArray:
+            {
+                std::size_t size = read_size();
+                ArrayAttribute::DataType entries;
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    entries.push_back(read_node());
+                }
+                return ArrayAttribute(entries, immutable);
+            }
+            case kTagMap:
+            {
+                std::size_t size = read_size();
+                MapAttribute::DataType entries;
+                for(std::size_t i = 0; i < size; ++i)
+                {
+                    arc::str::UTF8String name = read_string();
+                    entries.insert(
+                        MapAttribute::DataType::value_type(name, read_node())
+                    );
+                }
+                return MapAttribute(entries, immutable);
+            }
+        }
+
+        arc::str::UTF8String error_message;
+        error_message << "Unknown encoded attribute type: " << tag;
+        throw arc::ex::ParseError(error_message);
+    }
+
+    // reads the tuple size, size, and then the aligned values of a data
+    // attribute
+    template<typename T_AttributeType>
+    Attribute read_block(bool immutable)
+    {
+        typedef typename T_AttributeType::DataType DataType;
+        typedef typename T_AttributeType::ArrayType ArrayType;
+
+        std::size_t tuple_size = read_size();
+        std::size_t size = read_size();
+        align(AttributeCodec::kBlockAlignment);
+        if(size > (m_length - m_offset) / sizeof(DataType))
+        {
+            throw arc::ex::ParseError("Encoded attribute data is truncated");
+        }
+        const char* block = read(size * sizeof(DataType));
+
+        // borrow the block? small arrays are stored inline so are cheaper to
+        // copy, and the block may not be aligned if the data isn't
+        if(m_shared != nullptr &&
+           size > ArrayType::kInlineCapacity &&
+           reinterpret_cast<std::uintptr_t>(block) % alignof(DataType) == 0)
+        {
+            m_shared->references.fetch_add(1);
+            return T_AttributeType(
+                ArrayType::borrow(
+                    reinterpret_cast<const DataType*>(block),
+                    size,
+                    &release_shared_buffer,
+                    m_shared
+                ),
+                tuple_size,
+                immutable
+            );
+        }
+
+        ArrayType values;
+        values.resize(size);
+        if(size > 0)
+        {
+            std::memcpy(
+                static_cast<void*>(values.mutable_data()),
+                block,
+                size * sizeof(DataType)
+            );
+        }
+        return T_AttributeType(std::move(values), tuple_size, immutable);
+    }
+};
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT const arc::uint32 AttributeCodec::kVersion = 1;
+
+OMI_API_EXPORT const std::size_t AttributeCodec::kBlockAlignment = 16;
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void AttributeCodec::encode(
+        const Attribute& attribute,
+        std::vector<char>& out)
+{
+    out.clear();
+    Encoder encoder(out);
+
+    // header
+    encoder.write(static_cast<const void*>(kMagic), sizeof(kMagic));
+    encoder.write_value(kVersion);
+    encoder.write_value(kByteOrderMark);
+    encoder.write_value(get_type_signature());
+    // the total length is filled in once it's known
+    encoder.write_size(0);
+
+    encoder.write_node(attribute);
+    encoder.pad(kNodeAlignment);
+
+    arc::uint64 length = static_cast<arc::uint64>(out.size());
+    std::memcpy(&out[kLengthOffset], &length, sizeof(length));
+}
+
+OMI_API_EXPORT Attribute AttributeCodec::decode(
+        const char* data,
+        std::size_t length)
+{
+    Decoder decoder(data, length, nullptr);
+    return decoder.decode();
+}
+
+OMI_API_EXPORT Attribute AttributeCodec::decode_borrowed(
+        const char* data,
+        std::size_t length,
+        ReleaseFunc* release,
+        void* user_data)
+{
+    // the decoder holds a reference while decoding so that the data isn't
+    // released by an attribute that is discarded part way through
+    SharedBuffer* shared = new SharedBuffer();
+    shared->references = 1;
+    shared->release = release;
+    shared->user_data = user_data;
+
+    Decoder decoder(data, length, shared);
+    try
+    {
+        Attribute attribute(decoder.decode());
+        release_shared_buffer(shared);
+        return attribute;
+    }
+    catch(...)
+    {
+        release_shared_buffer(shared);
+        throw;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void AttributeCodec::restore_hash(
+        const Attribute& attribute,
+        const Hash& hash)
+{
+    Attribute::get_storage<DataAttribute::DataStorage>(attribute)
+        ->m_cached_hash = hash;
+}
+
+} // namespace omi
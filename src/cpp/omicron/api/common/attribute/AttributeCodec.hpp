@@ -0,0 +1,159 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTECODEC_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTECODEC_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <arcanecore/base/Types.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/attribute/Attribute.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief Encodes attribute hierarchies to, and decodes them from, a compact
+ *        versioned binary format.
+ *
+ * The encoding holds the complete hierarchy: the type, immutability, and hash
+ * of every attribute, the tuple sizes and values of data attributes, and the
+ * entries of array and map attributes. This allows resources to be compiled
+ * ahead of time and state to be snapshotted without the cost of parsing text
+ * formats.
+ *
+ * The values of numeric and byte attributes are written as raw blocks which
+ * are aligned to kBlockAlignment bytes from the start of the encoding. When
+ * decoding with decode_borrowed() these attributes refer directly to the
+ * encoded memory (e.g. a memory-mapped file) rather than copying it, see
+ * omi::DataArray::borrow().
+ *
+ * Values are stored in the byte order of the machine that encoded them, and
+ * encodings with a different byte order are rejected. The hashes of data
+ * attributes are restored on decode so large blocks do not need to be
+ * rehashed, but only if the encoding was written by a build that uses the same
+ * attribute type identifiers (otherwise they are recomputed when required).
+ *
+ * Example usage:
+ *
+ * \code
+ * std::vector<char> encoded;
+ * omi::AttributeCodec::encode(attribute, encoded);
+ *
+ * omi::Attribute decoded =
+ *     omi::AttributeCodec::decode(encoded.data(), encoded.size());
+ * \endcode
+ */
+class AttributeCodec
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              TYPE DEFINITIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Function signature for the callback used to release encoded
+     *        memory that was decoded with decode_borrowed().
+     *
+     * \param user_data The user data that was passed to decode_borrowed().
+     */
+    typedef void (ReleaseFunc)(void* user_data);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The version of the format written by encode(), only encodings of
+     *        this version can be decoded.
+     */
+    OMI_API_EXPORT static const arc::uint32 kVersion;
+
+    /*!
+     * \brief The alignment in bytes of the blocks of data attribute values,
+     *        relative to the start of the encoding.
+     */
+    OMI_API_EXPORT static const std::size_t kBlockAlignment;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Encodes the given attribute and all of its descendants.
+     *
+     * The entries of maps are written in name order so that equal attributes
+     * always have identical encodings.
+     *
+     * \param attribute The root attribute to encode.
+     * \param out Is replaced with the encoded data.
+     */
+    OMI_API_EXPORT static void encode(
+            const Attribute& attribute,
+            std::vector<char>& out);
+
+    /*!
+     * \brief Decodes an attribute hierarchy from a copy of the given encoded
+     *        data, the data is not referenced once this function returns.
+     *
+     * \throw arc::ex::ParseError If the data is not a valid encoding of the
+     *                            current version.
+     */
+    OMI_API_EXPORT static Attribute decode(
+            const char* data,
+            std::size_t length);
+
+    /*!
+     * \brief Decodes an attribute hierarchy where large blocks of numeric and
+     *        byte values refer to the given encoded data rather than copying
+     *        it.
+     *
+     * The data must remain valid and unmodified until the release function is
+     * called. The release function is called exactly once, when no decoded
+     * attribute refers to the data anymore (which may be before this function
+     * returns if nothing was borrowed). Blocks that are not correctly aligned
+     * in memory for their type are copied.
+     *
+     * \param data Pointer to the start of the encoded data.
+     * \param length The length of the encoded data in bytes.
+     * \param release Function that will be called once the data is no longer
+     *                required, may be null.
+     * \param user_data Pointer that will be passed to the release function.
+     *
+     * \throw arc::ex::ParseError If the data is not a valid encoding of the
+     *                            current version.
+     */
+    OMI_API_EXPORT static Attribute decode_borrowed(
+            const char* data,
+            std::size_t length,
+            ReleaseFunc* release = nullptr,
+            void* user_data = nullptr);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                              PRIVATE CLASSES
+    //--------------------------------------------------------------------------
+
+    // reads attributes from encoded data
+    class Decoder;
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // sets the cached hash of the given data attribute
+    OMI_API_EXPORT static void restore_hash(
+            const Attribute& attribute,
+            const Hash& hash);
+};
+
+} // namespace omi
+
+#endif
@@ -0,0 +1,1075 @@
+#include "omicron/api/common/attribute/AttributeMap.hpp"
+
+#include <new>
+
+
+namespace omi
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the number of bits of the hash of a name that each level of a trie uses
+static const std::size_t kBitsPerLevel = 5;
+
+// the mask of the bits used by a single level of a trie
+static const std::size_t kLevelMask = (1 << kBitsPerLevel) - 1;
+
+// the depth at which every bit of the hash has been used - nodes at this depth
+// hold entries with colliding hashes and don't use their bitmaps
+static const std::size_t kMaxDepth =
+    (sizeof(std::size_t) * 8 + kBitsPerLevel - 1) / kBitsPerLevel;
+
+// returns the bit for the given hash in the bitmaps of a node at the given
+// depth
+arc::uint32 get_bit(std::size_t hash, std::size_t depth)
+{
+    return static_cast<arc::uint32>(1) <<
+        ((hash >> (depth * kBitsPerLevel)) & kLevelMask);
+}
+
+// returns the number of bits that are set in the given bitmap
+std::size_t count_bits(arc::uint32 bitmap)
+{
+    bitmap = bitmap - ((bitmap >> 1) & 0x55555555);
+    bitmap = (bitmap & 0x33333333) + ((bitmap >> 2) & 0x33333333);
+    return (((bitmap + (bitmap >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+// returns the index of the child for the given bit in the given bitmap
+std::size_t get_index(arc::uint32 bitmap, arc::uint32 bit)
+{
+    return count_bits(bitmap & (bit - 1));
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                               STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT const std::size_t AttributeMap::kInlineCapacity;
+OMI_API_EXPORT const std::size_t AttributeMap::kDemoteSize;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeMap::AttributeMap()
+    : m_size(0)
+    , m_root(nullptr)
+{
+}
+
+OMI_API_EXPORT AttributeMap::AttributeMap(
+        std::initializer_list<value_type> values)
+    : m_size(0)
+    , m_root(nullptr)
+{
+    try
+    {
+        for(const value_type& value : values)
+        {
+            insert(value);
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+}
+
+OMI_API_EXPORT AttributeMap::AttributeMap(const AttributeMap& other)
+    : m_size(0)
+    , m_root(nullptr)
+{
+    // share the trie
+    if(other.m_root != nullptr)
+    {
+        m_root = other.m_root;
+        m_root->ref_count.increment();
+        m_size = other.m_size;
+    }
+    else
+    {
+        copy_inline(other);
+    }
+}
+
+OMI_API_EXPORT AttributeMap::AttributeMap(AttributeMap&& other)
+    : m_size(0)
+    , m_root(nullptr)
+{
+    move_from(other);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeMap::~AttributeMap()
+{
+    clear();
+}
+
+//------------------------------------------------------------------------------
+//                                   OPERATORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeMap& AttributeMap::operator=(const AttributeMap& other)
+{
+    if(this != &other)
+    {
+        AttributeMap copy(other);
+        clear();
+        move_from(copy);
+    }
+    return *this;
+}
+
+OMI_API_EXPORT AttributeMap& AttributeMap::operator=(AttributeMap&& other)
+{
+    if(this != &other)
+    {
+        clear();
+        move_from(other);
+    }
+    return *this;
+}
+
+OMI_API_EXPORT AttributeMap::mapped_type& AttributeMap::operator[](
+        const key_type& key)
+{
+    std::size_t hash = hasher()(key);
+    mapped_type* mapped = find_mutable(hash, key);
+    if(mapped != nullptr)
+    {
+        return *mapped;
+    }
+    // only construct the null attribute if it's needed
+    bool inserted = false;
+    return insert_value(hash, key, mapped_type(), inserted).second;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT AttributeMap::const_iterator AttributeMap::begin() const
+{
+    if(m_root == nullptr)
+    {
+        return const_iterator(this, nullptr, 0);
+    }
+    // nodes without entries always have sub-nodes
+    const Node* node = m_root;
+    while(node->entry_count == 0)
+    {
+        node = node->get_children()[0].node;
+    }
+    return const_iterator(this, node, 0);
+}
+
+OMI_API_EXPORT std::size_t AttributeMap::get_memory_usage() const
+{
+    if(m_root == nullptr)
+    {
+        return sizeof(AttributeMap);
+    }
+    return sizeof(AttributeMap) + get_node_memory_usage(m_root);
+}
+
+OMI_API_EXPORT AttributeMap::const_iterator AttributeMap::find(
+        const key_type& key) const
+{
+    return find(hasher()(key), key);
+}
+
+OMI_API_EXPORT AttributeMap::const_iterator AttributeMap::find(
+        std::size_t hash,
+        const key_type& key) const
+{
+    const Node* node = nullptr;
+    std::size_t position = 0;
+    if(!locate(hash, key, node, position))
+    {
+        return end();
+    }
+    return const_iterator(this, node, position);
+}
+
+OMI_API_EXPORT AttributeMap::mapped_type* AttributeMap::find_mutable(
+        const key_type& key)
+{
+    return find_mutable(hasher()(key), key);
+}
+
+OMI_API_EXPORT AttributeMap::mapped_type* AttributeMap::find_mutable(
+        std::size_t hash,
+        const key_type& key)
+{
+    const Node* node = nullptr;
+    std::size_t position = 0;
+    if(!locate(hash, key, node, position))
+    {
+        return nullptr;
+    }
+    if(node == nullptr)
+    {
+        return &get_inline(position).second;
+    }
+    // the entry may be shared with copies of this map
+    return &make_path_unique(hash, position)->value.second;
+}
+
+OMI_API_EXPORT std::size_t AttributeMap::count(const key_type& key) const
+{
+    const Node* node = nullptr;
+    std::size_t position = 0;
+    return locate(hasher()(key), key, node, position) ? 1 : 0;
+}
+
+OMI_API_EXPORT std::pair<AttributeMap::const_iterator, bool>
+AttributeMap::insert(const value_type& value)
+{
+    std::size_t hash = hasher()(value.first);
+    // check for an existing entry first so that the trie isn't modified
+    bool inserted = false;
+    if(find(hash, value.first) == end())
+    {
+        insert_value(hash, value.first, value.second, inserted);
+    }
+    return std::make_pair(find(hash, value.first), inserted);
+}
+
+OMI_API_EXPORT std::size_t AttributeMap::erase(const key_type& key)
+{
+    std::size_t hash = hasher()(key);
+
+    if(m_root == nullptr)
+    {
+        for(std::size_t i = 0; i < m_size && m_hashes[i] <= hash; ++i)
+        {
+            if(m_hashes[i] != hash || get_inline(i).first != key)
+            {
+                continue;
+            }
+            get_inline(i).~value_type();
+            for(std::size_t j = i + 1; j < m_size; ++j)
+            {
+                m_hashes[j - 1] = m_hashes[j];
+                m_order[j - 1] = m_order[j];
+            }
+            --m_size;
+            return 1;
+        }
+        return 0;
+    }
+
+    // check the entry exists first so that the trie isn't modified
+    const Node* node = nullptr;
+    std::size_t position = 0;
+    if(!locate(hash, key, node, position))
+    {
+        return 0;
+    }
+
+    // move the remaining entries inline instead?
+    if(m_size - 1 <= kDemoteSize)
+    {
+        demote(node->get_children()[position].entry);
+        return 1;
+    }
+
+    release_entry(erase_entry(m_root, 0, hash, key));
+    --m_size;
+    return 1;
+}
+
+OMI_API_EXPORT void AttributeMap::clear()
+{
+    if(m_root != nullptr)
+    {
+        release_node(m_root);
+        m_root = nullptr;
+    }
+    else
+    {
+        for(std::size_t i = 0; i < m_size; ++i)
+        {
+            get_inline(i).~value_type();
+        }
+    }
+    m_size = 0;
+}
+
+OMI_API_EXPORT void AttributeMap::swap(AttributeMap& other)
+{
+    if(this == &other)
+    {
+        return;
+    }
+    AttributeMap temp(std::move(other));
+    other.move_from(*this);
+    move_from(temp);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+bool AttributeMap::locate(
+        std::size_t hash,
+        const key_type& key,
+        const Node*& node,
+        std::size_t& position) const
+{
+    if(m_root == nullptr)
+    {
+        // the hashes are sorted so stop at the first larger hash
+        for(position = 0; position < m_size && m_hashes[position] <= hash;
+            ++position)
+        {
+            if(m_hashes[position] == hash && get_inline(position).first == key)
+            {
+                node = nullptr;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    node = m_root;
+    for(std::size_t depth = 0; depth < kMaxDepth; ++depth)
+    {
+        arc::uint32 bit = get_bit(hash, depth);
+        if((node->entry_map & bit) != 0)
+        {
+            position = get_index(node->entry_map, bit);
+            const Entry* entry = node->get_children()[position].entry;
+            return entry->hash == hash && entry->value.first == key;
+        }
+        if((node->node_map & bit) == 0)
+        {
+            return false;
+        }
+        node = node->get_children()[
+            node->entry_count + get_index(node->node_map, bit)
+        ].node;
+    }
+
+    // every entry of a node at the maximum depth has the same hash
+    for(position = 0; position < node->entry_count; ++position)
+    {
+        const Entry* entry = node->get_children()[position].entry;
+        if(entry->hash == hash && entry->value.first == key)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+AttributeMap::value_type& AttributeMap::insert_value(
+        std::size_t hash,
+        const key_type& key,
+        const mapped_type& mapped,
+        bool& inserted)
+{
+    inserted = false;
+
+    if(m_root == nullptr)
+    {
+        // find the position of the entry in the order
+        std::size_t position = 0;
+        for(; position < m_size && m_hashes[position] <= hash; ++position)
+        {
+            if(m_hashes[position] == hash && get_inline(position).first == key)
+            {
+                return get_inline(position);
+            }
+        }
+
+        if(m_size < kInlineCapacity)
+        {
+            // find a free slot
+            unsigned used = 0;
+            for(std::size_t i = 0; i < m_size; ++i)
+            {
+                used |= 1U << m_order[i];
+            }
+            unsigned char slot = 0;
+            while((used & (1U << slot)) != 0)
+            {
+                ++slot;
+            }
+
+            // the entry is constructed before the order is changed so nothing
+            // is modified if constructing it throws
+            new(&m_slots[slot]) value_type(key, mapped);
+            for(std::size_t i = m_size; i > position; --i)
+            {
+                m_hashes[i] = m_hashes[i - 1];
+                m_order[i] = m_order[i - 1];
+            }
+            m_hashes[position] = hash;
+            m_order[position] = slot;
+            ++m_size;
+            inserted = true;
+            return get_inline(position);
+        }
+
+        promote();
+    }
+
+    Entry* entry = insert_entry(m_root, 0, hash, key, mapped, inserted);
+    if(inserted)
+    {
+        ++m_size;
+    }
+    return entry->value;
+}
+
+AttributeMap::Entry* AttributeMap::make_path_unique(
+        std::size_t hash,
+        std::size_t position)
+{
+    Node** node = &m_root;
+    for(std::size_t depth = 0;; ++depth)
+    {
+        make_unique(*node);
+        arc::uint32 bit = get_bit(hash, depth);
+        if(depth == kMaxDepth || ((*node)->entry_map & bit) != 0)
+        {
+            break;
+        }
+        node = &(*node)->get_children()[
+            (*node)->entry_count + get_index((*node)->node_map, bit)
+        ].node;
+    }
+
+    Entry*& entry = (*node)->get_children()[position].entry;
+    make_unique(entry);
+    return entry;
+}
+
+void AttributeMap::advance(const Node*& node, std::size_t& position) const
+{
+    // inline entries and the next entry of the same node
+    if(node == nullptr || position + 1 < node->entry_count)
+    {
+        ++position;
+        return;
+    }
+
+    // iterators don't store the path to their node since copying it would
+    // make them expensive, so rebuild it from the hash of the current entry
+    std::size_t hash = node->get_children()[position].entry->hash;
+    const Node* path[kMaxDepth + 1];
+    std::size_t depth = 0;
+    path[0] = m_root;
+    while(path[depth] != node)
+    {
+        const Node* current = path[depth];
+        path[depth + 1] = current->get_children()[
+            current->entry_count +
+            get_index(current->node_map, get_bit(hash, depth))
+        ].node;
+        ++depth;
+    }
+
+    // the sub-nodes of a node are visited after its entries, so move to the
+    // first entry of the next sub-node of the closest node that has one
+    std::size_t next = 0;
+    while(true)
+    {
+        const Node* current = path[depth];
+        if(next < current->node_count)
+        {
+            node = current->get_children()[current->entry_count + next].node;
+            while(node->entry_count == 0)
+            {
+                node = node->get_children()[0].node;
+            }
+            position = 0;
+            return;
+        }
+        if(depth == 0)
+        {
+            node = nullptr;
+            position = m_size;
+            return;
+        }
+        --depth;
+        next = get_index(path[depth]->node_map, get_bit(hash, depth)) + 1;
+    }
+}
+
+void AttributeMap::copy_inline(const AttributeMap& other)
+{
+    try
+    {
+        for(std::size_t i = 0; i < other.m_size; ++i)
+        {
+            m_order[i] = other.m_order[i];
+            new(&m_slots[m_order[i]]) value_type(other.get_inline(i));
+            m_hashes[i] = other.m_hashes[i];
+            ++m_size;
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+}
+
+void AttributeMap::move_from(AttributeMap& other)
+{
+    // the trie can just be taken
+    if(other.m_root != nullptr)
+    {
+        m_root = other.m_root;
+        m_size = other.m_size;
+        other.m_root = nullptr;
+        other.m_size = 0;
+        return;
+    }
+
+    try
+    {
+        for(std::size_t i = 0; i < other.m_size; ++i)
+        {
+            m_order[i] = other.m_order[i];
+            new(&m_slots[m_order[i]]) value_type(
+                std::move(other.get_inline(i))
+            );
+            m_hashes[i] = other.m_hashes[i];
+            ++m_size;
+        }
+    }
+    catch(...)
+    {
+        clear();
+        throw;
+    }
+    other.clear();
+}
+
+void AttributeMap::promote()
+{
+    // build the trie before destroying the inline entries so nothing is
+    // modified if an allocation fails
+    Node* root = allocate_node(0, 0);
+    try
+    {
+        for(std::size_t i = 0; i < m_size; ++i)
+        {
+            const value_type& value = get_inline(i);
+            bool inserted = false;
+            insert_entry(
+                root,
+                0,
+                m_hashes[i],
+                value.first,
+                value.second,
+                inserted
+            );
+        }
+    }
+    catch(...)
+    {
+        release_node(root);
+        throw;
+    }
+
+    for(std::size_t i = 0; i < m_size; ++i)
+    {
+        get_inline(i).~value_type();
+    }
+    m_root = root;
+}
+
+void AttributeMap::demote(const Entry* skip)
+{
+    // copy the entries inline before releasing the trie so nothing is modified
+    // if copying an entry throws, the inline storage is unused while the map
+    // is promoted
+    std::size_t count = 0;
+    try
+    {
+        for(const_iterator it = begin(); it != end(); ++it)
+        {
+            const Entry* entry = it.m_node->get_children()[it.m_position].entry;
+            if(entry == skip)
+            {
+                continue;
+            }
+            new(&m_slots[count]) value_type(entry->value);
+
+            // insert into the order
+            std::size_t position = count;
+            for(; position > 0 && m_hashes[position - 1] > entry->hash;
+                --position)
+            {
+                m_hashes[position] = m_hashes[position - 1];
+                m_order[position] = m_order[position - 1];
+            }
+            m_hashes[position] = entry->hash;
+            m_order[position] = static_cast<unsigned char>(count);
+            ++count;
+        }
+    }
+    catch(...)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            reinterpret_cast<value_type*>(&m_slots[i])->~value_type();
+        }
+        throw;
+    }
+
+    release_node(m_root);
+    m_root = nullptr;
+    m_size = count;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+std::size_t AttributeMap::get_node_size(std::size_t child_count)
+{
+    return sizeof(Node) + child_count * sizeof(Child);
+}
+
+AttributeMap::Node* AttributeMap::allocate_node(
+        std::size_t entry_count,
+        std::size_t node_count)
+{
+    void* memory = StoragePool::allocate(
+        get_node_size(entry_count + node_count)
+    );
+    Node* node = new(memory) Node();
+    node->entry_map = 0;
+    node->node_map = 0;
+    node->entry_count = static_cast<arc::uint32>(entry_count);
+    node->node_count = static_cast<arc::uint32>(node_count);
+    return node;
+}
+
+void AttributeMap::free_node(Node* node)
+{
+    std::size_t size =
+        get_node_size(node->entry_count + node->node_count);
+    node->~Node();
+    StoragePool::deallocate(node, size);
+}
+
+void AttributeMap::release_entry(Entry* entry)
+{
+    if(entry->ref_count.decrement())
+    {
+        delete entry;
+    }
+}
+
+void AttributeMap::release_node(Node* node)
+{
+    // still used by other maps?
+    if(!node->ref_count.decrement())
+    {
+        return;
+    }
+
+    Child* children = node->get_children();
+    for(std::size_t i = 0; i < node->entry_count; ++i)
+    {
+        release_entry(children[i].entry);
+    }
+    for(std::size_t i = 0; i < node->node_count; ++i)
+    {
+        release_node(children[node->entry_count + i].node);
+    }
+    free_node(node);
+}
+
+std::size_t AttributeMap::get_node_memory_usage(const Node* node)
+{
+    std::size_t bytes =
+        get_node_size(node->entry_count + node->node_count) +
+        node->entry_count * sizeof(Entry);
+    for(std::size_t i = 0; i < node->node_count; ++i)
+    {
+        bytes += get_node_memory_usage(
+            node->get_children()[node->entry_count + i].node
+        );
+    }
+    return bytes;
+}
+
+AttributeMap::Node* AttributeMap::copy_node(const Node* node)
+{
+    Node* copy = allocate_node(node->entry_count, node->node_count);
+    copy->entry_map = node->entry_map;
+    copy->node_map = node->node_map;
+
+    // the children are shared rather than copied
+    const Child* children = node->get_children();
+    Child* copy_children = copy->get_children();
+    for(std::size_t i = 0; i < node->entry_count; ++i)
+    {
+        copy_children[i].entry = children[i].entry;
+        copy_children[i].entry->ref_count.increment();
+    }
+    for(std::size_t i = node->entry_count;
+        i < node->entry_count + node->node_count; ++i)
+    {
+        copy_children[i].node = children[i].node;
+        copy_children[i].node->ref_count.increment();
+    }
+    return copy;
+}
+
+void AttributeMap::make_unique(Node*& node)
+{
+    if(node->ref_count.get() == 1)
+    {
+        return;
+    }
+    Node* copy = copy_node(node);
+    release_node(node);
+    node = copy;
+}
+
+void AttributeMap::make_unique(Entry*& entry)
+{
+    if(entry->ref_count.get() == 1)
+    {
+        return;
+    }
+    Entry* copy = new Entry(entry->hash, entry->value);
+    release_entry(entry);
+    entry = copy;
+}
+
+AttributeMap::Node* AttributeMap::make_pair_node(
+        Entry* a,
+        Entry* b,
+        std::size_t depth)
+{
+    // the hashes collide
+    if(depth == kMaxDepth)
+    {
+        Node* node = allocate_node(2, 0);
+        node->get_children()[0].entry = a;
+        node->get_children()[1].entry = b;
+        return node;
+    }
+
+    arc::uint32 bit_a = get_bit(a->hash, depth);
+    arc::uint32 bit_b = get_bit(b->hash, depth);
+
+    // the hashes are the same at this level so the entries go further down
+    if(bit_a == bit_b)
+    {
+        Node* child = make_pair_node(a, b, depth + 1);
+        Node* node = nullptr;
+        try
+        {
+            node = allocate_node(0, 1);
+        }
+        catch(...)
+        {
+            // only free the nodes, the entries are still owned by the caller
+            while(child != nullptr)
+            {
+                Node* next = nullptr;
+                if(child->node_count != 0)
+                {
+                    next = child->get_children()[0].node;
+                }
+                free_node(child);
+                child = next;
+            }
+            throw;
+        }
+        node->node_map = bit_a;
+        node->get_children()[0].node = child;
+        return node;
+    }
+
+    Node* node = allocate_node(2, 0);
+    node->entry_map = bit_a | bit_b;
+    node->get_children()[bit_a < bit_b ? 0 : 1].entry = a;
+    node->get_children()[bit_a < bit_b ? 1 : 0].entry = b;
+    return node;
+}
+
+AttributeMap::Node* AttributeMap::node_insert_entry(
+        Node* node,
+        arc::uint32 bit,
+        std::size_t index,
+        Entry* entry)
+{
+    Node* ret = allocate_node(node->entry_count + 1, node->node_count);
+    ret->entry_map = node->entry_map | bit;
+    ret->node_map = node->node_map;
+
+    const Child* from = node->get_children();
+    Child* to = ret->get_children();
+    std::size_t child_count = node->entry_count + node->node_count;
+    for(std::size_t i = 0; i < index; ++i)
+    {
+        to[i] = from[i];
+    }
+    to[index].entry = entry;
+    for(std::size_t i = index; i < child_count; ++i)
+    {
+        to[i + 1] = from[i];
+    }
+
+    free_node(node);
+    return ret;
+}
+
+AttributeMap::Node* AttributeMap::node_erase_entry(
+        Node* node,
+        arc::uint32 bit,
+        std::size_t index)
+{
+    Node* ret = allocate_node(node->entry_count - 1, node->node_count);
+    ret->entry_map = node->entry_map & ~bit;
+    ret->node_map = node->node_map;
+
+    const Child* from = node->get_children();
+    Child* to = ret->get_children();
+    std::size_t child_count = node->entry_count + node->node_count;
+    for(std::size_t i = 0; i < index; ++i)
+    {
+        to[i] = from[i];
+    }
+    for(std::size_t i = index + 1; i < child_count; ++i)
+    {
+        to[i - 1] = from[i];
+    }
+
+    free_node(node);
+    return ret;
+}
+
+void AttributeMap::node_entry_to_node(
+        Node* node,
+        arc::uint32 bit,
+        Node* child)
+{
+    // the number of children doesn't change so the node is updated in place
+    Child* children = node->get_children();
+    std::size_t entry_index = get_index(node->entry_map, bit);
+    std::size_t node_index = get_index(node->node_map, bit);
+    for(std::size_t i = entry_index + 1; i < node->entry_count; ++i)
+    {
+        children[i - 1] = children[i];
+    }
+    std::size_t last = node->entry_count - 1;
+    for(std::size_t i = 0; i < node_index; ++i)
+    {
+        children[last + i] = children[last + i + 1];
+    }
+    children[last + node_index].node = child;
+
+    node->entry_map &= ~bit;
+    node->node_map |= bit;
+    --node->entry_count;
+    ++node->node_count;
+}
+
+void AttributeMap::node_node_to_entry(
+        Node* node,
+        arc::uint32 bit,
+        Entry* entry)
+{
+    // the number of children doesn't change so the node is updated in place
+    Child* children = node->get_children();
+    std::size_t entry_index = get_index(node->entry_map, bit);
+    std::size_t node_index = get_index(node->node_map, bit);
+    std::size_t first = node->entry_count;
+    for(std::size_t i = node_index; i > 0; --i)
+    {
+        children[first + i] = children[first + i - 1];
+    }
+    for(std::size_t i = first; i > entry_index; --i)
+    {
+        children[i] = children[i - 1];
+    }
+    children[entry_index].entry = entry;
+
+    node->entry_map |= bit;
+    node->node_map &= ~bit;
+    ++node->entry_count;
+    --node->node_count;
+}
+
+AttributeMap::Entry* AttributeMap::insert_entry(
+        Node*& node,
+        std::size_t depth,
+        std::size_t hash,
+        const key_type& key,
+        const mapped_type& mapped,
+        bool& inserted)
+{
+    make_unique(node);
+    Child* children = node->get_children();
+
+    // the hashes collide
+    if(depth == kMaxDepth)
+    {
+        for(std::size_t i = 0; i < node->entry_count; ++i)
+        {
+            Entry* entry = children[i].entry;
+            if(entry->hash == hash && entry->value.first == key)
+            {
+                make_unique(children[i].entry);
+                return children[i].entry;
+            }
+        }
+        Entry* entry = new Entry(hash, key, mapped);
+        try
+        {
+            node = node_insert_entry(node, 0, node->entry_count, entry);
+        }
+        catch(...)
+        {
+            delete entry;
+            throw;
+        }
+        inserted = true;
+        return entry;
+    }
+
+    arc::uint32 bit = get_bit(hash, depth);
+
+    // there is already an entry for this bit
+    if((node->entry_map & bit) != 0)
+    {
+        Entry*& existing = children[get_index(node->entry_map, bit)].entry;
+        if(existing->hash == hash && existing->value.first == key)
+        {
+            make_unique(existing);
+            return existing;
+        }
+        // both entries move to a new sub-node
+        Entry* entry = new Entry(hash, key, mapped);
+        try
+        {
+            node_entry_to_node(
+                node,
+                bit,
+                make_pair_node(existing, entry, depth + 1)
+            );
+        }
+        catch(...)
+        {
+            delete entry;
+            throw;
+        }
+        inserted = true;
+        return entry;
+    }
+
+    // insert into the sub-node
+    if((node->node_map & bit) != 0)
+    {
+        return insert_entry(
+            children[node->entry_count + get_index(node->node_map, bit)].node,
+            depth + 1,
+            hash,
+            key,
+            mapped,
+            inserted
+        );
+    }
+
+    Entry* entry = new Entry(hash, key, mapped);
+    try
+    {
+        node = node_insert_entry(
+            node,
+            bit,
+            get_index(node->entry_map, bit),
+            entry
+        );
+    }
+    catch(...)
+    {
+        delete entry;
+        throw;
+    }
+    inserted = true;
+    return entry;
+}
+
+AttributeMap::Entry* AttributeMap::erase_entry(
+        Node*& node,
+        std::size_t depth,
+        std::size_t hash,
+        const key_type& key)
+{
+    make_unique(node);
+    Child* children = node->get_children();
+
+    // the hashes collide
+    if(depth == kMaxDepth)
+    {
+        for(std::size_t i = 0; i < node->entry_count; ++i)
+        {
+            Entry* entry = children[i].entry;
+            if(entry->hash == hash && entry->value.first == key)
+            {
+                node = node_erase_entry(node, 0, i);
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+    arc::uint32 bit = get_bit(hash, depth);
+
+    if((node->entry_map & bit) != 0)
+    {
+        std::size_t index = get_index(node->entry_map, bit);
+        Entry* entry = children[index].entry;
+        if(entry->hash != hash || entry->value.first != key)
+        {
+            return nullptr;
+        }
+        node = node_erase_entry(node, bit, index);
+        return entry;
+    }
+
+    if((node->node_map & bit) != 0)
+    {
+        Node*& child =
+            children[node->entry_count + get_index(node->node_map, bit)].node;
+        Entry* entry = erase_entry(child, depth + 1, hash, key);
+        // if the sub-node only has a single entry left, pull the entry up into
+        // this node
+        if(entry != nullptr && child->node_count == 0 &&
+           child->entry_count == 1)
+        {
+            Node* single = child;
+            node_node_to_entry(node, bit, single->get_children()[0].entry);
+            free_node(single);
+        }
+        return entry;
+    }
+
+    return nullptr;
+}
+
+} // namespace omi
@@ -0,0 +1,659 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTEMAP_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_ATTRIBUTEMAP_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <arcanecore/base/Types.hpp>
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/RefCount.hpp"
+#include "omicron/api/common/attribute/Attribute.hpp"
+#include "omicron/api/common/attribute/StoragePool.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief The container used to store the entries of a MapAttribute.
+ *
+ * Most MapAttributes only have a handful of entries, so up to kInlineCapacity
+ * entries are stored inside the AttributeMap itself, ordered by the hashes of
+ * their names. Finding one of these entries is a short scan of the hashes and
+ * creating, copying, or destroying a small map makes no allocations for the
+ * container itself.
+ *
+ * Inserting an entry into a full map promotes the map to a hash array mapped
+ * trie. Each entry of a promoted map is allocated individually and each node
+ * of the trie branches on the next 5 bits of the hashes of the names, so a
+ * lookup only visits a few nodes regardless of the size of the map. Once a
+ * promoted map shrinks to kDemoteSize entries they are moved back inline.
+ *
+ * The nodes and entries of a trie are reference counted, so copying a promoted
+ * map only shares its trie with the copy. Modifying either map afterwards
+ * copies just the nodes along the path to the modified entry, which makes
+ * updating a copy of a large map logarithmic in its size rather than linear.
+ *
+ * The interface is a subset of std::unordered_map's, however iteration is
+ * read-only: entries are modified using operator[]() or find_mutable().
+ *
+ * \warning Unlike std::unordered_map, pointers and references to the entries of
+ *          an AttributeMap are invalidated when the map is promoted or
+ *          demoted, and when a map that stores its entries inline is moved.
+ *          Since promoted maps share entries with their copies, references
+ *          returned by operator[]() and find_mutable() are invalidated when
+ *          the map is copied, and other references to an entry that is shared
+ *          with a copy are invalidated when the entry is modified. Otherwise
+ *          entries never move until they are erased. Iterators are
+ *          invalidated by any insertion, erasure or modification.
+ */
+class AttributeMap
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    // an individually allocated entry of a promoted map
+    struct Entry;
+    // a node of the trie of a promoted map
+    struct Node;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                              TYPE DEFINITIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The type of the names of the entries.
+     */
+    typedef arc::str::UTF8String key_type;
+
+    /*!
+     * \brief The type of the attributes of the entries.
+     */
+    typedef Attribute mapped_type;
+
+    /*!
+     * \brief The type of the entries.
+     */
+    typedef std::pair<const key_type, mapped_type> value_type;
+
+    /*!
+     * \brief The type used for the number of entries.
+     */
+    typedef std::size_t size_type;
+
+    /*!
+     * \brief The hash function used for the names of the entries.
+     *
+     * \note This is the same function used by Symbol::get_string_hash().
+     */
+    typedef std::hash<key_type> hasher;
+
+    class const_iterator;
+
+    /*!
+     * \brief Iteration is always read-only.
+     */
+    typedef const_iterator iterator;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum number of entries that are stored inline.
+     */
+    static const std::size_t kInlineCapacity = 4;
+
+    /*!
+     * \brief The number of entries a promoted map must shrink to before its
+     *        entries are moved back inline.
+     *
+     * This is lower than kInlineCapacity so that a map which repeatedly has an
+     * entry inserted and erased at the threshold is not promoted and demoted
+     * each time.
+     */
+    static const std::size_t kDemoteSize = 2;
+
+    //--------------------------------------------------------------------------
+    //                                 ITERATOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Forward iterator over the entries of an AttributeMap.
+     *
+     * Inline entries are visited in the order of the hashes of their names,
+     * the entries of a promoted map are visited in the order of the trie.
+     */
+    class const_iterator
+    {
+    public:
+
+        //-----------------T Y P E    D E F I N I T I O N S------------------
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef AttributeMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const AttributeMap::value_type* pointer;
+        typedef const AttributeMap::value_type& reference;
+
+        //----------------------C O N S T R U C T O R-----------------------
+
+        /*!
+         * \brief Creates a new iterator which does not refer to any map.
+         */
+        const_iterator()
+            : m_map     (nullptr)
+            , m_node    (nullptr)
+            , m_position(0)
+        {
+        }
+
+        //------------------------O P E R A T O R S-------------------------
+
+        reference operator*() const
+        {
+            if(m_node == nullptr)
+            {
+                return m_map->get_inline(m_position);
+            }
+            return m_node->get_children()[m_position].entry->value;
+        }
+
+        pointer operator->() const
+        {
+            return &(**this);
+        }
+
+        const_iterator& operator++()
+        {
+            m_map->advance(m_node, m_position);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator ret(*this);
+            m_map->advance(m_node, m_position);
+            return ret;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return m_node == other.m_node && m_position == other.m_position;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return !((*this) == other);
+        }
+
+    private:
+
+        //--------------------------F R I E N D S---------------------------
+
+        friend class AttributeMap;
+
+        //-------------P R I V A T E    C O N S T R U C T O R---------------
+
+        const_iterator(
+                const AttributeMap* map,
+                const Node* node,
+                std::size_t position)
+            : m_map     (map)
+            , m_node    (node)
+            , m_position(position)
+        {
+        }
+
+        //-------------P R I V A T E    A T T R I B U T E S-----------------
+
+        // the map being iterated over
+        const AttributeMap* m_map;
+        // the node of the current entry, or null if the entry is inline or
+        // this is the end iterator
+        const Node* m_node;
+        // the position of the current entry within the node or in the inline
+        // order
+        std::size_t m_position;
+    };
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new empty map.
+     */
+    OMI_API_EXPORT AttributeMap();
+
+    /*!
+     * \brief Creates a new map containing the entries described by the given
+     *        iterators.
+     *
+     * If multiple entries have the same name, only the first is used.
+     */
+    template<typename T_InputIterator>
+    AttributeMap(const T_InputIterator& first, const T_InputIterator& last)
+        : m_size(0)
+        , m_root(nullptr)
+    {
+        try
+        {
+            for(T_InputIterator it = first; it != last; ++it)
+            {
+                insert(*it);
+            }
+        }
+        catch(...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Creates a new map containing the given entries.
+     *
+     * If multiple entries have the same name, only the first is used.
+     */
+    OMI_API_EXPORT AttributeMap(std::initializer_list<value_type> values);
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * The trie of a promoted map is shared with the copy rather than copied.
+     */
+    OMI_API_EXPORT AttributeMap(const AttributeMap& other);
+
+    /*!
+     * \brief Move constructor, this leaves the other map empty.
+     */
+    OMI_API_EXPORT AttributeMap(AttributeMap&& other);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~AttributeMap();
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Copy assignment operator.
+     */
+    OMI_API_EXPORT AttributeMap& operator=(const AttributeMap& other);
+
+    /*!
+     * \brief Move assignment operator, this leaves the other map empty.
+     */
+    OMI_API_EXPORT AttributeMap& operator=(AttributeMap&& other);
+
+    /*!
+     * \brief Returns the attribute under the given name, inserting a null
+     *        attribute under the name if there is no such entry.
+     */
+    OMI_API_EXPORT mapped_type& operator[](const key_type& key);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns an iterator to the first entry of this map.
+     */
+    OMI_API_EXPORT const_iterator begin() const;
+
+    /*!
+     * \brief Returns the iterator one-past-the-end of this map.
+     */
+    const_iterator end() const
+    {
+        return const_iterator(this, nullptr, m_size);
+    }
+
+    /*!
+     * \brief Returns the number of entries in this map.
+     */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns whether this map has no entries.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /*!
+     * \brief Returns whether this map has been promoted to a trie.
+     */
+    bool is_promoted() const
+    {
+        return m_root != nullptr;
+    }
+
+    /*!
+     * \brief Returns the number of bytes used by this map.
+     *
+     * This is the size of the map itself plus the nodes and entries allocated
+     * for the trie of a promoted map, including any that are shared with
+     * copies of the map. It does not include any memory allocated by the names
+     * or attributes of the entries.
+     */
+    OMI_API_EXPORT std::size_t get_memory_usage() const;
+
+    /*!
+     * \brief Returns an iterator to the entry with the given name, or end() if
+     *        there is no such entry.
+     */
+    OMI_API_EXPORT const_iterator find(const key_type& key) const;
+
+    /*!
+     * \brief Returns an iterator to the entry with the given name, or end() if
+     *        there is no such entry.
+     *
+     * \param hash The hash of the name, computed using hasher.
+     * \param key The name of the entry.
+     */
+    OMI_API_EXPORT const_iterator find(
+            std::size_t hash,
+            const key_type& key) const;
+
+    /*!
+     * \brief Returns the attribute under the given name so that it can be
+     *        modified, or null if there is no such entry.
+     */
+    OMI_API_EXPORT mapped_type* find_mutable(const key_type& key);
+
+    /*!
+     * \brief Returns the attribute under the given name so that it can be
+     *        modified, or null if there is no such entry.
+     *
+     * \param hash The hash of the name, computed using hasher.
+     * \param key The name of the entry.
+     */
+    OMI_API_EXPORT mapped_type* find_mutable(
+            std::size_t hash,
+            const key_type& key);
+
+    /*!
+     * \brief Returns the number of entries with the given name (0 or 1).
+     */
+    OMI_API_EXPORT std::size_t count(const key_type& key) const;
+
+    /*!
+     * \brief Inserts the given entry if there is no entry with the same name.
+     *
+     * \return An iterator to the entry with the name, and whether the given
+     *         entry was inserted.
+     */
+    OMI_API_EXPORT std::pair<const_iterator, bool> insert(
+            const value_type& value);
+
+    /*!
+     * \brief Removes the entry with the given name.
+     *
+     * \return The number of entries removed (0 or 1).
+     */
+    OMI_API_EXPORT std::size_t erase(const key_type& key);
+
+    /*!
+     * \brief Removes all entries from this map.
+     */
+    OMI_API_EXPORT void clear();
+
+    /*!
+     * \brief Swaps the entries of this map with the entries of the given map.
+     */
+    OMI_API_EXPORT void swap(AttributeMap& other);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    struct Entry
+    {
+        // the number of nodes that refer to the entry
+        RefCount ref_count;
+        // the hash of the name of the entry
+        std::size_t hash;
+        // the name and attribute of the entry
+        value_type value;
+
+        Entry(std::size_t name_hash, const value_type& entry_value)
+            : hash (name_hash)
+            , value(entry_value)
+        {
+        }
+
+        Entry(
+                std::size_t name_hash,
+                const key_type& key,
+                const mapped_type& mapped)
+            : hash (name_hash)
+            , value(key, mapped)
+        {
+        }
+
+        static void* operator new(std::size_t size)
+        {
+            return StoragePool::allocate(size);
+        }
+
+        static void operator delete(void* ptr, std::size_t size)
+        {
+            StoragePool::deallocate(ptr, size);
+        }
+    };
+
+    // a child of a node of the trie
+    union Child
+    {
+        Entry* entry;
+        Node* node;
+    };
+
+    struct Node
+    {
+        // the number of maps and nodes that refer to the node
+        RefCount ref_count;
+        // the bits of the hashes at this level that have an entry
+        arc::uint32 entry_map;
+        // the bits of the hashes at this level that have a sub-node
+        arc::uint32 node_map;
+        // the number of entries, which are the first children of the node
+        arc::uint32 entry_count;
+        // the number of sub-nodes, which follow the entries
+        arc::uint32 node_count;
+
+        // the children are allocated directly after the node
+        Child* get_children()
+        {
+            return reinterpret_cast<Child*>(this + 1);
+        }
+
+        const Child* get_children() const
+        {
+            return reinterpret_cast<const Child*>(this + 1);
+        }
+    };
+
+    // the storage of an inline entry
+    typedef std::aligned_storage<
+        sizeof(value_type),
+        std::alignment_of<value_type>::value
+    >::type InlineSlot;
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the number of entries in the map
+    std::size_t m_size;
+    // the root of the trie if the map has been promoted, otherwise null
+    Node* m_root;
+    // the hashes of the names of the inline entries in ascending order
+    std::size_t m_hashes[kInlineCapacity];
+    // the slots of the inline entries in the same order as m_hashes
+    unsigned char m_order[kInlineCapacity];
+    // the inline entries, slots are not moved when entries are inserted or
+    // erased so that the order is updated without moving the entries
+    InlineSlot m_slots[kInlineCapacity];
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the inline entry at the given position in the order
+    const value_type& get_inline(std::size_t position) const
+    {
+        return *reinterpret_cast<const value_type*>(
+            &m_slots[m_order[position]]
+        );
+    }
+
+    value_type& get_inline(std::size_t position)
+    {
+        return *reinterpret_cast<value_type*>(&m_slots[m_order[position]]);
+    }
+
+    // finds the entry with the given name, returning whether it was found
+    bool locate(
+            std::size_t hash,
+            const key_type& key,
+            const Node*& node,
+            std::size_t& position) const;
+
+    // returns the entry with the given name, inserting the given attribute
+    // under the name if there is no such entry
+    value_type& insert_value(
+            std::size_t hash,
+            const key_type& key,
+            const mapped_type& mapped,
+            bool& inserted);
+
+    // makes every node along the path to the entry at the given position of
+    // the node that locate() found for the hash unique to this map, along with
+    // the entry itself, and returns the entry
+    Entry* make_path_unique(std::size_t hash, std::size_t position);
+
+    // moves the given iterator state to the next entry
+    void advance(const Node*& node, std::size_t& position) const;
+
+    // copies the inline entries of the other map into this empty map
+    void copy_inline(const AttributeMap& other);
+
+    // moves the entries of the other map into this empty map
+    void move_from(AttributeMap& other);
+
+    // moves the inline entries of this map into a trie
+    void promote();
+
+    // moves the entries of the trie, except for the given entry, inline
+    void demote(const Entry* skip);
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the number of bytes allocated for a node with the given number
+    // of children
+    static std::size_t get_node_size(std::size_t child_count);
+
+    // allocates a node with the given number of entries and sub-nodes
+    static Node* allocate_node(
+            std::size_t entry_count,
+            std::size_t node_count);
+
+    // frees the given node without releasing its children
+    static void free_node(Node* node);
+
+    // releases a reference to the given entry, deleting it if this was the
+    // last reference
+    static void release_entry(Entry* entry);
+
+    // releases a reference to the given node, freeing it and releasing its
+    // entries and sub-nodes if this was the last reference
+    static void release_node(Node* node);
+
+    // returns the number of bytes allocated for the given node along with all
+    // of its entries and sub-nodes
+    static std::size_t get_node_memory_usage(const Node* node);
+
+    // returns a copy of the given node which shares its entries and sub-nodes
+    static Node* copy_node(const Node* node);
+
+    // replaces the given node with a copy if it is shared with other maps
+    static void make_unique(Node*& node);
+
+    // replaces the given entry with a copy if it is shared with other maps
+    static void make_unique(Entry*& entry);
+
+    // returns a node at the given depth holding the two given entries
+    static Node* make_pair_node(Entry* a, Entry* b, std::size_t depth);
+
+    // returns the given node with the entry inserted at the given index
+    static Node* node_insert_entry(
+            Node* node,
+            arc::uint32 bit,
+            std::size_t index,
+            Entry* entry);
+
+    // returns the given node without the entry at the given index
+    static Node* node_erase_entry(
+            Node* node,
+            arc::uint32 bit,
+            std::size_t index);
+
+    // replaces the entry for the given bit with the sub-node, in place
+    static void node_entry_to_node(Node* node, arc::uint32 bit, Node* child);
+
+    // replaces the sub-node for the given bit with the entry, in place
+    static void node_node_to_entry(Node* node, arc::uint32 bit, Entry* entry);
+
+    // inserts the given attribute into the trie under the given name, unless
+    // there is already an entry with the name, and returns the entry - the
+    // nodes along the path to the entry are made unique to this map
+    static Entry* insert_entry(
+            Node*& node,
+            std::size_t depth,
+            std::size_t hash,
+            const key_type& key,
+            const mapped_type& mapped,
+            bool& inserted);
+
+    // removes the entry with the given name from the trie and returns it, or
+    // returns null if there is no such entry - the nodes along the path to the
+    // entry are made unique to this map
+    static Entry* erase_entry(
+            Node*& node,
+            std::size_t depth,
+            std::size_t hash,
+            const key_type& key);
+};
+
+} // namespace omi
+
+#endif
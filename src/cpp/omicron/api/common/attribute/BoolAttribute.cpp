@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/BoolAttribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 #include <arcanecore/crypt/hash/Spooky.hpp>
@@ -106,6 +107,18 @@ OMI_API_EXPORT BoolAttribute::BoolAttribute(
 {
 }
 
+OMI_API_EXPORT BoolAttribute::BoolAttribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeBool,
+        immutable,
+        new BoolStorage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT BoolAttribute::BoolAttribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -145,7 +158,7 @@ OMI_API_EXPORT BoolAttribute::DataType BoolAttribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    BoolStorage* storage = get_storage<BoolStorage>();
+    const BoolStorage* storage = get_storage<BoolStorage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -176,7 +189,7 @@ OMI_API_EXPORT BoolAttribute::DataType BoolAttribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    BoolStorage* storage = get_storage<BoolStorage>();
+    const BoolStorage* storage = get_storage<BoolStorage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -230,10 +243,10 @@ OMI_API_EXPORT void BoolAttribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<BoolStorage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #ifndef OMCIRON_API_COMMON_ATTRIBUTE_BOOLATTRIBUTE_HPP_
 #define OMCIRON_API_COMMON_ATTRIBUTE_BOOLATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
 #include "omicron/api/common/attribute/DataAttribute.hpp"
@@ -31,8 +32,12 @@ public:
 
     /*!
      * \brief The array type that is used to hold this attribute's data.
+     *
+     * \note Unlike std::vector<bool> this stores one bool per byte, so
+     *       elements may be accessed by reference and via data(). Values
+     *       convert implicitly to and from std::vector<bool>.
      */
-    typedef std::vector<DataType> ArrayType;
+    typedef DataArray<DataType> ArrayType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -79,6 +84,20 @@ public:
         {
         }
 
+        /*!
+         * \brief Creates new BoolStorage which takes ownership of the given
+         *        data.
+         *
+         * \param data The data of this storage.
+         * \param tuple_size The tuple size of the data.
+         */
+        BoolStorage(
+                DataArray<DataType>&& data,
+                std::size_t tuple_size)
+            : TypedDataStorage<DataType>(std::move(data), tuple_size)
+        {
+        }
+
         //-------------------------D E S T R U C T O R--------------------------
 
         OMI_API_EXPORT virtual ~BoolStorage();
@@ -143,6 +162,22 @@ public:
             std::size_t tuple_size = 0,
             bool immutable = true);
 
+    /*!
+     * \brief Constructs a new BoolAttribute which takes ownership of the data
+     *        in the given array rather than copying it.
+     *
+     * If the array is a borrowed view (see omi::DataArray::borrow()) this
+     * attribute will refer to the borrowed memory until it is modified.
+     *
+     * \param values The data to move into this attribute.
+     * \param tuple_size The tuple size of this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT BoolAttribute(
+            ArrayType&& values,
+            std::size_t tuple_size = 0,
+            bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -225,8 +260,7 @@ public:
         check_state("set_values() used on an invalid attribute");
 
         prepare_modifcation();
-        get_storage<BoolStorage>()->m_data =
-            std::vector<DataType>(first, last);
+        get_storage<BoolStorage>()->m_data.assign(first, last);
     }
 
     /*!
@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/ByteAttribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 
@@ -58,6 +59,18 @@ OMI_API_EXPORT ByteAttribute::ByteAttribute(
 {
 }
 
+OMI_API_EXPORT ByteAttribute::ByteAttribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeByte,
+        immutable,
+        new ByteStorage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT ByteAttribute::ByteAttribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -97,7 +110,7 @@ OMI_API_EXPORT ByteAttribute::DataType ByteAttribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    ByteStorage* storage = get_storage<ByteStorage>();
+    const ByteStorage* storage = get_storage<ByteStorage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -128,7 +141,7 @@ OMI_API_EXPORT const ByteAttribute::DataType& ByteAttribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    ByteStorage* storage = get_storage<ByteStorage>();
+    const ByteStorage* storage = get_storage<ByteStorage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -182,10 +195,10 @@ OMI_API_EXPORT void ByteAttribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<ByteStorage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
@@ -48,14 +48,14 @@ OMI_API_EXPORT bool DataAttribute::DataStorage::is_data_pure_mutable() const
 OMI_API_EXPORT Attribute::Storage*
 DataAttribute::DataStorage::as_pure_immutable()
 {
-    ++m_ref_count;
+    m_ref_count.increment();
     return this;
 }
 
 OMI_API_EXPORT
 Attribute::Storage* DataAttribute::DataStorage::as_pure_mutable()
 {
-    ++m_ref_count;
+    m_ref_count.increment();
     return this;
 }
 
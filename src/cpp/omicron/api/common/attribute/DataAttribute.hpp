@@ -5,8 +5,10 @@
 #ifndef OMICRON_API_COMMON_ATTRIBUTE_DATAATTRIBUTE_HPP_
 #define OMICRON_API_COMMON_ATTRIBUTE_DATAATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
+#include "omicron/api/common/DataArray.hpp"
 #include "omicron/api/common/attribute/Attribute.hpp"
 
 // TODO: REMOVE ME
@@ -112,6 +114,9 @@ public:
      * This implementation should be used by classes that inherit from
      * DataAttribute.
      *
+     * The data is held in a DataArray so small arrays (e.g. single values used
+     * as counters) are stored inline within the storage object.
+     *
      * \tparam T_DataType The data type of the attribute and hence the data
      *                    type this storage will hold.
      */
@@ -125,7 +130,7 @@ public:
         /*!
          * \brief The internal data of this storage.
          */
-        std::vector<T_DataType> m_data;
+        DataArray<T_DataType> m_data;
 
         //-----------------------C O N S T R U C T O R S------------------------
 
@@ -155,6 +160,19 @@ public:
         {
         }
 
+        /*!
+         * \brief Creates new TypedDataStorage which takes ownership of the
+         *        given data.
+         *
+         * \param data The data of this storage.
+         * \param tuple_size The tuple size of the data.
+         */
+        TypedDataStorage(DataArray<T_DataType>&& data, std::size_t tuple_size)
+            : DataStorage(tuple_size)
+            , m_data     (std::move(data))
+        {
+        }
+
         //-------------------------D E S T R U C T O R--------------------------
 
         virtual ~TypedDataStorage()
@@ -250,10 +268,12 @@ public:
         {
             if(soft)
             {
-                // soft overwrite - so copy everything
+                // soft overwrite - so copy everything (via a const reference
+                // so that borrowed data isn't detached from)
+                const DataArray<T_DataType>& data = m_data;
                 return new TypedDataStorage<T_DataType>(
-                    m_data.begin(),
-                    m_data.end(),
+                    data.begin(),
+                    data.end(),
                     m_tuple_size
                 );
             }
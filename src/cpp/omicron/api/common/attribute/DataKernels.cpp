@@ -0,0 +1,700 @@
+#include "omicron/api/common/attribute/DataKernels.hpp"
+
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OMI_API_KERNELS_SSE2
+    #include <emmintrin.h>
+#endif
+
+
+namespace omi
+{
+namespace kernels
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// integer multiplication and addition are performed using unsigned integers so
+// that overflow wraps (as it does in the vector code) rather than being
+// undefined
+
+arc::int32 wrapping_mul(arc::int32 a, arc::int32 b)
+{
+    return static_cast<arc::int32>(
+        static_cast<arc::uint32>(a) * static_cast<arc::uint32>(b)
+    );
+}
+
+arc::int32 wrapping_add(arc::int32 a, arc::int32 b)
+{
+    return static_cast<arc::int32>(
+        static_cast<arc::uint32>(a) + static_cast<arc::uint32>(b)
+    );
+}
+
+// floating point to integer conversions return the minimum integer for NaN and
+// out of range values (as the SSE truncating conversions do) rather than being
+// undefined
+
+arc::int32 truncate_to_int32(float v)
+{
+    if(v >= -2147483648.0F && v < 2147483648.0F)
+    {
+        return static_cast<arc::int32>(v);
+    }
+    return std::numeric_limits<arc::int32>::min();
+}
+
+arc::int32 truncate_to_int32(double v)
+{
+    if(v > -2147483649.0 && v < 2147483648.0)
+    {
+        return static_cast<arc::int32>(v);
+    }
+    return std::numeric_limits<arc::int32>::min();
+}
+
+#ifdef OMI_API_KERNELS_SSE2
+
+// the number of elements in a vector register
+static const std::size_t kFloatLanes = 4;
+static const std::size_t kDoubleLanes = 2;
+static const std::size_t kInt32Lanes = 4;
+
+// SSE2 has no 32-bit integer multiply so this is built from two unsigned
+// 32->64-bit multiplies (the low 32-bits of the product are the same for
+// signed integers)
+inline __m128i mullo_epi32(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(
+        _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+        _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+    );
+}
+
+// SSE2 has no 32-bit integer min/max so these select using a comparison mask
+inline __m128i min_epi32(__m128i a, __m128i b)
+{
+    __m128i mask = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i max_epi32(__m128i a, __m128i b)
+{
+    __m128i mask = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+#endif
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                      FILL
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void fill(float* data, std::size_t size, float value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128 v = _mm_set1_ps(value);
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            _mm_storeu_ps(data + i, v);
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = value;
+    }
+}
+
+OMI_API_EXPORT void fill(double* data, std::size_t size, double value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128d v = _mm_set1_pd(value);
+        for(; i + kDoubleLanes <= size; i += kDoubleLanes)
+        {
+            _mm_storeu_pd(data + i, v);
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = value;
+    }
+}
+
+OMI_API_EXPORT void fill(arc::int32* data, std::size_t size, arc::int32 value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128i v = _mm_set1_epi32(value);
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), v);
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = value;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                     SCALE
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void scale(float* data, std::size_t size, float factor)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128 f = _mm_set1_ps(factor);
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), f));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] *= factor;
+    }
+}
+
+OMI_API_EXPORT void scale(double* data, std::size_t size, double factor)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128d f = _mm_set1_pd(factor);
+        for(; i + kDoubleLanes <= size; i += kDoubleLanes)
+        {
+            _mm_storeu_pd(data + i, _mm_mul_pd(_mm_loadu_pd(data + i), f));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] *= factor;
+    }
+}
+
+OMI_API_EXPORT void scale(
+        arc::int32* data,
+        std::size_t size,
+        arc::int32 factor)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128i f = _mm_set1_epi32(factor);
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i* p = reinterpret_cast<__m128i*>(data + i);
+            _mm_storeu_si128(p, mullo_epi32(_mm_loadu_si128(p), f));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = wrapping_mul(data[i], factor);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                      ADD
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void add(float* data, std::size_t size, float value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128 v = _mm_set1_ps(value);
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), v));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] += value;
+    }
+}
+
+OMI_API_EXPORT void add(double* data, std::size_t size, double value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128d v = _mm_set1_pd(value);
+        for(; i + kDoubleLanes <= size; i += kDoubleLanes)
+        {
+            _mm_storeu_pd(data + i, _mm_add_pd(_mm_loadu_pd(data + i), v));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] += value;
+    }
+}
+
+OMI_API_EXPORT void add(arc::int32* data, std::size_t size, arc::int32 value)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128i v = _mm_set1_epi32(value);
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i* p = reinterpret_cast<__m128i*>(data + i);
+            _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), v));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = wrapping_add(data[i], value);
+    }
+}
+
+OMI_API_EXPORT void add(float* data, const float* other, std::size_t size)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            _mm_storeu_ps(
+                data + i,
+                _mm_add_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(other + i))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] += other[i];
+    }
+}
+
+OMI_API_EXPORT void add(double* data, const double* other, std::size_t size)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kDoubleLanes <= size; i += kDoubleLanes)
+        {
+            _mm_storeu_pd(
+                data + i,
+                _mm_add_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(other + i))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] += other[i];
+    }
+}
+
+OMI_API_EXPORT void add(
+        arc::int32* data,
+        const arc::int32* other,
+        std::size_t size)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i* p = reinterpret_cast<__m128i*>(data + i);
+            const __m128i* o = reinterpret_cast<const __m128i*>(other + i);
+            _mm_storeu_si128(
+                p,
+                _mm_add_epi32(_mm_loadu_si128(p), _mm_loadu_si128(o))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        data[i] = wrapping_add(data[i], other[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   REDUCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT float min(const float* data, std::size_t size)
+{
+    float result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kFloatLanes)
+        {
+            __m128 m = _mm_loadu_ps(data);
+            for(i = kFloatLanes; i + kFloatLanes <= size; i += kFloatLanes)
+            {
+                m = _mm_min_ps(m, _mm_loadu_ps(data + i));
+            }
+            float lanes[kFloatLanes];
+            _mm_storeu_ps(lanes, m);
+            for(std::size_t j = 0; j < kFloatLanes; ++j)
+            {
+                result = lanes[j] < result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT double min(const double* data, std::size_t size)
+{
+    double result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kDoubleLanes)
+        {
+            __m128d m = _mm_loadu_pd(data);
+            for(i = kDoubleLanes; i + kDoubleLanes <= size; i += kDoubleLanes)
+            {
+                m = _mm_min_pd(m, _mm_loadu_pd(data + i));
+            }
+            double lanes[kDoubleLanes];
+            _mm_storeu_pd(lanes, m);
+            for(std::size_t j = 0; j < kDoubleLanes; ++j)
+            {
+                result = lanes[j] < result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT arc::int32 min(const arc::int32* data, std::size_t size)
+{
+    arc::int32 result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kInt32Lanes)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(data);
+            __m128i m = _mm_loadu_si128(p);
+            for(i = kInt32Lanes; i + kInt32Lanes <= size; i += kInt32Lanes)
+            {
+                p = reinterpret_cast<const __m128i*>(data + i);
+                m = min_epi32(m, _mm_loadu_si128(p));
+            }
+            arc::int32 lanes[kInt32Lanes];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), m);
+            for(std::size_t j = 0; j < kInt32Lanes; ++j)
+            {
+                result = lanes[j] < result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] < result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT float max(const float* data, std::size_t size)
+{
+    float result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kFloatLanes)
+        {
+            __m128 m = _mm_loadu_ps(data);
+            for(i = kFloatLanes; i + kFloatLanes <= size; i += kFloatLanes)
+            {
+                m = _mm_max_ps(m, _mm_loadu_ps(data + i));
+            }
+            float lanes[kFloatLanes];
+            _mm_storeu_ps(lanes, m);
+            for(std::size_t j = 0; j < kFloatLanes; ++j)
+            {
+                result = lanes[j] > result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT double max(const double* data, std::size_t size)
+{
+    double result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kDoubleLanes)
+        {
+            __m128d m = _mm_loadu_pd(data);
+            for(i = kDoubleLanes; i + kDoubleLanes <= size; i += kDoubleLanes)
+            {
+                m = _mm_max_pd(m, _mm_loadu_pd(data + i));
+            }
+            double lanes[kDoubleLanes];
+            _mm_storeu_pd(lanes, m);
+            for(std::size_t j = 0; j < kDoubleLanes; ++j)
+            {
+                result = lanes[j] > result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT arc::int32 max(const arc::int32* data, std::size_t size)
+{
+    arc::int32 result = data[0];
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        if(size >= kInt32Lanes)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(data);
+            __m128i m = _mm_loadu_si128(p);
+            for(i = kInt32Lanes; i + kInt32Lanes <= size; i += kInt32Lanes)
+            {
+                p = reinterpret_cast<const __m128i*>(data + i);
+                m = max_epi32(m, _mm_loadu_si128(p));
+            }
+            arc::int32 lanes[kInt32Lanes];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), m);
+            for(std::size_t j = 0; j < kInt32Lanes; ++j)
+            {
+                result = lanes[j] > result ? lanes[j] : result;
+            }
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        result = data[i] > result ? data[i] : result;
+    }
+    return result;
+}
+
+OMI_API_EXPORT float sum(const float* data, std::size_t size)
+{
+    float result = 0.0F;
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128 s = _mm_setzero_ps();
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            s = _mm_add_ps(s, _mm_loadu_ps(data + i));
+        }
+        float lanes[kFloatLanes];
+        _mm_storeu_ps(lanes, s);
+        result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    #endif
+    for(; i < size; ++i)
+    {
+        result += data[i];
+    }
+    return result;
+}
+
+OMI_API_EXPORT double sum(const double* data, std::size_t size)
+{
+    double result = 0.0;
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        __m128d s = _mm_setzero_pd();
+        for(; i + kDoubleLanes <= size; i += kDoubleLanes)
+        {
+            s = _mm_add_pd(s, _mm_loadu_pd(data + i));
+        }
+        double lanes[kDoubleLanes];
+        _mm_storeu_pd(lanes, s);
+        result = lanes[0] + lanes[1];
+    #endif
+    for(; i < size; ++i)
+    {
+        result += data[i];
+    }
+    return result;
+}
+
+OMI_API_EXPORT arc::int64 sum(const arc::int32* data, std::size_t size)
+{
+    arc::int64 result = 0;
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        // the 32-bit values are sign extended to 64-bits before accumulating
+        __m128i s = _mm_setzero_si128();
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + i)
+            );
+            __m128i sign = _mm_srai_epi32(v, 31);
+            s = _mm_add_epi64(s, _mm_unpacklo_epi32(v, sign));
+            s = _mm_add_epi64(s, _mm_unpackhi_epi32(v, sign));
+        }
+        arc::int64 lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), s);
+        result = lanes[0] + lanes[1];
+    #endif
+    for(; i < size; ++i)
+    {
+        result += data[i];
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+//                                   CONVERSION
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void convert(
+        const float* source,
+        std::size_t size,
+        double* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            __m128 v = _mm_loadu_ps(source + i);
+            _mm_storeu_pd(destination + i, _mm_cvtps_pd(v));
+            _mm_storeu_pd(
+                destination + i + 2,
+                _mm_cvtps_pd(_mm_movehl_ps(v, v))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = static_cast<double>(source[i]);
+    }
+}
+
+OMI_API_EXPORT void convert(
+        const float* source,
+        std::size_t size,
+        arc::int32* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_cvttps_epi32(_mm_loadu_ps(source + i))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = truncate_to_int32(source[i]);
+    }
+}
+
+OMI_API_EXPORT void convert(
+        const double* source,
+        std::size_t size,
+        float* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kFloatLanes <= size; i += kFloatLanes)
+        {
+            __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(source + i));
+            __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(source + i + 2));
+            _mm_storeu_ps(destination + i, _mm_movelh_ps(low, high));
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]);
+    }
+}
+
+OMI_API_EXPORT void convert(
+        const double* source,
+        std::size_t size,
+        arc::int32* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i low = _mm_cvttpd_epi32(_mm_loadu_pd(source + i));
+            __m128i high = _mm_cvttpd_epi32(_mm_loadu_pd(source + i + 2));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_unpacklo_epi64(low, high)
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = truncate_to_int32(source[i]);
+    }
+}
+
+OMI_API_EXPORT void convert(
+        const arc::int32* source,
+        std::size_t size,
+        float* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            _mm_storeu_ps(
+                destination + i,
+                _mm_cvtepi32_ps(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(source + i)
+                ))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = static_cast<float>(source[i]);
+    }
+}
+
+OMI_API_EXPORT void convert(
+        const arc::int32* source,
+        std::size_t size,
+        double* destination)
+{
+    std::size_t i = 0;
+    #ifdef OMI_API_KERNELS_SSE2
+        for(; i + kInt32Lanes <= size; i += kInt32Lanes)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(source + i)
+            );
+            _mm_storeu_pd(destination + i, _mm_cvtepi32_pd(v));
+            _mm_storeu_pd(
+                destination + i + 2,
+                _mm_cvtepi32_pd(_mm_srli_si128(v, 8))
+            );
+        }
+    #endif
+    for(; i < size; ++i)
+    {
+        destination[i] = static_cast<double>(source[i]);
+    }
+}
+
+} // namespace kernels
+} // namespace omi
@@ -0,0 +1,233 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_DATAKERNELS_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_DATAKERNELS_HPP_
+
+#include <cstddef>
+
+#include <arcanecore/base/Types.hpp>
+
+#include "omicron/api/API.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief Vectorised operations over contiguous arrays of numeric data.
+ *
+ * These are the kernels behind the bulk operations of the numeric
+ * DataAttributes (e.g. omi::FloatAttribute::scale()), they are implemented
+ * using SSE2 intrinsics where available and fall back to plain loops
+ * otherwise. None of the functions require the data to be aligned.
+ *
+ * \note The floating point reductions accumulate in multiple lanes so the
+ *       result of sum() may differ from a sequential sum in the last few bits.
+ */
+namespace kernels
+{
+
+//------------------------------------------------------------------------------
+//                                      FILL
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Sets every element of the given array to the given value.
+ */
+OMI_API_EXPORT void fill(float* data, std::size_t size, float value);
+
+/*!
+ * \copydoc fill(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void fill(double* data, std::size_t size, double value);
+
+/*!
+ * \copydoc fill(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void fill(arc::int32* data, std::size_t size, arc::int32 value);
+
+//------------------------------------------------------------------------------
+//                                     SCALE
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Multiplies every element of the given array by the given factor.
+ */
+OMI_API_EXPORT void scale(float* data, std::size_t size, float factor);
+
+/*!
+ * \copydoc scale(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void scale(double* data, std::size_t size, double factor);
+
+/*!
+ * \copydoc scale(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void scale(
+        arc::int32* data,
+        std::size_t size,
+        arc::int32 factor);
+
+//------------------------------------------------------------------------------
+//                                      ADD
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Adds the given value to every element of the given array.
+ */
+OMI_API_EXPORT void add(float* data, std::size_t size, float value);
+
+/*!
+ * \copydoc add(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void add(double* data, std::size_t size, double value);
+
+/*!
+ * \copydoc add(float*, std::size_t, float)
+ */
+OMI_API_EXPORT void add(arc::int32* data, std::size_t size, arc::int32 value);
+
+/*!
+ * \brief Adds each element of the other array to the corresponding element
+ *        of the data array.
+ *
+ * \param data The array to add to.
+ * \param other The array to add, must hold at least size elements.
+ * \param size The number of elements to add.
+ */
+OMI_API_EXPORT void add(float* data, const float* other, std::size_t size);
+
+/*!
+ * \copydoc add(float*, const float*, std::size_t)
+ */
+OMI_API_EXPORT void add(double* data, const double* other, std::size_t size);
+
+/*!
+ * \copydoc add(float*, const float*, std::size_t)
+ */
+OMI_API_EXPORT void add(
+        arc::int32* data,
+        const arc::int32* other,
+        std::size_t size);
+
+//------------------------------------------------------------------------------
+//                                   REDUCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Returns the smallest element of the given non-empty array.
+ */
+OMI_API_EXPORT float min(const float* data, std::size_t size);
+
+/*!
+ * \copydoc min(const float*, std::size_t)
+ */
+OMI_API_EXPORT double min(const double* data, std::size_t size);
+
+/*!
+ * \copydoc min(const float*, std::size_t)
+ */
+OMI_API_EXPORT arc::int32 min(const arc::int32* data, std::size_t size);
+
+/*!
+ * \brief Returns the largest element of the given non-empty array.
+ */
+OMI_API_EXPORT float max(const float* data, std::size_t size);
+
+/*!
+ * \copydoc max(const float*, std::size_t)
+ */
+OMI_API_EXPORT double max(const double* data, std::size_t size);
+
+/*!
+ * \copydoc max(const float*, std::size_t)
+ */
+OMI_API_EXPORT arc::int32 max(const arc::int32* data, std::size_t size);
+
+/*!
+ * \brief Returns the sum of the elements of the given array (0 if the array
+ *        is empty).
+ */
+OMI_API_EXPORT float sum(const float* data, std::size_t size);
+
+/*!
+ * \copydoc sum(const float*, std::size_t)
+ */
+OMI_API_EXPORT double sum(const double* data, std::size_t size);
+
+/*!
+ * \brief Returns the sum of the elements of the given array (0 if the array
+ *        is empty).
+ *
+ * The sum is accumulated using 64-bit integers so will not overflow.
+ */
+OMI_API_EXPORT arc::int64 sum(const arc::int32* data, std::size_t size);
+
+//------------------------------------------------------------------------------
+//                                   CONVERSION
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Writes each element of the source array to the destination array,
+ *        converted to the destination type.
+ *
+ * Conversions from floating point to integers truncate towards zero (as with
+ * static_cast), NaN and values outside of the destination type's range are
+ * converted to the minimum value of the destination type (matching the SSE
+ * truncating conversions).
+ *
+ * \param source The array to convert.
+ * \param size The number of elements in the source array.
+ * \param destination The array to write to, must hold at least size elements.
+ */
+OMI_API_EXPORT void convert(
+        const float* source,
+        std::size_t size,
+        double* destination);
+
+/*!
+ * \copydoc convert(const float*, std::size_t, double*)
+ */
+OMI_API_EXPORT void convert(
+        const float* source,
+        std::size_t size,
+        arc::int32* destination);
+
+/*!
+ * \copydoc convert(const float*, std::size_t, double*)
+ */
+OMI_API_EXPORT void convert(
+        const double* source,
+        std::size_t size,
+        float* destination);
+
+/*!
+ * \copydoc convert(const float*, std::size_t, double*)
+ */
+OMI_API_EXPORT void convert(
+        const double* source,
+        std::size_t size,
+        arc::int32* destination);
+
+/*!
+ * \copydoc convert(const float*, std::size_t, double*)
+ */
+OMI_API_EXPORT void convert(
+        const arc::int32* source,
+        std::size_t size,
+        float* destination);
+
+/*!
+ * \copydoc convert(const float*, std::size_t, double*)
+ */
+OMI_API_EXPORT void convert(
+        const arc::int32* source,
+        std::size_t size,
+        double* destination);
+
+} // namespace kernels
+} // namespace omi
+
+#endif
@@ -5,6 +5,7 @@
 #ifndef OMCIRON_API_COMMON_ATTRIBUTE_DOUBLEATTRIBUTE_HPP_
 #define OMCIRON_API_COMMON_ATTRIBUTE_DOUBLEATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
 #include "omicron/api/common/attribute/DataAttribute.hpp"
@@ -13,6 +14,13 @@
 namespace omi
 {
 
+//------------------------------------------------------------------------------
+//                              FORWARD DECLARATIONS
+//------------------------------------------------------------------------------
+
+class FloatAttribute;
+class Int32Attribute;
+
 /*!
  * \brief A DataAttribute that holds double precision floating point numbers.
  */
@@ -32,7 +40,7 @@ public:
     /*!
      * \brief The array type that is used to hold this attribute's data.
      */
-    typedef std::vector<DataType> ArrayType;
+    typedef DataArray<DataType> ArrayType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -107,6 +115,22 @@ public:
             std::size_t tuple_size = 0,
             bool immutable = true);
 
+    /*!
+     * \brief Constructs a new DoubleAttribute which takes ownership of the data
+     *        in the given array rather than copying it.
+     *
+     * If the array is a borrowed view (see omi::DataArray::borrow()) this
+     * attribute will refer to the borrowed memory until it is modified.
+     *
+     * \param values The data to move into this attribute.
+     * \param tuple_size The tuple size of this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT DoubleAttribute(
+            ArrayType&& values,
+            std::size_t tuple_size = 0,
+            bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -138,6 +162,26 @@ public:
      */
     OMI_API_EXPORT static arc::str::UTF8String get_type_string();
 
+    /*!
+     * \brief Returns a new DoubleAttribute holding the values of the given
+     *        attribute converted to doubles, with the same tuple size.
+     *
+     * \throw arc::ex::StateError If the given attribute is not valid.
+     */
+    OMI_API_EXPORT static DoubleAttribute convert(
+            const FloatAttribute& other,
+            bool immutable = true);
+
+    /*!
+     * \brief Returns a new DoubleAttribute holding the values of the given
+     *        attribute converted to doubles, with the same tuple size.
+     *
+     * \throw arc::ex::StateError If the given attribute is not valid.
+     */
+    OMI_API_EXPORT static DoubleAttribute convert(
+            const Int32Attribute& other,
+            bool immutable = true);
+
     //--------------------------------------------------------------------------
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
@@ -189,8 +233,7 @@ public:
         check_state("set_values() used on an invalid attribute");
 
         prepare_modifcation();
-        get_storage<DoubleStorage>()->m_data =
-            std::vector<DataType>(first, last);
+        get_storage<DoubleStorage>()->m_data.assign(first, last);
     }
 
     /*!
@@ -212,6 +255,66 @@ public:
      */
     OMI_API_EXPORT void set_at(std::size_t index, DataType value);
 
+    /*!
+     * \brief Sets every value of this attribute to the given value, the size
+     *        of this attribute is unchanged.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throw arc::ex::IllegalActionError If this attribute is immutable.
+     */
+    OMI_API_EXPORT void fill(DataType value);
+
+    /*!
+     * \brief Multiplies every value of this attribute by the given factor.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throw arc::ex::IllegalActionError If this attribute is immutable.
+     */
+    OMI_API_EXPORT void scale(DataType factor);
+
+    /*!
+     * \brief Adds the given value to every value of this attribute.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throw arc::ex::IllegalActionError If this attribute is immutable.
+     */
+    OMI_API_EXPORT void add(DataType value);
+
+    /*!
+     * \brief Adds each value of the given attribute to the value at the same
+     *        index of this attribute.
+     *
+     * \throw arc::ex::StateError If either attribute is not valid.
+     * \throw arc::ex::IllegalActionError If this attribute is immutable.
+     * \throw arc::ex::ValueError If the attributes do not have the same number
+     *                            of values.
+     */
+    OMI_API_EXPORT void add(const DoubleAttribute& other);
+
+    /*!
+     * \brief Returns the smallest value of this attribute.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throw arc::ex::IndexOutOfBoundsError If this attribute has no values.
+     */
+    OMI_API_EXPORT DataType get_min() const;
+
+    /*!
+     * \brief Returns the largest value of this attribute.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throw arc::ex::IndexOutOfBoundsError If this attribute has no values.
+     */
+    OMI_API_EXPORT DataType get_max() const;
+
+    /*!
+     * \brief Returns the sum of the values of this attribute (0 if this
+     *        attribute has no values).
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     */
+    OMI_API_EXPORT DataType get_sum() const;
+
 protected:
 
     //--------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/Int16Attribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 
@@ -58,6 +59,18 @@ OMI_API_EXPORT Int16Attribute::Int16Attribute(
 {
 }
 
+OMI_API_EXPORT Int16Attribute::Int16Attribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeInt16,
+        immutable,
+        new Int16Storage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT Int16Attribute::Int16Attribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -97,7 +110,7 @@ OMI_API_EXPORT Int16Attribute::DataType Int16Attribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    Int16Storage* storage = get_storage<Int16Storage>();
+    const Int16Storage* storage = get_storage<Int16Storage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -128,7 +141,7 @@ OMI_API_EXPORT const Int16Attribute::DataType& Int16Attribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    Int16Storage* storage = get_storage<Int16Storage>();
+    const Int16Storage* storage = get_storage<Int16Storage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -182,10 +195,10 @@ OMI_API_EXPORT void Int16Attribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<Int16Storage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
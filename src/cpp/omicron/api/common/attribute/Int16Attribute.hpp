@@ -5,6 +5,7 @@
 #ifndef OMCIRON_API_COMMON_ATTRIBUTE_INT16ATTRIBUTE_HPP_
 #define OMCIRON_API_COMMON_ATTRIBUTE_INT16ATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
 #include "omicron/api/common/attribute/DataAttribute.hpp"
@@ -32,7 +33,7 @@ public:
     /*!
      * \brief The array type that is used to hold this attribute's data.
      */
-    typedef std::vector<DataType> ArrayType;
+    typedef DataArray<DataType> ArrayType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -107,6 +108,22 @@ public:
             std::size_t tuple_size = 0,
             bool immutable = true);
 
+    /*!
+     * \brief Constructs a new Int16Attribute which takes ownership of the data
+     *        in the given array rather than copying it.
+     *
+     * If the array is a borrowed view (see omi::DataArray::borrow()) this
+     * attribute will refer to the borrowed memory until it is modified.
+     *
+     * \param values The data to move into this attribute.
+     * \param tuple_size The tuple size of this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT Int16Attribute(
+            ArrayType&& values,
+            std::size_t tuple_size = 0,
+            bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -189,8 +206,7 @@ public:
         check_state("set_values() used on an invalid attribute");
 
         prepare_modifcation();
-        get_storage<Int16Storage>()->m_data =
-            std::vector<DataType>(first, last);
+        get_storage<Int16Storage>()->m_data.assign(first, last);
     }
 
     /*!
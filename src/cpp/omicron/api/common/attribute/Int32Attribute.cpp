@@ -1,9 +1,14 @@
 #include "omicron/api/common/attribute/Int32Attribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 
+#include "omicron/api/common/attribute/DataKernels.hpp"
+#include "omicron/api/common/attribute/FloatAttribute.hpp"
+#include "omicron/api/common/attribute/DoubleAttribute.hpp"
+
 
 namespace omi
 {
@@ -58,6 +63,18 @@ OMI_API_EXPORT Int32Attribute::Int32Attribute(
 {
 }
 
+OMI_API_EXPORT Int32Attribute::Int32Attribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeInt32,
+        immutable,
+        new Int32Storage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT Int32Attribute::Int32Attribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -87,6 +104,40 @@ OMI_API_EXPORT arc::str::UTF8String Int32Attribute::get_type_string()
     return "Int32Attribute";
 }
 
+OMI_API_EXPORT Int32Attribute Int32Attribute::convert(
+        const FloatAttribute& other,
+        bool immutable)
+{
+    const FloatAttribute::ArrayType& source = other.get_values();
+
+    ArrayType values;
+    values.resize(source.size());
+    kernels::convert(source.data(), source.size(), values.mutable_data());
+
+    return Int32Attribute(
+        std::move(values),
+        other.get_tuple_size(),
+        immutable
+    );
+}
+
+OMI_API_EXPORT Int32Attribute Int32Attribute::convert(
+        const DoubleAttribute& other,
+        bool immutable)
+{
+    const DoubleAttribute::ArrayType& source = other.get_values();
+
+    ArrayType values;
+    values.resize(source.size());
+    kernels::convert(source.data(), source.size(), values.mutable_data());
+
+    return Int32Attribute(
+        std::move(values),
+        other.get_tuple_size(),
+        immutable
+    );
+}
+
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
@@ -97,7 +148,7 @@ OMI_API_EXPORT Int32Attribute::DataType Int32Attribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    Int32Storage* storage = get_storage<Int32Storage>();
+    const Int32Storage* storage = get_storage<Int32Storage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -128,7 +179,7 @@ OMI_API_EXPORT const Int32Attribute::DataType& Int32Attribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    Int32Storage* storage = get_storage<Int32Storage>();
+    const Int32Storage* storage = get_storage<Int32Storage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -182,10 +233,121 @@ OMI_API_EXPORT void Int32Attribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
+    prepare_modifcation(true);
+
+    get_storage<Int32Storage>()->m_data.set(index, value);
+}
+
+OMI_API_EXPORT void Int32Attribute::fill(DataType value)
+{
+    // valid?
+    check_state("fill() used on an invalid attribute");
+
+    // the current values will be overwritten so there's no need to copy them
+    std::size_t size = get_storage<Int32Storage>()->m_data.size();
+    prepare_modifcation();
+
+    ArrayType& data = get_storage<Int32Storage>()->m_data;
+    data.resize(size);
+    kernels::fill(data.mutable_data(), size, value);
+}
+
+OMI_API_EXPORT void Int32Attribute::scale(DataType factor)
+{
+    // valid?
+    check_state("scale() used on an invalid attribute");
+
+    // soft modification - this may replace the storage
+    prepare_modifcation(true);
+
+    ArrayType& data = get_storage<Int32Storage>()->m_data;
+    kernels::scale(data.mutable_data(), data.size(), factor);
+}
+
+OMI_API_EXPORT void Int32Attribute::add(DataType value)
+{
+    // valid?
+    check_state("add() used on an invalid attribute");
+
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    ArrayType& data = get_storage<Int32Storage>()->m_data;
+    kernels::add(data.mutable_data(), data.size(), value);
+}
+
+OMI_API_EXPORT void Int32Attribute::add(const Int32Attribute& other)
+{
+    // valid?
+    check_state("add() used on an invalid attribute");
+    const ArrayType& values = other.get_values();
+
+    // check sizes
+    if(values.size() != get_storage<Int32Storage>()->m_data.size())
+    {
+        arc::str::UTF8String error_message;
+        error_message
+            << "Cannot add attribute with " << values.size() << " values to "
+            << "attribute with " << get_storage<Int32Storage>()->m_data.size()
+            << " values.";
+        throw arc::ex::ValueError(error_message);
+    }
+
+    // soft modification - this may replace the storage
+    prepare_modifcation(true);
+
+    // get the destination first since this may detach from borrowed data that
+    // is shared with the other attribute
+    DataType* data = get_storage<Int32Storage>()->m_data.mutable_data();
+    kernels::add(data, values.data(), values.size());
+}
+
+OMI_API_EXPORT Int32Attribute::DataType Int32Attribute::get_min() const
+{
+    // valid?
+    check_state("get_min() used on an invalid attribute");
+
+    // get the storage
+    const Int32Storage* storage = get_storage<Int32Storage>();
+
+    // non-empty?
+    if(storage->m_data.empty())
+    {
+        throw arc::ex::IndexOutOfBoundsError(
+            "Failed to get minimum value of empty Int32Attribute"
+        );
+    }
+
+    return kernels::min(storage->m_data.data(), storage->m_data.size());
+}
+
+OMI_API_EXPORT Int32Attribute::DataType Int32Attribute::get_max() const
+{
+    // valid?
+    check_state("get_max() used on an invalid attribute");
+
+    // get the storage
+    const Int32Storage* storage = get_storage<Int32Storage>();
+
+    // non-empty?
+    if(storage->m_data.empty())
+    {
+        throw arc::ex::IndexOutOfBoundsError(
+            "Failed to get maximum value of empty Int32Attribute"
+        );
+    }
+
+    return kernels::max(storage->m_data.data(), storage->m_data.size());
+}
+
+OMI_API_EXPORT arc::int64 Int32Attribute::get_sum() const
+{
+    // valid?
+    check_state("get_sum() used on an invalid attribute");
+
+    const ArrayType& data = get_storage<Int32Storage>()->m_data;
+    return kernels::sum(data.data(), data.size());
 }
 
 //------------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/Int64Attribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 
@@ -58,6 +59,18 @@ OMI_API_EXPORT Int64Attribute::Int64Attribute(
 {
 }
 
+OMI_API_EXPORT Int64Attribute::Int64Attribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeInt64,
+        immutable,
+        new Int64Storage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT Int64Attribute::Int64Attribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -97,7 +110,7 @@ OMI_API_EXPORT Int64Attribute::DataType Int64Attribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    Int64Storage* storage = get_storage<Int64Storage>();
+    const Int64Storage* storage = get_storage<Int64Storage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -128,7 +141,7 @@ OMI_API_EXPORT const Int64Attribute::DataType& Int64Attribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    Int64Storage* storage = get_storage<Int64Storage>();
+    const Int64Storage* storage = get_storage<Int64Storage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -182,10 +195,10 @@ OMI_API_EXPORT void Int64Attribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<Int64Storage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
@@ -1,8 +1,6 @@
 #include "omicron/api/common/attribute/MapAttribute.hpp"
 
-#include <cassert>
 #include <cstring>
-#include <unordered_set>
 
 #include <arcanecore/base/Exceptions.hpp>
 #include <arcanecore/crypt/hash/Spooky.hpp>
@@ -11,6 +9,44 @@
 namespace omi
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// returns the contribution an entry with the given name and hash makes to the
+// hash of a map
+Hash hash_entry(const arc::str::UTF8String& name, const Hash& hash)
+{
+    Hash ret;
+    arc::crypt::hash::spooky_128(
+        static_cast<const void*>(name.get_raw()),
+        name.get_byte_length(),
+        ret.part1,
+        ret.part2,
+        ret.part1,
+        ret.part2
+    );
+    arc::crypt::hash::spooky_128(
+        static_cast<const void*>(&hash),
+        sizeof(hash),
+        ret.part1,
+        ret.part2,
+        ret.part1,
+        ret.part2
+    );
+    // (0, 0) is reserved for entries that need recomputing
+    if(ret.part1 == 0 && ret.part2 == 0)
+    {
+        ret.part1 = 1;
+    }
+    return ret;
+}
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                               STATIC ATTRIBUTES
 //------------------------------------------------------------------------------
@@ -24,6 +60,28 @@ OMI_API_EXPORT Attribute::Type MapAttribute::kTypeMap = 2;
 //----------------------------C O N S T U C T O R S-----------------------------
 
 OMI_API_EXPORT MapAttribute::MapStorage::MapStorage()
+    : Attribute::Storage(true)
+    , m_structure_dirty (true)
+{
+}
+
+OMI_API_EXPORT MapAttribute::MapStorage::MapStorage(DataType&& data)
+    : Attribute::Storage(true)
+    , m_data            (std::move(data))
+    , m_structure_dirty (true)
+{
+    for(const auto& entry : m_data)
+    {
+        link_entry(entry.second);
+    }
+}
+
+OMI_API_EXPORT MapAttribute::MapStorage::MapStorage(
+        DataType&& data,
+        MapStorage* shares_entries_with)
+    : Attribute::Storage(true, shares_entries_with)
+    , m_data            (std::move(data))
+    , m_structure_dirty (true)
 {
 }
 
@@ -110,7 +168,7 @@ Attribute::Storage* MapAttribute::MapStorage::as_pure_immutable()
     // is the data already pure immutable?
     if(is_data_pure_immutable())
     {
-        ++m_ref_count;
+        m_ref_count.increment();
         return this;
     }
 
@@ -145,41 +203,41 @@ Attribute::Storage* MapAttribute::MapStorage::as_pure_mutable()
 OMI_API_EXPORT Hash MapAttribute::MapStorage::get_hash(
         arc::uint64 seed) const
 {
-    // iterate the sub hashes to make sure none have gone out of date
-    bool out_of_date = false;
-    for(auto child : m_data)
+    // the entries only need to be checked if one of them may have been
+    // modified since the hash was computed
+    bool entries_modified = clear_entries_modified();
+    if(!entries_modified &&
+       !m_structure_dirty &&
+       (m_cached_hash.part1 != 0 || m_cached_hash.part2 != 0))
     {
-        // get the child attribute's hash
-        Hash attr_hash = child.second.get_hash();
-        // out of date?
-        auto f_sub_hash = m_sub_hashes.find(child.first);
-        if(f_sub_hash == m_sub_hashes.end() ||
-           f_sub_hash->second != attr_hash     )
-        {
-            m_sub_hashes[child.first] = attr_hash;
-            out_of_date = true;
-        }
+        return m_cached_hash;
     }
-    if(out_of_date)
+
+    // rebuild the contributions of every entry?
+    if(m_structure_dirty)
     {
-        m_cached_hash.part1 = 0;
-        m_cached_hash.part2 = 0;
+        m_sub_hashes.assign(m_data.size(), EntryHash());
+        m_hash_sum = Hash();
+        m_structure_dirty = false;
+        m_cached_hash = Hash();
     }
 
-    // find any entries in the hash map that are no longer needed and remove
-    // them
-    std::unordered_set<arc::str::UTF8String> remove_set;
-    for(auto entry : m_sub_hashes)
+    // only recompute the contributions of the entries whose hashes have
+    // changed, entries which haven't been modified return their cached hash
+    // without visiting their own entries
+    auto entry_hash = m_sub_hashes.begin();
+    for(const auto& entry : m_data)
     {
-        auto f_attr = m_data.find(entry.first);
-        if(f_attr == m_data.end())
+        Hash hash = entry.second.get_hash();
+        if(entry_hash->contribution == Hash() || entry_hash->hash != hash)
         {
-            remove_set.insert(entry.first);
+            m_hash_sum -= entry_hash->contribution;
+            entry_hash->hash = hash;
+            entry_hash->contribution = hash_entry(entry.first, hash);
+            m_hash_sum += entry_hash->contribution;
+            m_cached_hash = Hash();
         }
-    }
-    for(const arc::str::UTF8String& r : remove_set)
-    {
-        m_sub_hashes.erase(m_sub_hashes.find(r));
+        ++entry_hash;
     }
 
     // hash needs recomputing?
@@ -189,42 +247,34 @@ OMI_API_EXPORT Hash MapAttribute::MapStorage::get_hash(
         m_cached_hash.part1 = seed;
         m_cached_hash.part2 = seed;
 
-        // is there actually anything to hash?
-        if(!m_data.empty())
-        {
-            assert(m_sub_hashes.size() == m_data.size());
-
-            // compute the hash
-            for(auto sub_hash : m_sub_hashes)
-            {
-                arc::crypt::hash::spooky_128(
-                    static_cast<const void*>(&sub_hash.second),
-                    sizeof(sub_hash.second),
-                    m_cached_hash.part1,
-                    m_cached_hash.part2,
-                    m_cached_hash.part1,
-                    m_cached_hash.part2
-                );
-            }
-        }
+        // the sum is independent of the order the entries are stored in
+        arc::crypt::hash::spooky_128(
+            static_cast<const void*>(&m_hash_sum),
+            sizeof(m_hash_sum),
+            m_cached_hash.part1,
+            m_cached_hash.part2,
+            m_cached_hash.part1,
+            m_cached_hash.part2
+        );
     }
     return m_cached_hash;
 }
 
 OMI_API_EXPORT void MapAttribute::MapStorage::invalidate_hash()
 {
-    m_cached_hash.part1 = 0;
-    m_cached_hash.part2 = 0;
+    m_cached_hash = Hash();
     m_sub_hashes.clear();
+    m_structure_dirty = true;
 }
 
 OMI_API_EXPORT Attribute::Storage* MapAttribute::MapStorage::copy_for_overwrite(
         bool soft)
 {
-    // soft overwrite - so copy everything
+    // soft overwrite - so copy everything, this only copies the references to
+    // the entries
     if(soft)
     {
-        return new MapStorage(m_data.begin(), m_data.end());
+        return new MapStorage(DataType(m_data), this);
     }
 
     return new MapStorage();
@@ -265,6 +315,82 @@ OMI_API_EXPORT void MapAttribute::MapStorage::string_repr(
     }
 }
 
+OMI_API_EXPORT const Attribute* MapAttribute::MapStorage::find(
+        const Symbol& name) const
+{
+    auto f_entry = m_data.find(name.get_string_hash(), name.get_string());
+    if(f_entry == m_data.end())
+    {
+        return nullptr;
+    }
+    return &f_entry->second;
+}
+
+OMI_API_EXPORT Attribute* MapAttribute::MapStorage::find_mutable(
+        const Symbol& name)
+{
+    return m_data.find_mutable(name.get_string_hash(), name.get_string());
+}
+
+//------------------------------------------------------------------------------
+//                                    BUILDER
+//------------------------------------------------------------------------------
+
+//---------------------------C O N S T R U C T O R S----------------------------
+
+OMI_API_EXPORT MapAttribute::Builder::Builder()
+{
+}
+
+OMI_API_EXPORT MapAttribute::Builder::Builder(const MapAttribute& map)
+    : m_data(map.get_values())
+{
+}
+
+//-----------------------------D E S T R U C T O R------------------------------
+
+OMI_API_EXPORT MapAttribute::Builder::~Builder()
+{
+}
+
+//---------------P U B L I C    M E M B E R    F U N C T I O N S----------------
+
+OMI_API_EXPORT std::size_t MapAttribute::Builder::get_size() const
+{
+    return m_data.size();
+}
+
+OMI_API_EXPORT bool MapAttribute::Builder::has(
+        const arc::str::UTF8String& name) const
+{
+    return m_data.count(name) != 0;
+}
+
+OMI_API_EXPORT MapAttribute::Builder& MapAttribute::Builder::insert(
+        const arc::str::UTF8String& name,
+        const Attribute& attribute)
+{
+    m_data[name] = attribute;
+    return *this;
+}
+
+OMI_API_EXPORT MapAttribute::Builder& MapAttribute::Builder::erase(
+        const arc::str::UTF8String& name)
+{
+    if(m_data.erase(name) == 0)
+    {
+        throw arc::ex::KeyError(
+            "No entry in MapAttribute::Builder under name \"" + name + "\""
+        );
+    }
+    return *this;
+}
+
+OMI_API_EXPORT MapAttribute MapAttribute::Builder::build(bool immutable)
+{
+    return MapAttribute(std::move(m_data), immutable);
+}
+
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTORS
 //------------------------------------------------------------------------------
@@ -275,7 +401,12 @@ OMI_API_EXPORT MapAttribute::MapAttribute(bool immutable)
 }
 
 OMI_API_EXPORT MapAttribute::MapAttribute(const DataType& data, bool immutable)
-    : Attribute(kTypeMap, immutable, new MapStorage(data.begin(), data.end()))
+    : Attribute(kTypeMap, immutable, new MapStorage(DataType(data)))
+{
+}
+
+OMI_API_EXPORT MapAttribute::MapAttribute(DataType&& data, bool immutable)
+    : Attribute(kTypeMap, immutable, new MapStorage(std::move(data)))
 {
 }
 
@@ -291,6 +422,15 @@ OMI_API_EXPORT MapAttribute::MapAttribute(const MapAttribute& other)
     assign(other);
 }
 
+//------------------------------------------------------------------------------
+//                              PRIVATE CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT MapAttribute::MapAttribute(MapStorage* storage, bool immutable)
+    : Attribute(kTypeMap, immutable, storage)
+{
+}
+
 //------------------------------------------------------------------------------
 //                                   DESTRUCTOR
 //------------------------------------------------------------------------------
@@ -315,6 +455,17 @@ OMI_API_EXPORT Attribute& MapAttribute::operator[](
     return get(name);
 }
 
+OMI_API_EXPORT const Attribute& MapAttribute::operator[](
+        const SymbolPath& path) const
+{
+    return get(path);
+}
+
+OMI_API_EXPORT Attribute& MapAttribute::operator[](const SymbolPath& path)
+{
+    return get(path);
+}
+
 //------------------------------------------------------------------------------
 //                            PUBLIC MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
@@ -400,6 +551,14 @@ OMI_API_EXPORT bool MapAttribute::has(const arc::str::UTF8String& name) const
     }
 }
 
+OMI_API_EXPORT bool MapAttribute::has(const SymbolPath& path) const
+{
+    // valid?
+    check_state("has() used on an invalid attribute");
+
+    return find_path(path, false, false) != nullptr;
+}
+
 OMI_API_EXPORT const Attribute& MapAttribute::get(
         const arc::str::UTF8String& name) const
 {
@@ -453,14 +612,14 @@ OMI_API_EXPORT Attribute& MapAttribute::get(const arc::str::UTF8String& name)
     std::size_t delimiter = name.find_first(".");
     if(delimiter == arc::str::npos)
     {
-        auto f_data = data.find(name);
-        if(f_data == data.end())
+        Attribute* f_data = data.find_mutable(name);
+        if(f_data == nullptr)
         {
             throw arc::ex::KeyError(
                 "No entry in MapAttribute under name \"" + name + "\""
             );
         }
-        return f_data->second;
+        return *f_data;
     }
     else
     {
@@ -485,20 +644,39 @@ OMI_API_EXPORT Attribute& MapAttribute::get(const arc::str::UTF8String& name)
     }
 }
 
+OMI_API_EXPORT const Attribute& MapAttribute::get(const SymbolPath& path) const
+{
+    // valid?
+    check_state("get() used on an invalid attribute");
+
+    return *find_path(path, true, false);
+}
+
+OMI_API_EXPORT Attribute& MapAttribute::get(const SymbolPath& path)
+{
+    // valid?
+    check_state("get() used on an invalid attribute");
+
+    return *find_path(path, true, true);
+}
+
 OMI_API_EXPORT void MapAttribute::insert(
         const arc::str::UTF8String& name,
         const Attribute& attrribute)
 {
     // valid?
     check_state("insert() used on an invalid attribute");
-    prepare_modifcation();
+    // soft since the existing entries are kept
+    prepare_modifcation(true);
 
-    DataType& data = get_storage<MapStorage>()->m_data;
+    MapStorage* storage = get_storage<MapStorage>();
+    DataType& data = storage->m_data;
     // nested?
     std::size_t delimiter = name.find_first(".");
     if(delimiter == arc::str::npos)
     {
-        get_storage<MapStorage>()->m_data[name] = attrribute;
+        storage->link_entry(attrribute);
+        data[name] = attrribute;
     }
     else
     {
@@ -537,14 +715,12 @@ OMI_API_EXPORT void MapAttribute::erase(const arc::str::UTF8String& name)
     std::size_t delimiter = name.find_first(".");
     if(delimiter == arc::str::npos)
     {
-        auto f_data = data.find(name);
-        if(f_data == data.end())
+        if(data.erase(name) == 0)
         {
             throw arc::ex::KeyError(
                 "No entry in MapAttribute under name \"" + name + "\""
             );
         }
-        data.erase(f_data);
     }
     else
     {
@@ -569,12 +745,130 @@ OMI_API_EXPORT void MapAttribute::erase(const arc::str::UTF8String& name)
     }
 }
 
+OMI_API_EXPORT MapAttribute MapAttribute::copy_with(
+        const arc::str::UTF8String& name,
+        const Attribute& attribute) const
+{
+    // valid?
+    check_state("copy_with() used on an invalid attribute");
+
+    MapStorage* storage = get_storage<MapStorage>();
+    // the entry of this map that is replaced in the new map
+    arc::str::UTF8String entry_name = name;
+    Attribute entry;
+    // nested?
+    std::size_t delimiter = name.find_first(".");
+    if(delimiter == arc::str::npos)
+    {
+        entry = attribute;
+    }
+    else
+    {
+        entry_name = name.substring(0, delimiter);
+        auto f_data = storage->m_data.find(entry_name);
+        if(f_data == storage->m_data.end())
+        {
+            throw arc::ex::KeyError(
+                "No entry in MapAttribute under name \"" + entry_name + "\""
+            );
+        }
+        omi::MapAttribute sub = f_data->second;
+        if(!sub.is_valid())
+        {
+            throw arc::ex::KeyError(
+                "No nested MapAttribute in MapAttribute under name \"" +
+                entry_name + "\""
+            );
+        }
+        entry = sub.copy_with(
+            name.substring(delimiter + 1, name.get_length()),
+            attribute
+        );
+    }
+
+    // this only copies the references to the entries, and the new map shares
+    // the links of the entries with this map
+    MapAttribute ret(
+        new MapStorage(DataType(storage->m_data), storage),
+        is_immutable()
+    );
+    MapStorage* ret_storage = ret.get_storage<MapStorage>();
+    ret_storage->link_entry(entry);
+    // the entry is replaced rather than assigned to, since assigning would
+    // mark every map sharing the old entry as modified
+    ret_storage->m_data.erase(entry_name);
+    ret_storage->m_data.insert(std::make_pair(entry_name, entry));
+    return ret;
+}
+
+OMI_API_EXPORT MapAttribute MapAttribute::copy_without(
+        const arc::str::UTF8String& name) const
+{
+    // valid?
+    check_state("copy_without() used on an invalid attribute");
+
+    MapStorage* storage = get_storage<MapStorage>();
+    // nested?
+    std::size_t delimiter = name.find_first(".");
+    if(delimiter == arc::str::npos)
+    {
+        // this only copies the references to the entries, and the new map
+        // shares the links of the entries with this map
+        DataType data(storage->m_data);
+        if(data.erase(name) == 0)
+        {
+            throw arc::ex::KeyError(
+                "No entry in MapAttribute under name \"" + name + "\""
+            );
+        }
+        return MapAttribute(
+            new MapStorage(std::move(data), storage),
+            is_immutable()
+        );
+    }
+
+    arc::str::UTF8String entry_name = name.substring(0, delimiter);
+    auto f_data = storage->m_data.find(entry_name);
+    if(f_data == storage->m_data.end())
+    {
+        throw arc::ex::KeyError(
+            "No entry in MapAttribute under name \"" + entry_name + "\""
+        );
+    }
+    omi::MapAttribute sub = f_data->second;
+    if(!sub.is_valid())
+    {
+        throw arc::ex::KeyError(
+            "No nested MapAttribute in MapAttribute under name \"" +
+            entry_name + "\""
+        );
+    }
+    MapAttribute entry =
+        sub.copy_without(name.substring(delimiter + 1, name.get_length()));
+
+    MapAttribute ret(
+        new MapStorage(DataType(storage->m_data), storage),
+        is_immutable()
+    );
+    MapStorage* ret_storage = ret.get_storage<MapStorage>();
+    ret_storage->link_entry(entry);
+    // replaced rather than assigned to, as in copy_with()
+    ret_storage->m_data.erase(entry_name);
+    ret_storage->m_data.insert(std::make_pair(entry_name, entry));
+    return ret;
+}
+
 OMI_API_EXPORT void MapAttribute::set_values(const DataType& data)
 {
     // valid?
     check_state("set_values() used on an invalid attribute");
     prepare_modifcation();
-    get_storage<MapStorage>()->m_data = DataType(data.begin(), data.end());
+    MapStorage* storage = get_storage<MapStorage>();
+    for(const auto& entry : data)
+    {
+        storage->link_entry(entry.second);
+    }
+    storage->m_data = data;
 }
 
 OMI_API_EXPORT void MapAttribute::clear()
@@ -594,4 +888,59 @@ OMI_API_EXPORT bool MapAttribute::check_type(Type type) const
     return type == kTypeMap;
 }
 
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT Attribute* MapAttribute::find_path(
+        const SymbolPath& path,
+        bool throw_missing,
+        bool modifiable) const
+{
+    // walk down the storages directly so that no new references are made
+    const std::vector<Symbol>& symbols = path.get_symbols();
+    MapStorage* storage = get_storage<MapStorage>();
+    for(std::size_t i = 0; i < symbols.size(); ++i)
+    {
+        const Attribute* entry = storage->find(symbols[i]);
+        if(entry == nullptr)
+        {
+            if(throw_missing)
+            {
+                throw arc::ex::KeyError(
+                    "No entry in MapAttribute under name \"" +
+                    symbols[i].get_string() + "\""
+                );
+            }
+            return nullptr;
+        }
+        // last level?
+        if(i == symbols.size() - 1)
+        {
+            // only the last entry is modified, so only it needs to be made
+            // unique to its map
+            if(modifiable)
+            {
+                return storage->find_mutable(symbols[i]);
+            }
+            // the entry is returned as const by the callers that don't
+            // modify it
+            return const_cast<Attribute*>(entry);
+        }
+        if(entry->get_type() != kTypeMap)
+        {
+            if(throw_missing)
+            {
+                throw arc::ex::KeyError(
+                    "No nested MapAttribute in MapAttribute under name \"" +
+                    symbols[i].get_string() + "\""
+                );
+            }
+            return nullptr;
+        }
+        storage = Attribute::get_storage<MapStorage>(*entry);
+    }
+    return nullptr;
+}
+
 } // namespace omi
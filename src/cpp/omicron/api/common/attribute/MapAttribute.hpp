@@ -5,9 +5,12 @@
 #ifndef OMICRON_API_COMMON_ATTRIBUTE_MAPATTRIBUTE_HPP_
 #define OMICRON_API_COMMON_ATTRIBUTE_MAPATTRIBUTE_HPP_
 
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "omicron/api/common/attribute/Attribute.hpp"
+#include "omicron/api/common/attribute/AttributeMap.hpp"
+#include "omicron/api/common/attribute/Symbol.hpp"
 
 
 namespace omi
@@ -26,6 +29,10 @@ namespace omi
  * ```"group"``` and that this MapAttribute has an attribute under the name
  * ```"attr1"```.
  *
+ * Names that are looked up repeatedly should be converted to an
+ * omi::SymbolPath once and then used with the SymbolPath overloads, which do
+ * not hash or allocate any strings.
+ *
  * \note Immutable MapAttributes only guarantee that that structure of the map
  *       is immutable. If a map has mutable child attributes they can still be
  *       modified. In order to have a pure immutable MapAttribute, itself and
@@ -41,8 +48,11 @@ public:
 
     /*!
      * \brief The type used to store MapAttribute's data.
+     *
+     * \note See AttributeMap for when references to the entries are
+     *       invalidated.
      */
-    typedef std::unordered_map<arc::str::UTF8String, Attribute> DataType;
+    typedef AttributeMap DataType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -64,6 +74,25 @@ public:
     {
     public:
 
+        //-------------------------S T R U C T U R E S--------------------------
+
+        /*!
+         * \brief The hash contribution of a single entry of the map.
+         */
+        struct EntryHash
+        {
+            /*!
+             * \brief The hash of the entry's attribute when the contribution
+             *        was computed.
+             */
+            Hash hash;
+            /*!
+             * \brief The hash contribution of the entry, or (0, 0) if it has
+             *        not been computed.
+             */
+            Hash contribution;
+        };
+
         //------------------P U B L I C    A T T R I B U T E S------------------
 
         /*!
@@ -77,10 +106,26 @@ public:
          */
         mutable Hash m_cached_hash;
         /*!
-         * \brief The last checked hashes of the sub-attributes, these are
-         *        checked to see if the hash is out of date.
+         * \brief The hash contribution of each entry of the map, in the
+         *        iteration order of m_data.
+         *
+         * The hash of the map is the sum of these contributions. The entries
+         * are only revisited when m_entries_modified is set, in which case the
+         * current hash of each entry is compared against the one its
+         * contribution was computed from, so only the contributions of
+         * entries which have since been modified or reassigned are recomputed.
+         */
+        mutable std::vector<EntryHash> m_sub_hashes;
+        /*!
+         * \brief The sum of the contributions in m_sub_hashes.
+         */
+        mutable Hash m_hash_sum;
+        /*!
+         * \brief Whether the structure of the map has changed since the hash
+         *        was last computed, meaning the contributions of every entry
+         *        need to be rebuilt.
          */
-        mutable std::unordered_map<arc::str::UTF8String, Hash> m_sub_hashes;
+        mutable bool m_structure_dirty;
 
         //-----------------------C O N S T R U C T O R S------------------------
 
@@ -95,11 +140,35 @@ public:
          */
         template<typename T_InputIterator>
         MapStorage(const T_InputIterator& first, const T_InputIterator& last)
-            : Attribute::Storage()
+            : Attribute::Storage(true)
             , m_data            (first, last)
+            , m_structure_dirty (true)
         {
+            for(const auto& entry : m_data)
+            {
+                link_entry(entry.second);
+            }
         }
 
+        /*!
+         * \brief Creates new MapStorage which takes ownership of the given
+         *        data.
+         */
+        OMI_API_EXPORT MapStorage(DataType&& data);
+
+        /*!
+         * \brief Creates new MapStorage which takes ownership of the given
+         *        data, which shares all but a few of its entries with the
+         *        given storage.
+         *
+         * The entries are not linked to the new storage individually, entries
+         * which aren't shared with the given storage need to be passed to
+         * link_entry().
+         */
+        OMI_API_EXPORT MapStorage(
+                DataType&& data,
+                MapStorage* shares_entries_with);
+
         //-------------------------D E S T R U C T O R--------------------------
 
         OMI_API_EXPORT virtual ~MapStorage();
@@ -128,6 +197,120 @@ public:
         OMI_API_EXPORT virtual void string_repr(
                 std::size_t indentation,
                 arc::str::UTF8String& s) const override;
+
+        /*!
+         * \brief Returns the entry with the given name, or null if there is no
+         *        such entry.
+         */
+        OMI_API_EXPORT const Attribute* find(const Symbol& name) const;
+
+        /*!
+         * \brief Returns the entry with the given name so that it can be
+         *        modified, or null if there is no such entry.
+         *
+         * \note The entry may be shared with copies of the map data, in which
+         *       case it is copied first.
+         */
+        OMI_API_EXPORT Attribute* find_mutable(const Symbol& name);
+    };
+
+    //--------------------------------------------------------------------------
+    //                                  BUILDER
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Accumulates the entries of a new MapAttribute.
+     *
+     * Every insert() on a MapAttribute checks whether the storage needs to be
+     * copied and invalidates the hash of the map.
+     * A Builder holds its entries in a plain DataType instead, which is moved
+     * into the storage of a new MapAttribute by build() in a single step.
+     *
+     * Example usage:
+     *
+     * \code
+     * omi::MapAttribute::Builder builder;
+     * builder.insert("name", omi::StringAttribute("mesh"));
+     * builder.insert("scale", omi::FloatAttribute(2.0F));
+     * omi::MapAttribute map = builder.build();
+     * \endcode
+     *
+     * \note Builders do not support nested naming syntax, names are used as is.
+     */
+    class Builder
+    {
+    public:
+
+        //-----------------------C O N S T R U C T O R S------------------------
+
+        /*!
+         * \brief Creates a new Builder with no entries.
+         */
+        OMI_API_EXPORT Builder();
+
+        /*!
+         * \brief Creates a new Builder which starts with the entries of the
+         *        given map.
+         *
+         * The entries are shared with the given map rather than copied.
+         *
+         * \throw arc::ex::StateError If the given map is not valid.
+         */
+        OMI_API_EXPORT Builder(const MapAttribute& map);
+
+        //-------------------------D E S T R U C T O R--------------------------
+
+        OMI_API_EXPORT ~Builder();
+
+        //-----------P U B L I C    M E M B E R    F U N C T I O N S------------
+
+        /*!
+         * \brief Returns the number of entries in this Builder.
+         */
+        OMI_API_EXPORT std::size_t get_size() const;
+
+        /*!
+         * \brief Returns whether this Builder has an entry under the given
+         *        name.
+         */
+        OMI_API_EXPORT bool has(const arc::str::UTF8String& name) const;
+
+        /*!
+         * \brief Inserts the given attribute under the provided name.
+         *
+         * \note If an attribute already exists under the name, it will be
+         *       overridden.
+         *
+         * \return This Builder so that calls can be chained.
+         */
+        OMI_API_EXPORT Builder& insert(
+                const arc::str::UTF8String& name,
+                const Attribute& attribute);
+
+        /*!
+         * \brief Removes the attribute with the given name from this Builder.
+         *
+         * \return This Builder so that calls can be chained.
+         *
+         * \throws arc::ex::KeyError If there is no attribute under the given
+         *                           name in this Builder.
+         */
+        OMI_API_EXPORT Builder& erase(const arc::str::UTF8String& name);
+
+        /*!
+         * \brief Returns a new MapAttribute which takes the entries of this
+         *        Builder, leaving the Builder empty.
+         *
+         * \param immutable Whether the new attribute is immutable or not.
+         */
+        OMI_API_EXPORT MapAttribute build(bool immutable = true);
+
+    private:
+
+        //------------------P R I V A T E    A T T R I B U T E S----------------
+
+        // the accumulated entries
+        DataType m_data;
     };
 
     //--------------------------------------------------------------------------
@@ -167,6 +350,15 @@ public:
      */
     OMI_API_EXPORT MapAttribute(const DataType& data, bool immutable = true);
 
+    /*!
+     * \brief Constructs a new MapAttribute which takes ownership of the given
+     *        data, leaving it empty.
+     *
+     * \param data The data to move into this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT MapAttribute(DataType&& data, bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -216,6 +408,24 @@ public:
      */
     OMI_API_EXPORT Attribute& operator[](const arc::str::UTF8String& name);
 
+    /*!
+     * \brief Returns the attribute in this MapAttribute at the given path.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is not attribute at the given path in
+     *                           this MapAttribute.
+     */
+    OMI_API_EXPORT const Attribute& operator[](const SymbolPath& path) const;
+
+    /*!
+     * \brief Returns the attribute in this MapAttribute at the given path.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is not attribute at the given path in
+     *                           this MapAttribute.
+     */
+    OMI_API_EXPORT Attribute& operator[](const SymbolPath& path);
+
     //--------------------------------------------------------------------------
     //                          PUBLIC MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
@@ -268,6 +478,13 @@ public:
      */
     OMI_API_EXPORT bool has(const arc::str::UTF8String& name) const;
 
+    /*!
+     * \brief Returns whether there is an entry in the map at the given path.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     */
+    OMI_API_EXPORT bool has(const SymbolPath& path) const;
+
     /*!
      * \brief Returns the attribute in this MapAttribute under the given name.
      *
@@ -290,6 +507,24 @@ public:
      */
     OMI_API_EXPORT Attribute& get(const arc::str::UTF8String& name);
 
+    /*!
+     * \brief Returns the attribute in this MapAttribute at the given path.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is not attribute at the given path in
+     *                           this MapAttribute.
+     */
+    OMI_API_EXPORT const Attribute& get(const SymbolPath& path) const;
+
+    /*!
+     * \brief Returns the attribute in this MapAttribute at the given path.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is not attribute at the given path in
+     *                           this MapAttribute.
+     */
+    OMI_API_EXPORT Attribute& get(const SymbolPath& path);
+
     /*!
      * \brief Inserts the given attribute into the map under the provided name.
      *
@@ -317,6 +552,45 @@ public:
      */
     OMI_API_EXPORT void erase(const arc::str::UTF8String& name);
 
+    /*!
+     * \brief Returns a copy of this MapAttribute, with the same immutability,
+     *        where the given attribute is under the provided name.
+     *
+     * This map is not modified. The new map shares the entries of this map
+     * and only copies the nodes of the AttributeMap along the path to the
+     * updated entry, so this is logarithmic in the number of entries.
+     *
+     * \note If an attribute already exists under the name, it will be
+     *       overridden in the new map.
+     *
+     * \note Supports nested naming syntax, in which case each nested map along
+     *       the name is replaced in the same way.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is no nested MapAttribute under the
+     *                           name.
+     */
+    OMI_API_EXPORT MapAttribute copy_with(
+            const arc::str::UTF8String& name,
+            const Attribute& attribute) const;
+
+    /*!
+     * \brief Returns a copy of this MapAttribute, with the same immutability,
+     *        without the entry with the given name.
+     *
+     * Like copy_with() this map is not modified and the new map shares all but
+     * the path to the removed entry with this map.
+     *
+     * \note Supports nested naming syntax, in which case each nested map along
+     *       the name is replaced in the same way.
+     *
+     * \throw arc::ex::StateError If this attribute is not valid.
+     * \throws arc::ex::KeyError If there is not attribute under the given name
+     *                           in this MapAttribute.
+     */
+    OMI_API_EXPORT MapAttribute copy_without(
+            const arc::str::UTF8String& name) const;
+
     /*!
      * \brief Replaces the current data of this MapAttribute with the given
      *        data.
@@ -360,6 +634,27 @@ protected:
     //--------------------------------------------------------------------------
 
     OMI_API_EXPORT virtual bool check_type(Type type) const override;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    // Creates a new MapAttribute which takes ownership of the given storage
+    OMI_API_EXPORT MapAttribute(MapStorage* storage, bool immutable);
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // Returns the attribute at the given path, if there is no attribute at the
+    // path this either throws a KeyError or returns null. If the attribute is
+    // to be modified the entries along the path are made unique to their maps
+    OMI_API_EXPORT Attribute* find_path(
+            const SymbolPath& path,
+            bool throw_missing,
+            bool modifiable) const;
 };
 
 } // namespace omi
@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/PathAttribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 #include <arcanecore/crypt/hash/Spooky.hpp>
@@ -109,6 +110,18 @@ OMI_API_EXPORT PathAttribute::PathAttribute(
 {
 }
 
+OMI_API_EXPORT PathAttribute::PathAttribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypePath,
+        immutable,
+        new PathStorage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT PathAttribute::PathAttribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -148,7 +161,7 @@ OMI_API_EXPORT PathAttribute::DataType PathAttribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    PathStorage* storage = get_storage<PathStorage>();
+    const PathStorage* storage = get_storage<PathStorage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -179,7 +192,7 @@ OMI_API_EXPORT const PathAttribute::DataType& PathAttribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    PathStorage* storage = get_storage<PathStorage>();
+    const PathStorage* storage = get_storage<PathStorage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -233,10 +246,10 @@ OMI_API_EXPORT void PathAttribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<PathStorage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #ifndef OMCIRON_API_COMMON_ATTRIBUTE_PATHATTRIBUTE_HPP_
 #define OMCIRON_API_COMMON_ATTRIBUTE_PATHATTRIBUTE_HPP_
 
+#include <utility>
 #include <vector>
 
 #include <arcanecore/io/sys/Path.hpp>
@@ -34,7 +35,7 @@ public:
     /*!
      * \brief The array type that is used to hold this attribute's data.
      */
-    typedef std::vector<DataType> ArrayType;
+    typedef DataArray<DataType> ArrayType;
 
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC ATTRIBUTES
@@ -85,6 +86,20 @@ public:
         {
         }
 
+        /*!
+         * \brief Creates new PathStorage which takes ownership of the given
+         *        data.
+         *
+         * \param data The data of this storage.
+         * \param tuple_size The tuple size of the data.
+         */
+        PathStorage(
+                DataArray<DataType>&& data,
+                std::size_t tuple_size)
+            : TypedDataStorage<DataType>(std::move(data), tuple_size)
+        {
+        }
+
         //-------------------------D E S T R U C T O R--------------------------
 
         OMI_API_EXPORT virtual ~PathStorage();
@@ -149,6 +164,22 @@ public:
             std::size_t tuple_size = 0,
             bool immutable = true);
 
+    /*!
+     * \brief Constructs a new PathAttribute which takes ownership of the data
+     *        in the given array rather than copying it.
+     *
+     * If the array is a borrowed view (see omi::DataArray::borrow()) this
+     * attribute will refer to the borrowed memory until it is modified.
+     *
+     * \param values The data to move into this attribute.
+     * \param tuple_size The tuple size of this attribute.
+     * \param immutable Whether this attribute is immutable or not.
+     */
+    OMI_API_EXPORT PathAttribute(
+            ArrayType&& values,
+            std::size_t tuple_size = 0,
+            bool immutable = true);
+
     /*!
      * \brief Constructs a new reference count of the given Attribute.
      *
@@ -231,8 +262,7 @@ public:
         check_state("set_values() used on an invalid attribute");
 
         prepare_modifcation();
-        get_storage<PathStorage>()->m_data =
-            std::vector<DataType>(first, last);
+        get_storage<PathStorage>()->m_data.assign(first, last);
     }
 
     /*!
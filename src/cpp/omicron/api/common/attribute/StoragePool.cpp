@@ -0,0 +1,212 @@
+#include "omicron/api/common/attribute/StoragePool.hpp"
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+
+namespace omi
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the number of size classes served by the pool
+static const std::size_t kSizeClassCount =
+    StoragePool::kMaxBlockSize / StoragePool::kGranularity;
+
+// a block in a free list
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+// the number of times a SpinLock will spin before yielding the thread
+static const std::size_t kSpinsBeforeYield = 64;
+
+// lock used to guard the pool's free lists, the critical sections are only a
+// few instructions so spinning is cheaper than a mutex
+class SpinLock
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    SpinLock()
+    {
+        m_flag.clear();
+    }
+
+    void lock()
+    {
+        std::size_t spins = 0;
+        while(m_flag.test_and_set(std::memory_order_acquire))
+        {
+            // back off if the lock is contended for longer than expected
+            if(++spins >= kSpinsBeforeYield)
+            {
+                std::this_thread::yield();
+                spins = 0;
+            }
+        }
+    }
+
+    void unlock()
+    {
+        m_flag.clear(std::memory_order_release);
+    }
+
+private:
+
+    std::atomic_flag m_flag;
+};
+
+// locks the given SpinLock for the lifetime of this object
+class ScopedSpinLock
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    ScopedSpinLock(SpinLock& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+
+    ~ScopedSpinLock()
+    {
+        m_lock.unlock();
+    }
+
+private:
+
+    SpinLock& m_lock;
+};
+
+// the free list of a single size class
+struct SizeClass
+{
+    SpinLock lock;
+    FreeBlock* head;
+
+    SizeClass()
+        : head(nullptr)
+    {
+    }
+};
+
+// rounds the given size up to the size of the block it will be served with
+std::size_t get_block_size(std::size_t size)
+{
+    if(size == 0)
+    {
+        return StoragePool::kGranularity;
+    }
+    return
+        ((size + StoragePool::kGranularity - 1) / StoragePool::kGranularity) *
+        StoragePool::kGranularity;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                               PRIVATE STRUCTURES
+//------------------------------------------------------------------------------
+
+struct StoragePool::State
+{
+    // the free lists of each size class
+    SizeClass size_classes[kSizeClassCount];
+};
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void* StoragePool::allocate(std::size_t size)
+{
+    // too large to be pooled?
+    if(size > kMaxBlockSize)
+    {
+        return ::operator new(size);
+    }
+    std::size_t block_size = get_block_size(size);
+
+    SizeClass& size_class =
+        get_state().size_classes[(block_size / kGranularity) - 1];
+
+    // take a block from the free list
+    {
+        ScopedSpinLock lock(size_class.lock);
+        if(size_class.head != nullptr)
+        {
+            FreeBlock* block = size_class.head;
+            size_class.head = block->next;
+            return block;
+        }
+    }
+
+    // the free list is empty so allocate a new slab, the first block is
+    // returned and the rest are added to the free list
+    char* slab =
+        static_cast<char*>(::operator new(block_size * kBlocksPerSlab));
+    FreeBlock* first = reinterpret_cast<FreeBlock*>(slab + block_size);
+    FreeBlock* last = first;
+    for(std::size_t i = 2; i < kBlocksPerSlab; ++i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * block_size);
+        last->next = block;
+        last = block;
+    }
+
+    ScopedSpinLock lock(size_class.lock);
+    last->next = size_class.head;
+    size_class.head = first;
+
+    return slab;
+}
+
+OMI_API_EXPORT void StoragePool::deallocate(void* ptr, std::size_t size)
+{
+    if(ptr == nullptr)
+    {
+        return;
+    }
+
+    // not pooled?
+    if(size > kMaxBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // return to the free list
+    SizeClass& size_class =
+        get_state().size_classes[(get_block_size(size) / kGranularity) - 1];
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    ScopedSpinLock lock(size_class.lock);
+    block->next = size_class.head;
+    size_class.head = block;
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+StoragePool::State& StoragePool::get_state()
+{
+    // this is intentionally never deleted since attributes may be destroyed
+    // during static deinitialisation
+    static State* state = new State();
+    return *state;
+}
+
+} // namespace omi
@@ -0,0 +1,97 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_STORAGEPOOL_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_STORAGEPOOL_HPP_
+
+#include <cstddef>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+
+#include "omicron/api/API.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief Pooled memory allocator used for the internal objects of Attributes
+ *        (i.e. storages and definitions).
+ *
+ * Allocations are grouped into size classes of kGranularity bytes up to
+ * kMaxBlockSize bytes, each of which has its own free list that is refilled a
+ * slab of kBlocksPerSlab blocks at a time. Memory returned to the pool is
+ * reused by later allocations of the same size class but is never returned to
+ * the system. Allocations larger than kMaxBlockSize fall through to the global
+ * allocator.
+ *
+ * \note The pool is thread-safe.
+ */
+class StoragePool
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE STRUCTURES
+    //--------------------------------------------------------------------------
+
+    // the global state of the pool
+    struct State;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The size difference in bytes between each size class.
+     */
+    static const std::size_t kGranularity = 16;
+
+    /*!
+     * \brief The largest allocation size that will be served by the pool.
+     */
+    static const std::size_t kMaxBlockSize = 256;
+
+    /*!
+     * \brief The number of blocks that are allocated at once when a size
+     *        class runs out of free blocks.
+     */
+    static const std::size_t kBlocksPerSlab = 64;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Allocates uninitialised memory of the given size.
+     */
+    OMI_API_EXPORT static void* allocate(std::size_t size);
+
+    /*!
+     * \brief Deallocates memory that was allocated by allocate().
+     *
+     * \param ptr The memory to deallocate.
+     * \param size The size of the memory, this must match the size that was
+     *             passed to allocate().
+     */
+    OMI_API_EXPORT static void deallocate(void* ptr, std::size_t size);
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                           PRIVATE STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // returns the global state of the pool
+    static State& get_state();
+};
+
+} // namespace omi
+
+#endif
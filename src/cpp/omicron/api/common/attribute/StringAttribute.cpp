@@ -1,6 +1,7 @@
 #include "omicron/api/common/attribute/StringAttribute.hpp"
 
 #include <typeinfo>
+#include <utility>
 
 #include <arcanecore/base/Exceptions.hpp>
 #include <arcanecore/crypt/hash/Spooky.hpp>
@@ -105,6 +106,18 @@ OMI_API_EXPORT StringAttribute::StringAttribute(
 {
 }
 
+OMI_API_EXPORT StringAttribute::StringAttribute(
+        ArrayType&& values,
+        std::size_t tuple_size,
+        bool immutable)
+    : DataAttribute(
+        kTypeString,
+        immutable,
+        new StringStorage(std::move(values), tuple_size)
+    )
+{
+}
+
 OMI_API_EXPORT StringAttribute::StringAttribute(const Attribute& other)
     : DataAttribute(nullptr)
 {
@@ -144,7 +157,7 @@ OMI_API_EXPORT StringAttribute::DataType StringAttribute::get_value() const
     check_state("get_value() used on an invalid attribute");
 
     // get the storage
-    StringStorage* storage = get_storage<StringStorage>();
+    const StringStorage* storage = get_storage<StringStorage>();
 
     // non-empty?
     if(storage->m_data.empty())
@@ -175,7 +188,7 @@ OMI_API_EXPORT const StringAttribute::DataType& StringAttribute::at(
     check_state("at() used on an invalid attribute");
 
     // get the storage
-    StringStorage* storage = get_storage<StringStorage>();
+    const StringStorage* storage = get_storage<StringStorage>();
 
     // check bounds
     if(index >= storage->m_data.size())
@@ -229,10 +242,10 @@ OMI_API_EXPORT void StringAttribute::set_at(
         throw arc::ex::IndexOutOfBoundsError(error_message);
     }
 
-    // soft modification
+    // soft modification - this may replace the storage
     prepare_modifcation(true);
 
-    storage->m_data[index] = value;
+    get_storage<StringStorage>()->m_data.set(index, value);
 }
 
 //------------------------------------------------------------------------------
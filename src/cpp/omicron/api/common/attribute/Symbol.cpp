@@ -0,0 +1,136 @@
+#include "omicron/api/common/attribute/Symbol.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace omi
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the global table of interned strings
+struct SymbolTable
+{
+    // guards the table
+    std::mutex mutex;
+    // the interned strings in id order - a deque is used so that the strings
+    // never move
+    std::deque<arc::str::UTF8String> strings;
+    // maps strings to their ids
+    std::unordered_map<arc::str::UTF8String, Symbol::Id> ids;
+    // the empty string, which is always id 0 - this is never modified after
+    // construction so can be read without locking the table
+    const arc::str::UTF8String* empty;
+    // the hash of the empty string
+    std::size_t empty_hash;
+
+    SymbolTable()
+    {
+        strings.push_back("");
+        ids[strings.back()] = 0;
+        empty = &strings.back();
+        empty_hash = std::hash<arc::str::UTF8String>()(*empty);
+    }
+};
+
+// returns the global table - this is a function static so that symbols can be
+// safely constructed during static initialisation
+SymbolTable& get_table()
+{
+    static SymbolTable table;
+    return table;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                     SYMBOL
+//------------------------------------------------------------------------------
+
+//---------------------------C O N S T R U C T O R S----------------------------
+
+OMI_API_EXPORT Symbol::Symbol()
+    : m_id         (0)
+    , m_string     (get_table().empty)
+    , m_string_hash(get_table().empty_hash)
+{
+}
+
+OMI_API_EXPORT Symbol::Symbol(const arc::str::UTF8String& str)
+    : m_string_hash(std::hash<arc::str::UTF8String>()(str))
+{
+    SymbolTable& table = get_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto f_id = table.ids.find(str);
+    if(f_id != table.ids.end())
+    {
+        m_id = f_id->second;
+        m_string = &table.strings[m_id];
+        return;
+    }
+
+    // intern the new string
+    m_id = static_cast<Id>(table.strings.size());
+    table.strings.push_back(str);
+    m_string = &table.strings.back();
+    table.ids[str] = m_id;
+}
+
+//---------------P U B L I C    S T A T I C    F U N C T I O N S----------------
+
+OMI_API_EXPORT std::size_t Symbol::get_count()
+{
+    SymbolTable& table = get_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.strings.size();
+}
+
+//------------------------------------------------------------------------------
+//                                  SYMBOL PATH
+//------------------------------------------------------------------------------
+
+//---------------------------C O N S T R U C T O R S----------------------------
+
+OMI_API_EXPORT SymbolPath::SymbolPath(const arc::str::UTF8String& name)
+{
+    arc::str::UTF8String remaining = name;
+    std::size_t delimiter = remaining.find_first(".");
+    while(delimiter != arc::str::npos)
+    {
+        m_symbols.push_back(Symbol(remaining.substring(0, delimiter)));
+        remaining = remaining.substring(delimiter + 1, remaining.get_length());
+        delimiter = remaining.find_first(".");
+    }
+    m_symbols.push_back(Symbol(remaining));
+}
+
+OMI_API_EXPORT SymbolPath::SymbolPath(const Symbol& symbol)
+    : m_symbols(1, symbol)
+{
+}
+
+//---------------P U B L I C    M E M B E R    F U N C T I O N S----------------
+
+OMI_API_EXPORT arc::str::UTF8String SymbolPath::get_name() const
+{
+    arc::str::UTF8String name;
+    for(std::size_t i = 0; i < m_symbols.size(); ++i)
+    {
+        if(i > 0)
+        {
+            name << ".";
+        }
+        name << m_symbols[i].get_string();
+    }
+    return name;
+}
+
+} // namespace omi
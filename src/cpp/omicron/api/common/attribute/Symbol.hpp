@@ -0,0 +1,225 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_COMMON_ATTRIBUTE_SYMBOL_HPP_
+#define OMICRON_API_COMMON_ATTRIBUTE_SYMBOL_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <arcanecore/base/Types.hpp>
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include "omicron/api/API.hpp"
+
+
+namespace omi
+{
+
+/*!
+ * \brief An interned string.
+ *
+ * Each unique string is stored once in a global table for the lifetime of the
+ * program and is identified by a small integer id, which means symbols can be
+ * copied, compared, and hashed without touching the string data. Symbols are
+ * used to look up the entries of MapAttributes without hashing or allocating
+ * strings (see omi::SymbolPath).
+ *
+ * Constructing a Symbol from a string requires a lookup in the global table so
+ * symbols that are used repeatedly should be constructed once and reused, for
+ * example:
+ *
+ * \code
+ * static const omi::Symbol kPositions("positions");
+ * \endcode
+ *
+ * \note Interning strings is thread-safe.
+ */
+class Symbol
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                              TYPE DEFINITIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The integral type used to identify symbols.
+     */
+    typedef arc::uint32 Id;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates the symbol of the empty string.
+     */
+    OMI_API_EXPORT Symbol();
+
+    /*!
+     * \brief Creates the symbol of the given string, adding the string to the
+     *        global table if it hasn't been interned before.
+     */
+    OMI_API_EXPORT explicit Symbol(const arc::str::UTF8String& str);
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Equality operator.
+     */
+    bool operator==(const Symbol& other) const
+    {
+        return m_id == other.m_id;
+    }
+
+    /*!
+     * \brief Inequality operator.
+     */
+    bool operator!=(const Symbol& other) const
+    {
+        return m_id != other.m_id;
+    }
+
+    /*!
+     * \brief Less than operator.
+     *
+     * \note Symbols are ordered by their ids, not their strings.
+     */
+    bool operator<(const Symbol& other) const
+    {
+        return m_id < other.m_id;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the unique id of this symbol.
+     */
+    Id get_id() const
+    {
+        return m_id;
+    }
+
+    /*!
+     * \brief Returns the string of this symbol.
+     */
+    const arc::str::UTF8String& get_string() const
+    {
+        return *m_string;
+    }
+
+    /*!
+     * \brief Returns the std::hash of the string of this symbol.
+     *
+     * This is computed once when the symbol is created.
+     */
+    std::size_t get_string_hash() const
+    {
+        return m_string_hash;
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of strings that have been interned.
+     */
+    OMI_API_EXPORT static std::size_t get_count();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the id of the symbol
+    Id m_id;
+    // the string of the symbol in the global table
+    const arc::str::UTF8String* m_string;
+    // the hash of the symbol's string
+    std::size_t m_string_hash;
+};
+
+/*!
+ * \brief A name of an entry in a hierarchy of MapAttributes that has been split
+ *        and interned ahead of time.
+ *
+ * This is the fast equivalent of using a nested name such as
+ * ```"group.attr1"``` with MapAttribute::get(), the name is split on ```.```
+ * once when the path is constructed, and then looking up the path performs no
+ * string hashing or allocation. Paths should be constructed once and reused.
+ */
+class SymbolPath
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new path from the given nested name.
+     */
+    OMI_API_EXPORT explicit SymbolPath(const arc::str::UTF8String& name);
+
+    /*!
+     * \brief Creates a new path of a single entry.
+     */
+    OMI_API_EXPORT explicit SymbolPath(const Symbol& symbol);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the symbols of each level of this path.
+     */
+    const std::vector<Symbol>& get_symbols() const
+    {
+        return m_symbols;
+    }
+
+    /*!
+     * \brief Returns the nested name this path was created from.
+     */
+    OMI_API_EXPORT arc::str::UTF8String get_name() const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the symbols of each level of the path
+    std::vector<Symbol> m_symbols;
+};
+
+} // namespace omi
+
+//------------------------------------------------------------------------------
+//                                      HASH
+//------------------------------------------------------------------------------
+
+namespace std
+{
+
+template<>
+struct hash<omi::Symbol>
+{
+    std::size_t operator()(const omi::Symbol& symbol) const
+    {
+        return static_cast<std::size_t>(symbol.get_id());
+    }
+};
+
+} // namespace std
+
+#endif
@@ -1,5 +1,10 @@
 #include "omicron/api/context/Event.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
+#include <arcanecore/base/Exceptions.hpp>
+
 
 namespace omi
 {
@@ -56,6 +61,94 @@ OMI_API_EXPORT const arc::str::UTF8String Event::kDataWindowPosition =
 OMI_API_EXPORT const arc::str::UTF8String Event::kTypeEngineShutdown =
     "engine_shutdown";
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the data names as pre-split paths so that they can be looked up quickly,
+// these must be defined after the names themselves
+static const omi::SymbolPath g_data_modifiers(Event::kDataModifiers);
+static const omi::SymbolPath g_data_mouse_position(Event::kDataMousePosition);
+static const omi::SymbolPath g_data_mouse_button(Event::kDataMouseButton);
+static const omi::SymbolPath g_data_mouse_scroll_amount_x(
+    Event::kDataMouseScrollAmountX
+);
+static const omi::SymbolPath g_data_mouse_scroll_amount_y(
+    Event::kDataMouseScrollAmountY
+);
+static const omi::SymbolPath g_data_key_code(Event::kDataKeyCode);
+static const omi::SymbolPath g_data_window_size(Event::kDataWindowSize);
+static const omi::SymbolPath g_data_window_position(Event::kDataWindowPosition);
+
+// the names of the built-in event types, indexed by their ids
+static const arc::str::UTF8String* const g_builtin_types[] =
+{
+    &Event::kTypeMouseMove,
+    &Event::kTypeMouseButtonPress,
+    &Event::kTypeMouseButtonRelease,
+    &Event::kTypeMouseScroll,
+    &Event::kTypeMouseEnter,
+    &Event::kTypeMouseExit,
+    &Event::kTypeKeyPress,
+    &Event::kTypeKeyRelease,
+    &Event::kTypeWindowResize,
+    &Event::kTypeWindowMove,
+    &Event::kTypeEngineShutdown
+};
+static_assert(
+    sizeof(g_builtin_types) / sizeof(g_builtin_types[0]) ==
+        Event::kBuiltinTypeCount,
+    "Every built-in event type must have a name"
+);
+
+// Assigns ids to event types, built-in types are registered up front so their
+// ids are their BuiltinTypeId.
+class TypeRegistry
+{
+public:
+
+    TypeRegistry()
+    {
+        for(Event::TypeId i = 0; i < Event::kBuiltinTypeCount; ++i)
+        {
+            m_ids.insert(std::make_pair(*g_builtin_types[i], i));
+        }
+    }
+
+    // returns the registered name of the given type and its id
+    const std::pair<const arc::str::UTF8String, Event::TypeId>& get(
+            const arc::str::UTF8String& type)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto f_id = m_ids.find(type);
+        if(f_id == m_ids.end())
+        {
+            Event::TypeId id = static_cast<Event::TypeId>(m_ids.size());
+            f_id = m_ids.insert(std::make_pair(type, id)).first;
+        }
+        return *f_id;
+    }
+
+private:
+
+    // the ids of the registered types, the names are never removed so
+    // references to them remain valid
+    std::unordered_map<arc::str::UTF8String, Event::TypeId> m_ids;
+    std::mutex m_mutex;
+};
+
+// returns the registry of event types
+TypeRegistry& get_type_registry()
+{
+    static TypeRegistry registry;
+    return registry;
+}
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                  CONSTRUCTORS
 //------------------------------------------------------------------------------
@@ -63,22 +156,55 @@ OMI_API_EXPORT const arc::str::UTF8String Event::kTypeEngineShutdown =
 OMI_API_EXPORT Event::Event(
         const arc::str::UTF8String& type,
         const omi::MapAttribute& data)
-    : m_type(type)
-    , m_data(data.as_immutable())
+    : m_type_id    (0)
+    , m_type       (nullptr)
+    , m_has_payload(false)
+    , m_payload    ()
+    , m_data       (data.as_immutable())
+    , m_data_built (true)
 {
+    const std::pair<const arc::str::UTF8String, TypeId>& registered =
+        get_type_registry().get(type);
+    m_type_id = registered.second;
+    m_type = &registered.first;
+}
+
+OMI_API_EXPORT Event::Event(TypeId type_id, const Payload& payload)
+    : m_type_id    (type_id)
+    , m_type       (nullptr)
+    , m_has_payload(true)
+    , m_payload    (payload)
+    , m_data_built (false)
+{
+    if(type_id >= kBuiltinTypeCount)
+    {
+        arc::str::UTF8String error_message;
+        error_message
+            << "Only events of built-in types can have fixed-layout data, not "
+            << "events with type id: " << type_id;
+        throw arc::ex::ValueError(error_message);
+    }
+    m_type = g_builtin_types[type_id];
 }
 
 OMI_API_EXPORT Event::Event(const Event& other)
-    : m_type(other.m_type)
-    , m_data(other.m_data)
+    : m_type_id    (other.m_type_id)
+    , m_type       (other.m_type)
+    , m_has_payload(other.m_has_payload)
+    , m_payload    (other.m_payload)
+    , m_data       (other.m_data)
+    , m_data_built (other.m_data_built)
 {
 }
 
 OMI_API_EXPORT Event::Event(Event&& other)
-    : m_type(other.m_type)
-    , m_data(other.m_data)
+    : m_type_id    (other.m_type_id)
+    , m_type       (other.m_type)
+    , m_has_payload(other.m_has_payload)
+    , m_payload    (other.m_payload)
+    , m_data       (other.m_data)
+    , m_data_built (other.m_data_built)
 {
-    other.m_type = "";
     other.m_data = omi::MapAttribute();
 }
 
@@ -96,18 +222,25 @@ OMI_API_EXPORT Event::~Event()
 
 OMI_API_EXPORT Event& Event::operator=(const Event& other)
 {
+    m_type_id = other.m_type_id;
     m_type = other.m_type;
+    m_has_payload = other.m_has_payload;
+    m_payload = other.m_payload;
     m_data = other.m_data;
+    m_data_built = other.m_data_built;
 
     return *this;
 }
 
 OMI_API_EXPORT Event& Event::operator=(Event&& other)
 {
+    m_type_id = other.m_type_id;
     m_type = other.m_type;
+    m_has_payload = other.m_has_payload;
+    m_payload = other.m_payload;
     m_data = other.m_data;
+    m_data_built = other.m_data_built;
 
-    other.m_type = "";
     other.m_data = omi::MapAttribute();
 
     return *this;
@@ -115,7 +248,18 @@ OMI_API_EXPORT Event& Event::operator=(Event&& other)
 
 OMI_API_EXPORT bool Event::operator==(const Event& other) const
 {
-    return m_type == other.m_type && m_data == other.m_data;
+    if(m_type_id != other.m_type_id)
+    {
+        return false;
+    }
+    if(m_has_payload && other.m_has_payload)
+    {
+        return m_payload.x == other.m_payload.x &&
+               m_payload.y == other.m_payload.y &&
+               m_payload.code == other.m_payload.code &&
+               m_payload.modifiers == other.m_payload.modifiers;
+    }
+    return get_data() == other.get_data();
 }
 
 OMI_API_EXPORT bool Event::operator!=(const Event& other) const
@@ -127,18 +271,31 @@ OMI_API_EXPORT bool Event::operator!=(const Event& other) const
 //                            PUBLIC STATIC FUNCTIONS
 //------------------------------------------------------------------------------
 
+OMI_API_EXPORT Event::TypeId Event::get_type_id(
+        const arc::str::UTF8String& type)
+{
+    return get_type_registry().get(type).second;
+}
+
 OMI_API_EXPORT bool Event::mouse_move(
         const omi::context::Event& event,
         arc::int32& position_x,
         arc::int32& position_y)
 {
-    if(event.get_type() != kTypeMouseMove)
+    if(event.get_type_id() != kTypeIdMouseMove)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        position_x = event.get_payload().x;
+        position_y = event.get_payload().y;
+        return true;
+    }
+
     // get the position
-    omi::Int32Attribute position_attr = event.get_data()[kDataMousePosition];
+    omi::Int32Attribute position_attr = event.get_data()[g_data_mouse_position];
     if(!position_attr.is_valid() || position_attr.get_size() != 2)
     {
         return false;
@@ -153,13 +310,21 @@ OMI_API_EXPORT bool Event::mouse_button_press(
         const omi::context::Event& event,
         omi::context::Event::MouseButton& button)
 {
-    if(event.get_type() != kTypeMouseButtonPress)
+    if(event.get_type_id() != kTypeIdMouseButtonPress)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        button = static_cast<omi::context::Event::MouseButton>(
+            event.get_payload().code
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute button_attr = event.get_data()[kDataMouseButton];
+    omi::Int32Attribute button_attr = event.get_data()[g_data_mouse_button];
     if(!button_attr.is_valid() || button_attr.get_size() != 1)
     {
         return false;
@@ -175,20 +340,31 @@ OMI_API_EXPORT bool Event::mouse_button_press(
         omi::context::Event::MouseButton& button,
         omi::context::Event::Modifier& modifiers)
 {
-    if(event.get_type() != kTypeMouseButtonPress)
+    if(event.get_type_id() != kTypeIdMouseButtonPress)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        button = static_cast<omi::context::Event::MouseButton>(
+            event.get_payload().code
+        );
+        modifiers = static_cast<omi::context::Event::Modifier>(
+            event.get_payload().modifiers
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute button_attr = event.get_data()[kDataMouseButton];
+    omi::Int32Attribute button_attr = event.get_data()[g_data_mouse_button];
     if(!button_attr.is_valid() || button_attr.get_size() != 1)
     {
         return false;
     }
 
     // get the modifiers
-    omi::Int32Attribute modifiers_attr = event.get_data()[kDataModifiers];
+    omi::Int32Attribute modifiers_attr = event.get_data()[g_data_modifiers];
     if(!modifiers_attr.is_valid() || modifiers_attr.get_size() != 1)
     {
         return false;
@@ -205,13 +381,21 @@ OMI_API_EXPORT bool Event::mouse_button_release(
         const omi::context::Event& event,
         omi::context::Event::MouseButton& button)
 {
-    if(event.get_type() != kTypeMouseButtonRelease)
+    if(event.get_type_id() != kTypeIdMouseButtonRelease)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        button = static_cast<omi::context::Event::MouseButton>(
+            event.get_payload().code
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute button_attr = event.get_data()[kDataMouseButton];
+    omi::Int32Attribute button_attr = event.get_data()[g_data_mouse_button];
     if(!button_attr.is_valid() || button_attr.get_size() != 1)
     {
         return false;
@@ -227,20 +411,31 @@ OMI_API_EXPORT bool Event::mouse_button_release(
         omi::context::Event::MouseButton& button,
         omi::context::Event::Modifier& modifiers)
 {
-    if(event.get_type() != kTypeMouseButtonRelease)
+    if(event.get_type_id() != kTypeIdMouseButtonRelease)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        button = static_cast<omi::context::Event::MouseButton>(
+            event.get_payload().code
+        );
+        modifiers = static_cast<omi::context::Event::Modifier>(
+            event.get_payload().modifiers
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute button_attr = event.get_data()[kDataMouseButton];
+    omi::Int32Attribute button_attr = event.get_data()[g_data_mouse_button];
     if(!button_attr.is_valid() || button_attr.get_size() != 1)
     {
         return false;
     }
 
     // get the modifiers
-    omi::Int32Attribute modifiers_attr = event.get_data()[kDataModifiers];
+    omi::Int32Attribute modifiers_attr = event.get_data()[g_data_modifiers];
     if(!modifiers_attr.is_valid() || modifiers_attr.get_size() != 1)
     {
         return false;
@@ -258,21 +453,28 @@ OMI_API_EXPORT bool Event::mouse_scroll(
         arc::int32& amount_x,
         arc::int32& amount_y)
 {
-    if(event.get_type() != kTypeMouseScroll)
+    if(event.get_type_id() != kTypeIdMouseScroll)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        amount_x = event.get_payload().x;
+        amount_y = event.get_payload().y;
+        return true;
+    }
+
     // get the x amount
     omi::Int32Attribute amount_x_attr =
-        event.get_data()[kDataMouseScrollAmountX];
+        event.get_data()[g_data_mouse_scroll_amount_x];
     if(!amount_x_attr.is_valid() || amount_x_attr.get_size() != 1)
     {
         return false;
     }
     // get the y amount
     omi::Int32Attribute amount_y_attr =
-        event.get_data()[kDataMouseScrollAmountY];
+        event.get_data()[g_data_mouse_scroll_amount_y];
     if(!amount_y_attr.is_valid() || amount_y_attr.get_size() != 1)
     {
         return false;
@@ -287,13 +489,21 @@ OMI_API_EXPORT bool Event::key_press(
         const omi::context::Event& event,
         omi::context::Event::KeyCode& key_code)
 {
-    if(event.get_type() != kTypeKeyPress)
+    if(event.get_type_id() != kTypeIdKeyPress)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        key_code = static_cast<omi::context::Event::KeyCode>(
+            event.get_payload().code
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute key_code_attr = event.get_data()[kDataKeyCode];
+    omi::Int32Attribute key_code_attr = event.get_data()[g_data_key_code];
     if(!key_code_attr.is_valid() || key_code_attr.get_size() != 1)
     {
         return false;
@@ -309,20 +519,31 @@ OMI_API_EXPORT bool Event::key_press(
             omi::context::Event::KeyCode& key_code,
             omi::context::Event::Modifier& modifiers)
 {
-    if(event.get_type() != kTypeKeyPress)
+    if(event.get_type_id() != kTypeIdKeyPress)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        key_code = static_cast<omi::context::Event::KeyCode>(
+            event.get_payload().code
+        );
+        modifiers = static_cast<omi::context::Event::Modifier>(
+            event.get_payload().modifiers
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute key_code_attr = event.get_data()[kDataKeyCode];
+    omi::Int32Attribute key_code_attr = event.get_data()[g_data_key_code];
     if(!key_code_attr.is_valid() || key_code_attr.get_size() != 1)
     {
         return false;
     }
 
     // get the modifiers
-    omi::Int32Attribute modifiers_attr = event.get_data()[kDataModifiers];
+    omi::Int32Attribute modifiers_attr = event.get_data()[g_data_modifiers];
     if(!modifiers_attr.is_valid() || modifiers_attr.get_size() != 1)
     {
         return false;
@@ -339,13 +560,21 @@ OMI_API_EXPORT bool Event::key_release(
         const omi::context::Event& event,
         omi::context::Event::KeyCode& key_code)
 {
-    if(event.get_type() != kTypeKeyRelease)
+    if(event.get_type_id() != kTypeIdKeyRelease)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        key_code = static_cast<omi::context::Event::KeyCode>(
+            event.get_payload().code
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute key_code_attr = event.get_data()[kDataKeyCode];
+    omi::Int32Attribute key_code_attr = event.get_data()[g_data_key_code];
     if(!key_code_attr.is_valid() || key_code_attr.get_size() != 1)
     {
         return false;
@@ -361,20 +590,31 @@ OMI_API_EXPORT bool Event::key_release(
         omi::context::Event::KeyCode& key_code,
         omi::context::Event::Modifier& modifiers)
 {
-    if(event.get_type() != kTypeKeyRelease)
+    if(event.get_type_id() != kTypeIdKeyRelease)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        key_code = static_cast<omi::context::Event::KeyCode>(
+            event.get_payload().code
+        );
+        modifiers = static_cast<omi::context::Event::Modifier>(
+            event.get_payload().modifiers
+        );
+        return true;
+    }
+
     // get the key code
-    omi::Int32Attribute key_code_attr = event.get_data()[kDataKeyCode];
+    omi::Int32Attribute key_code_attr = event.get_data()[g_data_key_code];
     if(!key_code_attr.is_valid() || key_code_attr.get_size() != 1)
     {
         return false;
     }
 
     // get the modifiers
-    omi::Int32Attribute modifiers_attr = event.get_data()[kDataModifiers];
+    omi::Int32Attribute modifiers_attr = event.get_data()[g_data_modifiers];
     if(!modifiers_attr.is_valid() || modifiers_attr.get_size() != 1)
     {
         return false;
@@ -392,13 +632,20 @@ OMI_API_EXPORT bool Event::window_resize(
         arc::int32& width,
         arc::int32& height)
 {
-    if(event.get_type() != kTypeWindowResize)
+    if(event.get_type_id() != kTypeIdWindowResize)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        width  = event.get_payload().x;
+        height = event.get_payload().y;
+        return true;
+    }
+
     // get the height and width
-    omi::Int32Attribute size_attr = event.get_data()[kDataWindowSize];
+    omi::Int32Attribute size_attr = event.get_data()[g_data_window_size];
     if(!size_attr.is_valid() || size_attr.get_size() != 2)
     {
         return false;
@@ -414,13 +661,21 @@ OMI_API_EXPORT bool Event::window_move(
         arc::int32& position_x,
         arc::int32& position_y)
 {
-    if(event.get_type() != kTypeWindowMove)
+    if(event.get_type_id() != kTypeIdWindowMove)
     {
         return false;
     }
 
+    if(event.has_payload())
+    {
+        position_x = event.get_payload().x;
+        position_y = event.get_payload().y;
+        return true;
+    }
+
     // get the position
-    omi::Int32Attribute position_attr = event.get_data()[kDataWindowPosition];
+    omi::Int32Attribute position_attr =
+        event.get_data()[g_data_window_position];
     if(!position_attr.is_valid() || position_attr.get_size() != 2)
     {
         return false;
@@ -437,13 +692,72 @@ OMI_API_EXPORT bool Event::window_move(
 
 OMI_API_EXPORT const arc::str::UTF8String& Event::get_type() const
 {
-    return m_type;
+    return *m_type;
+}
+
+OMI_API_EXPORT Event::TypeId Event::get_type_id() const
+{
+    return m_type_id;
+}
+
+OMI_API_EXPORT bool Event::has_payload() const
+{
+    return m_has_payload;
+}
+
+OMI_API_EXPORT const Event::Payload& Event::get_payload() const
+{
+    return m_payload;
 }
 
 OMI_API_EXPORT const omi::MapAttribute& Event::get_data() const
 {
+    if(!m_data_built)
+    {
+        build_data();
+    }
     return m_data;
 }
 
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void Event::build_data() const
+{
+    omi::Int32Attribute::ArrayType xy = {m_payload.x, m_payload.y};
+    omi::MapAttribute::DataType data;
+    switch(m_type_id)
+    {
+        case kTypeIdMouseMove:
+            data[kDataMousePosition] = omi::Int32Attribute(xy);
+            break;
+        case kTypeIdMouseButtonPress:
+        case kTypeIdMouseButtonRelease:
+            data[kDataMouseButton] = omi::Int32Attribute(m_payload.code);
+            data[kDataModifiers] = omi::Int32Attribute(m_payload.modifiers);
+            break;
+        case kTypeIdMouseScroll:
+            data[kDataMouseScrollAmountX] = omi::Int32Attribute(m_payload.x);
+            data[kDataMouseScrollAmountY] = omi::Int32Attribute(m_payload.y);
+            break;
+        case kTypeIdKeyPress:
+        case kTypeIdKeyRelease:
+            data[kDataKeyCode] = omi::Int32Attribute(m_payload.code);
+            data[kDataModifiers] = omi::Int32Attribute(m_payload.modifiers);
+            break;
+        case kTypeIdWindowResize:
+            data[kDataWindowSize] = omi::Int32Attribute(xy);
+            break;
+        case kTypeIdWindowMove:
+            data[kDataWindowPosition] = omi::Int32Attribute(xy);
+            break;
+        default:
+            break;
+    }
+    m_data = omi::MapAttribute(std::move(data));
+    m_data_built = true;
+}
+
 } // namespace context
 } // namespace omi
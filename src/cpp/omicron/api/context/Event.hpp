@@ -19,6 +19,12 @@ namespace context
 /*!
  * \brief Simple object that describes an event that can be propagated through
  *        Omicron.
+ *
+ * Each event type has an integer id, which is what events are dispatched by.
+ * Events of the built-in types (input and window events) can hold their data
+ * in a fixed-layout Payload rather than a MapAttribute, so that they can be
+ * constructed and broadcast without allocating memory. Custom events hold
+ * their data in a MapAttribute.
  */
 class Event
 {
@@ -79,6 +85,39 @@ public:
      */
     OMI_API_EXPORT static const arc::str::UTF8String kTypeEngineShutdown;
 
+    //----------------------------T Y P E    I D S------------------------------
+
+    /*!
+     * \brief The integer id of an event type.
+     *
+     * The built-in event types have the fixed ids of BuiltinTypeId, other
+     * event types are assigned an id the first time they are used (see
+     * get_type_id()).
+     */
+    typedef arc::uint32 TypeId;
+
+    /*!
+     * \brief The ids of the built-in event types.
+     */
+    enum BuiltinTypeId
+    {
+        kTypeIdMouseMove = 0,
+        kTypeIdMouseButtonPress,
+        kTypeIdMouseButtonRelease,
+        kTypeIdMouseScroll,
+        kTypeIdMouseEnter,
+        kTypeIdMouseExit,
+        kTypeIdKeyPress,
+        kTypeIdKeyRelease,
+        kTypeIdWindowResize,
+        kTypeIdWindowMove,
+        kTypeIdEngineShutdown,
+        /*!
+         * \brief The number of built-in event types.
+         */
+        kBuiltinTypeCount
+    };
+
     //---------------------------D A T A    N A M E S---------------------------
 
     /*!
@@ -150,6 +189,29 @@ public:
         kMouseMiddle = kMouse3,
     };
 
+    /*!
+     * \brief The fixed-layout data of an event of a built-in type.
+     *
+     * The meaning of the values depends on the type of the event, values that
+     * are not used by the type are 0:
+     *
+     * - mouse move: x and y are the mouse position.
+     * - mouse button press/release: code is the MouseButton and modifiers are
+     *   the Modifier flags.
+     * - mouse scroll: x and y are the scroll amounts.
+     * - key press/release: code is the KeyCode and modifiers are the Modifier
+     *   flags.
+     * - window resize: x and y are the width and height of the window.
+     * - window move: x and y are the position of the window.
+     */
+    struct Payload
+    {
+        arc::int32 x;
+        arc::int32 y;
+        arc::int32 code;
+        arc::int32 modifiers;
+    };
+
     /*!
      * \brief The various key codes.
      */
@@ -290,6 +352,16 @@ public:
             const arc::str::UTF8String& type,
             const omi::MapAttribute& data);
 
+    /*!
+     * \brief Constructs a new event of a built-in type with fixed-layout data.
+     *
+     * Unlike the MapAttribute constructor this does not allocate any memory, so
+     * it should be used for events that are broadcast at a high rate.
+     *
+     * \throw arc::ex::ValueError If the given type is not a built-in type.
+     */
+    OMI_API_EXPORT Event(TypeId type_id, const Payload& payload);
+
     /*!
      * \brief Copy constructor.
      */
@@ -334,6 +406,15 @@ public:
     //                          PUBLIC STATIC FUNCTIONS
     //--------------------------------------------------------------------------
 
+    /*!
+     * \brief Returns the id of the event type with the given name, assigning a
+     *        new id if the type has not been used before.
+     *
+     * The names of the built-in types return their BuiltinTypeId. This is safe
+     * to call from any thread.
+     */
+    OMI_API_EXPORT static TypeId get_type_id(const arc::str::UTF8String& type);
+
     /*!
      * \brief Utility function that returns true if the given event is a valid
      *        mouse move event.
@@ -483,19 +564,58 @@ public:
      */
     OMI_API_EXPORT const arc::str::UTF8String& get_type() const;
 
+    /*!
+     * \brief Returns the id of the type of this event.
+     */
+    OMI_API_EXPORT TypeId get_type_id() const;
+
+    /*!
+     * \brief Returns whether this event holds fixed-layout data, see
+     *        get_payload().
+     */
+    OMI_API_EXPORT bool has_payload() const;
+
+    /*!
+     * \brief Returns the fixed-layout data of this event.
+     *
+     * This is only meaningful if has_payload() returns true, otherwise all of
+     * the values are 0.
+     */
+    OMI_API_EXPORT const Payload& get_payload() const;
+
     /*!
      * \brief Returns the data describing this event.
+     *
+     * If this event holds fixed-layout data, the equivalent MapAttribute is
+     * built the first time this is called.
      */
     OMI_API_EXPORT const omi::MapAttribute& get_data() const;
 
 private:
 
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the id of the event's type
+    TypeId m_type_id;
+    // the name of the event's type, which is owned by the type registry
+    const arc::str::UTF8String* m_type;
+    // whether the event's data is held by m_payload rather than m_data
+    bool m_has_payload;
+    // the fixed-layout data of the event
+    Payload m_payload;
+    // the data of the event, which is only built from the payload on demand
+    mutable MapAttribute m_data;
+    // whether m_data has been built from the payload yet
+    mutable bool m_data_built;
+
     //--------------------------------------------------------------------------
     //                          PRIVATE MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    arc::str::UTF8String m_type;
-    MapAttribute m_data;
+    // builds m_data from the payload
+    void build_data() const;
 };
 
 } // namespace context
@@ -39,40 +39,54 @@ OMI_API_EXPORT void EventListener::on_event(const omi::context::Event& event)
 //------------------------------------------------------------------------------
 
 OMI_API_EXPORT void EventListener::subscribe_to_event(
-        const arc::str::UTF8String& type)
+        const arc::str::UTF8String& type,
+        arc::int32 priority)
+{
+    subscribe_to_event(omi::context::Event::get_type_id(type), priority);
+}
+
+OMI_API_EXPORT void EventListener::subscribe_to_event(
+        omi::context::Event::TypeId type_id,
+        arc::int32 priority)
 {
     // already subscribed?
-    auto f_subscribed = m_subscribed_events.find(type);
+    auto f_subscribed = m_subscribed_events.find(type_id);
     if(f_subscribed != m_subscribed_events.end())
     {
         // TODO: could warn here?
         return;
     }
 
-    omi::context::EventService::instance().subscribe(this, type);
-    m_subscribed_events.insert(type);
+    omi::context::EventService::instance().subscribe(this, type_id, priority);
+    m_subscribed_events.insert(type_id);
 }
 
 OMI_API_EXPORT void EventListener::unsubsribe_from_event(
         const arc::str::UTF8String& type)
+{
+    unsubsribe_from_event(omi::context::Event::get_type_id(type));
+}
+
+OMI_API_EXPORT void EventListener::unsubsribe_from_event(
+        omi::context::Event::TypeId type_id)
 {
     // not subscribed?
-    auto f_subscribed = m_subscribed_events.find(type);
+    auto f_subscribed = m_subscribed_events.find(type_id);
     if(f_subscribed == m_subscribed_events.end())
     {
         // TODO: could warn here?
         return;
     }
 
-    omi::context::EventService::instance().unsubscribe(this, type);
+    omi::context::EventService::instance().unsubscribe(this, type_id);
     m_subscribed_events.erase(f_subscribed);
 }
 
 OMI_API_EXPORT void EventListener::unsubsribe_from_all_events()
 {
-    for(const arc::str::UTF8String& type : m_subscribed_events)
+    for(omi::context::Event::TypeId type_id : m_subscribed_events)
     {
-        omi::context::EventService::instance().unsubscribe(this, type);
+        omi::context::EventService::instance().unsubscribe(this, type_id);
     }
     m_subscribed_events.clear();
 }
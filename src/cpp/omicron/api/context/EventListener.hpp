@@ -57,10 +57,32 @@ protected:
     //                         PROTECTED MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    OMI_API_EXPORT void subscribe_to_event(const arc::str::UTF8String& type);
+    /*!
+     * \brief Subscribes to the events with the given type.
+     *
+     * \param priority Listeners with a higher priority have on_event called
+     *                 before listeners with a lower priority.
+     */
+    OMI_API_EXPORT void subscribe_to_event(
+            const arc::str::UTF8String& type,
+            arc::int32 priority = 0);
+
+    /*!
+     * \brief Subscribes to the events with the given type id, which avoids
+     *        looking up the id of the type's name.
+     *
+     * \param priority Listeners with a higher priority have on_event called
+     *                 before listeners with a lower priority.
+     */
+    OMI_API_EXPORT void subscribe_to_event(
+            omi::context::Event::TypeId type_id,
+            arc::int32 priority = 0);
 
     OMI_API_EXPORT void unsubsribe_from_event(const arc::str::UTF8String& type);
 
+    OMI_API_EXPORT void unsubsribe_from_event(
+            omi::context::Event::TypeId type_id);
+
     OMI_API_EXPORT void unsubsribe_from_all_events();
 
 private:
@@ -69,8 +91,8 @@ private:
     //                          PRIVATE MEMBER FUNCTIONS
     //--------------------------------------------------------------------------
 
-    // holds the names of the events this listener is subscribed to
-    std::unordered_set<arc::str::UTF8String> m_subscribed_events;
+    // holds the ids of the events this listener is subscribed to
+    std::unordered_set<omi::context::Event::TypeId> m_subscribed_events;
 };
 
 } // namespace context
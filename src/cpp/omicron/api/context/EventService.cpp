@@ -1,9 +1,17 @@
 #include "omicron/api/context/EventService.hpp"
 
-#include <unordered_map>
-#include <unordered_set>
-
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "omicron/api/common/Attributes.hpp"
 #include "omicron/api/context/EventListener.hpp"
+#include "omicron/api/report/stats/StatsDatabase.hpp"
 
 
 namespace omi
@@ -11,6 +19,180 @@ namespace omi
 namespace context
 {
 
+//------------------------------------------------------------------------------
+//                                  EVENT QUEUE
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+/*
+ * Bounded lock-free queue that supports multiple producers and a single
+ * consumer.
+ *
+ * Each slot holds a sequence number which tells producers whether the slot is
+ * free to be claimed for the current lap of the buffer, and tells the consumer
+ * whether the event in the slot has finished being written.
+ */
+class EventQueue
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+private:
+
+    //----------------------------C O N S T A N T S-----------------------------
+
+    // the size of the padding between the producer and consumer positions
+    static const std::size_t kCacheLineSize = 64;
+
+    // the mask to convert a position into an index of the buffer
+    static const std::size_t kIndexMask = EventService::kQueueCapacity - 1;
+
+    static_assert(
+        (EventService::kQueueCapacity & kIndexMask) == 0,
+        "The event queue capacity must be a power of two"
+    );
+
+    //-----------------------------S T R U C T S--------------------------------
+
+    struct Slot
+    {
+        // the position this slot is ready to be written at (if equal to the
+        // position), or read at (if one past the position)
+        std::atomic<std::size_t> sequence;
+        // uninitialised storage for the event in this slot
+        std::aligned_storage<
+            sizeof(omi::context::Event),
+            alignof(omi::context::Event)
+        >::type storage;
+    };
+
+    //-------------------P R I V A T E    A T T R I B U T E S-------------------
+
+    // the ring buffer of slots
+    Slot* m_slots;
+    // the next position to be claimed by a producer
+    std::atomic<std::size_t> m_write_position;
+    // keeps the producer and consumer positions on separate cache lines
+    char m_padding[kCacheLineSize];
+    // the next position to be read by the consumer
+    std::size_t m_read_position;
+
+public:
+
+    //--------------------------C O N S T R U C T O R---------------------------
+
+    EventQueue()
+        : m_slots         (new Slot[EventService::kQueueCapacity])
+        , m_write_position(0)
+        , m_read_position (0)
+    {
+        for(std::size_t i = 0; i < EventService::kQueueCapacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    //---------------------------D E S T R U C T O R----------------------------
+
+    ~EventQueue()
+    {
+        // destroy any events that were never read
+        while(peek(0) != nullptr)
+        {
+            pop();
+        }
+        delete[] m_slots;
+    }
+
+    //-------------P U B L I C    M E M B E R    F U N C T I O N S--------------
+
+    // appends a copy of the given event to the queue, returns false if the
+    // queue is full (events with fixed-layout data are rebuilt from their
+    // payload so that the copy never shares attributes with the original)
+    bool push(const omi::context::Event& event)
+    {
+        std::size_t position = m_write_position.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while(true)
+        {
+            slot = &m_slots[position & kIndexMask];
+            std::size_t sequence =
+                slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t difference =
+                static_cast<std::intptr_t>(sequence) -
+                static_cast<std::intptr_t>(position);
+
+            if(difference == 0)
+            {
+                // the slot is free, attempt to claim it
+                if(m_write_position.compare_exchange_weak(
+                        position,
+                        position + 1,
+                        std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(difference < 0)
+            {
+                // the slot still holds an event from the previous lap
+                return false;
+            }
+            else
+            {
+                // another producer claimed the slot
+                position = m_write_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        if(event.has_payload())
+        {
+            new(&slot->storage) omi::context::Event(
+                event.get_type_id(),
+                event.get_payload()
+            );
+        }
+        else
+        {
+            new(&slot->storage) omi::context::Event(event);
+        }
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // returns the event at the given offset from the front of the queue, or
+    // null if there is no event written at that offset yet (only to be called
+    // by the consumer)
+    const omi::context::Event* peek(std::size_t offset) const
+    {
+        std::size_t position = m_read_position + offset;
+        const Slot& slot = m_slots[position & kIndexMask];
+        if(slot.sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const omi::context::Event*>(&slot.storage);
+    }
+
+    // destroys the event at the front of the queue and frees its slot for the
+    // next lap (only to be called by the consumer after peek(0) has returned
+    // an event)
+    void pop()
+    {
+        Slot& slot = m_slots[m_read_position & kIndexMask];
+        reinterpret_cast<omi::context::Event*>(&slot.storage)->~Event();
+        slot.sequence.store(
+            m_read_position + EventService::kQueueCapacity,
+            std::memory_order_release
+        );
+        ++m_read_position;
+    }
+};
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                 IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -22,20 +204,119 @@ class EventService::EventServiceImpl
 {
 private:
 
+    //-----------------------------S T R U C T S--------------------------------
+
+    // a listener that is subscribed to an event type
+    struct Subscriber
+    {
+        // the listener, or null if it has been unsubscribed during dispatch
+        EventListener* listener;
+        // the priority the listener subscribed with
+        arc::int32 priority;
+    };
+
+    // a subscription that was made during dispatch, which will be added once
+    // dispatch has finished
+    struct PendingSubscription
+    {
+        EventListener* listener;
+        omi::context::Event::TypeId type_id;
+        arc::int32 priority;
+    };
+
+    // how the queued events of a type are coalesced
+    struct Coalescing
+    {
+        // the policy used for the type
+        CoalescePolicy policy;
+        // the number of queued events of the type that are being coalesced
+        std::size_t count;
+        // the offset of the last queued event of the type being coalesced
+        std::size_t last;
+        // the accumulated payload values
+        arc::int32 x;
+        arc::int32 y;
+
+        Coalescing()
+            : policy(kCoalesceNone)
+            , count (0)
+            , last  (0)
+            , x     (0)
+            , y     (0)
+        {
+        }
+    };
+
     //-------------------P R I V A T E    A T T R I B U T E S-------------------
 
-    // mapping from event type to the listeners that are subscribed to them
-    std::unordered_map<
-        arc::str::UTF8String,
-        std::unordered_set<EventListener*>
-    > m_subscribers;
+    // the listeners that are subscribed to each event type, indexed by the id
+    // of the type, and in the order they will be called
+    std::vector<std::vector<Subscriber>> m_subscribers;
+    // the number of broadcasts that are currently in progress, which is more
+    // than one when a listener broadcasts from on_event
+    std::size_t m_dispatch_depth;
+    // subscriptions that have been made during dispatch
+    std::vector<PendingSubscription> m_pending;
+    // whether listeners have been unsubscribed during dispatch, so there are
+    // null subscribers to remove
+    bool m_has_removed;
+    // the events that have been posted but not yet dispatched
+    EventQueue m_queue;
+    // how the queued events of each type are coalesced, indexed by the id of
+    // the type
+    std::vector<Coalescing> m_coalescing;
+    // the number of events that could not be posted because the queue was full
+    std::atomic<arc::int64> m_dropped;
+    // the thread the service was created on, which is the only thread that may
+    // post events without fixed-layout data
+    std::thread::id m_main_thread;
+
+    // stats
+    omi::Int64Attribute m_stat_received;
+    omi::Int64Attribute m_stat_dispatched;
+    omi::Int64Attribute m_stat_dropped;
 
 public:
 
     //--------------------------C O N S T R U C T O R---------------------------
 
     EventServiceImpl()
+        : m_subscribers    (omi::context::Event::kBuiltinTypeCount)
+        , m_dispatch_depth (0)
+        , m_has_removed    (false)
+        , m_coalescing     (omi::context::Event::kBuiltinTypeCount)
+        , m_dropped        (0)
+        , m_main_thread    (std::this_thread::get_id())
+        , m_stat_received  (0, false)
+        , m_stat_dispatched(0, false)
+        , m_stat_dropped   (0, false)
     {
+        // only the latest mouse position is needed, while scrolling is
+        // relative so the amounts are summed
+        m_coalescing[omi::context::Event::kTypeIdMouseMove].policy =
+            kCoalesceLatest;
+        m_coalescing[omi::context::Event::kTypeIdMouseScroll].policy =
+            kCoalesceAccumulate;
+
+        // set up the stats
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Events.Received",
+            m_stat_received,
+            "The total number of events that have been posted to the event "
+            "queue and taken from it to be dispatched."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Events.Dispatched",
+            m_stat_dispatched,
+            "The total number of events that have been dispatched from the "
+            "event queue after high frequency events have been coalesced."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Events.Dropped",
+            m_stat_dropped,
+            "The number of events that could not be posted because the event "
+            "queue was full."
+        );
     }
 
     //---------------------------D E S T R U C T O R----------------------------
@@ -49,64 +330,307 @@ public:
     void broadcast(const omi::context::Event& event)
     {
         // anything subscribed to this event?
-        auto f_subscriber = m_subscribers.find(event.get_type());
-        if(f_subscriber != m_subscribers.end())
+        if(event.get_type_id() >= m_subscribers.size())
+        {
+            return;
+        }
+
+        // the subscribers are not added to or removed from while dispatching
+        // so they can't be reallocated, but may be nulled by unsubscribe
+        const std::vector<Subscriber>& subscribers =
+            m_subscribers[event.get_type_id()];
+        ++m_dispatch_depth;
+        try
         {
-            for(EventListener* listener : f_subscriber->second)
+            for(std::size_t i = 0; i < subscribers.size(); ++i)
             {
-                listener->on_event(event);
+                if(subscribers[i].listener != nullptr)
+                {
+                    subscribers[i].listener->on_event(event);
+                }
             }
         }
+        catch(...)
+        {
+            end_dispatch();
+            throw;
+        }
+        end_dispatch();
     }
 
     void broadcast_shutdown()
     {
         broadcast(omi::context::Event(
-            omi::context::Event::kTypeEngineShutdown,
-            omi::MapAttribute()
+            omi::context::Event::kTypeIdEngineShutdown,
+            omi::context::Event::Payload()
         ));
     }
 
+    bool post(const omi::context::Event& event)
+    {
+        // attributes are not safe to share between threads
+        assert(
+            event.has_payload() ||
+            std::this_thread::get_id() == m_main_thread
+        );
+
+        if(!m_queue.push(event))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    std::size_t dispatch_queued()
+    {
+        // count the events in the queue before dispatching any of them so that
+        // the events posted by listeners are left for the next dispatch, while
+        // finding the last event of each type that is being coalesced
+        std::size_t count = 0;
+        const omi::context::Event* event = nullptr;
+        while((event = m_queue.peek(count)) != nullptr)
+        {
+            Coalescing* coalescing = get_coalescing(*event);
+            if(coalescing != nullptr)
+            {
+                ++coalescing->count;
+                coalescing->last = count;
+                if(coalescing->policy == kCoalesceAccumulate)
+                {
+                    coalescing->x += event->get_payload().x;
+                    coalescing->y += event->get_payload().y;
+                }
+            }
+            ++count;
+        }
+
+        // the events are dispatched in place and then removed from the queue
+        std::size_t dispatched = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            event = m_queue.peek(0);
+            Coalescing* coalescing = get_coalescing(*event);
+            if(coalescing == nullptr)
+            {
+                broadcast(*event);
+                ++dispatched;
+            }
+            else if(i == coalescing->last)
+            {
+                if(coalescing->policy == kCoalesceAccumulate &&
+                   coalescing->count > 1)
+                {
+                    omi::context::Event::Payload payload =
+                        event->get_payload();
+                    payload.x = coalescing->x;
+                    payload.y = coalescing->y;
+                    broadcast(
+                        omi::context::Event(event->get_type_id(), payload)
+                    );
+                }
+                else
+                {
+                    broadcast(*event);
+                }
+                ++dispatched;
+
+                coalescing->count = 0;
+                coalescing->x = 0;
+                coalescing->y = 0;
+            }
+            m_queue.pop();
+        }
+
+        m_stat_received.set_at(
+            0,
+            m_stat_received.at(0) + static_cast<arc::int64>(count)
+        );
+        m_stat_dispatched.set_at(
+            0,
+            m_stat_dispatched.at(0) + static_cast<arc::int64>(dispatched)
+        );
+        m_stat_dropped.set_at(0, m_dropped.load(std::memory_order_relaxed));
+
+        return dispatched;
+    }
+
+    CoalescePolicy get_coalesce_policy(
+            omi::context::Event::TypeId type_id) const
+    {
+        if(type_id >= m_coalescing.size())
+        {
+            return kCoalesceNone;
+        }
+        return m_coalescing[type_id].policy;
+    }
+
+    void set_coalesce_policy(
+            omi::context::Event::TypeId type_id,
+            CoalescePolicy policy)
+    {
+        if(type_id >= m_coalescing.size())
+        {
+            m_coalescing.resize(type_id + 1);
+        }
+        m_coalescing[type_id].policy = policy;
+    }
+
     void subscribe(
             omi::context::EventListener* listener,
-            const arc::str::UTF8String& type)
+            omi::context::Event::TypeId type_id,
+            arc::int32 priority)
     {
-        auto f_subscriber = m_subscribers.find(type);
-        if(f_subscriber == m_subscribers.end())
+        // wait until dispatch has finished?
+        if(m_dispatch_depth > 0)
         {
-            m_subscribers.emplace(type, std::unordered_set<EventListener*>());
-            f_subscriber = m_subscribers.find(type);
+            m_pending.push_back({listener, type_id, priority});
+            return;
         }
+        add_subscriber(listener, type_id, priority);
+    }
 
-        // is the listener already subscribed?
-        auto f_listener = f_subscriber->second.find(listener);
-        if(f_listener != f_subscriber->second.end())
+    void unsubscribe(
+            omi::context::EventListener* listener,
+            omi::context::Event::TypeId type_id)
+    {
+        // cancel any subscription made during dispatch
+        m_pending.erase(
+            std::remove_if(
+                m_pending.begin(),
+                m_pending.end(),
+                [listener, type_id](const PendingSubscription& pending)
+                {
+                    return pending.listener == listener &&
+                           pending.type_id == type_id;
+                }
+            ),
+            m_pending.end()
+        );
+
+        if(type_id >= m_subscribers.size())
         {
             return;
         }
 
-        // subscribe!
-        f_subscriber->second.insert(listener);
+        std::vector<Subscriber>& subscribers = m_subscribers[type_id];
+        for(auto subscriber = subscribers.begin();
+            subscriber != subscribers.end();
+            ++subscriber)
+        {
+            if(subscriber->listener != listener)
+            {
+                continue;
+            }
+            // null the subscriber if it could be being iterated over, it will
+            // be removed once dispatch has finished
+            if(m_dispatch_depth > 0)
+            {
+                subscriber->listener = nullptr;
+                m_has_removed = true;
+            }
+            else
+            {
+                subscribers.erase(subscriber);
+            }
+            return;
+        }
     }
 
-    void unsubscribe(
+private:
+
+    //------------P R I V A T E    M E M B E R    F U N C T I O N S-------------
+
+    // inserts the given listener into the subscribers of the given type after
+    // any subscribers with the same or a higher priority
+    void add_subscriber(
             omi::context::EventListener* listener,
-            const arc::str::UTF8String& type)
+            omi::context::Event::TypeId type_id,
+            arc::int32 priority)
     {
-        auto f_subscriber = m_subscribers.find(type);
-        if(f_subscriber == m_subscribers.end())
+        if(type_id >= m_subscribers.size())
         {
-            return;
+            m_subscribers.resize(type_id + 1);
         }
 
-        // is the listener subscribed?
-        auto f_listener = f_subscriber->second.find(listener);
-        if(f_listener == f_subscriber->second.end())
+        std::vector<Subscriber>& subscribers = m_subscribers[type_id];
+        // already subscribed?
+        for(const Subscriber& subscriber : subscribers)
+        {
+            if(subscriber.listener == listener)
+            {
+                return;
+            }
+        }
+
+        auto position = std::upper_bound(
+            subscribers.begin(),
+            subscribers.end(),
+            priority,
+            [](arc::int32 priority, const Subscriber& subscriber)
+            {
+                return priority > subscriber.priority;
+            }
+        );
+        subscribers.insert(position, {listener, priority});
+    }
+
+    // called when a broadcast has finished, if this was the outermost
+    // broadcast the subscribers are updated with the changes that were made
+    // during dispatch
+    void end_dispatch()
+    {
+        --m_dispatch_depth;
+        if(m_dispatch_depth > 0)
         {
             return;
         }
 
-        f_subscriber->second.erase(f_listener);
+        if(m_has_removed)
+        {
+            for(std::vector<Subscriber>& subscribers : m_subscribers)
+            {
+                subscribers.erase(
+                    std::remove_if(
+                        subscribers.begin(),
+                        subscribers.end(),
+                        [](const Subscriber& subscriber)
+                        {
+                            return subscriber.listener == nullptr;
+                        }
+                    ),
+                    subscribers.end()
+                );
+            }
+            m_has_removed = false;
+        }
+
+        for(const PendingSubscription& subscription : m_pending)
+        {
+            add_subscriber(
+                subscription.listener,
+                subscription.type_id,
+                subscription.priority
+            );
+        }
+        m_pending.clear();
+    }
+
+    // returns how the given event is coalesced, or null if the event is not
+    // coalesced
+    Coalescing* get_coalescing(const omi::context::Event& event)
+    {
+        if(event.get_type_id() >= m_coalescing.size())
+        {
+            return nullptr;
+        }
+        Coalescing& coalescing = m_coalescing[event.get_type_id()];
+        if(coalescing.policy == kCoalesceNone ||
+           (coalescing.policy == kCoalesceAccumulate && !event.has_payload()))
+        {
+            return nullptr;
+        }
+        return &coalescing;
     }
 };
 
@@ -134,22 +658,46 @@ OMI_API_EXPORT void EventService::broadcast_shutdown()
     m_impl->broadcast_shutdown();
 }
 
+OMI_API_EXPORT bool EventService::post(const omi::context::Event& event)
+{
+    return m_impl->post(event);
+}
+
+OMI_API_EXPORT std::size_t EventService::dispatch_queued()
+{
+    return m_impl->dispatch_queued();
+}
+
+OMI_API_EXPORT EventService::CoalescePolicy EventService::get_coalesce_policy(
+        omi::context::Event::TypeId type_id) const
+{
+    return m_impl->get_coalesce_policy(type_id);
+}
+
+OMI_API_EXPORT void EventService::set_coalesce_policy(
+        omi::context::Event::TypeId type_id,
+        CoalescePolicy policy)
+{
+    m_impl->set_coalesce_policy(type_id, policy);
+}
+
 //------------------------------------------------------------------------------
 //                           PROTECTED MEMBER FUNCTIONS
 //------------------------------------------------------------------------------
 
 OMI_API_EXPORT void EventService::subscribe(
         omi::context::EventListener* listener,
-        const arc::str::UTF8String& type)
+        omi::context::Event::TypeId type_id,
+        arc::int32 priority)
 {
-    m_impl->subscribe(listener, type);
+    m_impl->subscribe(listener, type_id, priority);
 }
 
 OMI_API_EXPORT void EventService::unsubscribe(
         omi::context::EventListener* listener,
-        const arc::str::UTF8String& type)
+        omi::context::Event::TypeId type_id)
 {
-    m_impl->unsubscribe(listener, type);
+    m_impl->unsubscribe(listener, type_id);
 }
 
 //------------------------------------------------------------------------------
@@ -27,6 +27,27 @@ class EventListener;
 /*!
  * \brief The EventService is a singleton that manages the broadcasting and
  *        propagation of events within Omicron.
+ *
+ * Subscribers are looked up by the integer id of the event's type, so
+ * broadcasting an event does not hash its type name. The subscribers of each
+ * type are stored contiguously in order of priority. Listeners may subscribe
+ * and unsubscribe while an event is being broadcast: unsubscribed listeners are
+ * not called again, while new subscriptions only take effect once the
+ * outermost broadcast has finished.
+ *
+ * Events can either be broadcast, which calls the subscribed listeners
+ * immediately, or posted, which appends the event to a lock-free queue. Events
+ * with fixed-layout data (see Event::has_payload()) can be posted from any
+ * thread, while events with MapAttribute data can only be posted from the main
+ * thread, since attributes are not safe to share between threads. The queued
+ * events are only dispatched to listeners when dispatch_queued() is called by
+ * the engine once per frame. Broadcasting, dispatching, and subscribing should
+ * only be done from the main thread, which is the thread that first calls
+ * instance().
+ *
+ * High frequency events can be coalesced when they are dispatched from the
+ * queue (see CoalescePolicy), by default mouse move events use kCoalesceLatest
+ * and mouse scroll events use kCoalesceAccumulate.
  */
 class EventService
     : private arc::lang::Noncopyable
@@ -43,6 +64,42 @@ protected:
 
 public:
 
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The maximum number of events that can be waiting in the queue
+     *        to be dispatched.
+     */
+    static const std::size_t kQueueCapacity = 4096;
+
+    //--------------------------------------------------------------------------
+    //                                ENUMERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief How queued events of the same type are combined when they are
+     *        dispatched.
+     *
+     * - kCoalesceNone: Every queued event of the type is dispatched.
+     * - kCoalesceLatest: Only the last queued event of the type is dispatched.
+     * - kCoalesceAccumulate: The last queued event of the type is dispatched
+     *   with the x and y of its payload replaced by the sums of the x and y of
+     *   all the queued events of the type. Events without a payload are not
+     *   coalesced.
+     *
+     * A coalesced event is dispatched at the position of the last queued event
+     * of its type, so at most one event of the type is dispatched per call to
+     * dispatch_queued().
+     */
+    enum CoalescePolicy
+    {
+        kCoalesceNone = 0,
+        kCoalesceLatest,
+        kCoalesceAccumulate
+    };
+
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC FUNCTIONS
     //--------------------------------------------------------------------------
@@ -67,6 +124,51 @@ public:
      */
     OMI_API_EXPORT void broadcast_shutdown();
 
+    /*!
+     * \brief Appends the given event to the queue of events that will be
+     *        dispatched to the subscribed EventListeners at the next call to
+     *        dispatch_queued().
+     *
+     * This function is lock-free and may be called from any thread for events
+     * with fixed-layout data. Events with MapAttribute data share their
+     * attributes with the queued copy, so they may only be posted from the
+     * main thread (this is asserted). Events posted from the same thread will
+     * be dispatched in the order they were posted.
+     *
+     * \return False if the queue is full, in which case the event is dropped.
+     */
+    OMI_API_EXPORT bool post(const omi::context::Event& event);
+
+    /*!
+     * \brief Dispatches all events in the queue to the EventListeners that are
+     *        subscribed to them.
+     *
+     * Only the events that are in the queue when this function is called are
+     * dispatched, events that are posted by listeners during dispatch will be
+     * dispatched at the next call.
+     *
+     * \return The number of events that were dispatched, after coalescing.
+     */
+    OMI_API_EXPORT std::size_t dispatch_queued();
+
+    /*!
+     * \brief Returns the policy used to coalesce queued events with the given
+     *        type id.
+     */
+    OMI_API_EXPORT CoalescePolicy get_coalesce_policy(
+            omi::context::Event::TypeId type_id) const;
+
+    /*!
+     * \brief Sets the policy used to coalesce queued events with the given
+     *        type id.
+     *
+     * This should not be called by listeners while events are being
+     * dispatched.
+     */
+    OMI_API_EXPORT void set_coalesce_policy(
+            omi::context::Event::TypeId type_id,
+            CoalescePolicy policy);
+
 protected:
 
     //--------------------------------------------------------------------------
@@ -75,19 +177,24 @@ protected:
 
     /*!
      * \brief Subscribes the given EventListener to have its on_event function
-     *        called every time an event with the given function is broadcast.
+     *        called every time an event with the given type id is broadcast.
+     *
+     * Listeners with a higher priority are called before listeners with a
+     * lower priority, and listeners with the same priority are called in the
+     * order they subscribed.
      */
     OMI_API_EXPORT void subscribe(
             omi::context::EventListener* listener,
-            const arc::str::UTF8String& type);
+            omi::context::Event::TypeId type_id,
+            arc::int32 priority);
 
     /*!
      * \brief Unsubscribes the given EventListener from events with the given
-     *        type.
+     *        type id.
      */
     OMI_API_EXPORT void unsubscribe(
             omi::context::EventListener* listener,
-            const arc::str::UTF8String& type);
+            omi::context::Event::TypeId type_id);
 
 private:
 
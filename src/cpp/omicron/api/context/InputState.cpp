@@ -0,0 +1,121 @@
+#include "omicron/api/context/InputState.hpp"
+
+
+namespace omi
+{
+namespace context
+{
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT InputState& InputState::instance()
+{
+    static InputState inst;
+    return inst;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void InputState::set_key(
+        omi::context::Event::KeyCode key_code,
+        bool down)
+{
+    // ignore unknown keys
+    if(key_code < 0 || static_cast<std::size_t>(key_code) >= kKeyCount)
+    {
+        return;
+    }
+
+    std::size_t index = static_cast<std::size_t>(key_code);
+    arc::uint64 bit = static_cast<arc::uint64>(1) << (index % 64);
+    if(down)
+    {
+        m_recording.keys[index / 64] |= bit;
+    }
+    else
+    {
+        m_recording.keys[index / 64] &= ~bit;
+    }
+}
+
+OMI_API_EXPORT void InputState::set_mouse_button(
+        omi::context::Event::MouseButton button,
+        bool down)
+{
+    if(button < 0 || static_cast<std::size_t>(button) >= kMouseButtonCount)
+    {
+        return;
+    }
+
+    arc::uint32 bit = static_cast<arc::uint32>(1) << button;
+    if(down)
+    {
+        m_recording.mouse_buttons |= bit;
+    }
+    else
+    {
+        m_recording.mouse_buttons &= ~bit;
+    }
+}
+
+OMI_API_EXPORT void InputState::set_mouse_position(arc::int32 x, arc::int32 y)
+{
+    if(m_has_mouse_position)
+    {
+        m_recording.mouse_delta_x += x - m_recording.mouse_x;
+        m_recording.mouse_delta_y += y - m_recording.mouse_y;
+    }
+    warp_mouse_position(x, y);
+}
+
+OMI_API_EXPORT void InputState::warp_mouse_position(arc::int32 x, arc::int32 y)
+{
+    m_recording.mouse_x = x;
+    m_recording.mouse_y = y;
+    m_has_mouse_position = true;
+}
+
+OMI_API_EXPORT void InputState::add_scroll(
+        arc::int32 amount_x,
+        arc::int32 amount_y)
+{
+    m_recording.scroll_x += amount_x;
+    m_recording.scroll_y += amount_y;
+}
+
+OMI_API_EXPORT void InputState::update()
+{
+    m_snapshot = m_recording;
+
+    // the deltas are relative to each frame
+    m_recording.mouse_delta_x = 0;
+    m_recording.mouse_delta_y = 0;
+    m_recording.scroll_x = 0;
+    m_recording.scroll_y = 0;
+}
+
+//------------------------------------------------------------------------------
+//                              PRIVATE CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+InputState::InputState()
+    : m_recording         ()
+    , m_snapshot          ()
+    , m_has_mouse_position(false)
+{
+}
+
+//------------------------------------------------------------------------------
+//                               PRIVATE DESTRUCTOR
+//------------------------------------------------------------------------------
+
+InputState::~InputState()
+{
+}
+
+} // namespace context
+} // namespace omi
@@ -0,0 +1,253 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_CONTEXT_INPUTSTATE_HPP_
+#define OMICRON_API_CONTEXT_INPUTSTATE_HPP_
+
+#include <arcanecore/base/Types.hpp>
+#include <arcanecore/base/lang/Restrictors.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/context/Event.hpp"
+
+
+namespace omi
+{
+namespace context
+{
+
+/*!
+ * \brief Singleton which holds a snapshot of the state of the input devices,
+ *        which is taken once per frame.
+ *
+ * The InputState is an alternative to tracking the state of input devices by
+ * listening to events, for example an entity can check whether a key is held
+ * down in its update function rather than subscribing to key press and key
+ * release events. Querying the state is a bit test on the snapshot, and does
+ * not change during a frame.
+ *
+ * The context subsystem records input as it is received, and the engine takes
+ * the snapshot at the start of each frame, at the same point that queued
+ * events are dispatched. All functions should only be called from the main
+ * thread.
+ */
+class InputState
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The number of key codes that can be tracked, all key codes are
+     *        less than this value.
+     */
+    static const std::size_t kKeyCount = 512;
+
+    /*!
+     * \brief The number of mouse buttons that can be tracked.
+     */
+    static const std::size_t kMouseButtonCount = 32;
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the singleton instance of the Omicron InputState.
+     */
+    OMI_API_EXPORT static InputState& instance();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether the given key was held down at the start of this
+     *        frame.
+     *
+     * kKeyCodeUnkown is never held down.
+     */
+    bool is_key_down(omi::context::Event::KeyCode key_code) const
+    {
+        std::size_t index =
+            static_cast<std::size_t>(key_code) & (kKeyCount - 1);
+        return ((m_snapshot.keys[index / 64] >> (index % 64)) & 1) != 0;
+    }
+
+    /*!
+     * \brief Returns whether the given mouse button was held down at the start
+     *        of this frame.
+     */
+    bool is_mouse_button_down(omi::context::Event::MouseButton button) const
+    {
+        std::size_t index =
+            static_cast<std::size_t>(button) & (kMouseButtonCount - 1);
+        return ((m_snapshot.mouse_buttons >> index) & 1) != 0;
+    }
+
+    /*!
+     * \brief Returns the mask of the mouse buttons that were held down at the
+     *        start of this frame, where bit n is set if the mouse button n is
+     *        held down.
+     */
+    arc::uint32 get_mouse_buttons() const
+    {
+        return m_snapshot.mouse_buttons;
+    }
+
+    /*!
+     * \brief Returns the x position of the mouse at the start of this frame
+     *        (in pixels).
+     */
+    arc::int32 get_mouse_x() const
+    {
+        return m_snapshot.mouse_x;
+    }
+
+    /*!
+     * \brief Returns the y position of the mouse at the start of this frame
+     *        (in pixels).
+     */
+    arc::int32 get_mouse_y() const
+    {
+        return m_snapshot.mouse_y;
+    }
+
+    /*!
+     * \brief Returns how far the mouse moved along the x axis during the
+     *        previous frame (in pixels).
+     */
+    arc::int32 get_mouse_delta_x() const
+    {
+        return m_snapshot.mouse_delta_x;
+    }
+
+    /*!
+     * \brief Returns how far the mouse moved along the y axis during the
+     *        previous frame (in pixels).
+     */
+    arc::int32 get_mouse_delta_y() const
+    {
+        return m_snapshot.mouse_delta_y;
+    }
+
+    /*!
+     * \brief Returns the total amount the mouse was scrolled along the x axis
+     *        during the previous frame.
+     */
+    arc::int32 get_scroll_x() const
+    {
+        return m_snapshot.scroll_x;
+    }
+
+    /*!
+     * \brief Returns the total amount the mouse was scrolled along the y axis
+     *        during the previous frame.
+     */
+    arc::int32 get_scroll_y() const
+    {
+        return m_snapshot.scroll_y;
+    }
+
+    //-----------------------------ENGINE INTERNALS-----------------------------
+    // hide from doxygen
+    #ifndef IN_DOXYGEN
+
+    /*!
+     * \brief Records whether the given key is held down.
+     */
+    OMI_API_EXPORT void set_key(
+            omi::context::Event::KeyCode key_code,
+            bool down);
+
+    /*!
+     * \brief Records whether the given mouse button is held down.
+     */
+    OMI_API_EXPORT void set_mouse_button(
+            omi::context::Event::MouseButton button,
+            bool down);
+
+    /*!
+     * \brief Records that the mouse has moved to the given position, which
+     *        adds to the mouse delta.
+     */
+    OMI_API_EXPORT void set_mouse_position(arc::int32 x, arc::int32 y);
+
+    /*!
+     * \brief Records that the mouse has been moved to the given position by
+     *        the context subsystem (i.e. locking the mouse to the centre of the
+     *        surface), which doesn't add to the mouse delta.
+     */
+    OMI_API_EXPORT void warp_mouse_position(arc::int32 x, arc::int32 y);
+
+    /*!
+     * \brief Records that the mouse has been scrolled by the given amounts.
+     */
+    OMI_API_EXPORT void add_scroll(arc::int32 amount_x, arc::int32 amount_y);
+
+    /*!
+     * \brief Takes a snapshot of the recorded input state which will be
+     *        returned by the query functions until the next update, and resets
+     *        the mouse delta and scroll amounts.
+     */
+    OMI_API_EXPORT void update();
+
+    #endif
+    // IN_DOXYGEN
+    //--------------------------------------------------------------------------
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                              PRIVATE STRUCTS
+    //--------------------------------------------------------------------------
+
+    struct State
+    {
+        // bit set of the keys that are held down
+        arc::uint64 keys[kKeyCount / 64];
+        // bit mask of the mouse buttons that are held down
+        arc::uint32 mouse_buttons;
+        arc::int32 mouse_x;
+        arc::int32 mouse_y;
+        arc::int32 mouse_delta_x;
+        arc::int32 mouse_delta_y;
+        arc::int32 scroll_x;
+        arc::int32 scroll_y;
+    };
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the state as it has been recorded since the last update
+    State m_recording;
+    // the snapshot of the state taken at the last update
+    State m_snapshot;
+    // whether the position of the mouse has been recorded yet, the first
+    // position does not add to the mouse delta
+    bool m_has_mouse_position;
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    InputState();
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    ~InputState();
+};
+
+} // namespace context
+} // namespace omi
+
+#endif
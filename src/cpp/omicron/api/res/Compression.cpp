@@ -0,0 +1,284 @@
+#include "omicron/api/res/Compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Types.hpp>
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the minimum length of a match, which the block stores matches relative to
+static const std::size_t MIN_MATCH = 4;
+// the block format requires the last bytes of the data to be literals
+static const std::size_t LAST_LITERALS = 5;
+// and matches can not start within this many bytes of the end of the data
+static const std::size_t MATCH_LIMIT = 12;
+// the maximum distance back to a match
+static const std::size_t MAX_OFFSET = 65535;
+// the number of bits of the hash used to find matches
+static const std::size_t HASH_BITS = 16;
+// the number of consecutive failed searches before the compressor starts
+// skipping bytes, which keeps incompressible data fast
+static const std::size_t SKIP_TRIGGER = 6;
+
+// reads 4 unaligned bytes
+arc::uint32 read_32(const char* data)
+{
+    arc::uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// returns the hash table index of the given 4 bytes
+std::size_t hash_32(arc::uint32 value)
+{
+    return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+// writes the remainder of a length that did not fit in a token
+void write_length(std::size_t length, std::vector<char>& compressed)
+{
+    for(; length >= 255; length -= 255)
+    {
+        compressed.push_back(static_cast<char>(255));
+    }
+    compressed.push_back(static_cast<char>(length));
+}
+
+// writes a sequence of literals followed by a match, or just the literals if
+// the match length is 0
+void write_sequence(
+        const char* literals,
+        std::size_t literal_length,
+        std::size_t offset,
+        std::size_t match_length,
+        std::vector<char>& compressed)
+{
+    std::size_t match_code = match_length > 0 ? match_length - MIN_MATCH : 0;
+    compressed.push_back(static_cast<char>(
+        (std::min<std::size_t>(literal_length, 15) << 4) |
+        std::min<std::size_t>(match_code, 15)
+    ));
+    if(literal_length >= 15)
+    {
+        write_length(literal_length - 15, compressed);
+    }
+    compressed.insert(
+        compressed.end(),
+        literals,
+        literals + literal_length
+    );
+    if(match_length == 0)
+    {
+        return;
+    }
+
+    compressed.push_back(static_cast<char>(offset & 0xFF));
+    compressed.push_back(static_cast<char>(offset >> 8));
+    if(match_code >= 15)
+    {
+        write_length(match_code - 15, compressed);
+    }
+}
+
+// throws a parse error for an invalid compressed block
+void throw_invalid_block(const char* reason)
+{
+    arc::str::UTF8String error_message;
+    error_message << "Invalid LZ4 block: " << reason;
+    throw arc::ex::ParseError(error_message);
+}
+
+// reads the remainder of a length that did not fit in a token
+std::size_t read_length(const unsigned char*& in, const unsigned char* in_end)
+{
+    std::size_t length = 0;
+    unsigned char byte = 255;
+    while(byte == 255)
+    {
+        if(in == in_end)
+        {
+            throw_invalid_block("Truncated length.");
+        }
+        byte = *in++;
+        length += byte;
+    }
+    return length;
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void compress(
+        const char* data,
+        std::size_t length,
+        std::vector<char>& compressed)
+{
+    compressed.clear();
+    compressed.reserve(length + (length / 255) + 16);
+
+    const char* anchor = data;
+    if(length > MATCH_LIMIT)
+    {
+        // the last position each hashed sequence of 4 bytes was seen at
+        std::vector<arc::uint32> table(std::size_t(1) << HASH_BITS, 0);
+
+        const char* p = data;
+        const char* match_limit = data + length - MATCH_LIMIT;
+        const char* literals_start = data + length - LAST_LITERALS;
+        std::size_t misses = 0;
+        while(p < match_limit)
+        {
+            arc::uint32 sequence = read_32(p);
+            arc::uint32& entry = table[hash_32(sequence)];
+            const char* candidate = data + entry;
+            entry = static_cast<arc::uint32>(p - data);
+
+            if(candidate >= p ||
+               static_cast<std::size_t>(p - candidate) > MAX_OFFSET ||
+               read_32(candidate) != sequence)
+            {
+                p += 1 + (misses++ >> SKIP_TRIGGER);
+                continue;
+            }
+            misses = 0;
+
+            // extend the match forwards, then backwards over the literals
+            const char* match_end = p + MIN_MATCH;
+            const char* candidate_end = candidate + MIN_MATCH;
+            while(match_end < literals_start && *match_end == *candidate_end)
+            {
+                ++match_end;
+                ++candidate_end;
+            }
+            while(p > anchor && candidate > data && p[-1] == candidate[-1])
+            {
+                --p;
+                --candidate;
+            }
+
+            write_sequence(
+                anchor,
+                static_cast<std::size_t>(p - anchor),
+                static_cast<std::size_t>(p - candidate),
+                static_cast<std::size_t>(match_end - p),
+                compressed
+            );
+            p = match_end;
+            anchor = p;
+        }
+    }
+
+    // the block always ends with a sequence of just literals
+    write_sequence(
+        anchor,
+        static_cast<std::size_t>(data + length - anchor),
+        0,
+        0,
+        compressed
+    );
+}
+
+OMI_API_EXPORT void decompress(
+        const char* data,
+        std::size_t length,
+        char* decompressed,
+        std::size_t decompressed_length)
+{
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* in_end = in + length;
+    char* out = decompressed;
+    char* out_end = decompressed + decompressed_length;
+
+    while(true)
+    {
+        if(in == in_end)
+        {
+            throw_invalid_block("Missing final literals.");
+        }
+        unsigned char token = *in++;
+
+        std::size_t literal_length = token >> 4;
+        if(literal_length == 15)
+        {
+            literal_length += read_length(in, in_end);
+        }
+        if(literal_length > static_cast<std::size_t>(in_end - in) ||
+           literal_length > static_cast<std::size_t>(out_end - out))
+        {
+            throw_invalid_block("Literals out of bounds.");
+        }
+        // an empty block may be decompressed into a null buffer, which
+        // memcpy doesn't allow even when there's nothing to copy
+        if(literal_length != 0)
+        {
+            std::memcpy(out, in, literal_length);
+        }
+        in += literal_length;
+        out += literal_length;
+
+        // the last sequence has no match
+        if(in == in_end)
+        {
+            break;
+        }
+
+        if(in_end - in < 2)
+        {
+            throw_invalid_block("Truncated match offset.");
+        }
+        std::size_t offset = static_cast<std::size_t>(in[0]) |
+            (static_cast<std::size_t>(in[1]) << 8);
+        in += 2;
+        std::size_t match_length = token & 0xF;
+        if(match_length == 15)
+        {
+            match_length += read_length(in, in_end);
+        }
+        match_length += MIN_MATCH;
+        if(offset == 0 ||
+           offset > static_cast<std::size_t>(out - decompressed) ||
+           match_length > static_cast<std::size_t>(out_end - out))
+        {
+            throw_invalid_block("Match out of bounds.");
+        }
+
+        // matches may overlap the bytes they produce (e.g. runs)
+        const char* match = out - offset;
+        if(offset >= match_length)
+        {
+            std::memcpy(out, match, match_length);
+            out += match_length;
+        }
+        else
+        {
+            for(char* match_end = out + match_length; out < match_end; ++out)
+            {
+                *out = *match++;
+            }
+        }
+    }
+
+    if(out != out_end)
+    {
+        throw_invalid_block("Decompressed length does not match.");
+    }
+}
+
+} // namespace res
+} // namespace omi
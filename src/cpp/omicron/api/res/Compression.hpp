@@ -0,0 +1,64 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Block compression used for resource data.
+ */
+#ifndef OMICRON_API_RES_COMPRESSION_HPP_
+#define OMICRON_API_RES_COMPRESSION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "omicron/api/API.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Compresses the given data as a single LZ4 block.
+ *
+ * LZ4 trades compression ratio for speed: decompression runs at memory
+ * bandwidth so reading compressed resources costs less than reading the bytes
+ * that were saved. The output is the raw LZ4 block format (without the LZ4
+ * frame), so the decompressed length must be stored alongside it.
+ *
+ * \param data The data to compress.
+ * \param length The length of the data in bytes.
+ * \param compressed Receives the compressed block, which replaces any existing
+ *                   contents.
+ */
+OMI_API_EXPORT void compress(
+        const char* data,
+        std::size_t length,
+        std::vector<char>& compressed);
+
+/*!
+ * \brief Decompresses the LZ4 block produced by compress().
+ *
+ * \param data The compressed block.
+ * \param length The length of the compressed block in bytes.
+ * \param decompressed The memory to decompress into.
+ * \param decompressed_length The length of the data before it was compressed,
+ *                            exactly this many bytes will be written to
+ *                            decompressed.
+ *
+ * \throw arc::ex::ParseError If the block is invalid or does not decompress to
+ *                            exactly decompressed_length bytes.
+ */
+OMI_API_EXPORT void decompress(
+        const char* data,
+        std::size_t length,
+        char* decompressed,
+        std::size_t decompressed_length);
+
+} // namespace res
+} // namespace omi
+
+#endif
@@ -26,4 +26,25 @@
     static const StaticDefineLoader define_loader;                             \
     }
 
+/*!
+ * \brief Defines a loader function for memory-mapped files at static
+ *        initialisation time, see ResourceRegistry::define_mapped_loader().
+ */
+#define OMICRON_API_RES_DEFINE_MAPPED_LOADER(function, extension)              \
+    namespace                                                                  \
+    {                                                                          \
+    class StaticDefineMappedLoader                                             \
+    {                                                                          \
+    public:                                                                    \
+        StaticDefineMappedLoader()                                             \
+        {                                                                      \
+            omi::res::ResourceRegistry::instance()->define_mapped_loader(      \
+                function,                                                      \
+                extension                                                      \
+            );                                                                 \
+        }                                                                      \
+    };                                                                         \
+    static const StaticDefineMappedLoader define_mapped_loader;                \
+    }
+
 #endif
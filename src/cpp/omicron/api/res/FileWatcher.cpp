@@ -0,0 +1,147 @@
+#include "omicron/api/res/FileWatcher.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <unordered_set>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Preproc.hpp>
+
+#ifdef ARC_OS_UNIX
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT FileWatcher::FileWatcher()
+    : m_instance(-1)
+{
+    #ifdef ARC_OS_UNIX
+
+        m_instance = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(m_instance < 0)
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "Failed to initialise inotify: " << std::strerror(errno);
+            throw arc::ex::IOError(error_message);
+        }
+
+    #endif
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT FileWatcher::~FileWatcher()
+{
+    #ifdef ARC_OS_UNIX
+
+        if(m_instance >= 0)
+        {
+            close(m_instance);
+        }
+
+    #endif
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT bool FileWatcher::is_supported()
+{
+    #ifdef ARC_OS_UNIX
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void FileWatcher::watch(const arc::io::sys::Path& directory)
+{
+    #ifdef ARC_OS_UNIX
+
+        // editors either write files in place or replace them with a new file
+        int descriptor = inotify_add_watch(
+            m_instance,
+            directory.to_native().get_raw(),
+            IN_CLOSE_WRITE | IN_MOVED_TO
+        );
+        if(descriptor < 0)
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "Failed to watch directory \"" << directory.to_native()
+                << "\": " << std::strerror(errno);
+            throw arc::ex::IOError(error_message);
+        }
+        m_directories[descriptor] = directory;
+
+    #endif
+}
+
+OMI_API_EXPORT std::vector<arc::io::sys::Path> FileWatcher::poll()
+{
+    std::vector<arc::io::sys::Path> changed;
+
+    #ifdef ARC_OS_UNIX
+
+        std::unordered_set<arc::str::UTF8String> reported;
+        alignas(inotify_event) char buffer[4096];
+        while(true)
+        {
+            // the instance is non-blocking so this fails once it's drained
+            ssize_t length = read(m_instance, buffer, sizeof(buffer));
+            if(length <= 0)
+            {
+                break;
+            }
+
+            const char* event_data = buffer;
+            while(event_data < buffer + length)
+            {
+                const inotify_event* event =
+                    reinterpret_cast<const inotify_event*>(event_data);
+                event_data += sizeof(inotify_event) + event->len;
+
+                if(event->len == 0 || (event->mask & IN_ISDIR) != 0)
+                {
+                    continue;
+                }
+                auto f_directory = m_directories.find(event->wd);
+                if(f_directory == m_directories.end())
+                {
+                    continue;
+                }
+
+                arc::io::sys::Path path(f_directory->second);
+                path << arc::str::UTF8String(event->name);
+                if(reported.insert(path.to_unix()).second)
+                {
+                    changed.push_back(path);
+                }
+            }
+        }
+
+    #endif
+
+    return changed;
+}
+
+} // namespace res
+} // namespace omi
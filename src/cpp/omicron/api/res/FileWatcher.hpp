@@ -0,0 +1,98 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_RES_FILEWATCHER_HPP_
+#define OMICRON_API_RES_FILEWATCHER_HPP_
+
+#include <unordered_map>
+#include <vector>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+#include <arcanecore/io/sys/Path.hpp>
+
+#include "omicron/api/API.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+/*!
+ * \brief Reports the files that have been modified in a set of directories.
+ *
+ * Changes are queued by the operating system (using inotify) and are collected
+ * by poll(), which never blocks, so the watcher can be polled once per frame
+ * without a thread of its own. Watching is only supported on Linux, elsewhere
+ * no changes are ever reported.
+ */
+class FileWatcher
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new watcher which is not watching any directories.
+     *
+     * \throw arc::ex::IOError If file watching is supported but could not be
+     *                         initialised.
+     */
+    OMI_API_EXPORT FileWatcher();
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~FileWatcher();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether file watching is supported on this platform.
+     */
+    OMI_API_EXPORT static bool is_supported();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Starts reporting changes to the files in the given directory (but
+     *        not in its subdirectories).
+     *
+     * \throw arc::ex::IOError If the directory could not be watched.
+     */
+    OMI_API_EXPORT void watch(const arc::io::sys::Path& directory);
+
+    /*!
+     * \brief Returns the paths of the files in the watched directories which
+     *        have been written or replaced since the last call, each path is
+     *        only returned once.
+     */
+    OMI_API_EXPORT std::vector<arc::io::sys::Path> poll();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the inotify instance, or -1 if watching is not supported
+    int m_instance;
+    // mapping from inotify watch descriptors to the watched directories
+    std::unordered_map<int, arc::io::sys::Path> m_directories;
+};
+
+} // namespace res
+} // namespace omi
+
+#endif
@@ -0,0 +1,322 @@
+#include "omicron/api/res/MappedFile.hpp"
+
+#include "omicron/api/res/Compression.hpp"
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Preproc.hpp>
+
+#ifdef ARC_OS_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// releases the reference to a MappedFile held by borrowed data
+void release_mapping(void* user_data)
+{
+    delete static_cast<std::shared_ptr<const MappedFile>*>(user_data);
+}
+
+// throws an IndexOutOfBoundsError if the given range is outside of a file of
+// the given size
+void check_range(
+        const arc::io::sys::Path& path,
+        std::size_t size,
+        std::size_t offset,
+        std::size_t length)
+{
+    if(offset > size || length > size - offset)
+    {
+        arc::str::UTF8String error_message;
+        error_message
+            << "Range [" << offset << ", " << (offset + length) << ") is out "
+            << "of bounds of the " << size << " bytes mapped from \""
+            << path.to_unix() << "\"";
+        throw arc::ex::IndexOutOfBoundsError(error_message);
+    }
+}
+
+// throws an IOError for the given file
+void throw_map_error(
+        const arc::io::sys::Path& path,
+        const arc::str::UTF8String& reason)
+{
+    arc::str::UTF8String error_message;
+    error_message
+        << "Failed to memory map \"" << path.to_unix() << "\": " << reason;
+    throw arc::ex::IOError(error_message);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT std::shared_ptr<MappedFile> MappedFile::open(
+        const arc::io::sys::Path& path)
+{
+    return std::shared_ptr<MappedFile>(new MappedFile(path));
+}
+
+OMI_API_EXPORT std::shared_ptr<MappedFile> MappedFile::read(
+        arc::io::sys::FileReader& reader)
+{
+    return std::shared_ptr<MappedFile>(new MappedFile(reader));
+}
+
+OMI_API_EXPORT std::shared_ptr<MappedFile> MappedFile::view(
+        const std::shared_ptr<const MappedFile>& file,
+        std::size_t offset,
+        std::size_t length,
+        const arc::io::sys::Path& path)
+{
+    return std::shared_ptr<MappedFile>(
+        new MappedFile(file, offset, length, path)
+    );
+}
+
+OMI_API_EXPORT std::shared_ptr<MappedFile> MappedFile::decompress(
+        const char* data,
+        std::size_t length,
+        std::size_t decompressed_length,
+        const arc::io::sys::Path& path)
+{
+    return std::shared_ptr<MappedFile>(
+        new MappedFile(data, length, decompressed_length, path)
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT MappedFile::~MappedFile()
+{
+    // views don't own their contents
+    if(m_data == nullptr || m_viewed)
+    {
+        return;
+    }
+
+    if(m_read)
+    {
+        delete[] m_data;
+        return;
+    }
+
+    #ifdef ARC_OS_WINDOWS
+        UnmapViewOfFile(m_data);
+    #else
+        munmap(m_data, m_size);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT omi::ByteAttribute::ArrayType MappedFile::borrow(
+        std::size_t offset,
+        std::size_t length) const
+{
+    check_range(m_path, m_size, offset, length);
+
+    if(length == 0)
+    {
+        return omi::ByteAttribute::ArrayType();
+    }
+
+    // the borrowed data holds a reference to this mapping
+    return omi::ByteAttribute::ArrayType::borrow(
+        m_data + offset,
+        length,
+        &release_mapping,
+        new std::shared_ptr<const MappedFile>(shared_from_this())
+    );
+}
+
+//------------------------------------------------------------------------------
+//                              PRIVATE CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+MappedFile::MappedFile(const arc::io::sys::Path& path)
+    : m_path(path)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_read(false)
+{
+    #ifdef ARC_OS_WINDOWS
+
+        HANDLE file = CreateFileA(
+            path.to_native().get_raw(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            throw_map_error(path, "file could not be opened");
+        }
+
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            throw_map_error(path, "file size could not be queried");
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+
+        // empty files can't be mapped
+        if(m_size == 0)
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        // the view keeps the file open
+        CloseHandle(file);
+        if(mapping == nullptr)
+        {
+            throw_map_error(path, "file mapping could not be created");
+        }
+
+        m_data = static_cast<char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+        );
+        CloseHandle(mapping);
+        if(m_data == nullptr)
+        {
+            throw_map_error(path, "file view could not be mapped");
+        }
+
+    #else
+
+        int file = ::open(path.to_native().get_raw(), O_RDONLY);
+        if(file == -1)
+        {
+            throw_map_error(path, "file could not be opened");
+        }
+
+        struct stat file_stat;
+        if(fstat(file, &file_stat) != 0)
+        {
+            close(file);
+            throw_map_error(path, "file size could not be queried");
+        }
+        m_size = static_cast<std::size_t>(file_stat.st_size);
+
+        // empty files can't be mapped
+        if(m_size == 0)
+        {
+            close(file);
+            return;
+        }
+
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        // the mapping keeps the file open
+        close(file);
+        if(data == MAP_FAILED)
+        {
+            throw_map_error(path, "file could not be mapped");
+        }
+        m_data = static_cast<char*>(data);
+
+        // resources are generally parsed from start to finish
+        madvise(m_data, m_size, MADV_SEQUENTIAL);
+
+    #endif
+}
+
+MappedFile::MappedFile(arc::io::sys::FileReader& reader)
+    : m_path(reader.get_path())
+    , m_data(nullptr)
+    , m_size(static_cast<std::size_t>(reader.get_size()))
+    , m_read(true)
+{
+    if(m_size == 0)
+    {
+        return;
+    }
+
+    m_data = new char[m_size];
+    try
+    {
+        reader.seek(0);
+        reader.read(m_data, static_cast<arc::int64>(m_size));
+    }
+    catch(...)
+    {
+        delete[] m_data;
+        throw;
+    }
+}
+
+MappedFile::MappedFile(
+        const std::shared_ptr<const MappedFile>& file,
+        std::size_t offset,
+        std::size_t length,
+        const arc::io::sys::Path& path)
+    : m_path  (path)
+    , m_data  (nullptr)
+    , m_size  (length)
+    , m_read  (false)
+    , m_viewed(file)
+{
+    check_range(file->get_path(), file->get_size(), offset, length);
+    if(length != 0)
+    {
+        m_data = const_cast<char*>(file->get_data()) + offset;
+    }
+}
+
+MappedFile::MappedFile(
+        const char* data,
+        std::size_t length,
+        std::size_t decompressed_length,
+        const arc::io::sys::Path& path)
+    : m_path(path)
+    , m_data(nullptr)
+    , m_size(decompressed_length)
+    , m_read(true)
+{
+    if(m_size == 0)
+    {
+        return;
+    }
+
+    m_data = new char[m_size];
+    try
+    {
+        omi::res::decompress(data, length, m_data, m_size);
+    }
+    catch(...)
+    {
+        delete[] m_data;
+        throw;
+    }
+}
+
+} // namespace res
+} // namespace omi
@@ -0,0 +1,208 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_RES_MAPPEDFILE_HPP_
+#define OMICRON_API_RES_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <memory>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+#include <arcanecore/io/sys/FileReader.hpp>
+#include <arcanecore/io/sys/Path.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/attribute/ByteAttribute.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+/*!
+ * \brief A read-only memory-mapped view of an entire file.
+ *
+ * Mapping a file allows resource loaders to parse its contents in place, and
+ * ByteAttributes to refer to its contents without copying them (see borrow()),
+ * rather than first reading the file into a heap buffer. The operating system
+ * pages the file in on demand and may drop clean pages under memory pressure.
+ *
+ * Files which can't be mapped (e.g. resources that are read from collated
+ * pages) can instead be read into memory owned by a MappedFile, so that loaders
+ * only need to support one interface. A range of another MappedFile (e.g. a
+ * resource stored in a ResourceArchive) can be viewed as a MappedFile too, and
+ * compressed data can be decompressed into memory owned by a MappedFile.
+ *
+ * MappedFiles are always owned by a std::shared_ptr, and the file remains
+ * mapped while any data borrowed from it is still referenced.
+ */
+class MappedFile
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+    , public std::enable_shared_from_this<MappedFile>
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Maps the file at the given path into memory.
+     *
+     * \throw arc::ex::IOError If the file cannot be opened or mapped.
+     */
+    OMI_API_EXPORT static std::shared_ptr<MappedFile> open(
+            const arc::io::sys::Path& path);
+
+    /*!
+     * \brief Reads the entire contents of the file opened by the given reader
+     *        into memory owned by the returned object.
+     *
+     * This should be used for files which can't be mapped.
+     */
+    OMI_API_EXPORT static std::shared_ptr<MappedFile> read(
+            arc::io::sys::FileReader& reader);
+
+    /*!
+     * \brief Returns a MappedFile which refers to the given range of the given
+     *        file's contents without copying it.
+     *
+     * The given file will remain mapped while the view, or any data borrowed
+     * from the view, is still referenced.
+     *
+     * \param file The file to view a range of.
+     * \param offset The offset in bytes of the start of the range.
+     * \param length The number of bytes in the range.
+     * \param path The path reported by the view, e.g. the path of the resource
+     *             stored in the range.
+     *
+     * \throw arc::ex::IndexOutOfBoundsError If the range extends past the end
+     *                                       of the file.
+     */
+    OMI_API_EXPORT static std::shared_ptr<MappedFile> view(
+            const std::shared_ptr<const MappedFile>& file,
+            std::size_t offset,
+            std::size_t length,
+            const arc::io::sys::Path& path);
+
+    /*!
+     * \brief Decompresses the given block (see omi::res::compress()) into
+     *        memory owned by the returned object.
+     *
+     * \param data The compressed block.
+     * \param length The length of the compressed block in bytes.
+     * \param decompressed_length The length of the data before it was
+     *                            compressed, which will be the size of the
+     *                            returned file.
+     * \param path The path reported by the returned file.
+     *
+     * \throw arc::ex::ParseError If the block is invalid.
+     */
+    OMI_API_EXPORT static std::shared_ptr<MappedFile> decompress(
+            const char* data,
+            std::size_t length,
+            std::size_t decompressed_length,
+            const arc::io::sys::Path& path);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~MappedFile();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the path of the mapped file.
+     */
+    const arc::io::sys::Path& get_path() const
+    {
+        return m_path;
+    }
+
+    /*!
+     * \brief Returns the size of the file in bytes.
+     */
+    std::size_t get_size() const
+    {
+        return m_size;
+    }
+
+    /*!
+     * \brief Returns a pointer to the start of the file's contents, this is
+     *        null if the file is empty.
+     */
+    const char* get_data() const
+    {
+        return m_data;
+    }
+
+    /*!
+     * \brief Returns an array which refers to the given range of the file's
+     *        contents without copying it.
+     *
+     * The file will remain mapped until the returned array (and any attributes
+     * that it is used by) has been released, see omi::DataArray::borrow().
+     *
+     * \param offset The offset in bytes of the start of the range.
+     * \param length The number of bytes in the range.
+     *
+     * \throw arc::ex::IndexOutOfBoundsError If the range extends past the end
+     *                                       of the file.
+     */
+    OMI_API_EXPORT omi::ByteAttribute::ArrayType borrow(
+            std::size_t offset,
+            std::size_t length) const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the path to the file
+    arc::io::sys::Path m_path;
+    // the mapped contents of the file
+    char* m_data;
+    // the size of the file in bytes
+    std::size_t m_size;
+    // whether the contents were read into memory rather than mapped
+    bool m_read;
+    // the file this is a view of, which owns the contents
+    std::shared_ptr<const MappedFile> m_viewed;
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    // maps the file at the given path
+    MappedFile(const arc::io::sys::Path& path);
+
+    // reads the file opened by the given reader
+    MappedFile(arc::io::sys::FileReader& reader);
+
+    // views the given range of the given file
+    MappedFile(
+            const std::shared_ptr<const MappedFile>& file,
+            std::size_t offset,
+            std::size_t length,
+            const arc::io::sys::Path& path);
+
+    // decompresses the given block
+    MappedFile(
+            const char* data,
+            std::size_t length,
+            std::size_t decompressed_length,
+            const arc::io::sys::Path& path);
+};
+
+} // namespace res
+} // namespace omi
+
+#endif
@@ -0,0 +1,57 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_RES_RELOADLISTENER_HPP_
+#define OMICRON_API_RES_RELOADLISTENER_HPP_
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/attribute/Attribute.hpp"
+#include "omicron/api/res/ResourceId.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+/*!
+ * \brief The ReloadListener class should be inherited from by objects that
+ *        hold data derived from a resource, so that they can rebuild it when
+ *        the resource is reloaded.
+ *
+ * Listeners are added with ResourceRegistry::add_reload_listener() and must be
+ * removed with ResourceRegistry::remove_reload_listener() before they are
+ * destroyed.
+ */
+class ReloadListener
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    virtual ~ReloadListener()
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Is called by ResourceRegistry::frame_routine() when a resource
+     *        this object listens to has been reloaded.
+     *
+     * \param id The id of the reloaded resource.
+     * \param data The new data of the resource, which has already replaced the
+     *             previous data in the ResourceRegistry.
+     */
+    virtual void on_reload(ResourceId id, const omi::Attribute& data) = 0;
+};
+
+} // namespace res
+} // namespace omi
+
+#endif
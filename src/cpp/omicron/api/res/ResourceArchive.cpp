@@ -0,0 +1,348 @@
+#include "omicron/api/res/ResourceArchive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Types.hpp>
+#include <arcanecore/crypt/hash/Spooky.hpp>
+
+#include "omicron/api/res/Compression.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the header at the start of an archive
+struct Header
+{
+    // identifies the data as an archive
+    char magic[4];
+    // the version of the archive format
+    arc::uint32 version;
+    // the number of resources in the archive
+    arc::uint64 count;
+};
+
+// an entry of the table of resources that follows the header
+struct Entry
+{
+    arc::uint64 id;
+    // the location of the stored data of the resource in the archive
+    arc::uint64 offset;
+    arc::uint64 length;
+    // the length of the resource once decompressed (the same as the stored
+    // length if the resource is not compressed)
+    arc::uint64 decompressed_length;
+    // FLAG_* bits describing how the data is stored
+    arc::uint64 flags;
+};
+
+// the data stored in an archive, which is shared by every resource that has
+// identical contents
+struct Blob
+{
+    // the resource the data is read from
+    std::shared_ptr<MappedFile> file;
+    // the compressed data, if the resource is stored compressed
+    std::vector<char> compressed;
+    // the location and format of the stored data
+    Entry entry;
+};
+
+// the magic bytes at the start of an archive
+static const char MAGIC[4] = {'O', 'M', 'I', 'A'};
+// the version of the archive written by this build
+static const arc::uint32 VERSION = 2;
+// flags the stored data of a resource as compressed
+static const arc::uint64 FLAG_COMPRESSED = 1U << 0;
+// the flags this build can load
+static const arc::uint64 SUPPORTED_FLAGS = FLAG_COMPRESSED;
+// compressed data is only stored if it saves at least this fraction of the
+// resource's length
+static const std::size_t MIN_SAVING_FRACTION = 8;
+
+// returns the given offset rounded up to the alignment of the resources
+arc::uint64 align_offset(arc::uint64 offset)
+{
+    arc::uint64 alignment = ResourceArchive::kAlignment;
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+// throws a parse error for the given archive
+void throw_archive_error(const arc::io::sys::Path& path, const char* reason)
+{
+    arc::str::UTF8String error_message;
+    error_message
+        << "Invalid resource archive \"" << path.to_unix() << "\": " << reason;
+    throw arc::ex::ParseError(error_message);
+}
+
+// writes the given data to the given stream, throwing if it fails
+void write_data(std::ostream& stream, const char* data, std::size_t size)
+{
+    stream.write(data, static_cast<std::streamsize>(size));
+    if(!stream.good())
+    {
+        throw arc::ex::IOError("Failed to write resource archive");
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC ATTRIBUTES
+//------------------------------------------------------------------------------
+
+// (the alignment of AttributeCodec blocks within cooked files is relative to
+// the start of the file, so this must be a multiple of it)
+OMI_API_EXPORT const std::size_t ResourceArchive::kAlignment = 64;
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceArchive::ResourceArchive(const arc::io::sys::Path& path)
+    : m_file (MappedFile::open(path))
+    , m_count(0)
+    , m_table(nullptr)
+{
+    Header header;
+    if(m_file->get_size() < sizeof(Header))
+    {
+        throw_archive_error(path, "Missing header.");
+    }
+    std::memcpy(&header, m_file->get_data(), sizeof(Header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw_archive_error(path, "Invalid magic.");
+    }
+    if(header.version != VERSION)
+    {
+        throw_archive_error(path, "Unsupported version.");
+    }
+    if(header.count > (m_file->get_size() - sizeof(Header)) / sizeof(Entry))
+    {
+        throw_archive_error(path, "Truncated table.");
+    }
+
+    m_count = static_cast<std::size_t>(header.count);
+    m_table = m_file->get_data() + sizeof(Header);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceArchive::~ResourceArchive()
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void ResourceArchive::write(
+        const std::vector<arc::io::sys::Path>& resources,
+        std::ostream& stream,
+        bool compress)
+{
+    // the data follows the table, with resources that have identical contents
+    // sharing the data of the first of them
+    std::vector<Entry> entries;
+    entries.reserve(resources.size());
+    std::vector<Blob> blobs;
+    std::map<std::tuple<arc::uint64, arc::uint64, arc::uint64>, std::size_t>
+        blob_hashes;
+    arc::uint64 offset =
+        align_offset(sizeof(Header) + (resources.size() * sizeof(Entry)));
+    for(const arc::io::sys::Path& resource : resources)
+    {
+        // the resources stay mapped until the archive has been written so
+        // that their contents can't change in between
+        std::shared_ptr<MappedFile> file = MappedFile::open(resource);
+        std::size_t size = file->get_size();
+
+        std::tuple<arc::uint64, arc::uint64, arc::uint64> hash(0, 0, size);
+        arc::crypt::hash::spooky_128(
+            file->get_data(),
+            size,
+            std::get<0>(hash),
+            std::get<1>(hash),
+            size,
+            size
+        );
+        auto f_blob = blob_hashes.find(hash);
+        if(f_blob != blob_hashes.end() &&
+           (size == 0 || std::memcmp(
+               blobs[f_blob->second].file->get_data(),
+               file->get_data(),
+               size
+           ) == 0))
+        {
+            Entry entry = blobs[f_blob->second].entry;
+            entry.id = omi::res::get_id(resource);
+            entries.push_back(entry);
+            continue;
+        }
+
+        Blob blob;
+        blob.file = file;
+        blob.entry.id = omi::res::get_id(resource);
+        blob.entry.offset = offset;
+        blob.entry.length = size;
+        blob.entry.decompressed_length = size;
+        blob.entry.flags = 0;
+        if(compress && size != 0)
+        {
+            omi::res::compress(file->get_data(), size, blob.compressed);
+            if(blob.compressed.size() <= size - (size / MIN_SAVING_FRACTION))
+            {
+                blob.entry.length = blob.compressed.size();
+                blob.entry.flags |= FLAG_COMPRESSED;
+            }
+            else
+            {
+                std::vector<char>().swap(blob.compressed);
+            }
+        }
+        offset = align_offset(offset + blob.entry.length);
+
+        entries.push_back(blob.entry);
+        blob_hashes.insert(std::make_pair(hash, blobs.size()));
+        blobs.push_back(std::move(blob));
+    }
+
+    // the table is sorted by id, while the data stays in the given order
+    std::vector<Entry> table(entries);
+    std::sort(
+        table.begin(),
+        table.end(),
+        [](const Entry& a, const Entry& b)
+        {
+            return a.id < b.id;
+        }
+    );
+    for(std::size_t i = 1; i < table.size(); ++i)
+    {
+        if(table[i].id == table[i - 1].id)
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "ResourceId collision on id " << std::to_string(table[i].id)
+                << " in resource archive";
+            throw arc::ex::KeyError(error_message);
+        }
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count = table.size();
+    write_data(stream, reinterpret_cast<const char*>(&header), sizeof(Header));
+    if(!table.empty())
+    {
+        write_data(
+            stream,
+            reinterpret_cast<const char*>(table.data()),
+            table.size() * sizeof(Entry)
+        );
+    }
+
+    static const std::vector<char> padding(kAlignment, 0);
+    arc::uint64 position = sizeof(Header) + (table.size() * sizeof(Entry));
+    for(const Blob& blob : blobs)
+    {
+        write_data(
+            stream,
+            padding.data(),
+            static_cast<std::size_t>(blob.entry.offset - position)
+        );
+        if(blob.entry.flags & FLAG_COMPRESSED)
+        {
+            write_data(stream, blob.compressed.data(), blob.compressed.size());
+        }
+        else if(blob.entry.length != 0)
+        {
+            write_data(stream, blob.file->get_data(), blob.file->get_size());
+        }
+        position = blob.entry.offset + blob.entry.length;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT std::size_t ResourceArchive::get_count() const
+{
+    return m_count;
+}
+
+OMI_API_EXPORT std::shared_ptr<MappedFile> ResourceArchive::find(
+        const arc::io::sys::Path& path) const
+{
+    ResourceId id = omi::res::get_id(path);
+
+    // binary search the table
+    std::size_t first = 0;
+    std::size_t last = m_count;
+    while(first < last)
+    {
+        std::size_t middle = first + ((last - first) / 2);
+        Entry entry;
+        std::memcpy(&entry, m_table + (middle * sizeof(Entry)), sizeof(Entry));
+        if(entry.id < id)
+        {
+            first = middle + 1;
+        }
+        else if(id < entry.id)
+        {
+            last = middle;
+        }
+        else
+        {
+            if((entry.flags & ~SUPPORTED_FLAGS) != 0)
+            {
+                throw_archive_error(
+                    m_file->get_path(),
+                    "Unsupported resource flags."
+                );
+            }
+
+            // (throws if the entry is outside of the archive)
+            std::shared_ptr<MappedFile> view = MappedFile::view(
+                m_file,
+                static_cast<std::size_t>(entry.offset),
+                static_cast<std::size_t>(entry.length),
+                path
+            );
+            if((entry.flags & FLAG_COMPRESSED) == 0)
+            {
+                return view;
+            }
+            return MappedFile::decompress(
+                view->get_data(),
+                view->get_size(),
+                static_cast<std::size_t>(entry.decompressed_length),
+                path
+            );
+        }
+    }
+    return nullptr;
+}
+
+} // namespace res
+} // namespace omi
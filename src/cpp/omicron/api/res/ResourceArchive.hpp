@@ -0,0 +1,142 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_RES_RESOURCEARCHIVE_HPP_
+#define OMICRON_API_RES_RESOURCEARCHIVE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+#include <arcanecore/io/sys/Path.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/res/MappedFile.hpp"
+#include "omicron/api/res/ResourceId.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+/*!
+ * \brief A read-only memory-mapped package of resources stored in a single
+ *        file.
+ *
+ * ArcaneCore's collated pages can only be read through an arc::col::Reader, so
+ * resources loaded from them are always copied into memory. The omicron_cook
+ * tool therefore also writes the resources of a package to an archive (see
+ * tools/collate_resources.bash), which the ResourceRegistry maps once so that
+ * loaders can parse its resources in place.
+ *
+ * Each resource is stored at an offset aligned to kAlignment, and is found by a
+ * binary search of a table of the resource ids. Resources with identical
+ * contents share the same stored data. Resources are stored uncompressed so
+ * they can be parsed in place, unless the archive was written with compression
+ * and the resource compresses well, in which case find() decompresses it.
+ */
+class ResourceArchive
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief The alignment in bytes of the resources in an archive.
+     */
+    OMI_API_EXPORT static const std::size_t kAlignment;
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Maps the archive at the given path.
+     *
+     * \throw arc::ex::IOError If the archive cannot be opened or mapped.
+     * \throw arc::ex::ParseError If the file is not a valid archive.
+     */
+    OMI_API_EXPORT ResourceArchive(const arc::io::sys::Path& path);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~ResourceArchive();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC STATIC FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Writes an archive of the given resources to the given stream.
+     *
+     * The resources are stored in the order they are given, a resource whose
+     * contents are identical to an earlier resource refers to the earlier
+     * resource's data rather than storing it again.
+     *
+     * \param resources The paths of the resources to archive.
+     * \param stream The stream to write the archive to.
+     * \param compress Whether resources which compress well should be stored
+     *                 compressed (see omi::res::compress()).
+     *
+     * \throw arc::ex::IOError If a resource could not be read or the archive
+     *                         could not be written.
+     * \throw arc::ex::KeyError If two resources have the same id.
+     */
+    OMI_API_EXPORT static void write(
+            const std::vector<arc::io::sys::Path>& resources,
+            std::ostream& stream,
+            bool compress = false);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of resources in the archive.
+     */
+    OMI_API_EXPORT std::size_t get_count() const;
+
+    /*!
+     * \brief Returns a view of the data of the resource at the given path, or
+     *        null if the resource is not in the archive.
+     *
+     * The archive remains mapped while the view, or any data borrowed from it,
+     * is still referenced. If the resource is stored compressed it is instead
+     * decompressed into memory owned by the returned object, so this should be
+     * called on the thread which is loading the resource.
+     *
+     * \throw arc::ex::ParseError If the resource's entry is invalid or its
+     *                            data could not be decompressed.
+     */
+    OMI_API_EXPORT std::shared_ptr<MappedFile> find(
+            const arc::io::sys::Path& path) const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the mapped archive
+    std::shared_ptr<const MappedFile> m_file;
+    // the number of resources in the archive
+    std::size_t m_count;
+    // the table of resources, sorted by id
+    const char* m_table;
+};
+
+} // namespace res
+} // namespace omi
+
+#endif
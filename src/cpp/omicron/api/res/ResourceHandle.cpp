@@ -0,0 +1,140 @@
+#include "omicron/api/res/ResourceHandle.hpp"
+
+#include <utility>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include "omicron/api/res/ResourceRegistry.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceHandle::ResourceHandle()
+    : m_valid(false)
+    , m_id   (0)
+{
+}
+
+OMI_API_EXPORT ResourceHandle::ResourceHandle(const ResourceHandle& other)
+    : m_valid(other.m_valid)
+    , m_id   (other.m_id)
+    , m_data (other.m_data)
+{
+    if(m_valid)
+    {
+        ResourceRegistry::instance()->add_reference(m_id);
+    }
+}
+
+OMI_API_EXPORT ResourceHandle::ResourceHandle(ResourceHandle&& other)
+    : m_valid(other.m_valid)
+    , m_id   (other.m_id)
+    , m_data (other.m_data)
+{
+    other.m_valid = false;
+    other.m_id = 0;
+    other.m_data = omi::Attribute();
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceHandle::~ResourceHandle()
+{
+    release();
+}
+
+//------------------------------------------------------------------------------
+//                                   OPERATORS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceHandle& ResourceHandle::operator=(
+        const ResourceHandle& other)
+{
+    if(this != &other)
+    {
+        ResourceHandle copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+OMI_API_EXPORT ResourceHandle& ResourceHandle::operator=(
+        ResourceHandle&& other)
+{
+    if(this != &other)
+    {
+        release();
+        m_valid = other.m_valid;
+        m_id = other.m_id;
+        m_data = other.m_data;
+        other.m_valid = false;
+        other.m_id = 0;
+        other.m_data = omi::Attribute();
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceId ResourceHandle::get_id() const
+{
+    check_state("get_id() used on an invalid resource handle");
+    return m_id;
+}
+
+OMI_API_EXPORT const omi::Attribute& ResourceHandle::get() const
+{
+    check_state("get() used on an invalid resource handle");
+    return m_data;
+}
+
+OMI_API_EXPORT void ResourceHandle::release()
+{
+    if(!m_valid)
+    {
+        return;
+    }
+
+    // drop the data before the registry may evict the resource
+    m_data = omi::Attribute();
+    m_valid = false;
+    ResourceRegistry::instance()->release_reference(m_id);
+    m_id = 0;
+}
+
+//------------------------------------------------------------------------------
+//                              PRIVATE CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+ResourceHandle::ResourceHandle(ResourceId id, const omi::Attribute& data)
+    : m_valid(true)
+    , m_id   (id)
+    , m_data (data)
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ResourceHandle::check_state(const arc::str::UTF8String& message) const
+{
+    if(!m_valid)
+    {
+        throw arc::ex::StateError(message);
+    }
+}
+
+} // namespace res
+} // namespace omi
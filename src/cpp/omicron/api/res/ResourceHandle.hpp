@@ -0,0 +1,152 @@
+/*!
+ * \file
+ * \author David Saxon
+ */
+#ifndef OMICRON_API_RES_RESOURCEHANDLE_HPP_
+#define OMICRON_API_RES_RESOURCEHANDLE_HPP_
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/attribute/Attribute.hpp"
+#include "omicron/api/res/ResourceId.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+/*!
+ * \brief A counted reference to a resource that is loaded in the
+ *        ResourceRegistry.
+ *
+ * While at least one handle to a resource exists the ResourceRegistry will
+ * keep the resource loaded. Once the last handle has been released the
+ * resource remains loaded (so it can be reacquired without being reloaded)
+ * until the registry needs to evict it to stay within its memory budget.
+ *
+ * Handles are acquired through ResourceRegistry::acquire().
+ *
+ * \note Handles must only be used from the same thread as the
+ *       ResourceRegistry.
+ */
+class ResourceHandle
+{
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class ResourceRegistry;
+
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new handle which does not refer to any resource.
+     */
+    OMI_API_EXPORT ResourceHandle();
+
+    /*!
+     * \brief Creates a new handle to the same resource as the given handle.
+     */
+    OMI_API_EXPORT ResourceHandle(const ResourceHandle& other);
+
+    /*!
+     * \brief Moves the reference held by the given handle to a new handle,
+     *        leaving the other handle not referring to any resource.
+     */
+    OMI_API_EXPORT ResourceHandle(ResourceHandle&& other);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~ResourceHandle();
+
+    //--------------------------------------------------------------------------
+    //                                 OPERATORS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Releases the resource referenced by this handle and references
+     *        the same resource as the other handle.
+     */
+    OMI_API_EXPORT ResourceHandle& operator=(const ResourceHandle& other);
+
+    /*!
+     * \brief Releases the resource referenced by this handle and takes the
+     *        reference held by the other handle.
+     */
+    OMI_API_EXPORT ResourceHandle& operator=(ResourceHandle&& other);
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns whether this handle refers to a resource.
+     */
+    bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    /*!
+     * \brief Returns the id of the resource this handle refers to.
+     *
+     * \throw arc::ex::StateError If this handle is not valid.
+     */
+    OMI_API_EXPORT ResourceId get_id() const;
+
+    /*!
+     * \brief Returns the data of the resource this handle refers to.
+     *
+     * \throw arc::ex::StateError If this handle is not valid.
+     */
+    OMI_API_EXPORT const omi::Attribute& get() const;
+
+    /*!
+     * \brief Releases the resource this handle refers to, after which this
+     *        handle is no longer valid.
+     *
+     * This has no effect if this handle is not valid.
+     */
+    OMI_API_EXPORT void release();
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // whether this handle refers to a resource
+    bool m_valid;
+    // the id of the referenced resource
+    ResourceId m_id;
+    // the data of the referenced resource
+    omi::Attribute m_data;
+
+    //--------------------------------------------------------------------------
+    //                            PRIVATE CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    // creates a handle to the given resource, the registry must have already
+    // counted the reference
+    ResourceHandle(ResourceId id, const omi::Attribute& data);
+
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // throws if this handle is not valid
+    void check_state(const arc::str::UTF8String& message) const;
+};
+
+} // namespace res
+} // namespace omi
+
+#endif
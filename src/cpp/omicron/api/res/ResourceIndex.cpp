@@ -0,0 +1,311 @@
+#include "omicron/api/res/ResourceIndex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Types.hpp>
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the header at the start of an index
+struct Header
+{
+    // identifies the data as an index
+    char magic[4];
+    // the version of the index format
+    arc::uint32 version;
+    // the number of entries in the index
+    arc::uint64 count;
+    // the length of the path table that follows the entries
+    arc::uint64 paths_length;
+};
+
+// an entry of an index
+struct Entry
+{
+    arc::uint64 id;
+    arc::uint64 read_order;
+    // the location of the unix path of the resource in the path table
+    arc::uint64 path_offset;
+    arc::uint64 path_length;
+};
+
+// the magic bytes at the start of an index
+static const char MAGIC[4] = {'O', 'M', 'I', 'X'};
+// the version of the index written by this build
+static const arc::uint32 VERSION = 1;
+
+// throws a parse error for an invalid index
+void throw_index_error(const char* reason)
+{
+    arc::str::UTF8String error_message;
+    error_message << "Invalid resource index: " << reason;
+    throw arc::ex::ParseError(error_message);
+}
+
+// returns the path for the given unix path
+arc::io::sys::Path to_path(const char* unix_path, std::size_t length)
+{
+    std::vector<arc::str::UTF8String> components;
+    const char* end = unix_path + length;
+    const char* start = unix_path;
+    for(const char* c = unix_path; c <= end; ++c)
+    {
+        if(c == end || *c == '/')
+        {
+            if(c != start)
+            {
+                components.push_back(arc::str::UTF8String(
+                    start,
+                    static_cast<std::size_t>(c - start)
+                ));
+            }
+            start = c + 1;
+        }
+    }
+    return arc::io::sys::Path(components);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceIndex::ResourceIndex(
+        const char* data,
+        std::size_t length)
+    : m_count       (0)
+    , m_entries     (nullptr)
+    , m_paths       (nullptr)
+    , m_paths_length(0)
+{
+    Header header;
+    if(length < sizeof(Header))
+    {
+        throw_index_error("Missing header.");
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw_index_error("Invalid magic.");
+    }
+    if(header.version != VERSION)
+    {
+        throw_index_error("Unsupported version.");
+    }
+    if(header.count > (length - sizeof(Header)) / sizeof(Entry) ||
+       header.paths_length !=
+       length - sizeof(Header) - (header.count * sizeof(Entry)))
+    {
+        throw_index_error("Unexpected length.");
+    }
+
+    m_count = static_cast<std::size_t>(header.count);
+    m_entries = data + sizeof(Header);
+    m_paths = m_entries + (m_count * sizeof(Entry));
+    m_paths_length = static_cast<std::size_t>(header.paths_length);
+}
+
+//------------------------------------------------------------------------------
+//                                   DESTRUCTOR
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceIndex::~ResourceIndex()
+{
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT std::size_t ResourceIndex::get_count() const
+{
+    return m_count;
+}
+
+OMI_API_EXPORT bool ResourceIndex::find(
+        ResourceId id,
+        std::size_t& position) const
+{
+    // binary search the entries
+    std::size_t first = 0;
+    std::size_t last = m_count;
+    while(first < last)
+    {
+        std::size_t middle = first + ((last - first) / 2);
+        ResourceId middle_id = get_id(middle);
+        if(middle_id < id)
+        {
+            first = middle + 1;
+        }
+        else if(id < middle_id)
+        {
+            last = middle;
+        }
+        else
+        {
+            position = middle;
+            return true;
+        }
+    }
+    return false;
+}
+
+OMI_API_EXPORT ResourceId ResourceIndex::get_id(std::size_t position) const
+{
+    // only the id is read since this is called by each step of find()
+    arc::uint64 id;
+    std::memcpy(
+        &id,
+        m_entries + (position * sizeof(Entry)) + offsetof(Entry, id),
+        sizeof(id)
+    );
+    return id;
+}
+
+OMI_API_EXPORT std::size_t ResourceIndex::get_read_order(
+        std::size_t position) const
+{
+    Entry entry;
+    std::memcpy(&entry, m_entries + (position * sizeof(Entry)), sizeof(Entry));
+    return static_cast<std::size_t>(entry.read_order);
+}
+
+OMI_API_EXPORT const char* ResourceIndex::get_unix_path(
+        std::size_t position,
+        std::size_t& length) const
+{
+    Entry entry;
+    std::memcpy(&entry, m_entries + (position * sizeof(Entry)), sizeof(Entry));
+    if(entry.path_offset > m_paths_length ||
+       entry.path_length > m_paths_length - entry.path_offset)
+    {
+        throw_index_error("Path out of bounds.");
+    }
+
+    length = static_cast<std::size_t>(entry.path_length);
+    return m_paths + entry.path_offset;
+}
+
+OMI_API_EXPORT arc::io::sys::Path ResourceIndex::get_path(
+        std::size_t position) const
+{
+    std::size_t length = 0;
+    const char* unix_path = get_unix_path(position, length);
+    return to_path(unix_path, length);
+}
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void encode_index(
+        const std::vector<arc::io::sys::Path>& resources,
+        std::vector<char>& index)
+{
+    std::vector<Entry> entries;
+    entries.reserve(resources.size());
+    std::vector<char> paths;
+    for(const arc::io::sys::Path& resource : resources)
+    {
+        arc::str::UTF8String unix_path = resource.to_unix();
+        std::size_t path_length = unix_path.get_byte_length() - 1;
+
+        Entry entry;
+        entry.id = omi::res::get_id(unix_path);
+        entry.read_order = entries.size();
+        entry.path_offset = paths.size();
+        entry.path_length = path_length;
+        entries.push_back(entry);
+
+        paths.insert(
+            paths.end(),
+            unix_path.get_raw(),
+            unix_path.get_raw() + path_length
+        );
+    }
+
+    std::sort(
+        entries.begin(),
+        entries.end(),
+        [](const Entry& a, const Entry& b)
+        {
+            return a.id < b.id;
+        }
+    );
+    for(std::size_t i = 1; i < entries.size(); ++i)
+    {
+        if(entries[i].id == entries[i - 1].id)
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "ResourceId collision on id "
+                << std::to_string(entries[i].id)
+                << " which is generated by both \""
+                << resources[entries[i - 1].read_order].to_unix() << "\" and \""
+                << resources[entries[i].read_order].to_unix() << "\"";
+            throw arc::ex::KeyError(error_message);
+        }
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.count = entries.size();
+    header.paths_length = paths.size();
+
+    std::size_t entries_length = entries.size() * sizeof(Entry);
+    index.resize(sizeof(Header) + entries_length + paths.size());
+    std::memcpy(index.data(), &header, sizeof(Header));
+    if(!entries.empty())
+    {
+        std::memcpy(
+            index.data() + sizeof(Header),
+            entries.data(),
+            entries_length
+        );
+    }
+    if(!paths.empty())
+    {
+        std::memcpy(
+            index.data() + sizeof(Header) + entries_length,
+            paths.data(),
+            paths.size()
+        );
+    }
+}
+
+OMI_API_EXPORT void decode_index(
+        const char* data,
+        std::size_t length,
+        std::vector<IndexEntry>& entries)
+{
+    ResourceIndex index(data, length);
+
+    entries.clear();
+    entries.resize(index.get_count());
+    for(std::size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].id = index.get_id(i);
+        entries[i].read_order = index.get_read_order(i);
+        entries[i].path = index.get_path(i);
+    }
+}
+
+} // namespace res
+} // namespace omi
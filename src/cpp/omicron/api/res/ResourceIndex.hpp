@@ -0,0 +1,204 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief The precomputed index of the resources in a package.
+ */
+#ifndef OMICRON_API_RES_RESOURCEINDEX_HPP_
+#define OMICRON_API_RES_RESOURCEINDEX_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <arcanecore/base/lang/Restrictors.hpp>
+#include <arcanecore/io/sys/Path.hpp>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/res/ResourceId.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief A resource described by a resource index.
+ */
+struct IndexEntry
+{
+    /*!
+     * \brief The id of the resource.
+     */
+    ResourceId id;
+    /*!
+     * \brief The position of the resource in the list of resources the index
+     *        was encoded from.
+     */
+    std::size_t read_order;
+    /*!
+     * \brief The path of the resource.
+     */
+    arc::io::sys::Path path;
+};
+
+//------------------------------------------------------------------------------
+//                                    CLASSES
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Looks up resources in an index written by encode_index() without
+ *        decoding it.
+ *
+ * Resources are found by a binary search of the entries, and their paths are
+ * only built when they are requested, so opening an index costs the same
+ * regardless of the number of resources in the package.
+ *
+ * The positions of the entries are in the order of their ids.
+ */
+class ResourceIndex
+    : private arc::lang::Noncopyable
+    , private arc::lang::Nonmovable
+    , private arc::lang::Noncomparable
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Opens the given encoded index.
+     *
+     * Only the header of the index is validated, the path of each entry is
+     * validated when it is requested.
+     *
+     * \param data The encoded index, which must remain valid for the lifetime
+     *             of this object.
+     * \param length The length of the encoded index in bytes.
+     *
+     * \throw arc::ex::ParseError If the data is not a valid index.
+     */
+    OMI_API_EXPORT ResourceIndex(const char* data, std::size_t length);
+
+    //--------------------------------------------------------------------------
+    //                                 DESTRUCTOR
+    //--------------------------------------------------------------------------
+
+    OMI_API_EXPORT ~ResourceIndex();
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Returns the number of resources in the index.
+     */
+    OMI_API_EXPORT std::size_t get_count() const;
+
+    /*!
+     * \brief Finds the entry of the resource with the given id.
+     *
+     * \param id The id of the resource to find.
+     * \param position Receives the position of the entry if it is found.
+     *
+     * \return Whether the resource is in the index.
+     */
+    OMI_API_EXPORT bool find(ResourceId id, std::size_t& position) const;
+
+    /*!
+     * \brief Returns the id of the resource at the given position.
+     */
+    OMI_API_EXPORT ResourceId get_id(std::size_t position) const;
+
+    /*!
+     * \brief Returns the position of the resource at the given position in
+     *        the list of resources the index was encoded from.
+     */
+    OMI_API_EXPORT std::size_t get_read_order(std::size_t position) const;
+
+    /*!
+     * \brief Returns the unix path of the resource at the given position.
+     *
+     * The returned data is not null terminated and is owned by the index.
+     *
+     * \param position The position of the entry.
+     * \param length Receives the length of the path in bytes.
+     *
+     * \throw arc::ex::ParseError If the path is outside of the index.
+     */
+    OMI_API_EXPORT const char* get_unix_path(
+            std::size_t position,
+            std::size_t& length) const;
+
+    /*!
+     * \brief Returns the path of the resource at the given position.
+     *
+     * \throw arc::ex::ParseError If the path is outside of the index.
+     */
+    OMI_API_EXPORT arc::io::sys::Path get_path(std::size_t position) const;
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the number of entries in the index
+    std::size_t m_count;
+    // the entries of the index, sorted by id
+    const char* m_entries;
+    // the table of the unix paths of the resources
+    const char* m_paths;
+    // the length of the path table in bytes
+    std::size_t m_paths_length;
+};
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Encodes an index of the given resources.
+ *
+ * The index is generated alongside the table of contents of a package (see
+ * tools/collate_resources.bash) so that the ResourceRegistry can discover the
+ * resources with a single read, rather than by listing the resource directory
+ * and computing the id of every resource. The entries of the index are sorted
+ * by id and refer to a table of the resource paths.
+ *
+ * \param resources The paths of the resources in the order they are read.
+ * \param index Receives the encoded index, which replaces any existing
+ *              contents.
+ *
+ * \throw arc::ex::KeyError If two resources have the same id.
+ */
+OMI_API_EXPORT void encode_index(
+        const std::vector<arc::io::sys::Path>& resources,
+        std::vector<char>& index);
+
+/*!
+ * \brief Decodes the entries of an index written by encode_index().
+ *
+ * This builds the path of every resource, so a ResourceIndex should be used
+ * where only some of the resources are needed.
+ *
+ * \param data The encoded index.
+ * \param length The length of the encoded index in bytes.
+ * \param entries Receives the entries of the index sorted by id, which replace
+ *                any existing contents.
+ *
+ * \throw arc::ex::ParseError If the data is not a valid index.
+ */
+OMI_API_EXPORT void decode_index(
+        const char* data,
+        std::size_t length,
+        std::vector<IndexEntry>& entries);
+
+} // namespace res
+} // namespace omi
+
+#endif
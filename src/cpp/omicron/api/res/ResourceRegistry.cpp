@@ -1,9 +1,21 @@
 #include "omicron/api/res/ResourceRegistry.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
+#include <sys/stat.h>
+
 #include <arcanecore/base/clock/ClockOperations.hpp>
 #include <arcanecore/col/Accessor.hpp>
 #include <arcanecore/col/Reader.hpp>
@@ -14,7 +26,12 @@
 #include "omicron/api/config/ConfigInline.hpp"
 #include "omicron/api/report/Logging.hpp"
 #include "omicron/api/report/stats/StatsDatabase.hpp"
+#include "omicron/api/res/FileWatcher.hpp"
+#include "omicron/api/res/MappedFile.hpp"
+#include "omicron/api/res/ResourceArchive.hpp"
 #include "omicron/api/res/ResourceGlobals.hpp"
+#include "omicron/api/res/ResourceIndex.hpp"
+#include "omicron/api/res/ReloadListener.hpp"
 #include "omicron/api/res/loaders/RawLoader.hpp"
 
 
@@ -23,6 +40,119 @@ namespace omi
 namespace res
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the suffix of the files written by the omicron_cook tool, which are loaded in
+// place of their source resource (e.g. "bunny.obj.cooked" for "bunny.obj")
+static const arc::str::UTF8String kCookedSuffix(".cooked");
+// the suffix of the files written by the omicron_cook tool in place of a cooked
+// file that would be identical to another, which hold the path of that file
+static const arc::str::UTF8String kCookedLinkSuffix(".cooked_link");
+
+// returns the last modification time of the given file, or 0 if it could not
+// be queried
+arc::int64 get_modified_time(const arc::io::sys::Path& path)
+{
+    struct stat file_stat;
+    if(stat(path.to_native().get_raw(), &file_stat) != 0)
+    {
+        return 0;
+    }
+    return static_cast<arc::int64>(file_stat.st_mtime);
+}
+
+// returns the number of bytes used by the values of the given data attribute
+template<typename T_AttributeType>
+std::size_t get_values_bytes(const omi::Attribute& attribute)
+{
+    return T_AttributeType(attribute).get_values().size() *
+        sizeof(typename T_AttributeType::DataType);
+}
+
+// returns the approximate number of bytes used by the given attribute and all
+// of its descendants
+std::size_t get_resident_bytes(const omi::Attribute& attribute)
+{
+    omi::Attribute::Type type = attribute.get_type();
+    if(type == omi::BoolAttribute::kTypeBool)
+    {
+        return get_values_bytes<omi::BoolAttribute>(attribute);
+    }
+    if(type == omi::ByteAttribute::kTypeByte)
+    {
+        return get_values_bytes<omi::ByteAttribute>(attribute);
+    }
+    if(type == omi::Int16Attribute::kTypeInt16)
+    {
+        return get_values_bytes<omi::Int16Attribute>(attribute);
+    }
+    if(type == omi::Int32Attribute::kTypeInt32)
+    {
+        return get_values_bytes<omi::Int32Attribute>(attribute);
+    }
+    if(type == omi::Int64Attribute::kTypeInt64)
+    {
+        return get_values_bytes<omi::Int64Attribute>(attribute);
+    }
+    if(type == omi::FloatAttribute::kTypeFloat)
+    {
+        return get_values_bytes<omi::FloatAttribute>(attribute);
+    }
+    if(type == omi::DoubleAttribute::kTypeDouble)
+    {
+        return get_values_bytes<omi::DoubleAttribute>(attribute);
+    }
+    if(type == omi::StringAttribute::kTypeString)
+    {
+        std::size_t bytes = get_values_bytes<omi::StringAttribute>(attribute);
+        for(const arc::str::UTF8String& value :
+            omi::StringAttribute(attribute).get_values())
+        {
+            bytes += value.get_byte_length();
+        }
+        return bytes;
+    }
+    if(type == omi::PathAttribute::kTypePath)
+    {
+        std::size_t bytes = get_values_bytes<omi::PathAttribute>(attribute);
+        for(const arc::io::sys::Path& value :
+            omi::PathAttribute(attribute).get_values())
+        {
+            bytes += value.to_unix().get_byte_length();
+        }
+        return bytes;
+    }
+    if(type == omi::ArrayAttribute::kTypeArray)
+    {
+        std::size_t bytes = get_values_bytes<omi::ArrayAttribute>(attribute);
+        for(const omi::Attribute& value :
+            omi::ArrayAttribute(attribute).get_values())
+        {
+            bytes += get_resident_bytes(value);
+        }
+        return bytes;
+    }
+    if(type == omi::MapAttribute::kTypeMap)
+    {
+        std::size_t bytes = 0;
+        for(const auto& entry : omi::MapAttribute(attribute).get_values())
+        {
+            bytes +=
+                sizeof(entry) + entry.first.get_byte_length() +
+                get_resident_bytes(entry.second);
+        }
+        return bytes;
+    }
+    return 0;
+}
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                 IMPLEMENTATION
 //------------------------------------------------------------------------------
@@ -34,6 +164,78 @@ class ResourceRegistry::ResourceRegistryImpl
 {
 private:
 
+    //---------------------P R I V A T E    S T R U C T U R E S-----------------
+
+    // The loader functions for a type of resource, if both are null the raw
+    // loader is used.
+    struct Loader
+    {
+        // the loader which reads the resource from a file stream
+        LoaderFunc* stream;
+        // the loader which parses the resource from a memory-mapped file
+        MappedLoaderFunc* mapped;
+    };
+
+    // A resource that is currently loaded.
+    struct LoadedResource
+    {
+        // the data of the resource
+        omi::Attribute data;
+        // the approximate number of bytes used by the data
+        std::size_t bytes;
+        // the number of handles to the resource
+        std::size_t references;
+        // the position of the resource in m_unreferenced while it has no
+        // handles
+        std::list<ResourceId>::iterator unreferenced_position;
+    };
+
+    // The outcome of an asynchronous resource load.
+    //
+    // Attributes are not reference counted atomically (unless Omicron is built
+    // with OMI_API_ATOMIC_REF_COUNT) so the worker only ever writes the loaded
+    // resource here and releases every reference it holds before signalling
+    // that it has finished. The resource is then only copied by the thread that
+    // waits on the load.
+    struct LoadResult
+    {
+        // the loaded resource
+        omi::Attribute resource;
+        // the error that caused the load to fail, if any
+        std::exception_ptr error;
+        // becomes ready once the worker has finished with the load
+        std::shared_future<void> finished;
+    };
+
+    // A pack of resources that is being loaded asynchronously, the resources
+    // are only published once all of them have been loaded.
+    struct PackLoad
+    {
+        // the ids of the resources being loaded by the pack
+        std::vector<ResourceId> ids;
+    };
+
+    // An asynchronous resource load.
+    struct LoadJob
+    {
+        // the id of the resource being loaded
+        ResourceId id;
+        // the path to the resource
+        arc::io::sys::Path path;
+        // the loader to use
+        Loader loader;
+        // the time in milliseconds the worker spent loading the resource
+        arc::uint64 load_time;
+        // written by the worker
+        std::shared_ptr<LoadResult> result;
+        // signalled by the worker once the result has been written
+        std::promise<void> done;
+        // the deferred future which is shared with the caller
+        std::shared_future<omi::Attribute> future;
+        // the pack this load is part of, or null
+        std::shared_ptr<PackLoad> pack;
+    };
+
     //-------------------P R I V A T E    A T T R I B U T E S-------------------
 
     // The config document for the ResourceRegistry.
@@ -41,15 +243,75 @@ private:
 
     // Access to the resource directory through ArcaneCore Collate.
     std::unique_ptr<arc::col::Accessor> m_accessor;
+    // The memory-mapped archive of the package's resources, or null if
+    // resources are not mapped from an archive.
+    std::unique_ptr<ResourceArchive> m_archive;
 
     // Mapping from defined extensions to their respective loaders.
     std::unordered_map<arc::str::UTF8String, LoaderFunc*> m_loaders;
-
-    // Mapping from discovered resource Ids to the associated paths.
+    // Mapping from defined extensions to their respective loaders which parse
+    // memory-mapped files.
+    std::unordered_map<arc::str::UTF8String, MappedLoaderFunc*>
+        m_mapped_loaders;
+
+    // Whether real resource files are memory-mapped for loaders that support
+    // it.
+    bool m_map_real_files;
+
+    // The mapped index of the package's resources, or null if resources were
+    // discovered by scanning.
+    std::shared_ptr<MappedFile> m_index_file;
+    // Looks up the resources of the package's index, whose paths are only
+    // built when they are first used.
+    std::unique_ptr<ResourceIndex> m_index;
+    // Mapping from resource Ids to the associated paths, for resources
+    // discovered by scanning, resources of the index whose paths have been
+    // built, and resources redirected to their cooked files.
     std::unordered_map<ResourceId, arc::io::sys::Path> m_entries;
+    // The position of each scanned or redirected resource in the accessor's
+    // listing, which follows the order of the resources in the table of
+    // contents and therefore the order of their data.
+    std::unordered_map<ResourceId, std::size_t> m_read_order;
+
+    // Mapping from the names of defined packs to their resources, sorted by
+    // read order.
+    std::unordered_map<arc::str::UTF8String, std::vector<ResourceId>> m_packs;
 
     // Stores the data of the currently loaded resources
-    std::unordered_map<ResourceId, omi::Attribute> m_resources;
+    std::unordered_map<ResourceId, LoadedResource> m_resources;
+    // The loaded resources that have no handles, least recently used first.
+    std::list<ResourceId> m_unreferenced;
+    // The approximate number of bytes used by the loaded resources.
+    std::size_t m_resident_bytes;
+    // The number of bytes that loaded resources without handles will be
+    // evicted to stay within, or 0 if there is no budget.
+    std::size_t m_memory_budget;
+
+    // The asynchronous loads that have not been added to m_resources yet.
+    std::unordered_map<ResourceId, std::shared_ptr<LoadJob>> m_jobs;
+
+    // Watches the directories of file-system resources for modifications, or
+    // null if resources are not hot reloaded.
+    std::unique_ptr<FileWatcher> m_watcher;
+    // The resources that have been modified and are waiting to be reloaded.
+    std::unordered_set<ResourceId> m_modified;
+    // The reloads of modified resources that have not been swapped into
+    // m_resources yet.
+    std::unordered_map<ResourceId, std::shared_ptr<LoadJob>> m_reloads;
+    // Mapping from resources to the objects that are notified when they are
+    // reloaded.
+    std::unordered_map<ResourceId, std::vector<ReloadListener*>>
+        m_reload_listeners;
+
+    // The threads that perform asynchronous loads.
+    std::vector<std::thread> m_workers;
+    // The asynchronous loads waiting for a worker - guarded by m_queue_mutex.
+    std::deque<std::shared_ptr<LoadJob>> m_queue;
+    // Whether the workers should exit - guarded by m_queue_mutex.
+    bool m_stop_workers;
+    std::mutex m_queue_mutex;
+    // Signalled when a load is queued or the workers should exit.
+    std::condition_variable m_queue_condition;
 
     #ifndef OMI_API_MODE_PRODUCTION
         // records the resources that have been loaded at least once
@@ -60,6 +322,11 @@ private:
     omi::Int32Attribute m_stat_loads;
     omi::Int32Attribute m_stat_leaks;
     omi::Int32Attribute m_stat_unanticipated;
+    omi::Int32Attribute m_stat_peak_queue_depth;
+    omi::Int32Attribute m_stat_evictions;
+    omi::Int64Attribute m_stat_resident_bytes;
+    omi::Int64Attribute m_stat_peak_resident_bytes;
+    omi::Int32Attribute m_stat_reloads;
     #ifndef OMI_API_MODE_PRODUCTION
         omi::Int32Attribute m_stat_raw_loads;
         omi::Int32Attribute m_stat_redundant_loads;
@@ -67,6 +334,8 @@ private:
         omi::Int64Attribute m_stat_total_load_time;
         omi::Int64Attribute m_stat_peak_load_time;
         omi::StringAttribute m_stat_peak_load_resource;
+        omi::Int64Attribute m_stat_async_wait_time;
+        omi::Int64Attribute m_stat_index_time;
     #endif
 
 public:
@@ -74,16 +343,27 @@ public:
     //--------------------------C O N S T R U C T O R---------------------------
 
     ResourceRegistryImpl()
-        : m_stat_loads             (0, false)
-        , m_stat_leaks             (0, false)
-        , m_stat_unanticipated     (0, false)
+        : m_map_real_files          (false)
+        , m_resident_bytes          (0)
+        , m_memory_budget           (0)
+        , m_stop_workers            (false)
+        , m_stat_loads              (0, false)
+        , m_stat_leaks              (0, false)
+        , m_stat_unanticipated      (0, false)
+        , m_stat_peak_queue_depth   (0, false)
+        , m_stat_evictions          (0, false)
+        , m_stat_resident_bytes     (0, false)
+        , m_stat_peak_resident_bytes(0, false)
+        , m_stat_reloads            (0, false)
         #ifndef OMI_API_MODE_PRODUCTION
-        , m_stat_raw_loads         (0, false)
-        , m_stat_redundant_loads   (0, false)
-        , m_stat_reoccurring_loads (0, false)
-        , m_stat_total_load_time   (0, false)
-        , m_stat_peak_load_time    (0, false)
-        , m_stat_peak_load_resource("", false)
+        , m_stat_raw_loads          (0, false)
+        , m_stat_redundant_loads    (0, false)
+        , m_stat_reoccurring_loads  (0, false)
+        , m_stat_total_load_time    (0, false)
+        , m_stat_peak_load_time     (0, false)
+        , m_stat_peak_load_resource ("", false)
+        , m_stat_async_wait_time    (0, false)
+        , m_stat_index_time         (0, false)
         #endif
     {
     }
@@ -92,6 +372,8 @@ public:
 
     ~ResourceRegistryImpl()
     {
+        // in case the registry was not shutdown
+        stop_workers();
     }
 
     //-------------P U B L I C    M E M B E R    F U N C T I O N S--------------
@@ -122,12 +404,24 @@ public:
         ));
 
         // using real files?
+        bool memory_map = *m_config_data->get("memory_map", AC_BOOLV);
         if(*m_config_data->get("use_real_files", AC_BOOLV))
         {
             arc::col::Accessor::force_real_resources = true;
             global::logger->warning
                 << "Using file-system resources rather than collated "
                 << "resources." << std::endl;
+
+            // hot reloaded files may be rewritten while attributes are still
+            // borrowing their mapped data, so they're read into memory instead
+            m_map_real_files =
+                memory_map && !*m_config_data->get("hot_reload", AC_BOOLV);
+        }
+        else if(memory_map)
+        {
+            // collated resources are read through the accessor, so they're
+            // mapped from the package's archive instead
+            open_archive();
         }
 
         // get the path to the data directory
@@ -155,30 +449,52 @@ public:
             *m_config_data->get("resource_directory", AC_PATHV)
         );
 
-        // discover resources
-        std::vector<arc::io::sys::Path> resource_files =
-            m_accessor->list_rec(res_path);
-        // compute the Id and add an entry for each discovered resource
-        for(const arc::io::sys::Path& resource : resource_files)
+        // discover resources from the package's index if there is one, but
+        // always scan file-system resources since they may have changed since
+        // the index was generated
+        #ifndef OMI_API_MODE_PRODUCTION
+            arc::uint64 index_start = arc::clock::get_current_time();
+        #endif
+        arc::io::sys::Path index_path(
+            *m_config_data->get("data_directory", AC_PATHV)
+        );
+        index_path << (*m_config_data->get("index", AC_U8STRV));
+        if(arc::col::Accessor::force_real_resources || !read_index(index_path))
         {
-            ResourceId id = omi::res::get_id(resource);
+            scan_resources(res_path);
+        }
+        #ifndef OMI_API_MODE_PRODUCTION
+            m_stat_index_time.set_at(
+                0,
+                arc::clock::get_current_time() - index_start
+            );
+        #endif
 
-            // check for hash collisions in non-production builds
-            #ifndef OMI_API_MODE_PRODUCTION
-                // TODO: REMOVE ME
-                auto f_collision_check = m_entries.find(id);
-                if(f_collision_check != m_entries.end())
-                {
-                    global::logger->critical
-                        << "Detected ResourceId collision on id: " << id
-                        << "which has been generated by both \""
-                        << f_collision_check->second.to_unix() << "\" and \""
-                        << resource.to_unix() << "\"" << std::endl;
-                    continue;
-                }
-            #endif
+        if(*m_config_data->get("use_cooked_resources", AC_BOOLV))
+        {
+            use_cooked_resources();
+        }
 
-            m_entries.insert(std::make_pair(id, resource));
+        // watch file-system resources so they can be reloaded when modified
+        if(arc::col::Accessor::force_real_resources &&
+           *m_config_data->get("hot_reload", AC_BOOLV))
+        {
+            start_watching();
+        }
+
+        // get the memory budget
+        arc::int32 memory_budget =
+            *m_config_data->get("memory_budget_mb", AC_INTV);
+        m_memory_budget =
+            static_cast<std::size_t>(std::max(memory_budget, 0)) * 1024 * 1024;
+
+        // start the workers
+        arc::int32 load_threads = *m_config_data->get("load_threads", AC_INTV);
+        for(arc::int32 i = 0; i < load_threads; ++i)
+        {
+            m_workers.push_back(
+                std::thread(&ResourceRegistryImpl::worker_routine, this)
+            );
         }
 
         // set up the stats
@@ -200,6 +516,35 @@ public:
             "The number of resources that were requested but had not been "
             "preemptively loaded."
         );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Resources.Peak Async Queue Depth",
+            m_stat_peak_queue_depth,
+            "The maximum number of asynchronous resource loads that were "
+            "queued or in progress at the same time."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Resources.Evictions",
+            m_stat_evictions,
+            "The number of unreferenced resources that were unloaded to keep "
+            "the loaded resources within the memory budget."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Resources.Resident Memory (bytes)",
+            m_stat_resident_bytes,
+            "The approximate memory used by the currently loaded resources."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Resources.Peak Resident Memory (bytes)",
+            m_stat_peak_resident_bytes,
+            "The maximum approximate memory used by loaded resources at the "
+            "same time."
+        );
+        omi::report::StatsDatabase::instance()->define_entry(
+            "Resources.Reloads",
+            m_stat_reloads,
+            "The number of loaded resources that were reloaded because their "
+            "file was modified."
+        );
         #ifndef OMI_API_MODE_PRODUCTION
             omi::report::StatsDatabase::instance()->define_entry(
                 "Resources.Raw Loads",
@@ -238,6 +583,19 @@ public:
                 "its load time is represented by the Resource.Max Load Time "
                 "stat."
             );
+            omi::report::StatsDatabase::instance()->define_entry(
+                "Resources.Index Time (ms)",
+                m_stat_index_time,
+                "The time spent discovering the available resources when the "
+                "ResourceRegistry started up, either by reading the package's "
+                "index or by scanning the resource directory."
+            );
+            omi::report::StatsDatabase::instance()->define_entry(
+                "Resources.Async Wait Time (ms)",
+                m_stat_async_wait_time,
+                "The total time the engine spent blocked waiting for "
+                "asynchronous resource loads to complete."
+            );
         #endif
 
         return true;
@@ -247,29 +605,51 @@ public:
     {
         global::logger->debug << "ResourceRegistry shutdown." << std::endl;
 
+        // abandon any loads that are still in progress
+        stop_workers();
+        m_jobs.clear();
+        m_reloads.clear();
+        m_modified.clear();
+        m_watcher.reset();
+        m_reload_listeners.clear();
+
+        // resources that still have handles have been leaked
+        arc::int32 leaks = 0;
+        arc::str::UTF8String leak_list;
+        for(const auto& resource : m_resources)
+        {
+            if(resource.second.references > 0)
+            {
+                ++leaks;
+                leak_list
+                    << resource.first << " :: "
+                    << get_path(resource.first).to_unix() << "\n";
+            }
+        }
+
         // stat leaks
-        m_stat_leaks.set_at(0, m_resources.size());
+        m_stat_leaks.set_at(0, leaks);
 
         // List leaked resources
-        if(!m_resources.empty())
+        if(leaks > 0)
         {
             arc::str::UTF8String header = "=";
             header *= 80;
-            arc::str::UTF8String leak_list;
-            for(auto r : m_resources)
-            {
-                leak_list
-                    << r.first << " :: " << m_entries[r.first].to_unix()
-                    << "\n";
-            }
             global::logger->warning
                 << "Leaked resources:\n\t" << header << "\n\t" << leak_list
                 << "\t" << header << std::endl;
         }
 
         m_resources.clear();
+        m_unreferenced.clear();
+        m_resident_bytes = 0;
+        m_packs.clear();
+        m_read_order.clear();
         m_entries.clear();
+        m_index.reset();
+        m_index_file.reset();
         m_loaders.clear();
+        m_mapped_loaders.clear();
         m_accessor.reset();
         m_config_data.reset();
 
@@ -296,169 +676,1382 @@ public:
         m_loaders.insert(std::make_pair(extension, function));
     }
 
-    bool is_loaded(ResourceId id) const
+    void define_mapped_loader(
+            MappedLoaderFunc* function,
+            const arc::str::UTF8String& extension)
+    {
+        // ensure the loader hasn't already been defined
+        #ifndef OMI_API_MODE_PRODUCTION
+            auto f_loader = m_mapped_loaders.find(extension);
+            if(f_loader != m_mapped_loaders.end())
+            {
+                global::logger->error
+                    << "Multiple mapped loaders defined for the \""
+                    << extension << "\" extension." << std::endl;
+                return;
+            }
+        #endif
+
+        // store
+        m_mapped_loaders.insert(std::make_pair(extension, function));
+    }
+
+    void frame_routine()
+    {
+        update();
+
+        if(!m_watcher)
+        {
+            return;
+        }
+
+        for(const arc::io::sys::Path& path : m_watcher->poll())
+        {
+            // new files are not discovered
+            ResourceId id = omi::res::get_id(path);
+            auto f_entry = m_entries.find(id);
+            if(f_entry == m_entries.end())
+            {
+                continue;
+            }
+
+            if(f_entry->second.to_unix() != path.to_unix())
+            {
+                global::logger->warning
+                    << "Loading modified resource \"" << path.to_unix()
+                    << "\" in place of its cooked file." << std::endl;
+                f_entry->second = path;
+            }
+            m_modified.insert(id);
+        }
+
+        start_reloads();
+        collect_reloads();
+    }
+
+    bool is_loaded(ResourceId id)
     {
+        update();
         return m_resources.find(id) != m_resources.end();
     }
 
+    bool is_loading(ResourceId id)
+    {
+        update();
+        return m_jobs.find(id) != m_jobs.end();
+    }
+
     omi::Attribute get(ResourceId id)
     {
-        // TODO: need to check if the id is in the async queue, or this could
-        //       take an optional argument whether it waits for async or forces
-        //       a blocking load...
+        update();
 
         // has the resource been loaded?
         auto f_resource = m_resources.find(id);
+        if(f_resource != m_resources.end())
+        {
+            touch(f_resource->second);
+            return f_resource->second.data;
+        }
 
-        if(f_resource == m_resources.end())
+        // is the resource being loaded asynchronously?
+        auto f_job = m_jobs.find(id);
+        if(f_job != m_jobs.end())
         {
-            // have do perform an unexpected load
-            global::logger->warning
-                << "Performing an unexpected load on resource \""
-                << m_entries[id].to_unix() << "\"" << std::endl;
+            return wait_for_load(f_job->second);
+        }
 
-            // stat
-            m_stat_unanticipated.set_at(0, m_stat_unanticipated.at(0) + 1);
+        // have do perform an unexpected load
+        global::logger->warning
+            << "Performing an unexpected load on resource \""
+            << get_path(id).to_unix() << "\"" << std::endl;
 
-            // perform the load and return
-            load_blocking(id);
-            return m_resources[id];
-        }
+        // stat
+        m_stat_unanticipated.set_at(0, m_stat_unanticipated.at(0) + 1);
 
-        return f_resource->second;
+        // perform the load and return
+        load_blocking(id);
+        return m_resources.at(id).data;
     }
 
     void load_blocking(ResourceId id)
     {
+        update();
+
         // early exit if the resource is already loaded
-        auto f_resource = m_resources.find(id);
-        if(f_resource != m_resources.end())
+        if(check_redundant(id))
         {
-            #ifndef OMI_API_MODE_PRODUCTION
-                // stat
-                m_stat_redundant_loads.set_at(
-                    0,
-                    m_stat_redundant_loads.at(0) + 1
-                );
-            #endif
-
             return;
         }
 
-        // ensure the resource exists
-        auto f_entry = m_entries.find(id);
-        if(f_entry == m_entries.end())
+        // wait for the resource if it's already being loaded asynchronously
+        auto f_job = m_jobs.find(id);
+        if(f_job != m_jobs.end())
         {
-            arc::str::UTF8String error_message;
-            error_message
-                << "No entry in ResourceRegistry with id: "
-                << std::to_string(id);
-            throw arc::ex::KeyError(error_message);
+            wait_for_load(f_job->second);
+            return;
         }
 
-        // get the extension of the resource
-        arc::str::UTF8String ext = f_entry->second.get_extension();
+        const arc::io::sys::Path& path = get_path(id);
+        Loader loader = find_loader(path);
+        record_load(id);
 
-        // open the file reader
-        arc::col::Reader reader(f_entry->second, m_accessor.get());
-
-        // record the number of loads
-        m_stat_loads.set_at(0, m_stat_loads.at(0) + 1);
-
-        // record the number of reoccurring loads
         #ifndef OMI_API_MODE_PRODUCTION
-            auto f_record = m_load_records.find(id);
-            if(f_record != m_load_records.end())
-            {
-                m_stat_reoccurring_loads.set_at(
-                    0,
-                    m_stat_reoccurring_loads.at(0) + 1
-                );
-            }
-            else
-            {
-                m_load_records.insert(id);
-            }
+            // time this load
+            arc::uint64 load_start = arc::clock::get_current_time();
         #endif
 
+        add_resource(id, read_resource(path, loader));
+
         #ifndef OMI_API_MODE_PRODUCTION
-            // time this load
-            arc::uint64 load_start = arc::clock::get_current_time();
+            record_load_time(path, arc::clock::get_current_time() - load_start);
         #endif
+    }
 
-        // find the loader for this extension
-        auto f_loader = m_loaders.find(ext);
-        if(f_loader != m_loaders.end())
+    std::shared_future<omi::Attribute> load_async(ResourceId id)
+    {
+        update();
+
+        // already loaded or loading?
+        if(check_redundant(id))
         {
-            // TODO: stat load -> stat duplicate loads
-            // do load
-            m_resources.insert(std::make_pair(id, f_loader->second(reader)));
+            std::promise<omi::Attribute> loaded;
+            loaded.set_value(m_resources.at(id).data);
+            return loaded.get_future().share();
         }
-        // fallback to the raw loader
-        else
+        auto f_job = m_jobs.find(id);
+        if(f_job != m_jobs.end())
         {
-            #ifndef OMI_API_MODE_PRODUCTION
-                // record in stats
-                m_stat_raw_loads.set_at(0, m_stat_raw_loads.at(0) + 1);
-            #endif
+            return f_job->second->future;
+        }
 
-            m_resources.insert(std::make_pair(id, omi::res::load_raw(reader)));
+        // no workers to perform the load
+        if(m_workers.empty())
+        {
+            load_blocking(id);
+            std::promise<omi::Attribute> loaded;
+            loaded.set_value(m_resources.at(id).data);
+            return loaded.get_future().share();
         }
 
-        #ifndef OMI_API_MODE_PRODUCTION
-            // get the time taken
-            arc::uint64 load_time = arc::clock::get_current_time() - load_start;
-            //stat
-            m_stat_total_load_time.set_at(
-                0,
-                m_stat_total_load_time.at(0) + load_time
-            );
-            // max load
-            if(static_cast<arc::int64>(load_time) > m_stat_peak_load_time.at(0))
-            {
-                m_stat_peak_load_time.set_at(0, load_time);
-                m_stat_peak_load_resource.set_at(0, f_entry->second.to_unix());
-            }
-        #endif
+        std::shared_ptr<LoadJob> job = create_job(id, nullptr);
+        queue_jobs({job});
+        return job->future;
     }
-};
 
-//------------------------------------------------------------------------------
-//                            PUBLIC STATIC FUNCTIONS
-//------------------------------------------------------------------------------
+    void define_pack(
+            const arc::str::UTF8String& name,
+            const std::vector<ResourceId>& resources)
+    {
+        if(m_packs.find(name) != m_packs.end())
+        {
+            global::logger->error
+                << "Multiple definitions of resource pack \"" << name << "\"."
+                << std::endl;
+            return;
+        }
 
-OMI_API_EXPORT ResourceRegistry* ResourceRegistry::instance()
-{
-    static ResourceRegistry inst;
-    return &inst;
-}
+        std::vector<ResourceId> ids;
+        ids.reserve(resources.size());
+        std::unordered_map<ResourceId, std::size_t> read_orders;
+        for(ResourceId id : resources)
+        {
+            // throws if the resource doesn't exist
+            get_path(id);
+            ids.push_back(id);
+            read_orders[id] = get_read_order(id);
+        }
 
-//------------------------------------------------------------------------------
-//                            PUBLIC MEMBER FUNCTIONS
-//------------------------------------------------------------------------------
+        // order the resources so that they are read sequentially
+        std::sort(
+            ids.begin(),
+            ids.end(),
+            [&](ResourceId a, ResourceId b)
+            {
+                return read_orders[a] < read_orders[b];
+            }
+        );
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
 
-OMI_API_EXPORT bool ResourceRegistry::startup_routine()
-{
-    return m_impl->startup_routine();
-}
+        m_packs.insert(std::make_pair(name, std::move(ids)));
+    }
 
-OMI_API_EXPORT bool ResourceRegistry::shutdown_routine()
-{
-    return m_impl->shutdown_routine();
-}
+    bool is_pack_loaded(const arc::str::UTF8String& name)
+    {
+        update();
+        for(ResourceId id : get_pack(name))
+        {
+            if(m_resources.find(id) == m_resources.end())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-OMI_API_EXPORT void ResourceRegistry::define_loader(
-        LoaderFunc* function,
+    void load_pack_blocking(const arc::str::UTF8String& name)
+    {
+        std::shared_ptr<PackLoad> pack = load_pack(name);
+        if(pack)
+        {
+            wait_for_pack(*pack);
+        }
+
+        // also wait for any resources of the pack which were already being
+        // loaded asynchronously
+        for(ResourceId id : get_pack(name))
+        {
+            auto f_job = m_jobs.find(id);
+            if(f_job != m_jobs.end())
+            {
+                wait_for_load(f_job->second);
+            }
+        }
+    }
+
+    void load_pack_async(const arc::str::UTF8String& name)
+    {
+        load_pack(name);
+    }
+
+    omi::res::ResourceHandle acquire(ResourceId id)
+    {
+        omi::Attribute data = get(id);
+        add_reference(id);
+        return omi::res::ResourceHandle(id, data);
+    }
+
+    void set_memory_budget(std::size_t bytes)
+    {
+        m_memory_budget = bytes;
+        enforce_budget();
+    }
+
+    void add_reload_listener(ResourceId id, ReloadListener* listener)
+    {
+        m_reload_listeners[id].push_back(listener);
+    }
+
+    void remove_reload_listener(ResourceId id, ReloadListener* listener)
+    {
+        auto f_listeners = m_reload_listeners.find(id);
+        if(f_listeners == m_reload_listeners.end())
+        {
+            return;
+        }
+
+        std::vector<ReloadListener*>& listeners = f_listeners->second;
+        listeners.erase(
+            std::remove(listeners.begin(), listeners.end(), listener),
+            listeners.end()
+        );
+        if(listeners.empty())
+        {
+            m_reload_listeners.erase(f_listeners);
+        }
+    }
+
+    void add_reference(ResourceId id)
+    {
+        auto f_resource = m_resources.find(id);
+        if(f_resource == m_resources.end())
+        {
+            return;
+        }
+
+        LoadedResource& resource = f_resource->second;
+        if(resource.references == 0)
+        {
+            m_unreferenced.erase(resource.unreferenced_position);
+        }
+        ++resource.references;
+    }
+
+    void release_reference(ResourceId id)
+    {
+        // the registry may have been shutdown
+        auto f_resource = m_resources.find(id);
+        if(f_resource == m_resources.end())
+        {
+            return;
+        }
+
+        LoadedResource& resource = f_resource->second;
+        if(--resource.references == 0)
+        {
+            resource.unreferenced_position =
+                m_unreferenced.insert(m_unreferenced.end(), id);
+            enforce_budget();
+        }
+    }
+
+private:
+
+    //------------P R I V A T E    M E M B E R    F U N C T I O N S-------------
+
+    // returns whether the worker has finished with the given load
+    static bool is_finished(const LoadJob& job)
+    {
+        return job.result->finished.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready;
+    }
+
+    // waits for the given load to finish and returns a copy of the resource,
+    // or rethrows the error that caused the load to fail
+    static omi::Attribute get_result(std::shared_ptr<LoadResult> result)
+    {
+        result->finished.wait();
+        if(result->error)
+        {
+            std::rethrow_exception(result->error);
+        }
+        return result->resource;
+    }
+
+    // returns the resources of the pack with the given name
+    const std::vector<ResourceId>& get_pack(
+            const arc::str::UTF8String& name) const
+    {
+        auto f_pack = m_packs.find(name);
+        if(f_pack == m_packs.end())
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "No resource pack has been defined with the name \"" << name
+                << "\".";
+            throw arc::ex::KeyError(error_message);
+        }
+        return f_pack->second;
+    }
+
+    // discovers the resources by listing the given resource directory
+    void scan_resources(const arc::io::sys::Path& res_path)
+    {
+        std::vector<arc::io::sys::Path> resource_files =
+            m_accessor->list_rec(res_path);
+        // compute the Id and add an entry for each discovered resource
+        for(const arc::io::sys::Path& resource : resource_files)
+        {
+            ResourceId id = omi::res::get_id(resource);
+
+            // check for hash collisions in non-production builds
+            #ifndef OMI_API_MODE_PRODUCTION
+                // TODO: REMOVE ME
+                auto f_collision_check = m_entries.find(id);
+                if(f_collision_check != m_entries.end())
+                {
+                    global::logger->critical
+                        << "Detected ResourceId collision on id: " << id
+                        << "which has been generated by both \""
+                        << f_collision_check->second.to_unix() << "\" and \""
+                        << resource.to_unix() << "\"" << std::endl;
+                    continue;
+                }
+            #endif
+
+            m_entries.insert(std::make_pair(id, resource));
+            m_read_order.insert(std::make_pair(id, m_read_order.size()));
+        }
+    }
+
+    // maps the package's archive of resources, if the archive can't be opened
+    // resources are read through the accessor instead
+    void open_archive()
+    {
+        arc::io::sys::Path archive_path(
+            *m_config_data->get("data_directory", AC_PATHV)
+        );
+        archive_path << (*m_config_data->get("archive", AC_U8STRV));
+        try
+        {
+            m_archive.reset(new ResourceArchive(archive_path));
+        }
+        catch(const std::exception& exc)
+        {
+            global::logger->warning
+                << "Failed to open resource archive, resources will be read "
+                << "from collated pages instead: " << exc.what() << std::endl;
+            return;
+        }
+
+        global::logger->debug
+            << "Mapped " << m_archive->get_count() << " resources from \""
+            << archive_path.to_unix() << "\"." << std::endl;
+    }
+
+    // opens the precomputed index of resources at the given path, returns
+    // false if the index could not be read
+    bool read_index(const arc::io::sys::Path& index_path)
+    {
+        try
+        {
+            m_index_file = MappedFile::open(index_path);
+            m_index.reset(new ResourceIndex(
+                m_index_file->get_data(),
+                m_index_file->get_size()
+            ));
+        }
+        catch(const std::exception& exc)
+        {
+            global::logger->warning
+                << "Failed to read resource index, resources will be "
+                << "discovered by scanning instead: " << exc.what()
+                << std::endl;
+            m_index_file.reset();
+            return false;
+        }
+        return true;
+    }
+
+    // redirects the entries of resources that have been cooked to their cooked
+    // file, so the resources are loaded from it rather than from their source
+    void use_cooked_resources()
+    {
+        // collect the cooked files first since looking up their sources may
+        // add entries
+        std::vector<std::pair<ResourceId, arc::str::UTF8String>> cooked;
+        for(const auto& entry : m_entries)
+        {
+            arc::str::UTF8String unix_path = entry.second.to_unix();
+            if(unix_path.ends_with(kCookedSuffix) ||
+               unix_path.ends_with(kCookedLinkSuffix))
+            {
+                cooked.push_back(std::make_pair(entry.first, unix_path));
+            }
+        }
+        if(m_index)
+        {
+            for(std::size_t i = 0; i < m_index->get_count(); ++i)
+            {
+                // only the paths of cooked files are built
+                std::size_t length = 0;
+                const char* unix_path = m_index->get_unix_path(i, length);
+                if(has_suffix(unix_path, length, kCookedSuffix) ||
+                   has_suffix(unix_path, length, kCookedLinkSuffix))
+                {
+                    cooked.push_back(std::make_pair(
+                        m_index->get_id(i),
+                        arc::str::UTF8String(unix_path, length)
+                    ));
+                }
+            }
+        }
+
+        std::vector<std::pair<ResourceId, ResourceId>> redirects;
+        for(const auto& entry : cooked)
+        {
+            find_cooked_redirect(entry.first, entry.second, redirects);
+        }
+        for(const auto& redirect : redirects)
+        {
+            std::size_t read_order = get_read_order(redirect.second);
+            m_entries[redirect.first] = get_path(redirect.second);
+            m_read_order[redirect.first] = read_order;
+        }
+        global::logger->debug
+            << "Using " << redirects.size() << " cooked resources."
+            << std::endl;
+    }
+
+    // returns whether the given unix path ends with the given suffix
+    static bool has_suffix(
+            const char* unix_path,
+            std::size_t length,
+            const arc::str::UTF8String& suffix)
+    {
+        std::size_t suffix_length = suffix.get_byte_length() - 1;
+        return length >= suffix_length &&
+               std::memcmp(
+                   unix_path + (length - suffix_length),
+                   suffix.get_raw(),
+                   suffix_length
+               ) == 0;
+    }
+
+    // adds a redirect from the source of the given cooked file, or cooked link
+    // file, to the given redirects if the source has an entry
+    void find_cooked_redirect(
+            ResourceId id,
+            const arc::str::UTF8String& unix_path,
+            std::vector<std::pair<ResourceId, ResourceId>>& redirects)
+    {
+        bool link = unix_path.ends_with(kCookedLinkSuffix);
+        if(!link && !unix_path.ends_with(kCookedSuffix))
+        {
+            return;
+        }
+        const arc::str::UTF8String& suffix =
+            link ? kCookedLinkSuffix : kCookedSuffix;
+        arc::str::UTF8String source_path = unix_path.substring(
+            0,
+            unix_path.get_length() - suffix.get_length()
+        );
+        ResourceId source_id = omi::res::get_id(source_path);
+        if(!has_entry(source_id))
+        {
+            return;
+        }
+
+        // file-system resources may have been modified since they were
+        // cooked, in which case the source is loaded instead
+        if(arc::col::Accessor::force_real_resources &&
+           get_modified_time(get_path(source_id)) >
+           get_modified_time(get_path(id)))
+        {
+            global::logger->warning
+                << "Ignoring out of date cooked resource: \""
+                << unix_path << "\"" << std::endl;
+            return;
+        }
+
+        ResourceId cooked_id = id;
+        if(link)
+        {
+            // identical cooked files are only stored once
+            cooked_id = omi::res::get_id(read_cooked_link(get_path(id)));
+            if(!has_entry(cooked_id))
+            {
+                global::logger->warning
+                    << "Ignoring cooked resource link to missing file: \""
+                    << unix_path << "\"" << std::endl;
+                return;
+            }
+        }
+
+        redirects.push_back(std::make_pair(source_id, cooked_id));
+    }
+
+    // returns the path of the cooked file held by the given cooked link file,
+    // or an empty string if it could not be read
+    arc::str::UTF8String read_cooked_link(const arc::io::sys::Path& path)
+    {
+        try
+        {
+            arc::col::Reader reader(path, m_accessor.get());
+            std::vector<char> text(static_cast<std::size_t>(reader.get_size()));
+            reader.read(text.data(), static_cast<arc::int64>(text.size()));
+            return arc::str::UTF8String(text.data(), text.size());
+        }
+        catch(const std::exception& exc)
+        {
+            global::logger->error
+                << "Failed to read cooked resource link \"" << path.to_unix()
+                << "\": " << exc.what() << std::endl;
+        }
+        return arc::str::UTF8String();
+    }
+
+    // starts watching the directories of the resources for modifications
+    void start_watching()
+    {
+        if(!FileWatcher::is_supported())
+        {
+            global::logger->warning
+                << "Hot reloading resources is not supported on this platform."
+                << std::endl;
+            return;
+        }
+
+        std::unordered_set<arc::str::UTF8String> directories;
+        try
+        {
+            m_watcher.reset(new FileWatcher());
+            for(const auto& entry : m_entries)
+            {
+                arc::io::sys::Path directory;
+                for(std::size_t i = 0; i + 1 < entry.second.get_length(); ++i)
+                {
+                    directory << entry.second[i];
+                }
+                if(directories.insert(directory.to_unix()).second)
+                {
+                    m_watcher->watch(directory);
+                }
+            }
+        }
+        catch(const std::exception& exc)
+        {
+            global::logger->error
+                << "Failed to watch resources for hot reloading: "
+                << exc.what() << std::endl;
+            m_watcher.reset();
+            return;
+        }
+
+        global::logger->debug
+            << "Watching " << directories.size() << " resource directories "
+            << "for modifications." << std::endl;
+    }
+
+    // returns whether a resource with the given id has been discovered
+    bool has_entry(ResourceId id) const
+    {
+        std::size_t position = 0;
+        return m_entries.find(id) != m_entries.end() ||
+               (m_index && m_index->find(id, position));
+    }
+
+    // returns the path of the resource with the given id
+    const arc::io::sys::Path& get_path(ResourceId id)
+    {
+        auto f_entry = m_entries.find(id);
+        if(f_entry != m_entries.end())
+        {
+            return f_entry->second;
+        }
+
+        // build the path from the index the first time it is used
+        std::size_t position = 0;
+        if(m_index && m_index->find(id, position))
+        {
+            return m_entries.insert(
+                std::make_pair(id, m_index->get_path(position))
+            ).first->second;
+        }
+
+        arc::str::UTF8String error_message;
+        error_message
+            << "No entry in ResourceRegistry with id: " << std::to_string(id);
+        throw arc::ex::KeyError(error_message);
+    }
+
+    // returns the position of the data of the resource with the given id in
+    // the package, the resource must have an entry
+    std::size_t get_read_order(ResourceId id) const
+    {
+        auto f_read_order = m_read_order.find(id);
+        if(f_read_order != m_read_order.end())
+        {
+            return f_read_order->second;
+        }
+        std::size_t position = 0;
+        if(m_index && m_index->find(id, position))
+        {
+            return m_index->get_read_order(position);
+        }
+        return 0;
+    }
+
+    // returns the loaders for the resource at the given path
+    Loader find_loader(const arc::io::sys::Path& path)
+    {
+        Loader loader = {nullptr, nullptr};
+
+        // find the loaders for this extension
+        arc::str::UTF8String extension = path.get_extension();
+        auto f_loader = m_loaders.find(extension);
+        if(f_loader != m_loaders.end())
+        {
+            loader.stream = f_loader->second;
+        }
+        auto f_mapped_loader = m_mapped_loaders.find(extension);
+        if(f_mapped_loader != m_mapped_loaders.end())
+        {
+            loader.mapped = f_mapped_loader->second;
+        }
+
+        #ifndef OMI_API_MODE_PRODUCTION
+            if(loader.stream == nullptr && loader.mapped == nullptr)
+            {
+                // record in stats
+                m_stat_raw_loads.set_at(0, m_stat_raw_loads.at(0) + 1);
+            }
+        #endif
+        return loader;
+    }
+
+    // returns whether the resource with the given id is already loaded,
+    // recording the redundant load if so
+    bool check_redundant(ResourceId id)
+    {
+        auto f_resource = m_resources.find(id);
+        if(f_resource == m_resources.end())
+        {
+            return false;
+        }
+        touch(f_resource->second);
+
+        #ifndef OMI_API_MODE_PRODUCTION
+            // stat
+            m_stat_redundant_loads.set_at(0, m_stat_redundant_loads.at(0) + 1);
+        #endif
+        return true;
+    }
+
+    // records the stats for a new load of the resource with the given id
+    void record_load(ResourceId id)
+    {
+        // record the number of loads
+        m_stat_loads.set_at(0, m_stat_loads.at(0) + 1);
+
+        // record the number of reoccurring loads
+        #ifndef OMI_API_MODE_PRODUCTION
+            auto f_record = m_load_records.find(id);
+            if(f_record != m_load_records.end())
+            {
+                m_stat_reoccurring_loads.set_at(
+                    0,
+                    m_stat_reoccurring_loads.at(0) + 1
+                );
+            }
+            else
+            {
+                m_load_records.insert(id);
+            }
+        #endif
+    }
+
+    #ifndef OMI_API_MODE_PRODUCTION
+
+    // records the time taken to load the resource at the given path
+    void record_load_time(const arc::io::sys::Path& path, arc::uint64 load_time)
+    {
+        m_stat_total_load_time.set_at(
+            0,
+            m_stat_total_load_time.at(0) + load_time
+        );
+        // max load
+        if(static_cast<arc::int64>(load_time) > m_stat_peak_load_time.at(0))
+        {
+            m_stat_peak_load_time.set_at(0, load_time);
+            m_stat_peak_load_resource.set_at(0, path.to_unix());
+        }
+    }
+
+    // records time spent blocked waiting for asynchronous loads
+    void record_wait_time(arc::uint64 wait_time)
+    {
+        m_stat_async_wait_time.set_at(
+            0,
+            m_stat_async_wait_time.at(0) + wait_time
+        );
+    }
+
+    #endif
+
+    // reads the resource at the given path using the given loader - this is
+    // safe to call from the worker threads
+    omi::Attribute read_resource(
+            const arc::io::sys::Path& path,
+            const Loader& loader) const
+    {
+        std::shared_ptr<MappedFile> file = map_resource(path);
+
+        // parse from memory if the file can be mapped, or if this resource
+        // type can only be parsed from memory
+        if(loader.mapped != nullptr && (file || loader.stream == nullptr))
+        {
+            if(!file)
+            {
+                arc::col::Reader reader(path, m_accessor.get());
+                file = MappedFile::read(reader);
+            }
+            return loader.mapped(*file);
+        }
+        if(loader.stream == nullptr && file)
+        {
+            return omi::res::load_raw_mapped(*file);
+        }
+
+        // open the file reader
+        arc::col::Reader reader(path, m_accessor.get());
+
+        if(loader.stream != nullptr)
+        {
+            return loader.stream(reader);
+        }
+        return omi::res::load_raw(reader);
+    }
+
+    // returns the mapped data of the resource at the given path, or null if
+    // the resource should be read through the accessor instead - this is safe
+    // to call from the worker threads, which is where resources stored
+    // compressed in the archive are decompressed
+    std::shared_ptr<MappedFile> map_resource(
+            const arc::io::sys::Path& path) const
+    {
+        if(m_archive)
+        {
+            return m_archive->find(path);
+        }
+        if(m_map_real_files)
+        {
+            return MappedFile::open(path);
+        }
+        return nullptr;
+    }
+
+    // creates a new asynchronous load of the given resource
+    std::shared_ptr<LoadJob> create_job(
+            ResourceId id,
+            const std::shared_ptr<PackLoad>& pack)
+    {
+        std::shared_ptr<LoadJob> job(new LoadJob());
+        job->id = id;
+        job->path = get_path(id);
+        job->loader = find_loader(job->path);
+        job->load_time = 0;
+        job->result = std::make_shared<LoadResult>();
+        job->result->finished = job->done.get_future().share();
+        job->future = std::async(
+            std::launch::deferred,
+            &ResourceRegistryImpl::get_result,
+            job->result
+        ).share();
+        job->pack = pack;
+        record_load(id);
+        return job;
+    }
+
+    // hands the given loads over to the workers, which will start them in
+    // the given order
+    void queue_jobs(const std::vector<std::shared_ptr<LoadJob>>& jobs)
+    {
+        for(const std::shared_ptr<LoadJob>& job : jobs)
+        {
+            m_jobs.insert(std::make_pair(job->id, job));
+        }
+        if(static_cast<arc::int32>(m_jobs.size()) >
+           m_stat_peak_queue_depth.at(0))
+        {
+            m_stat_peak_queue_depth.set_at(
+                0,
+                static_cast<arc::int32>(m_jobs.size())
+            );
+        }
+
+        push_jobs(jobs);
+    }
+
+    // adds the given loads to the end of the workers' queue
+    void push_jobs(const std::vector<std::shared_ptr<LoadJob>>& jobs)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_queue.insert(m_queue.end(), jobs.begin(), jobs.end());
+        }
+        if(jobs.size() == 1)
+        {
+            m_queue_condition.notify_one();
+        }
+        else
+        {
+            m_queue_condition.notify_all();
+        }
+    }
+
+    // starts loading the resources of the given pack which are not already
+    // loaded or being loaded, returns null if there was nothing to load
+    std::shared_ptr<PackLoad> load_pack(const arc::str::UTF8String& name)
+    {
+        update();
+
+        std::vector<ResourceId> ids;
+        for(ResourceId id : get_pack(name))
+        {
+            if(m_resources.find(id) == m_resources.end() &&
+               m_jobs.find(id) == m_jobs.end())
+            {
+                ids.push_back(id);
+            }
+        }
+        if(ids.empty())
+        {
+            return nullptr;
+        }
+
+        // no workers to perform the loads
+        if(m_workers.empty())
+        {
+            for(ResourceId id : ids)
+            {
+                load_blocking(id);
+            }
+            return nullptr;
+        }
+
+        std::shared_ptr<PackLoad> pack(new PackLoad());
+        pack->ids = std::move(ids);
+        std::vector<std::shared_ptr<LoadJob>> jobs;
+        jobs.reserve(pack->ids.size());
+        for(ResourceId id : pack->ids)
+        {
+            jobs.push_back(create_job(id, pack));
+        }
+        queue_jobs(jobs);
+        return pack;
+    }
+
+    // returns whether the workers have finished with every load of the given
+    // pack
+    bool is_pack_finished(const PackLoad& pack) const
+    {
+        for(ResourceId id : pack.ids)
+        {
+            auto f_job = m_jobs.find(id);
+            if(f_job != m_jobs.end() && !is_finished(*f_job->second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // adds the result of the given completed asynchronous load to the
+    // resources
+    void publish(const LoadJob& job)
+    {
+        #ifndef OMI_API_MODE_PRODUCTION
+            record_load_time(job.path, job.load_time);
+        #endif
+
+        try
+        {
+            add_resource(job.id, job.future.get());
+        }
+        catch(const std::exception& exc)
+        {
+            global::logger->error
+                << "Failed to load resource \"" << job.path.to_unix()
+                << "\": " << exc.what() << std::endl;
+        }
+    }
+
+    // publishes completed asynchronous loads and then evicts resources if the
+    // memory budget has been exceeded
+    void update()
+    {
+        collect_completed();
+        enforce_budget();
+    }
+
+    // adds the given data to the loaded resources, it initially has no
+    // handles
+    void add_resource(ResourceId id, const omi::Attribute& data)
+    {
+        LoadedResource resource;
+        resource.data = data;
+        resource.bytes = get_resident_bytes(data);
+        resource.references = 0;
+        resource.unreferenced_position =
+            m_unreferenced.insert(m_unreferenced.end(), id);
+        m_resources.insert(std::make_pair(id, resource));
+
+        m_resident_bytes += resource.bytes;
+        record_resident_bytes();
+    }
+
+    // marks the given resource as the most recently used if it has no handles
+    void touch(LoadedResource& resource)
+    {
+        if(resource.references == 0)
+        {
+            m_unreferenced.splice(
+                m_unreferenced.end(),
+                m_unreferenced,
+                resource.unreferenced_position
+            );
+        }
+    }
+
+    // unloads the least recently used resources without handles until the
+    // loaded resources are within the memory budget
+    void enforce_budget()
+    {
+        if(m_memory_budget == 0)
+        {
+            return;
+        }
+
+        bool evicted = false;
+        while(m_resident_bytes > m_memory_budget && !m_unreferenced.empty())
+        {
+            auto f_resource = m_resources.find(m_unreferenced.front());
+            m_unreferenced.pop_front();
+
+            m_resident_bytes -= f_resource->second.bytes;
+            m_resources.erase(f_resource);
+            m_stat_evictions.set_at(0, m_stat_evictions.at(0) + 1);
+            evicted = true;
+        }
+
+        if(evicted)
+        {
+            record_resident_bytes();
+        }
+    }
+
+    // updates the resident memory stats
+    void record_resident_bytes()
+    {
+        m_stat_resident_bytes.set_at(
+            0,
+            static_cast<arc::int64>(m_resident_bytes)
+        );
+        if(m_stat_resident_bytes.at(0) > m_stat_peak_resident_bytes.at(0))
+        {
+            m_stat_peak_resident_bytes.set_at(0, m_stat_resident_bytes.at(0));
+        }
+    }
+
+    // publishes the loads of the given pack, which must have finished
+    void publish_pack(const PackLoad& pack)
+    {
+        for(ResourceId id : pack.ids)
+        {
+            auto f_job = m_jobs.find(id);
+            if(f_job != m_jobs.end())
+            {
+                publish(*f_job->second);
+                m_jobs.erase(f_job);
+            }
+        }
+    }
+
+    // publishes all asynchronous loads that have completed, loads that are
+    // part of a pack are only published once the entire pack has completed
+    void collect_completed()
+    {
+        std::vector<std::shared_ptr<LoadJob>> completed;
+        std::unordered_map<const PackLoad*, bool> packs;
+        for(const auto& job : m_jobs)
+        {
+            const PackLoad* pack = job.second->pack.get();
+            if(pack == nullptr)
+            {
+                if(is_finished(*job.second))
+                {
+                    completed.push_back(job.second);
+                }
+                continue;
+            }
+
+            // only check each pack once
+            auto f_pack = packs.find(pack);
+            if(f_pack == packs.end())
+            {
+                f_pack = packs.insert(
+                    std::make_pair(pack, is_pack_finished(*pack))
+                ).first;
+                if(f_pack->second)
+                {
+                    completed.push_back(job.second);
+                }
+            }
+        }
+
+        for(const std::shared_ptr<LoadJob>& job : completed)
+        {
+            if(job->pack)
+            {
+                publish_pack(*job->pack);
+            }
+            else
+            {
+                publish(*job);
+                m_jobs.erase(job->id);
+            }
+        }
+    }
+
+    // starts reloading the modified resources that are loaded, resources that
+    // are modified again while being reloaded are reloaded once more after the
+    // current reload has been collected
+    void start_reloads()
+    {
+        std::vector<ResourceId> modified(m_modified.begin(), m_modified.end());
+        for(ResourceId id : modified)
+        {
+            if(m_reloads.find(id) != m_reloads.end())
+            {
+                continue;
+            }
+            m_modified.erase(id);
+
+            // resources that are not loaded will be read from the modified
+            // file when they are next loaded
+            if(m_resources.find(id) == m_resources.end())
+            {
+                continue;
+            }
+
+            std::shared_ptr<LoadJob> job = create_job(id, nullptr);
+            m_reloads.insert(std::make_pair(id, job));
+            if(m_workers.empty())
+            {
+                run_job(job);
+            }
+            else
+            {
+                push_jobs({job});
+            }
+        }
+    }
+
+    // swaps the data of the reloads that have completed into the loaded
+    // resources and notifies the listeners of the resources, resources that
+    // fail to reload keep their previous data
+    void collect_reloads()
+    {
+        std::vector<std::shared_ptr<LoadJob>> completed;
+        for(const auto& reload : m_reloads)
+        {
+            if(is_finished(*reload.second))
+            {
+                completed.push_back(reload.second);
+            }
+        }
+
+        for(const std::shared_ptr<LoadJob>& job : completed)
+        {
+            m_reloads.erase(job->id);
+
+            #ifndef OMI_API_MODE_PRODUCTION
+                record_load_time(job->path, job->load_time);
+            #endif
+
+            omi::Attribute data;
+            try
+            {
+                data = job->future.get();
+            }
+            catch(const std::exception& exc)
+            {
+                global::logger->error
+                    << "Failed to reload resource \"" << job->path.to_unix()
+                    << "\", its previous data will continue to be used: "
+                    << exc.what() << std::endl;
+                continue;
+            }
+
+            // the resource may have been evicted during the reload
+            auto f_resource = m_resources.find(job->id);
+            if(f_resource == m_resources.end())
+            {
+                continue;
+            }
+
+            m_resident_bytes -= f_resource->second.bytes;
+            f_resource->second.data = data;
+            f_resource->second.bytes = get_resident_bytes(data);
+            m_resident_bytes += f_resource->second.bytes;
+            record_resident_bytes();
+            m_stat_reloads.set_at(0, m_stat_reloads.at(0) + 1);
+
+            global::logger->debug
+                << "Reloaded resource \"" << job->path.to_unix() << "\""
+                << std::endl;
+
+            notify_reload(job->id, data);
+        }
+    }
+
+    // notifies the listeners of the given resource that it has been reloaded
+    void notify_reload(ResourceId id, const omi::Attribute& data)
+    {
+        auto f_listeners = m_reload_listeners.find(id);
+        if(f_listeners == m_reload_listeners.end())
+        {
+            return;
+        }
+
+        // listeners may be added or removed by the notified listeners
+        std::vector<ReloadListener*> listeners(f_listeners->second);
+        for(ReloadListener* listener : listeners)
+        {
+            f_listeners = m_reload_listeners.find(id);
+            if(f_listeners == m_reload_listeners.end())
+            {
+                return;
+            }
+            if(std::find(
+                    f_listeners->second.begin(),
+                    f_listeners->second.end(),
+                    listener
+                ) != f_listeners->second.end())
+            {
+                listener->on_reload(id, data);
+            }
+        }
+    }
+
+    // blocks until every load of the given pack has completed and then
+    // publishes them together
+    void wait_for_pack(const PackLoad& pack)
+    {
+        #ifndef OMI_API_MODE_PRODUCTION
+            arc::uint64 wait_start = arc::clock::get_current_time();
+        #endif
+
+        for(ResourceId id : pack.ids)
+        {
+            auto f_job = m_jobs.find(id);
+            if(f_job != m_jobs.end())
+            {
+                f_job->second->result->finished.wait();
+            }
+        }
+
+        #ifndef OMI_API_MODE_PRODUCTION
+            record_wait_time(arc::clock::get_current_time() - wait_start);
+        #endif
+
+        publish_pack(pack);
+    }
+
+    // blocks until the given asynchronous load (and the rest of its pack) has
+    // completed and returns the resource, or throws the error that caused the
+    // load to fail
+    omi::Attribute wait_for_load(std::shared_ptr<LoadJob> job)
+    {
+        if(job->pack)
+        {
+            wait_for_pack(*job->pack);
+            return job->future.get();
+        }
+
+        m_jobs.erase(job->id);
+
+        #ifndef OMI_API_MODE_PRODUCTION
+            arc::uint64 wait_start = arc::clock::get_current_time();
+        #endif
+
+        job->result->finished.wait();
+
+        #ifndef OMI_API_MODE_PRODUCTION
+            record_wait_time(arc::clock::get_current_time() - wait_start);
+        #endif
+
+        publish(*job);
+        return job->future.get();
+    }
+
+    // the main function of the worker threads
+    void worker_routine()
+    {
+        while(true)
+        {
+            // wait for a job
+            std::shared_ptr<LoadJob> job;
+            {
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                while(!m_stop_workers && m_queue.empty())
+                {
+                    m_queue_condition.wait(lock);
+                }
+                if(m_stop_workers)
+                {
+                    return;
+                }
+                job = m_queue.front();
+                m_queue.pop_front();
+            }
+
+            run_job(std::move(job));
+        }
+    }
+
+    // loads the resource of the given job and signals that the job has
+    // finished
+    void run_job(std::shared_ptr<LoadJob> job) const
+    {
+        arc::uint64 load_start = arc::clock::get_current_time();
+        try
+        {
+            job->result->resource = read_resource(job->path, job->loader);
+        }
+        catch(...)
+        {
+            job->result->error = std::current_exception();
+        }
+        job->load_time = arc::clock::get_current_time() - load_start;
+
+        // the job is still owned by m_jobs or m_reloads so releasing it here
+        // never destroys the result
+        std::promise<void> done(std::move(job->done));
+        job.reset();
+        done.set_value();
+    }
+
+    // stops and joins the worker threads, discarding any queued loads
+    void stop_workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_stop_workers = true;
+            for(std::shared_ptr<LoadJob>& job : m_queue)
+            {
+                job->result->error = std::make_exception_ptr(
+                    arc::ex::StateError(
+                        "ResourceRegistry was shutdown before the resource "
+                        "was loaded"
+                    )
+                );
+                job->done.set_value();
+            }
+            m_queue.clear();
+        }
+        m_queue_condition.notify_all();
+        for(std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+};
+
+//------------------------------------------------------------------------------
+//                            PUBLIC STATIC FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT ResourceRegistry* ResourceRegistry::instance()
+{
+    static ResourceRegistry inst;
+    return &inst;
+}
+
+//------------------------------------------------------------------------------
+//                            PUBLIC MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT bool ResourceRegistry::startup_routine()
+{
+    return m_impl->startup_routine();
+}
+
+OMI_API_EXPORT bool ResourceRegistry::shutdown_routine()
+{
+    return m_impl->shutdown_routine();
+}
+
+OMI_API_EXPORT void ResourceRegistry::define_loader(
+        LoaderFunc* function,
         const arc::str::UTF8String& extension)
 {
     m_impl->define_loader(function, extension);
 }
 
+OMI_API_EXPORT void ResourceRegistry::define_mapped_loader(
+        MappedLoaderFunc* function,
+        const arc::str::UTF8String& extension)
+{
+    m_impl->define_mapped_loader(function, extension);
+}
+
+OMI_API_EXPORT void ResourceRegistry::frame_routine()
+{
+    m_impl->frame_routine();
+}
+
 OMI_API_EXPORT bool ResourceRegistry::is_loaded(ResourceId id) const
 {
     return m_impl->is_loaded(id);
 }
 
+OMI_API_EXPORT bool ResourceRegistry::is_loading(ResourceId id) const
+{
+    return m_impl->is_loading(id);
+}
+
 OMI_API_EXPORT omi::Attribute ResourceRegistry::get(ResourceId id)
 {
     return m_impl->get(id);
@@ -469,6 +2062,75 @@ OMI_API_EXPORT void ResourceRegistry::load_blocking(ResourceId id)
     m_impl->load_blocking(id);
 }
 
+OMI_API_EXPORT std::shared_future<omi::Attribute> ResourceRegistry::load_async(
+        ResourceId id)
+{
+    return m_impl->load_async(id);
+}
+
+OMI_API_EXPORT void ResourceRegistry::define_pack(
+        const arc::str::UTF8String& name,
+        const std::vector<ResourceId>& resources)
+{
+    m_impl->define_pack(name, resources);
+}
+
+OMI_API_EXPORT bool ResourceRegistry::is_pack_loaded(
+        const arc::str::UTF8String& name) const
+{
+    return m_impl->is_pack_loaded(name);
+}
+
+OMI_API_EXPORT void ResourceRegistry::load_pack_blocking(
+        const arc::str::UTF8String& name)
+{
+    m_impl->load_pack_blocking(name);
+}
+
+OMI_API_EXPORT void ResourceRegistry::load_pack_async(
+        const arc::str::UTF8String& name)
+{
+    m_impl->load_pack_async(name);
+}
+
+OMI_API_EXPORT ResourceHandle ResourceRegistry::acquire(ResourceId id)
+{
+    return m_impl->acquire(id);
+}
+
+OMI_API_EXPORT void ResourceRegistry::set_memory_budget(std::size_t bytes)
+{
+    m_impl->set_memory_budget(bytes);
+}
+
+OMI_API_EXPORT void ResourceRegistry::add_reload_listener(
+        ResourceId id,
+        ReloadListener* listener)
+{
+    m_impl->add_reload_listener(id, listener);
+}
+
+OMI_API_EXPORT void ResourceRegistry::remove_reload_listener(
+        ResourceId id,
+        ReloadListener* listener)
+{
+    m_impl->remove_reload_listener(id, listener);
+}
+
+//------------------------------------------------------------------------------
+//                            PRIVATE MEMBER FUNCTIONS
+//------------------------------------------------------------------------------
+
+void ResourceRegistry::add_reference(ResourceId id)
+{
+    m_impl->add_reference(id);
+}
+
+void ResourceRegistry::release_reference(ResourceId id)
+{
+    m_impl->release_reference(id);
+}
+
 //------------------------------------------------------------------------------
 //                              PRIVATE CONSTRUCTOR
 //------------------------------------------------------------------------------
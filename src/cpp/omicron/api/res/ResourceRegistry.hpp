@@ -5,9 +5,13 @@
 #ifndef OMICRON_API_RES_RESOURCEREGISTRY_HPP_
 #define OMICRON_API_RES_RESOURCEREGISTRY_HPP_
 
+#include <future>
+#include <vector>
+
 #include <arcanecore/base/lang/Restrictors.hpp>
 
 #include "omicron/api/API.hpp"
+#include "omicron/api/res/ResourceHandle.hpp"
 #include "omicron/api/res/ResourceId.hpp"
 
 
@@ -36,16 +40,49 @@ class Attribute;
 namespace res
 {
 
+class MappedFile;
+class ReloadListener;
+
 /*!
  * \brief Singleton object that discovers the locations of avialable resources
  *        and provides functionality for loading resources either blocking or
  *        asynchronously.
+ *
+ * Asynchronous loads are read and parsed by a pool of worker threads, the size
+ * of which is defined by the "load_threads" value of registry.json.
+ *
+ * Resources that are used together (e.g. by a level) can be defined as a pack
+ * using define_pack(). Loading a pack reads its resources in the order their
+ * data is stored, parses them in parallel on the worker threads, and adds them
+ * to the registry together once they have all been loaded.
+ *
+ * Loaded resources stay loaded while there are ResourceHandles to them (see
+ * acquire()). If the approximate memory used by loaded resources exceeds the
+ * "memory_budget_mb" value of registry.json, the least recently used resources
+ * without handles are unloaded until the registry is back within the budget.
+ *
+ * When "use_real_files" and "hot_reload" are enabled in registry.json, the
+ * directories of the resources are watched for modifications. Loaded resources
+ * whose file is modified are reloaded by the worker threads and swapped in by
+ * frame_routine(), which then notifies the resource's ReloadListeners so that
+ * data derived from the resource can be rebuilt.
+ *
+ * \note Apart from its internal worker threads, the ResourceRegistry should
+ *       only be used from a single thread.
  */
 class ResourceRegistry
     : private arc::lang::Noncopyable
     , private arc::lang::Nonmovable
     , private arc::lang::Noncomparable
 {
+private:
+
+    //--------------------------------------------------------------------------
+    //                                  FRIENDS
+    //--------------------------------------------------------------------------
+
+    friend class ResourceHandle;
+
 public:
 
     //--------------------------------------------------------------------------
@@ -58,6 +95,15 @@ public:
      */
     typedef omi::Attribute (LoaderFunc)(arc::io::sys::FileReader&);
 
+    /*!
+     * \brief Definition of a function that can be used to load resources by
+     *        parsing the contents of a file in memory.
+     *
+     * Data attributes of the loaded resource may refer to the file's contents
+     * without copying them using omi::res::MappedFile::borrow().
+     */
+    typedef omi::Attribute (MappedLoaderFunc)(const MappedFile&);
+
     //--------------------------------------------------------------------------
     //                          PUBLIC STATIC FUNCTIONS
     //--------------------------------------------------------------------------
@@ -96,6 +142,37 @@ public:
             LoaderFunc* function,
             const arc::str::UTF8String& extension);
 
+    /*!
+     * \brief Adds a new resource loader function which parses files in memory
+     *        to the registry.
+     *
+     * When "memory_map" is enabled in registry.json resources are parsed in
+     * place from the memory-mapped package archive (see ResourceArchive), or
+     * from memory-mapped real files when "use_real_files" is enabled, and
+     * this loader is preferred over a loader defined with define_loader() for
+     * the same extension. Real files are never mapped while "hot_reload" is
+     * enabled, since they may be rewritten while their data is still in use.
+     * Otherwise this loader is only used if there is no loader defined with
+     * define_loader(), in which case the file is read into memory first.
+     *
+     * \param function The function that can be used to load a resource from
+     *                 a file in memory.
+     * \param extension The file extension this function should be used to load.
+     */
+    OMI_API_EXPORT void define_mapped_loader(
+            MappedLoaderFunc* function,
+            const arc::str::UTF8String& extension);
+
+    /*!
+     * \brief Performs the ResourceRegistry's per frame work, this should be
+     *        called once at the start of each frame.
+     *
+     * Publishes completed asynchronous loads and, if resources are being hot
+     * reloaded, starts reloading the resources that have been modified and
+     * swaps in the reloads that have completed.
+     */
+    OMI_API_EXPORT void frame_routine();
+
     #endif
     // IN_DOXYGEN
     //--------------------------------------------------------------------------
@@ -105,20 +182,138 @@ public:
      */
     OMI_API_EXPORT bool is_loaded(ResourceId id) const;
 
-    // TOOD: in async queue?
+    /*!
+     * \brief Returns whether the resource is currently queued for, or in the
+     *        process of, being loaded asynchronously.
+     */
+    OMI_API_EXPORT bool is_loading(ResourceId id) const;
 
-    // TODO: DOC once async loading is thing
+    /*!
+     * \brief Returns the data of the resource with the given id.
+     *
+     * If the resource is being loaded asynchronously this blocks until the
+     * load has completed. If the resource has not been requested at all it is
+     * loaded blocking, which is recorded by the
+     * "Resources.Unanticipated Loads" stat.
+     *
+     * The returned data does not keep the resource loaded in the registry, use
+     * acquire() if the resource will be used repeatedly.
+     *
+     * \throw arc::ex::KeyError If there is no resource with the given id.
+     */
     // TODO: this resource could be an mutable copy or the true mutable version
     OMI_API_EXPORT omi::Attribute get(ResourceId id);
 
-    // TODO: DOC
+    /*!
+     * \brief Loads the resource with the given id on the calling thread.
+     *
+     * If the resource is already being loaded asynchronously this waits for
+     * that load to complete instead.
+     *
+     * \throw arc::ex::KeyError If there is no resource with the given id.
+     */
     OMI_API_EXPORT void load_blocking(ResourceId id);
 
-    // TODO: load blocking from id
-    // TODO: load async from id
+    /*!
+     * \brief Queues the resource with the given id to be loaded by the
+     *        registry's worker threads.
+     *
+     * Completed loads are added to the registry by the next call to any of
+     * is_loaded(), is_loading(), get(), load_blocking(), or load_async(). If
+     * the registry has no worker threads the resource is loaded blocking.
+     *
+     * \return A future holding the loaded resource, or the error if the load
+     *         failed. Calling get() on the future blocks until the load has
+     *         completed. The future is deferred so that the resource is only
+     *         ever referenced by the calling thread, use is_loading() to poll
+     *         for completion rather than wait_for().
+     *
+     * \throw arc::ex::KeyError If there is no resource with the given id.
+     */
+    OMI_API_EXPORT std::shared_future<omi::Attribute> load_async(ResourceId id);
+
+    /*!
+     * \brief Defines a pack of resources which can be loaded together.
+     *
+     * \param name The name which will be used to refer to the pack.
+     * \param resources The ids of the resources in the pack.
+     *
+     * \throw arc::ex::KeyError If there is no resource with one of the given
+     *                          ids.
+     */
+    OMI_API_EXPORT void define_pack(
+            const arc::str::UTF8String& name,
+            const std::vector<ResourceId>& resources);
+
+    /*!
+     * \brief Returns whether every resource of the pack with the given name is
+     *        currently loaded.
+     *
+     * \throw arc::ex::KeyError If no pack has been defined with the given name.
+     */
+    OMI_API_EXPORT bool is_pack_loaded(const arc::str::UTF8String& name) const;
+
+    /*!
+     * \brief Loads all resources of the pack with the given name that are not
+     *        already loaded, blocking until they have all been loaded.
+     *
+     * \throw arc::ex::KeyError If no pack has been defined with the given name.
+     */
+    OMI_API_EXPORT void load_pack_blocking(const arc::str::UTF8String& name);
 
-    // TODO: loading blocking pack
-    // TODO: loading async from pack
+    /*!
+     * \brief Queues all resources of the pack with the given name that are not
+     *        already loaded to be loaded by the registry's worker threads.
+     *
+     * The resources are added to the registry together once all of them have
+     * been loaded, use is_pack_loaded() to poll for completion. Requesting a
+     * resource of the pack with get() before then blocks until the entire pack
+     * has been loaded.
+     *
+     * \throw arc::ex::KeyError If no pack has been defined with the given name.
+     */
+    OMI_API_EXPORT void load_pack_async(const arc::str::UTF8String& name);
+
+    /*!
+     * \brief Returns a handle to the resource with the given id, which keeps
+     *        the resource loaded until it is released.
+     *
+     * The resource is loaded in the same way as get().
+     *
+     * \throw arc::ex::KeyError If there is no resource with the given id.
+     */
+    OMI_API_EXPORT ResourceHandle acquire(ResourceId id);
+
+    /*!
+     * \brief Sets the approximate memory in bytes that loaded resources may use
+     *        before resources without handles are unloaded, overriding the
+     *        "memory_budget_mb" value of registry.json.
+     *
+     * Resources are unloaded straight away if they exceed the new budget. A
+     * budget of 0 means resources are never unloaded.
+     */
+    OMI_API_EXPORT void set_memory_budget(std::size_t bytes);
+
+    /*!
+     * \brief Adds an object that will be notified whenever the resource with
+     *        the given id is hot reloaded.
+     *
+     * Note that the listener is not owned by the registry and must be removed
+     * with remove_reload_listener() before it is destroyed.
+     */
+    OMI_API_EXPORT void add_reload_listener(
+            ResourceId id,
+            ReloadListener* listener);
+
+    /*!
+     * \brief Stops notifying the given object of reloads of the resource with
+     *        the given id.
+     *
+     * This does nothing if the listener was not added for the resource.
+     */
+    OMI_API_EXPORT void remove_reload_listener(
+            ResourceId id,
+            ReloadListener* listener);
 
 private:
 
@@ -134,6 +329,16 @@ private:
 
     ~ResourceRegistry();
 
+    //--------------------------------------------------------------------------
+    //                          PRIVATE MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    // counts a new handle to the given resource
+    void add_reference(ResourceId id);
+
+    // releases a handle to the given resource
+    void release_reference(ResourceId id);
+
     //--------------------------------------------------------------------------
     //                            COMPILATION FIREWALL
     //--------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+#include "omicron/api/res/loaders/CookedLoader.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/Types.hpp>
+
+#include "omicron/api/common/attribute/AttributeCodec.hpp"
+#include "omicron/api/res/Compression.hpp"
+#include "omicron/api/res/DefineLoader.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the header at the start of every cooked file, its size keeps the encoding
+// that follows it aligned
+struct Header
+{
+    // identifies the data as a cooked file
+    char magic[4];
+    // describes how the encoding is stored
+    arc::uint32 flags;
+    // the length of the encoding once decompressed
+    arc::uint64 encoded_length;
+};
+
+// the magic bytes at the start of cooked files
+static const char MAGIC[4] = {'O', 'M', 'C', 'K'};
+// flags the encoding as compressed
+static const arc::uint32 FLAG_COMPRESSED = 1U << 0;
+// the flags this build can load
+static const arc::uint32 SUPPORTED_FLAGS = FLAG_COMPRESSED;
+// compressed encodings are only kept if they save at least this fraction of the
+// encoded length
+static const std::size_t MIN_SAVING_FRACTION = 8;
+
+// releases the reference to the MappedFile held by the decoded attributes
+void release_cooked_data(void* user_data)
+{
+    delete static_cast<std::shared_ptr<const MappedFile>*>(user_data);
+}
+
+// releases the decompressed encoding held by the decoded attributes
+void release_decompressed_data(void* user_data)
+{
+    delete[] static_cast<char*>(user_data);
+}
+
+// throws a parse error for the given cooked file
+void throw_cooked_error(const MappedFile& file, const char* reason)
+{
+    arc::str::UTF8String error_message;
+    error_message
+        << reason << " in cooked file: \"" << file.get_path().to_unix()
+        << "\"";
+    throw arc::ex::ParseError(error_message);
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+OMI_API_EXPORT void encode_cooked(
+        const omi::Attribute& data,
+        bool compress,
+        std::vector<char>& cooked)
+{
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(data, encoded);
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.flags = 0;
+    header.encoded_length = encoded.size();
+
+    std::vector<char> compressed;
+    if(compress)
+    {
+        omi::res::compress(encoded.data(), encoded.size(), compressed);
+        if(compressed.size() <=
+           encoded.size() - (encoded.size() / MIN_SAVING_FRACTION))
+        {
+            header.flags |= FLAG_COMPRESSED;
+        }
+    }
+    const std::vector<char>& payload =
+        (header.flags & FLAG_COMPRESSED) ? compressed : encoded;
+
+    cooked.resize(sizeof(Header) + payload.size());
+    std::memcpy(cooked.data(), &header, sizeof(Header));
+    std::memcpy(cooked.data() + sizeof(Header), payload.data(), payload.size());
+}
+
+OMI_API_EXPORT omi::Attribute load_cooked(const MappedFile& file)
+{
+    Header header;
+    if(file.get_size() < sizeof(Header))
+    {
+        throw_cooked_error(file, "Missing header");
+    }
+    std::memcpy(&header, file.get_data(), sizeof(Header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw_cooked_error(file, "Invalid magic");
+    }
+    if((header.flags & ~SUPPORTED_FLAGS) != 0)
+    {
+        throw_cooked_error(file, "Unsupported flags");
+    }
+
+    const char* payload = file.get_data() + sizeof(Header);
+    std::size_t payload_length = file.get_size() - sizeof(Header);
+
+    if(!(header.flags & FLAG_COMPRESSED))
+    {
+        if(payload_length != header.encoded_length)
+        {
+            throw_cooked_error(file, "Truncated encoding");
+        }
+        // the decoded attributes keep the file mapped while they borrow from
+        // it
+        return omi::AttributeCodec::decode_borrowed(
+            payload,
+            payload_length,
+            &release_cooked_data,
+            new std::shared_ptr<const MappedFile>(file.shared_from_this())
+        );
+    }
+
+    // this is called by the ResourceRegistry's workers for asynchronous loads,
+    // so decompression happens off the main thread - and the decoded
+    // attributes borrow from the decompressed encoding rather than copying it
+    std::size_t encoded_length =
+        static_cast<std::size_t>(header.encoded_length);
+    std::unique_ptr<char[]> encoded(new char[encoded_length]);
+    omi::res::decompress(
+        payload,
+        payload_length,
+        encoded.get(),
+        encoded_length
+    );
+    // (which releases the data if decoding fails)
+    char* data = encoded.release();
+    return omi::AttributeCodec::decode_borrowed(
+        data,
+        encoded_length,
+        &release_decompressed_data,
+        data
+    );
+}
+
+} // namespace res
+} // namespace omi
+
+OMICRON_API_RES_DEFINE_MAPPED_LOADER(omi::res::load_cooked, "cooked");
@@ -0,0 +1,60 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Defines the interface for the cooked resource functions.
+ */
+#ifndef OMICRON_API_RES_LOADERS_COOKEDLOADER_HPP_
+#define OMICRON_API_RES_LOADERS_COOKEDLOADER_HPP_
+
+#include <vector>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/Attributes.hpp"
+#include "omicron/api/res/MappedFile.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Writes the contents of a cooked file holding the given attributes.
+ *
+ * A cooked file is a small header followed by the attributes encoded with
+ * omi::AttributeCodec. The header holds flags describing how the encoding is
+ * stored, so each cooked file can be stored differently.
+ *
+ * \param data The attributes to cook.
+ * \param compress Whether to compress the encoding (see omi::res::compress()).
+ *                 The encoding is only stored compressed if this saves enough
+ *                 space to be worth decompressing it on load.
+ * \param cooked Receives the contents of the cooked file, which replace any
+ *               existing contents.
+ */
+OMI_API_EXPORT void encode_cooked(
+        const omi::Attribute& data,
+        bool compress,
+        std::vector<char>& cooked);
+
+/*!
+ * \brief Loads a cooked resource file written by encode_cooked().
+ *
+ * Cooked files are written by the omicron_cook tool next to their source
+ * resources (e.g. "bunny.obj.cooked") and the ResourceRegistry loads them in
+ * place of the source. Large blocks of values (e.g. the positions of a mesh)
+ * refer directly to the mapped file rather than being copied or parsed, unless
+ * the file is compressed in which case they refer to the decompressed data.
+ *
+ * \throw arc::ex::ParseError If the file is not a valid cooked file.
+ */
+OMI_API_EXPORT omi::Attribute load_cooked(const MappedFile& file);
+
+} // namespace res
+} // namespace omi
+
+#endif
@@ -1,8 +1,15 @@
+#include "omicron/api/res/loaders/OBJLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <arcanecore/base/Exceptions.hpp>
-#include <arcanecore/io/sys/FileReader.hpp>
-#include <arcanecore/lx/Vector.hpp>
 
-#include "omicron/api/common/Attributes.hpp"
 #include "omicron/api/res/DefineLoader.hpp"
 
 
@@ -19,100 +26,838 @@ namespace
 
 // The stride of a geometry position (in floats).
 static const std::size_t POSITION_STRIDE = 3;
+// The stride of a geometry normal (in floats).
+static const std::size_t NORMAL_STRIDE = 3;
+// The stride of a geometry uv (in floats).
+static const std::size_t UV_STRIDE = 2;
+
+// The minimum number of bytes that load_obj gives to each parsing thread.
+static const std::size_t MIN_CHUNK_SIZE = 1024 * 1024;
+
+// Mantissas are only accumulated while they are small enough to be exactly
+// represented by a double, further digits are beyond the precision of a float.
+static const arc::uint64 MAX_MANTISSA = (1ULL << 53) / 10 - 1;
+// Exponents beyond this are clamped, since they underflow or overflow anyway.
+static const int MAX_EXPONENT = 400;
+// The powers of ten which are exactly representable by a double.
+static const double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int MAX_POW10 = 22;
+
+// The byte order mark of UTF-8 text files.
+static const char UTF8_BOM[] = {'\xEF', '\xBB', '\xBF'};
 
 //------------------------------------------------------------------------------
-//                                   FUNCTIONS
+//                                    STRUCTS
+//------------------------------------------------------------------------------
+
+// The number of each element in a range of obj data.
+struct Counts
+{
+    std::size_t lines;
+    std::size_t positions;
+    std::size_t uvs;
+    std::size_t normals;
+    // the number of triangle vertices the faces are split into
+    std::size_t vertices;
+    // whether any face references texture coordinates or normals
+    bool uv_indices;
+    bool normal_indices;
+
+    Counts()
+        : lines         (0)
+        , positions     (0)
+        , uvs           (0)
+        , normals       (0)
+        , vertices      (0)
+        , uv_indices    (false)
+        , normal_indices(false)
+    {
+    }
+
+    Counts& operator+=(const Counts& other)
+    {
+        lines += other.lines;
+        positions += other.positions;
+        uvs += other.uvs;
+        normals += other.normals;
+        vertices += other.vertices;
+        uv_indices = uv_indices || other.uv_indices;
+        normal_indices = normal_indices || other.normal_indices;
+        return *this;
+    }
+};
+
+// A range of lines of obj data which is counted and parsed by one thread.
+struct Chunk
+{
+    const char* begin;
+    const char* end;
+    // the elements in this chunk
+    Counts counts;
+    // the elements in all of the preceding chunks
+    Counts offsets;
+};
+
+// The arrays that obj data is parsed into, each chunk writes to its own range.
+struct Output
+{
+    // the elements in the entire file
+    Counts totals;
+    float* positions;
+    float* uvs;
+    float* normals;
+    arc::int32* point_indices;
+    // per vertex indices, these are -1 for vertices without an uv or normal
+    arc::int32* uv_indices;
+    arc::int32* normal_indices;
+};
+
+// The types of lines that are parsed, all others are ignored.
+enum LineType
+{
+    LINE_OTHER,
+    LINE_POSITION,
+    LINE_UV,
+    LINE_NORMAL,
+    LINE_FACE
+};
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
 //------------------------------------------------------------------------------
 
-// loads a Wavefront obj file into Omicron attributes
-static omi::Attribute load_obj(arc::io::sys::FileReader& reader)
+// returns whether the character is whitespace within a line
+static bool is_blank(char c)
 {
-    // TODO: time this an optimise file reading
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
 
-    // per point positions
-    std::vector<float> point_positions;
-    // per vertex positions
-    std::vector<float> vertex_positions;
+// returns whether the character is a decimal digit
+static bool is_digit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
 
-    // TODO: reserve this list (can try read from file)
+// returns whether the cursor is at the end of a line
+static bool is_line_end(const char* c, const char* end)
+{
+    return c == end || *c == '\n';
+}
 
-    // iterate over each line of the file
-    while(!reader.eof())
+// advances the cursor past any whitespace within the line
+static void skip_blank(const char*& c, const char* end)
+{
+    while(c != end && is_blank(*c))
+    {
+        ++c;
+    }
+}
+
+// advances the cursor past the current token of the line
+static void skip_token(const char*& c, const char* end)
+{
+    while(c != end && !is_blank(*c) && *c != '\n')
     {
-        // TODO: fastest to probably be able to get data from stream without
-        // copying
-        // TODO: move out?
-        arc::str::UTF8String line;
-        reader.read_line(line);
+        ++c;
+    }
+}
+
+// returns a pointer to the start of the line following the cursor
+static const char* next_line(const char* c, const char* end)
+{
+    const char* line_end =
+        static_cast<const char*>(std::memchr(c, '\n', end - c));
+    return line_end != nullptr ? line_end + 1 : end;
+}
 
-        // position?
-        if(line.starts_with("v"))
+// returns the type of the line at the cursor, and advances the cursor past the
+// line's keyword
+static LineType get_line_type(const char*& c, const char* end)
+{
+    skip_blank(c, end);
+    if(end - c < 2)
+    {
+        return LINE_OTHER;
+    }
+
+    if(c[0] == 'f' && is_blank(c[1]))
+    {
+        c += 1;
+        return LINE_FACE;
+    }
+    if(c[0] != 'v')
+    {
+        return LINE_OTHER;
+    }
+    if(is_blank(c[1]))
+    {
+        c += 1;
+        return LINE_POSITION;
+    }
+    if(end - c < 3 || !is_blank(c[2]))
+    {
+        return LINE_OTHER;
+    }
+    if(c[1] == 't')
+    {
+        c += 2;
+        return LINE_UV;
+    }
+    if(c[1] == 'n')
+    {
+        c += 2;
+        return LINE_NORMAL;
+    }
+    return LINE_OTHER;
+}
+
+// parses a decimal floating point number at the cursor (after any whitespace),
+// returns false if there is no valid number
+//
+// This avoids the locale handling and null terminated input of the standard
+// library functions. The significant digits are accumulated into an integer
+// which is scaled by exact powers of ten, so the result is within one ulp of
+// the correctly rounded float.
+static bool parse_float(const char*& c, const char* end, float& value)
+{
+    skip_blank(c, end);
+
+    bool negative = false;
+    if(c != end && (*c == '-' || *c == '+'))
+    {
+        negative = *c == '-';
+        ++c;
+    }
+
+    arc::uint64 mantissa = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    for(; c != end && is_digit(*c); ++c)
+    {
+        has_digits = true;
+        if(mantissa <= MAX_MANTISSA)
+        {
+            mantissa = mantissa * 10 + static_cast<arc::uint64>(*c - '0');
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+    if(c != end && *c == '.')
+    {
+        for(++c; c != end && is_digit(*c); ++c)
         {
-            // TODO: split with start from and end with
-            // split on space
-            std::vector<arc::str::UTF8String> values = line.split(" ");
-            // right number of values?
-            if(values.size() != (POSITION_STRIDE + 1))
+            has_digits = true;
+            if(mantissa <= MAX_MANTISSA)
             {
-                throw arc::ex::ParseError(
-                    "Invalid position line: \"" + line + "\""
-                );
+                mantissa = mantissa * 10 + static_cast<arc::uint64>(*c - '0');
+                --exponent;
             }
-            point_positions.push_back(values[1].to_float());
-            point_positions.push_back(values[2].to_float());
-            point_positions.push_back(values[3].to_float());
         }
-        else if(line.starts_with("f"))
+    }
+    if(!has_digits)
+    {
+        return false;
+    }
+
+    if(c != end && (*c == 'e' || *c == 'E'))
+    {
+        ++c;
+        bool negative_exponent = false;
+        if(c != end && (*c == '-' || *c == '+'))
+        {
+            negative_exponent = *c == '-';
+            ++c;
+        }
+        if(c == end || !is_digit(*c))
         {
-            // TODO: split with start from and end with
-            // split on space
-            std::vector<arc::str::UTF8String> values = line.split(" ");
-            // right number of values?
-            if(values.size() != 4)
+            return false;
+        }
+        int e = 0;
+        for(; c != end && is_digit(*c); ++c)
+        {
+            if(e < MAX_EXPONENT)
             {
-                throw arc::ex::ParseError("Non-triangle face line: " + line);
+                e = e * 10 + (*c - '0');
             }
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    double result = static_cast<double>(mantissa);
+    if(mantissa != 0)
+    {
+        exponent = std::max(-MAX_EXPONENT, std::min(exponent, MAX_EXPONENT));
+        for(; exponent > MAX_POW10; exponent -= MAX_POW10)
+        {
+            result *= POW10[MAX_POW10];
+        }
+        for(; exponent < -MAX_POW10; exponent += MAX_POW10)
+        {
+            result /= POW10[MAX_POW10];
+        }
+        if(exponent < 0)
+        {
+            result /= POW10[-exponent];
+        }
+        else
+        {
+            result *= POW10[exponent];
+        }
+    }
+
+    value = static_cast<float>(negative ? -result : result);
+    return true;
+}
+
+// parses a signed decimal integer at the cursor, returns false if there is no
+// valid integer
+static bool parse_int(const char*& c, const char* end, arc::int64& value)
+{
+    bool negative = false;
+    if(c != end && (*c == '-' || *c == '+'))
+    {
+        negative = *c == '-';
+        ++c;
+    }
+    if(c == end || !is_digit(*c))
+    {
+        return false;
+    }
+
+    value = 0;
+    for(; c != end && is_digit(*c); ++c)
+    {
+        // larger values are out of range regardless
+        if(value < std::numeric_limits<arc::int32>::max())
+        {
+            value = value * 10 + (*c - '0');
+        }
+    }
+    if(negative)
+    {
+        value = -value;
+    }
+    return true;
+}
+
+// resolves a one-based or relative (negative) obj index to a zero-based index,
+// returns false if the index is out of range
+static bool resolve_index(
+        arc::int64 index,
+        std::size_t defined,
+        std::size_t total,
+        arc::int32& resolved)
+{
+    if(index < 0)
+    {
+        index += static_cast<arc::int64>(defined);
+    }
+    else
+    {
+        index -= 1;
+    }
+    if(index < 0 || index >= static_cast<arc::int64>(total))
+    {
+        return false;
+    }
+    resolved = static_cast<arc::int32>(index);
+    return true;
+}
+
+// throws a parse error for the given line
+static void throw_line_error(const char* reason, std::size_t line)
+{
+    arc::str::UTF8String message;
+    message << reason << " on line " << line << " of obj data";
+    throw arc::ex::ParseError(message);
+}
+
+//------------------------------------------------------------------------------
+//                                    PASSES
+//------------------------------------------------------------------------------
+
+// calls the function with contiguous sub-ranges of [0, count) on up to the
+// given number of threads, and rethrows the first exception thrown by a range
+template<typename T_Function>
+void parallel_for(
+        std::size_t count,
+        std::size_t thread_count,
+        const T_Function& function)
+{
+    thread_count = std::max<std::size_t>(1, std::min(thread_count, count));
+
+    std::vector<std::exception_ptr> errors(thread_count);
+    auto run = [&](std::size_t index)
+    {
+        try
+        {
+            function(
+                count * index / thread_count,
+                count * (index + 1) / thread_count
+            );
+        }
+        catch(...)
+        {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for(std::size_t i = 1; i < thread_count; ++i)
+    {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const std::exception_ptr& error : errors)
+    {
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// counts the elements of the chunk without storing any of them
+static void count_chunk(Chunk& chunk)
+{
+    Counts& counts = chunk.counts;
+    for(const char* line = chunk.begin; line != chunk.end; ++counts.lines)
+    {
+        const char* c = line;
+        switch(get_line_type(c, chunk.end))
+        {
+            case LINE_POSITION:
+                ++counts.positions;
+                break;
+            case LINE_UV:
+                ++counts.uvs;
+                break;
+            case LINE_NORMAL:
+                ++counts.normals;
+                break;
+            case LINE_FACE:
+            {
+                std::size_t corners = 0;
+                for(skip_blank(c, chunk.end);
+                    !is_line_end(c, chunk.end);
+                    skip_blank(c, chunk.end))
+                {
+                    // check for the forms p/t, p//n and p/t/n
+                    const char* token = c;
+                    skip_token(c, chunk.end);
+                    const char* slash = static_cast<const char*>(
+                        std::memchr(token, '/', c - token)
+                    );
+                    if(slash != nullptr)
+                    {
+                        counts.uv_indices =
+                            counts.uv_indices ||
+                            (slash + 1 != c && slash[1] != '/');
+                        const char* second = static_cast<const char*>(
+                            std::memchr(slash + 1, '/', c - slash - 1)
+                        );
+                        counts.normal_indices =
+                            counts.normal_indices ||
+                            (second != nullptr && second + 1 != c);
+                    }
+                    ++corners;
+                }
+                // invalid faces are reported by the parse pass
+                if(corners >= 3)
+                {
+                    counts.vertices += (corners - 2) * 3;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        line = next_line(c, chunk.end);
+    }
+}
+
+// parses a face corner of the form p, p/t, p//n, or p/t/n at the cursor into
+// zero-based point, uv, and normal indices (which are -1 if not specified),
+// returns false if the corner is invalid
+static bool parse_corner(
+        const char*& c,
+        const char* end,
+        const Output& output,
+        const Counts& defined,
+        arc::int32* corner)
+{
+    arc::int64 index = 0;
+    if(!parse_int(c, end, index) ||
+       !resolve_index(
+            index,
+            defined.positions,
+            output.totals.positions,
+            corner[0]
+       ))
+    {
+        return false;
+    }
+
+    corner[1] = -1;
+    corner[2] = -1;
+    if(c != end && *c == '/')
+    {
+        ++c;
+        if(c != end && *c != '/')
+        {
+            if(!parse_int(c, end, index) ||
+               !resolve_index(index, defined.uvs, output.totals.uvs, corner[1]))
+            {
+                return false;
+            }
+        }
+        if(c != end && *c == '/')
+        {
+            ++c;
+            if(!parse_int(c, end, index) ||
+               !resolve_index(
+                    index,
+                    defined.normals,
+                    output.totals.normals,
+                    corner[2]
+               ))
+            {
+                return false;
+            }
+        }
+    }
+
+    return is_line_end(c, end) || is_blank(*c);
+}
+
+// parses the elements of the chunk into the output arrays
+static void parse_chunk(const Chunk& chunk, const Output& output)
+{
+    // the elements that have been parsed so far in the file
+    Counts defined = chunk.offsets;
+    for(const char* line = chunk.begin; line != chunk.end;)
+    {
+        ++defined.lines;
+
+        const char* c = line;
+        switch(get_line_type(c, chunk.end))
+        {
+            case LINE_POSITION:
+            {
+                float* position =
+                    output.positions + defined.positions * POSITION_STRIDE;
+                if(!parse_float(c, chunk.end, position[0]) ||
+                   !parse_float(c, chunk.end, position[1]) ||
+                   !parse_float(c, chunk.end, position[2]))
+                {
+                    throw_line_error("Invalid position", defined.lines);
+                }
+                ++defined.positions;
+                break;
+            }
+            case LINE_UV:
+            {
+                // v is optional
+                float* uv = output.uvs + defined.uvs * UV_STRIDE;
+                if(!parse_float(c, chunk.end, uv[0]))
+                {
+                    throw_line_error(
+                        "Invalid texture coordinate",
+                        defined.lines
+                    );
+                }
+                const char* v = c;
+                if(!parse_float(c, chunk.end, uv[1]))
+                {
+                    c = v;
+                    uv[1] = 0.0F;
+                }
+                ++defined.uvs;
+                break;
+            }
+            case LINE_NORMAL:
+            {
+                float* normal =
+                    output.normals + defined.normals * NORMAL_STRIDE;
+                if(!parse_float(c, chunk.end, normal[0]) ||
+                   !parse_float(c, chunk.end, normal[1]) ||
+                   !parse_float(c, chunk.end, normal[2]))
+                {
+                    throw_line_error("Invalid normal", defined.lines);
+                }
+                ++defined.normals;
+                break;
+            }
+            case LINE_FACE:
+            {
+                // triangulate as a fan around the first corner
+                arc::int32 corners[3][3];
+                std::size_t corner_count = 0;
+                for(skip_blank(c, chunk.end);
+                    !is_line_end(c, chunk.end);
+                    skip_blank(c, chunk.end))
+                {
+                    arc::int32* corner = corners[std::min<std::size_t>(
+                        corner_count,
+                        2
+                    )];
+                    if(!parse_corner(c, chunk.end, output, defined, corner))
+                    {
+                        throw_line_error("Invalid face", defined.lines);
+                    }
+                    ++corner_count;
+                    if(corner_count < 3)
+                    {
+                        continue;
+                    }
+
+                    for(std::size_t i = 0; i < 3; ++i)
+                    {
+                        std::size_t vertex = defined.vertices++;
+                        output.point_indices[vertex] = corners[i][0];
+                        if(output.uv_indices != nullptr)
+                        {
+                            output.uv_indices[vertex] = corners[i][1];
+                        }
+                        if(output.normal_indices != nullptr)
+                        {
+                            output.normal_indices[vertex] = corners[i][2];
+                        }
+                    }
+                    // the last corner is the first of the next triangle
+                    std::memcpy(corners[1], corners[2], sizeof(corners[2]));
+                }
+                if(corner_count < 3)
+                {
+                    throw_line_error(
+                        "Face with less than 3 vertices",
+                        defined.lines
+                    );
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        line = next_line(c, chunk.end);
+    }
+}
+
+// copies the tuple of the table at each index to the output, or zeros if the
+// index is -1
+static void expand(
+        const float* table,
+        const arc::int32* indices,
+        std::size_t stride,
+        std::size_t begin,
+        std::size_t end,
+        float* out)
+{
+    for(std::size_t i = begin; i < end; ++i)
+    {
+        float* value = out + i * stride;
+        if(indices[i] < 0)
+        {
+            std::fill(value, value + stride, 0.0F);
+        }
+        else
+        {
+            std::memcpy(
+                value,
+                table + static_cast<std::size_t>(indices[i]) * stride,
+                stride * sizeof(float)
+            );
+        }
+    }
+}
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+omi::Attribute parse_obj(
+        const char* data,
+        std::size_t length,
+        std::size_t thread_count)
+{
+    // skip the BOM if there is one
+    if(length >= sizeof(UTF8_BOM) &&
+       std::memcmp(data, UTF8_BOM, sizeof(UTF8_BOM)) == 0)
+    {
+        data += sizeof(UTF8_BOM);
+        length -= sizeof(UTF8_BOM);
+    }
+    const char* data_end = data + length;
+
+    // split the data into chunks at line boundaries
+    std::vector<Chunk> chunks;
+    thread_count = std::max<std::size_t>(1, thread_count);
+    for(const char* begin = data; begin != data_end;)
+    {
+        const char* split = begin + std::min<std::size_t>(
+            data_end - begin,
+            (length + thread_count - 1) / thread_count
+        );
+        if(split != data_end)
+        {
+            split = next_line(split, data_end);
+        }
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = split;
+        chunks.push_back(chunk);
+        begin = split;
+    }
+
+    // count the elements of each chunk to find where they will be parsed to
+    parallel_for(
+        chunks.size(),
+        chunks.size(),
+        [&chunks](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                count_chunk(chunks[i]);
+            }
+        }
+    );
+    Counts totals;
+    for(Chunk& chunk : chunks)
+    {
+        chunk.offsets = totals;
+        totals += chunk.counts;
+    }
+    if(totals.vertices >
+       static_cast<std::size_t>(std::numeric_limits<arc::int32>::max()))
+    {
+        throw arc::ex::ParseError("Obj data has too many vertices to index");
+    }
+
+    // allocate the output
+    omi::FloatAttribute::ArrayType point_positions;
+    point_positions.resize(totals.positions * POSITION_STRIDE);
+    omi::Int32Attribute::ArrayType point_indices;
+    point_indices.resize(totals.vertices);
+    std::vector<float> uvs(totals.uvs * UV_STRIDE);
+    std::vector<float> normals(totals.normals * NORMAL_STRIDE);
+    std::vector<arc::int32> uv_indices(totals.uv_indices ? totals.vertices : 0);
+    std::vector<arc::int32> normal_indices(
+        totals.normal_indices ? totals.vertices : 0
+    );
+
+    Output output;
+    output.totals = totals;
+    output.positions = point_positions.mutable_data();
+    output.uvs = uvs.data();
+    output.normals = normals.data();
+    output.point_indices = point_indices.mutable_data();
+    output.uv_indices = totals.uv_indices ? uv_indices.data() : nullptr;
+    output.normal_indices =
+        totals.normal_indices ? normal_indices.data() : nullptr;
+
+    // parse
+    parallel_for(
+        chunks.size(),
+        chunks.size(),
+        [&chunks, &output](std::size_t begin, std::size_t end)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                parse_chunk(chunks[i], output);
+            }
+        }
+    );
+
+    // expand the per vertex uvs and normals, positions remain indexed so
+    // shared points are only stored once
+    omi::FloatAttribute::ArrayType vertex_uvs;
+    vertex_uvs.resize(output.uv_indices ? totals.vertices * UV_STRIDE : 0);
+    omi::FloatAttribute::ArrayType vertex_normals;
+    vertex_normals.resize(
+        output.normal_indices ? totals.vertices * NORMAL_STRIDE : 0
+    );
+    float* vertex_uvs_data = vertex_uvs.mutable_data();
+    float* vertex_normals_data = vertex_normals.mutable_data();
+    if(output.uv_indices != nullptr || output.normal_indices != nullptr)
+    {
+        parallel_for(
+            totals.vertices,
+            chunks.size(),
+            [&](std::size_t begin, std::size_t end)
+            {
+                if(output.uv_indices != nullptr)
+                {
+                    expand(
+                        output.uvs,
+                        output.uv_indices,
+                        UV_STRIDE,
+                        begin,
+                        end,
+                        vertex_uvs_data
+                    );
+                }
+                if(output.normal_indices != nullptr)
+                {
+                    expand(
+                        output.normals,
+                        output.normal_indices,
+                        NORMAL_STRIDE,
+                        begin,
+                        end,
+                        vertex_normals_data
+                    );
+                }
+            }
+        );
+    }
 
-            // TODO: support normals and uv etc
-            // get indices
-            std::size_t i0 =
-                static_cast<std::size_t>(values[1].to_uint64());
-            std::size_t i1 =
-                static_cast<std::size_t>(values[2].to_uint64());
-            std::size_t i2 =
-                static_cast<std::size_t>(values[3].to_uint64());
-
-            i0 = (i0 - 1) * POSITION_STRIDE;
-            i1 = (i1 - 1) * POSITION_STRIDE;
-            i2 = (i2 - 1) * POSITION_STRIDE;
-
-            // add to vertex positions
-            // point 0
-            vertex_positions.push_back(point_positions[i0 + 0]);
-            vertex_positions.push_back(point_positions[i0 + 1]);
-            vertex_positions.push_back(point_positions[i0 + 2]);
-            // point 1
-            vertex_positions.push_back(point_positions[i1 + 0]);
-            vertex_positions.push_back(point_positions[i1 + 1]);
-            vertex_positions.push_back(point_positions[i1 + 2]);
-            // point 2
-            vertex_positions.push_back(point_positions[i2 + 0]);
-            vertex_positions.push_back(point_positions[i2 + 1]);
-            vertex_positions.push_back(point_positions[i2 + 2]);
-        }
-    }
-
-    // TODO: builder
     // build the data to return
-    omi::MapAttribute::DataType vertex_map_data = {
+    omi::MapAttribute::DataType point_map_data = {
         {
             "positions",
-            omi::FloatAttribute(vertex_positions, POSITION_STRIDE, false)
+            omi::FloatAttribute(
+                std::move(point_positions),
+                POSITION_STRIDE,
+                false
+            )
         }
     };
-    omi::MapAttribute vertex_map(vertex_map_data, false);
+
+    omi::MapAttribute::DataType vertex_map_data = {
+        {
+            "point_indices",
+            omi::Int32Attribute(std::move(point_indices), 3, false)
+        }
+    };
+    if(output.uv_indices != nullptr)
+    {
+        vertex_map_data["uvs"] =
+            omi::FloatAttribute(std::move(vertex_uvs), UV_STRIDE, false);
+    }
+    if(output.normal_indices != nullptr)
+    {
+        vertex_map_data["normals"] = omi::FloatAttribute(
+            std::move(vertex_normals),
+            NORMAL_STRIDE,
+            false
+        );
+    }
 
     omi::MapAttribute::DataType geometry_map_data = {
+        {"point", omi::MapAttribute(point_map_data, false)},
         {"vertex", omi::MapAttribute(vertex_map_data, false)}
     };
 
@@ -121,10 +866,21 @@ static omi::Attribute load_obj(arc::io::sys::FileReader& reader)
     };
 
     return omi::MapAttribute(root_data, false);
-};
+}
+
+omi::Attribute load_obj(const MappedFile& file)
+{
+    std::size_t thread_count = std::max<std::size_t>(
+        1,
+        std::min<std::size_t>(
+            std::thread::hardware_concurrency(),
+            file.get_size() / MIN_CHUNK_SIZE
+        )
+    );
+    return parse_obj(file.get_data(), file.get_size(), thread_count);
+}
 
-} // namespace anonymous
 } // namespace res
 } // namespace omi
 
-OMICRON_API_RES_DEFINE_LOADER(omi::res::load_obj, "obj");
+OMICRON_API_RES_DEFINE_MAPPED_LOADER(omi::res::load_obj, "obj");
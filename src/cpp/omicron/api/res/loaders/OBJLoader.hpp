@@ -0,0 +1,69 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief Defines the interface for the Wavefront obj loader functions.
+ */
+#ifndef OMICRON_API_RES_LOADERS_OBJLOADER_HPP_
+#define OMICRON_API_RES_LOADERS_OBJLOADER_HPP_
+
+#include <cstddef>
+
+#include "omicron/api/API.hpp"
+#include "omicron/api/common/Attributes.hpp"
+#include "omicron/api/res/MappedFile.hpp"
+
+
+namespace omi
+{
+namespace res
+{
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+/*!
+ * \brief Parses the given Wavefront obj data into Omicron attributes.
+ *
+ * The returned MapAttribute holds a "geometry" map with the following entries:
+ *
+ * - point.positions: The position (x, y, z) of each point (v) in the file.
+ * - vertex.point_indices: The index of the point of each vertex, where every
+ *   three vertices form a triangle. Polygons are triangulated as fans.
+ * - vertex.normals: The normal of each vertex, only if the faces of the file
+ *   reference normals (vn).
+ * - vertex.uvs: The texture coordinates (u, v) of each vertex, only if the
+ *   faces of the file reference texture coordinates (vt).
+ *
+ * Positions are not expanded per vertex, so points which are shared by
+ * multiple triangles are only stored once.
+ *
+ * The data is parsed in place without any per-line allocations: a counting
+ * pass over the data sizes the output arrays, which are then filled by a second
+ * pass. If more than one thread is requested the data is split into chunks at
+ * line boundaries which are counted and parsed concurrently.
+ *
+ * \param data Pointer to the start of the obj data, this does not need to be
+ *             null terminated.
+ * \param length The length of the data in bytes.
+ * \param thread_count The maximum number of threads to parse with.
+ *
+ * \throw arc::ex::ParseError If the data is not valid obj data.
+ */
+OMI_API_EXPORT omi::Attribute parse_obj(
+        const char* data,
+        std::size_t length,
+        std::size_t thread_count = 1);
+
+/*!
+ * \brief Loads the mapped Wavefront obj file, see parse_obj().
+ *
+ * Large files are parsed using a thread per megabyte of data, up to the number
+ * of hardware threads of the machine.
+ */
+omi::Attribute load_obj(const MappedFile& file);
+
+} // namespace res
+} // namespace omi
+
+#endif
@@ -1,11 +1,31 @@
 #include "omicron/api/res/loaders/RawLoader.hpp"
 
+#include <cstring>
+
 
 namespace omi
 {
 namespace res
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// releases the file data borrowed by the raw ByteAttribute
+void release_raw_data(void* data)
+{
+    delete[] static_cast<char*>(data);
+}
+
+// the byte order mark of UTF-8 text files
+static const char kUTF8BOM[] = {'\xEF', '\xBB', '\xBF'};
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                   FUNCTIONS
 //------------------------------------------------------------------------------
@@ -31,15 +51,40 @@ omi::Attribute load_raw(arc::io::sys::FileReader& reader)
     char* data = new char[static_cast<std::size_t>(length)];
     reader.read(data, length);
 
-    // TODO: this induces an extra copy - can we avoid by giving attribute some
-    //       sort of claim functionality?
-    // build the data into attributes
+    // build the data into attributes - the attribute borrows the data rather
+    // than copying it and is responsible for deleting it
     omi::MapAttribute::DataType map_data = {
-        {"raw", omi::ByteAttribute(data, data + length)}
+        {
+            "raw",
+            omi::ByteAttribute(omi::ByteAttribute::ArrayType::borrow(
+                data,
+                static_cast<std::size_t>(length),
+                &release_raw_data,
+                data
+            ))
+        }
     };
 
-    // clean up
-    delete[] data;
+    return omi::MapAttribute(map_data);
+}
+
+omi::Attribute load_raw_mapped(const MappedFile& file)
+{
+    // skip the BOM if there is one
+    std::size_t offset = 0;
+    if(file.get_size() > sizeof(kUTF8BOM) &&
+       std::memcmp(file.get_data(), kUTF8BOM, sizeof(kUTF8BOM)) == 0)
+    {
+        offset = sizeof(kUTF8BOM);
+    }
+
+    // the attribute refers directly to the mapped data
+    omi::MapAttribute::DataType map_data = {
+        {
+            "raw",
+            omi::ByteAttribute(file.borrow(offset, file.get_size() - offset))
+        }
+    };
 
     return omi::MapAttribute(map_data);
 }
@@ -9,6 +9,7 @@
 #include <arcanecore/io/sys/FileReader.hpp>
 
 #include "omicron/api/common/Attributes.hpp"
+#include "omicron/api/res/MappedFile.hpp"
 
 
 namespace omi
@@ -26,6 +27,13 @@ namespace res
  */
 omi::Attribute load_raw(arc::io::sys::FileReader& reader);
 
+/*!
+ * \brief Loads the mapped file as a MapAttribute with a single ByteAttribute
+ *        entry named "raw" which refers to the entire mapped data of the file
+ *        without copying it.
+ */
+omi::Attribute load_raw_mapped(const MappedFile& file);
+
 } // namespace res
 } // namespace omi
 
@@ -1,6 +1,7 @@
 #include "omicron/api/scene/component/renderable/Mesh.hpp"
 
 #include "omicron/api/common/Attributes.hpp"
+#include "omicron/api/res/ReloadListener.hpp"
 #include "omicron/api/res/ResourceRegistry.hpp"
 #include "omicron/api/scene/SceneGlobals.hpp"
 
@@ -10,12 +11,27 @@ namespace omi
 namespace scene
 {
 
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the paths of the mesh data
+static const omi::SymbolPath g_geometry("geometry");
+static const omi::SymbolPath g_point_positions("point.positions");
+static const omi::SymbolPath g_vertex_point_indices("vertex.point_indices");
+
+} // namespace anonymous
+
 //------------------------------------------------------------------------------
 //                                 IMPLEMENTATION
 //------------------------------------------------------------------------------
 
 class Mesh::MeshImpl
-    : private arc::lang::Noncopyable
+    : public omi::res::ReloadListener
+    , private arc::lang::Noncopyable
     , private arc::lang::Nonmovable
     , private arc::lang::Noncomparable
 {
@@ -23,31 +39,52 @@ private:
 
     //-------------------P R I V A T E    A T T R I B U T E S-------------------
 
+    // The id of the mesh's resource.
+    omi::res::ResourceId m_resource_id;
+    // Keeps the mesh's resource loaded while the mesh exists.
+    omi::res::ResourceHandle m_resource;
+    // Incremented each time the mesh's data is replaced.
+    arc::uint64 m_data_version;
+
     // The parent map attribute of this mesh's data.
     omi::MapAttribute m_data;
 
-    // vertex positions
-    omi::FloatAttribute m_vertex_positions;
+    // point positions
+    omi::FloatAttribute m_point_positions;
+    // the index of the point of each vertex
+    omi::Int32Attribute m_vertex_point_indices;
 
 public:
 
     //--------------------------C O N S T R U C T O R---------------------------
 
     MeshImpl(omi::res::ResourceId resource)
+        : m_resource_id (resource)
+        , m_resource    (
+            omi::res::ResourceRegistry::instance()->acquire(resource)
+        )
+        , m_data_version(0)
     {
-        omi::Attribute data =
-            omi::res::ResourceRegistry::instance()->get(resource);
         // check
-        if(!validate(data))
+        if(!validate(m_resource.get()))
         {
             enter_error_state();
         }
+
+        omi::res::ResourceRegistry::instance()->add_reload_listener(
+            m_resource_id,
+            this
+        );
     }
 
     //---------------------------D E S T R U C T O R----------------------------
 
-    ~MeshImpl()
+    virtual ~MeshImpl()
     {
+        omi::res::ResourceRegistry::instance()->remove_reload_listener(
+            m_resource_id,
+            this
+        );
     }
 
     //-------------P U B L I C    M E M B E R    F U N C T I O N S--------------
@@ -57,9 +94,43 @@ public:
         return omi::scene::RenderableType::kMesh;
     }
 
-    const std::vector<float>& get_vertex_positions() const
+    const omi::FloatAttribute::ArrayType& get_point_positions() const
+    {
+        return m_point_positions.get_values();
+    }
+
+    const omi::Int32Attribute::ArrayType& get_vertex_point_indices() const
+    {
+        return m_vertex_point_indices.get_values();
+    }
+
+    arc::uint64 get_data_version() const
+    {
+        return m_data_version;
+    }
+
+    virtual void on_reload(
+            omi::res::ResourceId id,
+            const omi::Attribute& data) override
     {
-        return m_vertex_positions.get_values();
+        // keep the current data if the reloaded data is invalid
+        omi::MapAttribute data_before = m_data;
+        omi::FloatAttribute point_positions_before = m_point_positions;
+        omi::Int32Attribute vertex_point_indices_before =
+            m_vertex_point_indices;
+        if(!validate(data))
+        {
+            global::logger->warning
+                << "Ignoring reloaded mesh data." << std::endl;
+            m_data = data_before;
+            m_point_positions = point_positions_before;
+            m_vertex_point_indices = vertex_point_indices_before;
+            return;
+        }
+
+        // hold the new data rather than the data that was replaced
+        m_resource = omi::res::ResourceRegistry::instance()->acquire(id);
+        ++m_data_version;
     }
 
 private:
@@ -78,7 +149,7 @@ private:
             return false;
         }
 
-        m_data = root.get("geometry");
+        m_data = root.get(g_geometry);
         if(!m_data.is_valid())
         {
             global::logger->warning
@@ -87,15 +158,40 @@ private:
             return false;
         }
 
-        m_vertex_positions = m_data.get("vertex.positions");
-        if(!m_vertex_positions.is_valid())
+        m_point_positions = m_data.get(g_point_positions);
+        if(!m_point_positions.is_valid() ||
+           m_point_positions.get_size() % 3 != 0)
         {
             global::logger->warning
-                << "Invalid mesh data: no valid geometry.vertex.positions "
+                << "Invalid mesh data: no valid geometry.point.positions "
                 << "FloatAttribute." << std::endl;
             return false;
         }
 
+        m_vertex_point_indices = m_data.get(g_vertex_point_indices);
+        if(!m_vertex_point_indices.is_valid() ||
+           m_vertex_point_indices.get_size() % 3 != 0)
+        {
+            global::logger->warning
+                << "Invalid mesh data: no valid geometry.vertex.point_indices "
+                << "Int32Attribute." << std::endl;
+            return false;
+        }
+
+        // check the indices so renderers don't need to
+        const arc::int32 point_count =
+            static_cast<arc::int32>(m_point_positions.get_size() / 3);
+        for(arc::int32 index : m_vertex_point_indices.get_values())
+        {
+            if(index < 0 || index >= point_count)
+            {
+                global::logger->warning
+                    << "Invalid mesh data: point index " << index << " is out "
+                    << "of range." << std::endl;
+                return false;
+            }
+        }
+
         return true;
     }
 
@@ -103,8 +199,10 @@ private:
     void enter_error_state()
     {
         // clear current state
+        m_resource.release();
         m_data = omi::MapAttribute();
-        m_vertex_positions = omi::FloatAttribute();
+        m_point_positions = omi::FloatAttribute();
+        m_vertex_point_indices = omi::Int32Attribute();
 
         // TODO: render explanation mark;
     }
@@ -138,9 +236,21 @@ OMI_API_EXPORT RenderableType Mesh::get_renderable_type() const
     return m_impl->get_renderable_type();
 }
 
-OMI_API_EXPORT const std::vector<float>& Mesh::get_vertex_positions() const
+OMI_API_EXPORT
+const omi::FloatAttribute::ArrayType& Mesh::get_point_positions() const
+{
+    return m_impl->get_point_positions();
+}
+
+OMI_API_EXPORT
+const omi::Int32Attribute::ArrayType& Mesh::get_vertex_point_indices() const
+{
+    return m_impl->get_vertex_point_indices();
+}
+
+OMI_API_EXPORT arc::uint64 Mesh::get_data_version() const
 {
-    return m_impl->get_vertex_positions();
+    return m_impl->get_data_version();
 }
 
 } // namespace scene
@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "omicron/api/API.hpp"
+#include "omicron/api/common/attribute/FloatAttribute.hpp"
+#include "omicron/api/common/attribute/Int32Attribute.hpp"
 #include "omicron/api/res/ResourceId.hpp"
 #include "omicron/api/scene/component/renderable/AbstractRenderable.hpp"
 
@@ -21,8 +23,10 @@ namespace scene
  * \brief A component that represents a geometric mesh to be rendered by the
  *        renderer subsystem.
  *
- * A mesh consists of an array of vertex positions and 0 or more arrays of
- * vertex attributes.
+ * A mesh consists of an array of point positions, an array of vertices which
+ * index the points (where every three vertices form a triangle), and 0 or more
+ * arrays of vertex attributes. Points which are shared by multiple triangles
+ * are only stored once.
  */
 class Mesh
     : public omi::scene::AbstractRenderable
@@ -57,9 +61,26 @@ public:
     OMI_API_EXPORT virtual RenderableType get_renderable_type() const override;
 
     /*!
-     * \brief Returns the vertex positions of the mesh.
+     * \brief Returns the positions (x, y, z) of the points of the mesh.
      */
-    OMI_API_EXPORT const std::vector<float>& get_vertex_positions() const;
+    OMI_API_EXPORT const omi::FloatAttribute::ArrayType&
+    get_point_positions() const;
+
+    /*!
+     * \brief Returns the index of the point of each vertex of the mesh, where
+     *        every three vertices form a triangle.
+     */
+    OMI_API_EXPORT const omi::Int32Attribute::ArrayType&
+    get_vertex_point_indices() const;
+
+    /*!
+     * \brief Returns a number which changes whenever the data of the mesh is
+     *        replaced, i.e. when its resource is hot reloaded.
+     *
+     * Renderers can compare this with the version their copy of the data was
+     * built from to find out whether it needs to be rebuilt.
+     */
+    OMI_API_EXPORT arc::uint64 get_data_version() const;
 
     // TODO: deindex
 
@@ -0,0 +1,455 @@
+/*!
+ * \file
+ * \author David Saxon
+ * \brief The omicron_cook tool, which converts source resources into binary
+ *        cooked files that the ResourceRegistry loads in place of the source.
+ *
+ * Usage: omicron_cook [--compress] [--index <path>] [--archive <path>]
+ *                     <resource directory>...
+ *
+ * Each cooked file is written next to its source resource with a ".cooked"
+ * suffix (e.g. "bunny.obj.cooked") and holds the attributes the source loads
+ * to, encoded by omi::AttributeCodec. Since the encoding is aligned, loading a
+ * cooked file maps it directly into attributes, see omi::res::load_cooked().
+ * With --compress, cooked files that compress well are stored compressed.
+ *
+ * Cooked files are deduplicated by their content: if a cooked file would be
+ * identical to one that has already been written, a ".cooked_link" file
+ * holding the path of that cooked file is written instead.
+ *
+ * With --index, an index of every resource in the directories (including the
+ * cooked files) is written to the given path once cooking has finished, see
+ * omi::res::encode_index(). Likewise with --archive, every resource is written
+ * to an archive at the given path, see omi::res::ResourceArchive. Sources which
+ * have a cooked file (or link) are left out of the archive since the
+ * ResourceRegistry loads them from their cooked file instead, and with
+ * --compress resources that compress well are stored compressed.
+ *
+ * Files are written to a temporary file which is then renamed over the
+ * destination, so that a process which has the previous file memory-mapped
+ * (e.g. a hot reloading ResourceRegistry) keeps seeing the previous contents.
+ */
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/crypt/hash/Spooky.hpp>
+#include <arcanecore/io/sys/FileSystemOperations.hpp>
+
+#include "omicron/api/common/Attributes.hpp"
+#include "omicron/api/res/MappedFile.hpp"
+#include "omicron/api/res/ResourceArchive.hpp"
+#include "omicron/api/res/ResourceIndex.hpp"
+#include "omicron/api/res/loaders/CookedLoader.hpp"
+#include "omicron/api/res/loaders/OBJLoader.hpp"
+
+
+//------------------------------------------------------------------------------
+//                                    GLOBALS
+//------------------------------------------------------------------------------
+
+namespace
+{
+
+// the suffix appended to the name of a source resource to name its cooked file
+static const arc::str::UTF8String COOKED_SUFFIX(".cooked");
+// the suffix appended to the name of a source resource to name the file linking
+// it to an identical cooked file
+static const arc::str::UTF8String COOKED_LINK_SUFFIX(".cooked_link");
+// the suffix appended to the name of a file to name the temporary file it is
+// written to before being renamed
+static const arc::str::UTF8String TEMP_SUFFIX(".tmp");
+
+// converts a source resource to the attributes that will be cooked
+typedef omi::Attribute (CookFunc)(const omi::res::MappedFile&);
+
+// cooks Wavefront obj files using every hardware thread
+omi::Attribute cook_obj(const omi::res::MappedFile& file)
+{
+    return omi::res::parse_obj(
+        file.get_data(),
+        file.get_size(),
+        std::max(std::thread::hardware_concurrency(), 1U)
+    );
+}
+
+// mapping from the extensions of the source resources that can be cooked to
+// the function that cooks them
+static const std::unordered_map<arc::str::UTF8String, CookFunc*> COOKERS =
+{
+    {"obj", &cook_obj}
+};
+
+// whether cooked files should be compressed
+bool g_compress = false;
+// mapping from the content hash of the cooked files that have been written to
+// their paths
+std::map<std::pair<arc::uint64, arc::uint64>, arc::str::UTF8String> g_cooked;
+
+} // namespace anonymous
+
+//------------------------------------------------------------------------------
+//                                   FUNCTIONS
+//------------------------------------------------------------------------------
+
+// returns the path for the given command line argument, which may use either
+// unix or windows separators
+arc::io::sys::Path to_path(const char* argument)
+{
+    std::vector<arc::str::UTF8String> components;
+    std::string component;
+    for(const char* c = argument; *c != '\0'; ++c)
+    {
+        if(*c == '/' || *c == '\\')
+        {
+            if(!component.empty())
+            {
+                components.push_back(component.c_str());
+                component.clear();
+            }
+            continue;
+        }
+        component += *c;
+    }
+    if(!component.empty())
+    {
+        components.push_back(component.c_str());
+    }
+    return arc::io::sys::Path(components);
+}
+
+// writes the file at the given path by passing a stream to the given function,
+// the file is replaced in a single step once the function has returned
+template<typename T_WriteFunc>
+void write_file(const arc::io::sys::Path& path, const T_WriteFunc& write_func)
+{
+    arc::io::sys::Path temp_path;
+    for(std::size_t i = 0; i + 1 < path.get_length(); ++i)
+    {
+        temp_path << path[i];
+    }
+    arc::str::UTF8String temp_name(path.get_back());
+    temp_name << TEMP_SUFFIX;
+    temp_path << temp_name;
+
+    try
+    {
+        std::ofstream stream(
+            temp_path.to_native().get_raw(),
+            std::ios::out | std::ios::binary | std::ios::trunc
+        );
+        write_func(stream);
+        stream.close();
+        if(!stream.good())
+        {
+            arc::str::UTF8String error_message;
+            error_message
+                << "Failed to write file: \"" << temp_path.to_native()
+                << "\"";
+            throw arc::ex::IOError(error_message);
+        }
+    }
+    catch(...)
+    {
+        std::remove(temp_path.to_native().get_raw());
+        throw;
+    }
+
+    // renaming replaces the file without modifying the previous contents
+    if(std::rename(
+            temp_path.to_native().get_raw(),
+            path.to_native().get_raw()) != 0)
+    {
+        std::remove(temp_path.to_native().get_raw());
+        arc::str::UTF8String error_message;
+        error_message
+            << "Failed to replace file: \"" << path.to_native() << "\"";
+        throw arc::ex::IOError(error_message);
+    }
+}
+
+// writes the given data to the file at the given path
+void write_file(
+        const arc::io::sys::Path& path,
+        const char* data,
+        std::size_t size)
+{
+    write_file(path, [data, size](std::ostream& stream)
+    {
+        stream.write(data, static_cast<std::streamsize>(size));
+    });
+}
+
+// writes the cooked file for the given source resource which is in the given
+// directory
+void cook(
+        const arc::io::sys::Path& directory,
+        const arc::io::sys::Path& path,
+        CookFunc* cooker)
+{
+    std::vector<char> cooked;
+    omi::res::encode_cooked(
+        cooker(*omi::res::MappedFile::open(path)),
+        g_compress,
+        cooked
+    );
+
+    arc::io::sys::Path cooked_path(directory);
+    arc::str::UTF8String cooked_name(path.get_back());
+    cooked_name << COOKED_SUFFIX;
+    cooked_path << cooked_name;
+    arc::io::sys::Path link_path(directory);
+    arc::str::UTF8String link_name(path.get_back());
+    link_name << COOKED_LINK_SUFFIX;
+    link_path << link_name;
+
+    std::pair<arc::uint64, arc::uint64> hash;
+    arc::crypt::hash::spooky_128(
+        cooked.data(),
+        cooked.size(),
+        hash.first,
+        hash.second,
+        cooked.size(),
+        cooked.size()
+    );
+    auto f_cooked = g_cooked.find(hash);
+
+    // only one of the cooked file or link may exist for a resource
+    if(f_cooked == g_cooked.end())
+    {
+        std::remove(link_path.to_native().get_raw());
+        write_file(cooked_path, cooked.data(), cooked.size());
+        g_cooked.insert(std::make_pair(hash, cooked_path.to_unix()));
+
+        std::cout
+            << "Cooked \"" << path.to_unix() << "\" (" << cooked.size()
+            << " bytes)" << std::endl;
+    }
+    else
+    {
+        std::remove(cooked_path.to_native().get_raw());
+        const arc::str::UTF8String& target = f_cooked->second;
+        write_file(link_path, target.get_raw(), target.get_byte_length() - 1);
+
+        std::cout
+            << "Linked \"" << path.to_unix() << "\" to identical \""
+            << target << "\"" << std::endl;
+    }
+}
+
+// cooks the resources in the given directory and all of its subdirectories,
+// returns whether every resource was cooked successfully
+bool cook_directory(const arc::io::sys::Path& directory)
+{
+    bool success = true;
+    for(const arc::io::sys::Path& path : arc::io::sys::list(directory))
+    {
+        if(arc::io::sys::is_directory(path))
+        {
+            success = cook_directory(path) && success;
+            continue;
+        }
+
+        auto f_cooker = COOKERS.find(path.get_extension());
+        if(f_cooker == COOKERS.end() || !arc::io::sys::is_file(path))
+        {
+            continue;
+        }
+
+        try
+        {
+            cook(directory, path, f_cooker->second);
+        }
+        catch(const std::exception& exc)
+        {
+            std::cerr
+                << "Failed to cook \"" << path.to_unix() << "\": "
+                << exc.what() << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
+
+// adds the paths of the files in the given directory and all of its
+// subdirectories to the given list
+void list_resources(
+        const arc::io::sys::Path& directory,
+        std::vector<arc::io::sys::Path>& resources)
+{
+    for(const arc::io::sys::Path& path : arc::io::sys::list(directory))
+    {
+        if(arc::io::sys::is_directory(path))
+        {
+            list_resources(path, resources);
+        }
+        else if(arc::io::sys::is_file(path))
+        {
+            resources.push_back(path);
+        }
+    }
+}
+
+// writes the index of the given resources to the given path, returns whether
+// the index was written successfully
+bool write_index(
+        const arc::io::sys::Path& index_path,
+        const std::vector<arc::io::sys::Path>& resources)
+{
+    try
+    {
+        std::vector<char> index;
+        omi::res::encode_index(resources, index);
+        write_file(index_path, index.data(), index.size());
+    }
+    catch(const std::exception& exc)
+    {
+        std::cerr
+            << "Failed to write index \"" << index_path.to_unix() << "\": "
+            << exc.what() << std::endl;
+        return false;
+    }
+
+    std::cout
+        << "Indexed " << resources.size() << " resources to \""
+        << index_path.to_unix() << "\"" << std::endl;
+    return true;
+}
+
+// returns the given resources excluding the sources which have a cooked file or
+// cooked link file, since these are always redirected to their cooked file
+std::vector<arc::io::sys::Path> exclude_cooked_sources(
+        const std::vector<arc::io::sys::Path>& resources)
+{
+    std::unordered_set<arc::str::UTF8String> paths;
+    for(const arc::io::sys::Path& path : resources)
+    {
+        paths.insert(path.to_unix());
+    }
+
+    std::vector<arc::io::sys::Path> included;
+    for(const arc::io::sys::Path& path : resources)
+    {
+        arc::str::UTF8String cooked_path(path.to_unix());
+        cooked_path << COOKED_SUFFIX;
+        arc::str::UTF8String link_path(path.to_unix());
+        link_path << COOKED_LINK_SUFFIX;
+        if(paths.find(cooked_path) == paths.end() &&
+           paths.find(link_path) == paths.end())
+        {
+            included.push_back(path);
+        }
+    }
+    return included;
+}
+
+// writes an archive of the given resources to the given path, returns whether
+// the archive was written successfully
+bool write_archive(
+        const arc::io::sys::Path& archive_path,
+        const std::vector<arc::io::sys::Path>& resources)
+{
+    std::vector<arc::io::sys::Path> archived =
+        exclude_cooked_sources(resources);
+    try
+    {
+        write_file(archive_path, [&archived](std::ostream& stream)
+        {
+            omi::res::ResourceArchive::write(archived, stream, g_compress);
+        });
+    }
+    catch(const std::exception& exc)
+    {
+        std::cerr
+            << "Failed to write archive \"" << archive_path.to_unix()
+            << "\": " << exc.what() << std::endl;
+        return false;
+    }
+
+    std::cout
+        << "Archived " << archived.size() << " resources to \""
+        << archive_path.to_unix() << "\" ("
+        << (resources.size() - archived.size()) << " cooked sources left out)"
+        << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    int first_directory = 1;
+    arc::io::sys::Path index_path;
+    arc::io::sys::Path archive_path;
+    for(; first_directory < argc; ++first_directory)
+    {
+        std::string option(argv[first_directory]);
+        if(option == "--compress")
+        {
+            g_compress = true;
+        }
+        else if(option == "--index" && first_directory + 1 < argc)
+        {
+            index_path = to_path(argv[++first_directory]);
+        }
+        else if(option == "--archive" && first_directory + 1 < argc)
+        {
+            archive_path = to_path(argv[++first_directory]);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if(first_directory >= argc)
+    {
+        std::cerr
+            << "Usage: omicron_cook [--compress] [--index <path>] "
+            << "[--archive <path>] <resource directory>..." << std::endl;
+        return 1;
+    }
+
+    bool success = true;
+    std::vector<arc::io::sys::Path> directories;
+    for(int i = first_directory; i < argc; ++i)
+    {
+        arc::io::sys::Path directory(to_path(argv[i]));
+        if(!arc::io::sys::is_directory(directory))
+        {
+            std::cerr
+                << "Not a directory: \"" << directory.to_unix() << "\""
+                << std::endl;
+            success = false;
+            continue;
+        }
+        success = cook_directory(directory) && success;
+        directories.push_back(directory);
+    }
+
+    // the index and archive are written last so that they include the cooked
+    // files
+    if(success && (!index_path.is_empty() || !archive_path.is_empty()))
+    {
+        std::vector<arc::io::sys::Path> resources;
+        for(const arc::io::sys::Path& directory : directories)
+        {
+            list_resources(directory, resources);
+        }
+        if(!index_path.is_empty())
+        {
+            success = write_index(index_path, resources);
+        }
+        if(success && !archive_path.is_empty())
+        {
+            success = write_archive(archive_path, resources);
+        }
+    }
+    return success ? 0 : 1;
+}
@@ -2,7 +2,10 @@
 
 #include <omicron/api/context/ContextSubsystem.hpp>
 #include "omicron/api/context/EventListener.hpp"
+#include <omicron/api/context/EventService.hpp>
+#include <omicron/api/context/InputState.hpp>
 #include <omicron/api/render/RenderSubsystem.hpp>
+#include <omicron/api/res/ResourceRegistry.hpp>
 #include <omicron/api/scene/SceneState.hpp>
 
 #include "omicron/runtime/RuntimeGlobals.hpp"
@@ -58,7 +61,7 @@ public:
         }
 
         // subscribe to events
-        subscribe_to_event(omi::context::Event::kTypeEngineShutdown);
+        subscribe_to_event(omi::context::Event::kTypeIdEngineShutdown);
 
         // start the main loop
         global::logger->info << "Starting main loop" << std::endl;
@@ -95,6 +98,11 @@ private:
             return false;
         }
 
+        // dispatch the events that have been posted since the last frame, and
+        // take the matching snapshot of the input state
+        omi::context::EventService::instance().dispatch_queued();
+        omi::context::InputState::instance().update();
+
         // exiting?
         if(m_should_exit)
         {
@@ -103,6 +111,10 @@ private:
 
         // TODO: don't update more than 60fps (config based)
 
+        // swap in resources that have been loaded or reloaded since the last
+        // frame
+        omi::res::ResourceRegistry::instance()->frame_routine();
+
         // update the scene state
         omi::scene::SceneState::instance().update();
 
@@ -116,7 +128,7 @@ private:
 
     virtual void on_event(const omi::context::Event& event) override
     {
-        if(event.get_type() == omi::context::Event::kTypeEngineShutdown)
+        if(event.get_type_id() == omi::context::Event::kTypeIdEngineShutdown)
         {
             m_should_exit = true;
         }
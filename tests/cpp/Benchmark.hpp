@@ -0,0 +1,80 @@
+/*!
+ * \file
+ * \brief Timing helpers shared by the benchmarks.
+ * \author David Saxon
+ */
+#ifndef OMICRON_TESTS_BENCHMARK_HPP_
+#define OMICRON_TESTS_BENCHMARK_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+
+namespace omi_bench
+{
+
+/*!
+ * \brief Measures the time elapsed since it was constructed or last restarted.
+ */
+class Timer
+{
+public:
+
+    //--------------------------------------------------------------------------
+    //                                CONSTRUCTOR
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Creates a new timer which starts immediately.
+     */
+    Timer()
+        : m_start(std::chrono::high_resolution_clock::now())
+    {
+    }
+
+    //--------------------------------------------------------------------------
+    //                          PUBLIC MEMBER FUNCTIONS
+    //--------------------------------------------------------------------------
+
+    /*!
+     * \brief Starts timing again from now.
+     */
+    void restart()
+    {
+        m_start = std::chrono::high_resolution_clock::now();
+    }
+
+    /*!
+     * \brief Returns the elapsed time in milliseconds.
+     */
+    double get_milliseconds() const
+    {
+        return get_nanoseconds() / 1000000.0;
+    }
+
+    /*!
+     * \brief Returns the elapsed time in nanoseconds divided by the given
+     *        number of operations.
+     */
+    double get_nanoseconds(std::size_t operations = 1) const
+    {
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::high_resolution_clock::now() - m_start
+            ).count()
+        ) / static_cast<double>(operations);
+    }
+
+private:
+
+    //--------------------------------------------------------------------------
+    //                             PRIVATE ATTRIBUTES
+    //--------------------------------------------------------------------------
+
+    // the time point timing started from
+    std::chrono::high_resolution_clock::time_point m_start;
+};
+
+} // namespace omi_bench
+
+#endif
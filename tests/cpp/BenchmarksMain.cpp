@@ -0,0 +1,11 @@
+#include <arcanecore/test/ArcTest.hpp>
+
+//------------------------------------------------------------------------------
+//                                 MAIN FUNCTION
+//------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    // run benchmarks
+    return arc::test::deferred_main(argc, argv);
+}
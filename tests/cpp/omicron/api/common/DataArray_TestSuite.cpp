@@ -0,0 +1,389 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.DataArray)
+
+#include <stdexcept>
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/DataArray.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// release function which counts the number of times it has been called
+void count_release(void* user_data)
+{
+    ++(*static_cast<std::size_t*>(user_data));
+}
+
+//------------------------------------------------------------------------------
+//                                  CONSTRUCTORS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(constructors)
+{
+    ARC_TEST_MESSAGE("Checking default constructor");
+    {
+        omi::DataArray<arc::int32> a;
+        ARC_CHECK_TRUE(a.empty());
+        ARC_CHECK_EQUAL(a.size(), 0);
+        ARC_CHECK_TRUE(a.is_inline());
+        ARC_CHECK_EQUAL(
+            a.capacity(),
+            omi::DataArray<arc::int32>::kInlineCapacity
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking initializer list constructor");
+    {
+        omi::DataArray<arc::int32> a = {4, 8, -1};
+        std::vector<arc::int32> values = {4, 8, -1};
+        ARC_CHECK_EQUAL(a.size(), 3);
+        ARC_CHECK_TRUE(a.is_inline());
+        ARC_CHECK_ITER_EQUAL(a, values);
+    }
+
+    ARC_TEST_MESSAGE("Checking vector constructor");
+    {
+        std::vector<arc::int32> values(100, 7);
+        omi::DataArray<arc::int32> a(values);
+        ARC_CHECK_EQUAL(a.size(), 100);
+        ARC_CHECK_FALSE(a.is_inline());
+        ARC_CHECK_ITER_EQUAL(a, values);
+    }
+
+    ARC_TEST_MESSAGE("Checking copy constructor");
+    {
+        omi::DataArray<arc::str::UTF8String> a = {"Hello", "World"};
+        omi::DataArray<arc::str::UTF8String> b(a);
+        ARC_CHECK_TRUE(a == b);
+        b.set(0, "Goodbye");
+        ARC_CHECK_EQUAL(a[0], "Hello");
+        ARC_CHECK_TRUE(a != b);
+    }
+
+    ARC_TEST_MESSAGE("Checking move constructor");
+    {
+        std::vector<arc::int32> values(100, 3);
+        omi::DataArray<arc::int32> a(values.begin(), values.end());
+        const arc::int32* data = a.data();
+        omi::DataArray<arc::int32> b(std::move(a));
+        ARC_CHECK_TRUE(a.empty());
+        ARC_CHECK_TRUE(a.is_inline());
+        ARC_CHECK_EQUAL(b.data(), data);
+        ARC_CHECK_ITER_EQUAL(b, values);
+
+        omi::DataArray<arc::str::UTF8String> c = {"inline"};
+        omi::DataArray<arc::str::UTF8String> d(std::move(c));
+        ARC_CHECK_TRUE(c.empty());
+        ARC_CHECK_EQUAL(d.size(), 1);
+        ARC_CHECK_EQUAL(d[0], "inline");
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                     GROWTH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(growth)
+{
+    ARC_TEST_MESSAGE("Checking push_back");
+    {
+        omi::DataArray<arc::str::UTF8String> a;
+        std::vector<arc::str::UTF8String> values;
+        for(std::size_t i = 0; i < 50; ++i)
+        {
+            arc::str::UTF8String s;
+            s << "value_" << i;
+            a.push_back(s);
+            values.push_back(s);
+            ARC_CHECK_ITER_EQUAL(a, values);
+        }
+        ARC_CHECK_FALSE(a.is_inline());
+
+        // push back an element of the array itself across a reallocation
+        while(a.size() < a.capacity())
+        {
+            a.push_back(a.front());
+        }
+        a.push_back(a.front());
+        ARC_CHECK_EQUAL(a.back(), "value_0");
+    }
+
+    ARC_TEST_MESSAGE("Checking resize");
+    {
+        omi::DataArray<double> a;
+        a.resize(2);
+        ARC_CHECK_TRUE(a.is_inline());
+        ARC_CHECK_EQUAL(a[1], 0.0);
+        a.resize(64);
+        ARC_CHECK_FALSE(a.is_inline());
+        ARC_CHECK_EQUAL(a.size(), 64);
+        a.resize(1);
+        ARC_CHECK_EQUAL(a.size(), 1);
+        a.pop_back();
+        ARC_CHECK_TRUE(a.empty());
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   COMPARISON
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(comparison)
+{
+    omi::DataArray<arc::int32> a = {1, 2, 3};
+    omi::DataArray<arc::int32> b = {1, 2, 4};
+    omi::DataArray<arc::int32> c = {1, 2};
+    ARC_CHECK_TRUE(a < b);
+    ARC_CHECK_FALSE(b < a);
+    ARC_CHECK_TRUE(c < a);
+    ARC_CHECK_FALSE(a == c);
+    c.push_back(3);
+    ARC_CHECK_TRUE(a == c);
+}
+
+//------------------------------------------------------------------------------
+//                             VECTOR COMPATIBILITY
+//------------------------------------------------------------------------------
+
+// takes a vector so that the implicit conversion can be checked
+std::size_t vector_size(const std::vector<arc::int32>& values)
+{
+    return values.size();
+}
+
+ARC_TEST_UNIT(vector_compatibility)
+{
+    ARC_TEST_MESSAGE("Checking conversion to and from std::vector");
+    {
+        std::vector<arc::int32> values = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        omi::Int32Attribute a(values, 1, false);
+        std::vector<arc::int32> copy = a.get_values();
+        ARC_CHECK_ITER_EQUAL(copy, values);
+        ARC_CHECK_TRUE(a.get_values() == values);
+        ARC_CHECK_TRUE(values == a.get_values());
+        ARC_CHECK_EQUAL(vector_size(a.get_values()), 10);
+        values.push_back(11);
+        ARC_CHECK_TRUE(a.get_values() != values);
+    }
+
+    ARC_TEST_MESSAGE("Checking std::vector members");
+    {
+        omi::DataArray<arc::int32> a = {1, 2, 3};
+        ARC_CHECK_EQUAL(a.at(2), 3);
+        ARC_CHECK_THROW(a.at(3), std::out_of_range);
+
+        a.insert(a.begin() + 1, 7);
+        std::vector<arc::int32> expected = {1, 7, 2, 3};
+        ARC_CHECK_TRUE(a == expected);
+
+        // grows beyond the inline capacity
+        std::vector<arc::int32> more(20, 5);
+        a.insert(a.end(), more.begin(), more.end());
+        ARC_CHECK_EQUAL(a.size(), 24);
+        ARC_CHECK_FALSE(a.is_inline());
+
+        a.erase(a.begin() + 4, a.end());
+        ARC_CHECK_TRUE(a == expected);
+        a.erase(a.begin());
+        expected.erase(expected.begin());
+        ARC_CHECK_TRUE(a == expected);
+
+        a.resize(5, 9);
+        expected.resize(5, 9);
+        ARC_CHECK_TRUE(a == expected);
+
+        omi::DataArray<arc::int32> b = {4};
+        a.swap(b);
+        ARC_CHECK_EQUAL(a.size(), 1);
+        ARC_CHECK_TRUE(b == expected);
+    }
+
+    ARC_TEST_MESSAGE("Checking bool arrays");
+    {
+        std::vector<bool> values = {true, false, true};
+        omi::DataArray<bool> a = values;
+        ARC_CHECK_TRUE(a == values);
+        std::vector<bool> copy = a;
+        ARC_CHECK_TRUE(copy == values);
+        // the elements are stored as real bools
+        bool* data = a.mutable_data();
+        data[1] = true;
+        ARC_CHECK_TRUE(a[1]);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                 ATTRIBUTE DATA
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(attribute_data)
+{
+    ARC_TEST_MESSAGE("Checking scalar attribute is stored inline");
+    {
+        omi::Int32Attribute a(12, false);
+        ARC_CHECK_TRUE(a.get_values().is_inline());
+        a.set_at(0, 13);
+        ARC_CHECK_EQUAL(a.get_value(), 13);
+    }
+
+    ARC_TEST_MESSAGE("Checking set_at on shared storage");
+    {
+        omi::Int32Attribute a(12, false);
+        omi::Int32Attribute b = a.as_immutable();
+        a.set_at(0, 14);
+        ARC_CHECK_EQUAL(a.get_value(), 14);
+        ARC_CHECK_EQUAL(b.get_value(), 12);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    BORROWED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(borrowed)
+{
+    ARC_TEST_MESSAGE("Checking borrowed arrays do not copy");
+    {
+        std::vector<arc::int32> values(100, 5);
+        std::size_t releases = 0;
+        {
+            omi::DataArray<arc::int32> a = omi::DataArray<arc::int32>::borrow(
+                values.data(),
+                values.size(),
+                &count_release,
+                &releases
+            );
+            const omi::DataArray<arc::int32>& c_a = a;
+            ARC_CHECK_TRUE(a.is_borrowed());
+            ARC_CHECK_FALSE(a.is_inline());
+            ARC_CHECK_EQUAL(c_a.data(), values.data());
+            ARC_CHECK_ITER_EQUAL(c_a, values);
+
+            // moving transfers the borrow
+            omi::DataArray<arc::int32> b(std::move(a));
+            ARC_CHECK_TRUE(b.is_borrowed());
+            ARC_CHECK_FALSE(a.is_borrowed());
+            ARC_CHECK_EQUAL(releases, 0);
+        }
+        ARC_CHECK_EQUAL(releases, 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking reading borrowed arrays does not copy");
+    {
+        std::vector<arc::int32> values = {1, 2, 3};
+        std::size_t releases = 0;
+        omi::DataArray<arc::int32> a = omi::DataArray<arc::int32>::borrow(
+            values.data(),
+            values.size(),
+            &count_release,
+            &releases
+        );
+        // element access through a non-const array is read-only
+        arc::int32 sum = 0;
+        for(arc::int32 v : a)
+        {
+            sum += v;
+        }
+        ARC_CHECK_EQUAL(sum, 6);
+        ARC_CHECK_EQUAL(a[1], 2);
+        ARC_CHECK_EQUAL(a.at(2), 3);
+        ARC_CHECK_EQUAL(a.front(), 1);
+        ARC_CHECK_EQUAL(a.back(), 3);
+        ARC_CHECK_EQUAL(a.data(), values.data());
+        ARC_CHECK_EQUAL(a.begin(), values.data());
+        ARC_CHECK_TRUE(a.is_borrowed());
+        ARC_CHECK_EQUAL(releases, 0);
+
+        arc::int32* data = a.mutable_data();
+        ARC_CHECK_FALSE(a.is_borrowed());
+        ARC_CHECK_NOT_EQUAL(data, values.data());
+        ARC_CHECK_EQUAL(releases, 1);
+        data[0] = 5;
+        ARC_CHECK_EQUAL(a[0], 5);
+        ARC_CHECK_EQUAL(values[0], 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking modification detaches from borrowed memory");
+    {
+        std::vector<arc::int32> values = {1, 2, 3};
+        std::size_t releases = 0;
+        omi::DataArray<arc::int32> a = omi::DataArray<arc::int32>::borrow(
+            values.data(),
+            values.size(),
+            &count_release,
+            &releases
+        );
+        omi::DataArray<arc::int32> b(a);
+        ARC_CHECK_FALSE(b.is_borrowed());
+
+        a.set(1, 7);
+        ARC_CHECK_FALSE(a.is_borrowed());
+        ARC_CHECK_EQUAL(releases, 1);
+        ARC_CHECK_EQUAL(values[1], 2);
+        ARC_CHECK_EQUAL(a[1], 7);
+        ARC_CHECK_EQUAL(a.size(), 3);
+
+        a.push_back(4);
+        ARC_CHECK_EQUAL(a.size(), 4);
+        ARC_CHECK_EQUAL(releases, 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking replacing borrowed memory");
+    {
+        std::vector<arc::int32> values = {1, 2, 3};
+        std::size_t releases = 0;
+        omi::DataArray<arc::int32> a = omi::DataArray<arc::int32>::borrow(
+            values.data(),
+            values.size(),
+            &count_release,
+            &releases
+        );
+        a = {4, 5};
+        ARC_CHECK_EQUAL(releases, 1);
+        ARC_CHECK_EQUAL(a.size(), 2);
+        ARC_CHECK_EQUAL(values[0], 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking attribute with borrowed data");
+    {
+        std::vector<arc::int32> values = {1, 2, 3, 4};
+        std::size_t releases = 0;
+        {
+            omi::Int32Attribute a(
+                omi::Int32Attribute::ArrayType::borrow(
+                    values.data(),
+                    values.size(),
+                    &count_release,
+                    &releases
+                ),
+                2,
+                false
+            );
+            omi::Int32Attribute b = a.as_immutable();
+            ARC_CHECK_TRUE(a.get_values().is_borrowed());
+            ARC_CHECK_EQUAL(a.at(2), 3);
+            ARC_CHECK_EQUAL(a.get_values().data(), values.data());
+
+            // copy-on-write leaves the borrowed data with the other attribute
+            a.set_at(0, 9);
+            ARC_CHECK_EQUAL(a.at(0), 9);
+            ARC_CHECK_EQUAL(b.at(0), 1);
+            ARC_CHECK_TRUE(b.get_values().is_borrowed());
+            ARC_CHECK_EQUAL(values[0], 1);
+            ARC_CHECK_EQUAL(releases, 0);
+        }
+        ARC_CHECK_EQUAL(releases, 1);
+    }
+}
+
+} // namespace anonymous
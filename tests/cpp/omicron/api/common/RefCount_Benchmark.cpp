@@ -0,0 +1,73 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.RefCount)
+
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/RefCount.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of increment/decrement pairs performed by the benchmarks
+static const std::size_t kIterations = 10000000;
+
+// times the given reference counter type and returns the duration in
+// nanoseconds per increment/decrement pair
+template<typename T_RefCountType>
+double benchmark_counter()
+{
+    // spread the references over a number of counters as if they belonged to
+    // different objects
+    static const std::size_t kCounterCount = 1024;
+    std::vector<T_RefCountType> counts(kCounterCount);
+    std::size_t released = 0;
+
+    omi_bench::Timer timer;
+    for(std::size_t i = 0; i < kIterations; ++i)
+    {
+        counts[i % kCounterCount].increment();
+    }
+    for(std::size_t i = 0; i < kIterations; ++i)
+    {
+        if(counts[i % kCounterCount].decrement())
+        {
+            ++released;
+        }
+    }
+    double time = timer.get_nanoseconds(kIterations);
+
+    // use the results so the loops aren't optimised away
+    ARC_CHECK_EQUAL(released, 0);
+    for(const T_RefCountType& count : counts)
+    {
+        ARC_CHECK_EQUAL(count.get(), 1);
+    }
+    return time;
+}
+
+//------------------------------------------------------------------------------
+//                                   COUNTERS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(counters)
+{
+    double plain_time = benchmark_counter<omi::PlainRefCount>();
+    double atomic_time = benchmark_counter<omi::AtomicRefCount>();
+
+    arc::str::UTF8String message;
+    message << "PlainRefCount: " << plain_time << "ns per reference, "
+            << "AtomicRefCount: " << atomic_time << "ns per reference";
+    ARC_TEST_MESSAGE(message);
+}
+
+} // namespace anonymous
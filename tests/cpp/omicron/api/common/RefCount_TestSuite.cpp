@@ -0,0 +1,131 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.RefCount)
+
+#include <thread>
+#include <vector>
+
+#include <omicron/api/common/RefCount.hpp>
+#include <omicron/api/common/attribute/FloatAttribute.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+#include <omicron/api/common/attribute/MapAttribute.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// checks the basic semantics of the given reference counter type
+template<typename T_RefCountType>
+void check_counter()
+{
+    T_RefCountType count;
+    ARC_CHECK_EQUAL(count.get(), 1);
+    count.increment();
+    count.increment();
+    ARC_CHECK_EQUAL(count.get(), 3);
+    ARC_CHECK_FALSE(count.decrement());
+    ARC_CHECK_FALSE(count.decrement());
+    ARC_CHECK_EQUAL(count.get(), 1);
+    ARC_CHECK_TRUE(count.decrement());
+
+    T_RefCountType count2(4);
+    ARC_CHECK_EQUAL(count2.get(), 4);
+}
+
+//------------------------------------------------------------------------------
+//                                 PLAIN COUNTER
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(plain_counter)
+{
+    check_counter<omi::PlainRefCount>();
+}
+
+//------------------------------------------------------------------------------
+//                                 ATOMIC COUNTER
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(atomic_counter)
+{
+    check_counter<omi::AtomicRefCount>();
+
+    ARC_TEST_MESSAGE("Checking concurrent access");
+    {
+        static const std::size_t kThreadCount = 4;
+        static const std::size_t kIterations = 100000;
+
+        omi::AtomicRefCount count;
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < kThreadCount; ++i)
+        {
+            threads.emplace_back([&count]()
+            {
+                for(std::size_t j = 0; j < kIterations; ++j)
+                {
+                    count.increment();
+                }
+                for(std::size_t j = 0; j < kIterations; ++j)
+                {
+                    count.decrement();
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        ARC_CHECK_EQUAL(count.get(), 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                               SHARED ATTRIBUTES
+//------------------------------------------------------------------------------
+
+#ifdef OMI_API_ATOMIC_REF_COUNT
+
+ARC_TEST_UNIT(shared_attributes)
+{
+    static const std::size_t kThreadCount = 4;
+    static const std::size_t kIterations = 10000;
+
+    omi::MapAttribute::DataType data =
+    {
+        {"positions", omi::FloatAttribute({1.0F, 2.0F, 3.0F}, 3)},
+        {"count", omi::Int32Attribute(12)}
+    };
+    omi::MapAttribute source(data);
+
+    // each thread repeatedly references and modifies mutable copies of the
+    // shared immutable map
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i < kThreadCount; ++i)
+    {
+        threads.emplace_back([&source, i]()
+        {
+            for(std::size_t j = 0; j < kIterations; ++j)
+            {
+                omi::MapAttribute copy = source.as_mutable();
+                copy.insert("thread", omi::Int32Attribute(
+                    static_cast<arc::int32>(i)
+                ));
+                omi::MapAttribute reference(source);
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ARC_CHECK_EQUAL(source.get_size(), 2);
+    ARC_CHECK_FALSE(source.has("thread"));
+}
+
+#endif
+
+} // namespace anonymous
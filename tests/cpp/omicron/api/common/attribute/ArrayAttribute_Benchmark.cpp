@@ -0,0 +1,72 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.ArrayAttribute)
+
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/attribute/ArrayAttribute.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                      COPY
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(copy)
+{
+    static const std::size_t kSizes[] = {100, 1000, 10000, 100000};
+    static const std::size_t kIterations = 1000;
+
+    for(std::size_t size : kSizes)
+    {
+        omi::ArrayAttribute::Builder builder;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            builder.push_back(omi::Int32Attribute(static_cast<arc::int32>(i)));
+        }
+        omi::ArrayAttribute array = builder.build();
+        omi::Int32Attribute value(-1);
+
+        // keep the copies alive so their destruction isn't timed
+        std::vector<omi::ArrayAttribute> copies;
+        copies.reserve(kIterations * 3);
+
+        omi_bench::Timer timer;
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            copies.push_back(array.copy_with((i * 7919) % size, value));
+        }
+        double with_time = timer.get_nanoseconds(kIterations);
+
+        timer.restart();
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            copies.push_back(array.copy_with_appended(value));
+        }
+        double appended_time = timer.get_nanoseconds(kIterations);
+
+        timer.restart();
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            copies.push_back(array.copy_without((i * 7919) % size));
+        }
+        double without_time = timer.get_nanoseconds(kIterations);
+
+        ARC_CHECK_EQUAL(copies.back().get_size(), size - 1);
+
+        arc::str::UTF8String message;
+        message << "Arrays of " << size << " elements - copy_with: "
+                << with_time << "ns, copy_with_appended: " << appended_time
+                << "ns, copy_without: " << without_time << "ns";
+        ARC_TEST_MESSAGE(message);
+    }
+}
+
+} // namespace anonymous
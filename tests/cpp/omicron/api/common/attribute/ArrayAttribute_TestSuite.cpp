@@ -1607,4 +1607,106 @@ ARC_TEST_UNIT(as_mutable)
     }
 }
 
+//------------------------------------------------------------------------------
+//                                    BUILDER
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(builder)
+{
+    std::vector<omi::Attribute> test_data = {
+        omi::ByteAttribute({'x', 'y'}, 1),
+        omi::Int16Attribute(55),
+        omi::StringAttribute("Hello world!")
+    };
+
+    ARC_TEST_MESSAGE("Checking empty builder");
+    omi::ArrayAttribute::Builder builder;
+    ARC_CHECK_EQUAL(builder.get_size(), 0);
+    omi::ArrayAttribute a = builder.build();
+    ARC_CHECK_TRUE(a.is_valid());
+    ARC_CHECK_TRUE(a.is_empty());
+    ARC_CHECK_TRUE(a.is_immutable());
+
+    ARC_TEST_MESSAGE("Checking push back and build");
+    builder.reserve(test_data.size());
+    builder.push_back(test_data[0]).push_back(test_data[1]);
+    builder.push_back(test_data[2]);
+    ARC_CHECK_EQUAL(builder.get_size(), 3);
+    omi::ArrayAttribute b = builder.build(false);
+    ARC_CHECK_EQUAL(builder.get_size(), 0);
+    ARC_CHECK_FALSE(b.is_immutable());
+    ARC_CHECK_ITER_EQUAL(b.get_values(), test_data);
+    ARC_CHECK_EQUAL(b, omi::ArrayAttribute(test_data));
+    ARC_CHECK_EQUAL(b.get_hash(), omi::ArrayAttribute(test_data).get_hash());
+
+    ARC_TEST_MESSAGE("Checking builder from existing array");
+    omi::ArrayAttribute::Builder from_b(b);
+    from_b.push_back(omi::Int32Attribute(12));
+    omi::ArrayAttribute c = from_b.build();
+    ARC_CHECK_EQUAL(c.get_size(), 4);
+    ARC_CHECK_EQUAL(b.get_size(), 3);
+    ARC_CHECK_TRUE(c.is_immutable());
+    ARC_CHECK_EQUAL(c.back(), omi::Int32Attribute(12));
+}
+
+//------------------------------------------------------------------------------
+//                                   PERSISTENT
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(copy_updates)
+{
+    std::vector<omi::Attribute> test_data = {
+        omi::ByteAttribute({'x', 'y'}, 1),
+        omi::Int16Attribute(55),
+        omi::StringAttribute("Hello world!")
+    };
+
+    omi::ArrayAttribute a(test_data);
+    omi::Hash hash = a.get_hash();
+
+    ARC_TEST_MESSAGE("Checking copy_with");
+    omi::ArrayAttribute b = a.copy_with(1, omi::Int32Attribute(12));
+    ARC_CHECK_TRUE(b.is_immutable());
+    ARC_CHECK_EQUAL(b.get_size(), 3);
+    ARC_CHECK_EQUAL(b[1], omi::Int32Attribute(12));
+    ARC_CHECK_EQUAL(a[1], test_data[1]);
+    ARC_CHECK_EQUAL(a.get_hash(), hash);
+    ARC_CHECK_NOT_EQUAL(b.get_hash(), hash);
+    ARC_CHECK_EQUAL(b.copy_with(1, test_data[1]), a);
+    ARC_CHECK_EQUAL(b.copy_with(1, test_data[1]).get_hash(), hash);
+    // the unchanged elements are shared
+    ARC_CHECK_EQUAL(
+        omi::ByteAttribute(b[0]).get_values().data(),
+        omi::ByteAttribute(a[0]).get_values().data()
+    );
+    ARC_CHECK_THROW(
+        a.copy_with(3, omi::Int32Attribute(12)),
+        arc::ex::IndexOutOfBoundsError
+    );
+
+    ARC_TEST_MESSAGE("Checking copy_with_appended");
+    omi::ArrayAttribute c = a.copy_with_appended(omi::Int32Attribute(12));
+    ARC_CHECK_EQUAL(c.get_size(), 4);
+    ARC_CHECK_EQUAL(c.back(), omi::Int32Attribute(12));
+    ARC_CHECK_EQUAL(a.get_size(), 3);
+
+    ARC_TEST_MESSAGE("Checking copy_without");
+    omi::ArrayAttribute d = c.copy_without(3);
+    ARC_CHECK_EQUAL(d, a);
+    ARC_CHECK_EQUAL(d.get_hash(), hash);
+    omi::ArrayAttribute e = a.copy_without(0);
+    ARC_CHECK_EQUAL(e.get_size(), 2);
+    ARC_CHECK_EQUAL(e[0], test_data[1]);
+    ARC_CHECK_EQUAL(e[1], test_data[2]);
+    ARC_CHECK_EQUAL(a.get_size(), 3);
+    ARC_CHECK_THROW(a.copy_without(3), arc::ex::IndexOutOfBoundsError);
+
+    ARC_TEST_MESSAGE("Checking mutable arrays");
+    omi::ArrayAttribute f(test_data, false);
+    omi::ArrayAttribute g = f.copy_with_appended(omi::Int32Attribute(12));
+    ARC_CHECK_FALSE(g.is_immutable());
+    g.erase(0);
+    ARC_CHECK_EQUAL(f.get_size(), 3);
+}
+
 } // namespace anonymous
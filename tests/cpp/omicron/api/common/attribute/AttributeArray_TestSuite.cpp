@@ -0,0 +1,335 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.AttributeArray)
+
+#include <vector>
+
+#include <omicron/api/common/attribute/AttributeArray.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the elements an AttributeArray is expected to have
+typedef std::vector<arc::int32> Expected;
+
+// returns the value of the given element
+arc::int32 get_value(const omi::Attribute& element)
+{
+    return omi::Int32Attribute(element).get_value();
+}
+
+// returns whether the array has exactly the expected elements, checking both
+// iteration and indexing
+bool check_elements(const omi::AttributeArray& array, const Expected& expected)
+{
+    if(array.size() != expected.size() || array.empty() != expected.empty())
+    {
+        return false;
+    }
+
+    std::size_t index = 0;
+    for(const omi::Attribute& element : array)
+    {
+        if(index >= expected.size() || get_value(element) != expected[index])
+        {
+            return false;
+        }
+        ++index;
+    }
+    if(index != expected.size())
+    {
+        return false;
+    }
+
+    for(std::size_t i = 0; i < expected.size(); ++i)
+    {
+        if(get_value(array[i]) != expected[i])
+        {
+            return false;
+        }
+    }
+    if(!expected.empty() &&
+       (get_value(array.front()) != expected.front() ||
+        get_value(array.back()) != expected.back()))
+    {
+        return false;
+    }
+    return true;
+}
+
+// performs a random insertion, erasure or replacement on the array and the
+// expected elements, insertions are twice as likely so that the array grows
+void modify(
+        omi::AttributeArray& array,
+        Expected& expected,
+        arc::uint32& state,
+        arc::int32 value)
+{
+    state = state * 1664525 + 1013904223;
+    std::size_t operation = (state >> 20) % 4;
+    if(expected.empty())
+    {
+        operation = 0;
+    }
+
+    if(operation <= 1)
+    {
+        std::size_t index = (state >> 4) % (expected.size() + 1);
+        array.insert(index, omi::Int32Attribute(value));
+        expected.insert(expected.begin() + index, value);
+    }
+    else if(operation == 2)
+    {
+        std::size_t index = (state >> 4) % expected.size();
+        array.erase(index);
+        expected.erase(expected.begin() + index);
+    }
+    else
+    {
+        std::size_t index = (state >> 4) % expected.size();
+        array.set(index, omi::Int32Attribute(value));
+        expected[index] = value;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                     BASIC
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(basic)
+{
+    ARC_TEST_MESSAGE("Checking an empty array");
+    {
+        omi::AttributeArray array;
+        ARC_CHECK_TRUE(array.empty());
+        ARC_CHECK_EQUAL(array.size(), 0);
+        ARC_CHECK_TRUE(array.begin() == array.end());
+        ARC_CHECK_TRUE(array == omi::AttributeArray());
+    }
+
+    ARC_TEST_MESSAGE("Checking appending elements");
+    {
+        omi::AttributeArray array;
+        Expected expected;
+        // enough elements for the tree to be three levels deep
+        for(arc::int32 i = 0; i < 40000; ++i)
+        {
+            array.push_back(omi::Int32Attribute(i));
+            expected.push_back(i);
+            if(i % 1000 == 0)
+            {
+                ARC_CHECK_TRUE(check_elements(array, expected));
+            }
+        }
+        ARC_CHECK_TRUE(check_elements(array, expected));
+    }
+
+    ARC_TEST_MESSAGE("Checking construction from other containers");
+    {
+        std::vector<omi::Attribute> values;
+        Expected expected;
+        for(arc::int32 i = 0; i < 100; ++i)
+        {
+            values.push_back(omi::Int32Attribute(i));
+            expected.push_back(i);
+        }
+        ARC_CHECK_TRUE(check_elements(omi::AttributeArray(values), expected));
+        ARC_CHECK_TRUE(check_elements(
+            omi::AttributeArray(values.begin(), values.end()),
+            expected
+        ));
+
+        omi::AttributeArray listed = {
+            omi::Int32Attribute(1),
+            omi::Int32Attribute(2)
+        };
+        ARC_CHECK_TRUE(check_elements(listed, {1, 2}));
+    }
+
+    ARC_TEST_MESSAGE("Checking comparisons");
+    {
+        omi::AttributeArray a = {
+            omi::Int32Attribute(1),
+            omi::Int32Attribute(2)
+        };
+        omi::AttributeArray b = {
+            omi::Int32Attribute(1),
+            omi::Int32Attribute(2)
+        };
+        omi::AttributeArray c = {
+            omi::Int32Attribute(1),
+            omi::Int32Attribute(3)
+        };
+        ARC_CHECK_TRUE(a == b);
+        ARC_CHECK_FALSE(a != b);
+        ARC_CHECK_TRUE(a != c);
+        ARC_CHECK_TRUE(a < c);
+        ARC_CHECK_FALSE(c < a);
+        ARC_CHECK_FALSE(a < b);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                  MODIFICATION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(modification)
+{
+    ARC_TEST_MESSAGE("Checking random insertions, erasures and replacements");
+    {
+        omi::AttributeArray array;
+        Expected expected;
+        arc::uint32 state = 12345;
+        for(arc::int32 i = 0; i < 20000; ++i)
+        {
+            modify(array, expected, state, i);
+            if(i % 500 == 0)
+            {
+                ARC_CHECK_TRUE(check_elements(array, expected));
+            }
+        }
+        ARC_CHECK_TRUE(check_elements(array, expected));
+
+        // erase everything from random positions
+        while(!expected.empty())
+        {
+            state = state * 1664525 + 1013904223;
+            std::size_t index = (state >> 4) % expected.size();
+            array.erase(index);
+            expected.erase(expected.begin() + index);
+            if(expected.size() % 200 == 0)
+            {
+                ARC_CHECK_TRUE(check_elements(array, expected));
+            }
+        }
+        ARC_CHECK_TRUE(check_elements(array, expected));
+    }
+
+    ARC_TEST_MESSAGE("Checking erasing from the front and back");
+    {
+        omi::AttributeArray array;
+        Expected expected;
+        for(arc::int32 i = 0; i < 5000; ++i)
+        {
+            array.push_back(omi::Int32Attribute(i));
+            expected.push_back(i);
+        }
+        while(!expected.empty())
+        {
+            array.erase(0);
+            expected.erase(expected.begin());
+            if(!expected.empty())
+            {
+                array.erase(array.size() - 1);
+                expected.pop_back();
+            }
+            if(expected.size() % 100 == 0)
+            {
+                ARC_CHECK_TRUE(check_elements(array, expected));
+            }
+        }
+    }
+
+    ARC_TEST_MESSAGE("Checking modifying elements in place");
+    {
+        omi::AttributeArray array;
+        Expected expected;
+        for(arc::int32 i = 0; i < 1000; ++i)
+        {
+            array.push_back(omi::Int32Attribute(i));
+            expected.push_back(i);
+        }
+        array.get_mutable(500) = omi::Int32Attribute(-500);
+        expected[500] = -500;
+        ARC_CHECK_TRUE(check_elements(array, expected));
+
+        array.clear();
+        ARC_CHECK_TRUE(check_elements(array, Expected()));
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    SHARING
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(sharing)
+{
+    omi::AttributeArray array;
+    Expected expected;
+    for(arc::int32 i = 0; i < 5000; ++i)
+    {
+        array.push_back(omi::Int32Attribute(i));
+        expected.push_back(i);
+    }
+
+    ARC_TEST_MESSAGE("Checking copies share their elements");
+    omi::AttributeArray copy(array);
+    ARC_CHECK_EQUAL(&copy[100], &array[100]);
+
+    ARC_TEST_MESSAGE("Checking modifying a copy doesn't modify the original");
+    {
+        Expected copy_expected(expected);
+        copy.set(100, omi::Int32Attribute(-100));
+        copy_expected[100] = -100;
+        copy.get_mutable(200) = omi::Int32Attribute(-200);
+        copy_expected[200] = -200;
+        copy.insert(300, omi::Int32Attribute(-300));
+        copy_expected.insert(copy_expected.begin() + 300, -300);
+        copy.erase(4000);
+        copy_expected.erase(copy_expected.begin() + 4000);
+        copy.push_back(omi::Int32Attribute(-1));
+        copy_expected.push_back(-1);
+
+        ARC_CHECK_TRUE(check_elements(array, expected));
+        ARC_CHECK_TRUE(check_elements(copy, copy_expected));
+        // only the leaves that were modified were copied, the insertion moved
+        // the later elements of the copy along by one
+        ARC_CHECK_NOT_EQUAL(&copy[100], &array[100]);
+        ARC_CHECK_EQUAL(&copy[2001], &array[2000]);
+    }
+
+    ARC_TEST_MESSAGE("Checking random modifications of many copies");
+    {
+        std::vector<omi::AttributeArray> versions(1, array);
+        std::vector<Expected> expected_versions(1, expected);
+        arc::uint32 state = 54321;
+        for(arc::int32 i = 0; i < 4000; ++i)
+        {
+            state = state * 1664525 + 1013904223;
+            std::size_t from = (state >> 8) % versions.size();
+
+            // modify a copy of an existing version
+            omi::AttributeArray version(versions[from]);
+            Expected expected_version(expected_versions[from]);
+            modify(version, expected_version, state, i);
+
+            // keep a handful of versions alive
+            if(versions.size() < 8)
+            {
+                versions.push_back(version);
+                expected_versions.push_back(expected_version);
+            }
+            else
+            {
+                std::size_t to = (state >> 12) % versions.size();
+                versions[to] = version;
+                expected_versions[to] = expected_version;
+            }
+        }
+        for(std::size_t i = 0; i < versions.size(); ++i)
+        {
+            ARC_CHECK_TRUE(
+                check_elements(versions[i], expected_versions[i])
+            );
+        }
+    }
+    ARC_CHECK_TRUE(check_elements(array, expected));
+}
+
+} // namespace anonymous
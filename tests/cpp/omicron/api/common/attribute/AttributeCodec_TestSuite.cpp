@@ -0,0 +1,280 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.AttributeCodec)
+
+#include <cstring>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/common/attribute/AttributeCodec.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// counts the number of times it is called
+void count_release(void* user_data)
+{
+    ++(*static_cast<std::size_t*>(user_data));
+}
+
+// returns a hierarchy which uses every encodable attribute type
+omi::MapAttribute make_hierarchy()
+{
+    std::vector<float> positions;
+    for(std::size_t i = 0; i < 300; ++i)
+    {
+        positions.push_back(static_cast<float>(i) * 0.5F);
+    }
+
+    omi::ArrayAttribute::DataType array_data;
+    array_data.push_back(omi::Int16Attribute(-3));
+    array_data.push_back(omi::Attribute());
+    array_data.push_back(omi::Int64Attribute({1, 2, 3, 4}, 2, false));
+
+    omi::MapAttribute::DataType vertex_data = {
+        {
+            "positions",
+            omi::FloatAttribute(positions.begin(), positions.end(), 3)
+        },
+        {"indices", omi::Int32Attribute({0, 1, 2, 2, 1, 0}, 3, false)}
+    };
+    omi::MapAttribute::DataType root_data = {
+        {"vertex", omi::MapAttribute(vertex_data, false)},
+        {"visible", omi::BoolAttribute({true, false, true}, 0, false)},
+        {"raw", omi::ByteAttribute({'a', 'b', '\0', 'c'}, 0)},
+        {"scale", omi::DoubleAttribute(2.5)},
+        {"names", omi::StringAttribute({"", "one", "two"}, 0, false)},
+        {
+            "file",
+            omi::PathAttribute(arc::io::sys::Path({"res", "mesh.obj"}))
+        },
+        {"array", omi::ArrayAttribute(array_data, false)},
+        {"empty", omi::MapAttribute()}
+    };
+    return omi::MapAttribute(root_data);
+}
+
+//------------------------------------------------------------------------------
+//                                   ROUND TRIP
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(round_trip)
+{
+    omi::MapAttribute a = make_hierarchy();
+
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(a, encoded);
+    ARC_CHECK_EQUAL(encoded.size() % 8, 0);
+
+    ARC_TEST_MESSAGE("Checking decoded values");
+    omi::MapAttribute b(
+        omi::AttributeCodec::decode(encoded.data(), encoded.size())
+    );
+    ARC_CHECK_TRUE(b.is_valid());
+    ARC_CHECK_EQUAL(a, b);
+    ARC_CHECK_EQUAL(a.get_hash(), b.get_hash());
+    ARC_CHECK_EQUAL(omi::FloatAttribute(b["vertex.positions"]).at(299), 149.5F);
+    ARC_CHECK_EQUAL(omi::StringAttribute(b["names"]).at(2), "two");
+    ARC_CHECK_EQUAL(
+        omi::ArrayAttribute(b["array"])[1].get_type(),
+        omi::Attribute::kTypeNull
+    );
+    ARC_CHECK_EQUAL(
+        omi::PathAttribute(b["file"]).get_value(),
+        arc::io::sys::Path({"res", "mesh.obj"})
+    );
+
+    ARC_TEST_MESSAGE("Checking tuple sizes and immutability");
+    ARC_CHECK_EQUAL(
+        omi::FloatAttribute(b["vertex.positions"]).get_tuple_size(),
+        3
+    );
+    ARC_CHECK_EQUAL(
+        omi::Int64Attribute(omi::ArrayAttribute(b["array"])[2])
+            .get_tuple_size(),
+        2
+    );
+    ARC_CHECK_TRUE(b.is_immutable());
+    ARC_CHECK_FALSE(b["vertex"].is_immutable());
+    ARC_CHECK_TRUE(b["vertex.positions"].is_immutable());
+    ARC_CHECK_FALSE(b["vertex.indices"].is_immutable());
+    ARC_CHECK_FALSE(b["names"].is_immutable());
+    ARC_CHECK_TRUE(b["raw"].is_immutable());
+
+    ARC_TEST_MESSAGE("Checking encodings are deterministic");
+    std::vector<char> reencoded;
+    omi::AttributeCodec::encode(b, reencoded);
+    ARC_CHECK_TRUE(reencoded == encoded);
+
+    ARC_TEST_MESSAGE("Checking single attributes");
+    omi::AttributeCodec::encode(omi::Attribute(), encoded);
+    ARC_CHECK_EQUAL(
+        omi::AttributeCodec::decode(encoded.data(), encoded.size()),
+        omi::Attribute()
+    );
+    omi::AttributeCodec::encode(omi::Int32Attribute(7), encoded);
+    ARC_CHECK_EQUAL(
+        omi::Int32Attribute(omi::AttributeCodec::decode(
+            encoded.data(),
+            encoded.size()
+        )).get_value(),
+        7
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                    BORROWED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(borrowed)
+{
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(make_hierarchy(), encoded);
+
+    ARC_TEST_MESSAGE("Checking large blocks are borrowed");
+    std::size_t release_count = 0;
+    {
+        omi::MapAttribute a(omi::AttributeCodec::decode_borrowed(
+            encoded.data(),
+            encoded.size(),
+            &count_release,
+            &release_count
+        ));
+        ARC_CHECK_EQUAL(a, make_hierarchy());
+
+        omi::FloatAttribute positions(a["vertex.positions"]);
+        ARC_CHECK_TRUE(positions.get_values().is_borrowed());
+        const char* values =
+            reinterpret_cast<const char*>(positions.get_values().data());
+        ARC_CHECK_TRUE(
+            values >= encoded.data() &&
+            values < encoded.data() + encoded.size()
+        );
+        ARC_CHECK_EQUAL(
+            (values - encoded.data()) % omi::AttributeCodec::kBlockAlignment,
+            0
+        );
+        // small blocks are copied
+        ARC_CHECK_FALSE(
+            omi::Int32Attribute(a["vertex.indices"]).get_values().is_borrowed()
+        );
+        ARC_CHECK_EQUAL(release_count, 0);
+    }
+    ARC_CHECK_EQUAL(release_count, 1);
+
+    ARC_TEST_MESSAGE("Checking release when nothing is borrowed");
+    {
+        std::vector<char> small;
+        omi::AttributeCodec::encode(omi::Int32Attribute(1), small);
+        release_count = 0;
+        omi::AttributeCodec::decode_borrowed(
+            small.data(),
+            small.size(),
+            &count_release,
+            &release_count
+        );
+        ARC_CHECK_EQUAL(release_count, 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking modification copies borrowed data");
+    {
+        release_count = 0;
+        omi::MapAttribute a(omi::AttributeCodec::decode_borrowed(
+            encoded.data(),
+            encoded.size(),
+            &count_release,
+            &release_count
+        ));
+        omi::FloatAttribute positions =
+            omi::FloatAttribute(a["vertex.positions"]).as_mutable();
+        positions.set_at(0, 100.0F);
+        ARC_CHECK_FALSE(positions.get_values().is_borrowed());
+        ARC_CHECK_EQUAL(
+            omi::FloatAttribute(a["vertex.positions"]).at(0),
+            0.0F
+        );
+        a = omi::MapAttribute();
+        ARC_CHECK_EQUAL(release_count, 1);
+        ARC_CHECK_EQUAL(positions.at(0), 100.0F);
+    }
+
+    ARC_TEST_MESSAGE("Checking release on invalid data");
+    {
+        release_count = 0;
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode_borrowed(
+                encoded.data(),
+                encoded.size() - 8,
+                &count_release,
+                &release_count
+            ),
+            arc::ex::ParseError
+        );
+        ARC_CHECK_EQUAL(release_count, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    INVALID
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(invalid)
+{
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(make_hierarchy(), encoded);
+
+    ARC_TEST_MESSAGE("Checking truncated data");
+    for(std::size_t length = 0; length < encoded.size(); length += 7)
+    {
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode(encoded.data(), length),
+            arc::ex::ParseError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking invalid headers");
+    {
+        std::vector<char> bad_magic(encoded);
+        bad_magic[0] = 'X';
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode(bad_magic.data(), bad_magic.size()),
+            arc::ex::ParseError
+        );
+
+        std::vector<char> bad_version(encoded);
+        arc::uint32 version = omi::AttributeCodec::kVersion + 1;
+        std::memcpy(&bad_version[8], &version, sizeof(version));
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode(bad_version.data(), bad_version.size()),
+            arc::ex::ParseError
+        );
+
+        std::vector<char> bad_order(encoded);
+        std::swap(bad_order[12], bad_order[15]);
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode(bad_order.data(), bad_order.size()),
+            arc::ex::ParseError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking unknown types");
+    {
+        omi::AttributeCodec::encode(omi::Attribute(), encoded);
+        // the tag of the root attribute follows the 32 byte header
+        arc::uint32 tag = 1000;
+        std::memcpy(&encoded[32], &tag, sizeof(tag));
+        ARC_CHECK_THROW(
+            omi::AttributeCodec::decode(encoded.data(), encoded.size()),
+            arc::ex::ParseError
+        );
+    }
+}
+
+} // namespace anonymous
@@ -0,0 +1,410 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.AttributeMap)
+
+#include <map>
+#include <vector>
+
+#include <omicron/api/common/attribute/AttributeMap.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the entries an AttributeMap is expected to have
+typedef std::map<arc::str::UTF8String, arc::int32> Expected;
+
+// returns the name used for the given key
+arc::str::UTF8String get_name(std::size_t key)
+{
+    arc::str::UTF8String name("entry_");
+    name << key;
+    return name;
+}
+
+// returns whether the map has exactly the expected entries, checking both
+// iteration and lookups
+bool check_entries(const omi::AttributeMap& map, const Expected& expected)
+{
+    if(map.size() != expected.size() || map.empty() != expected.empty())
+    {
+        return false;
+    }
+
+    // every entry is visited once
+    std::size_t visited = 0;
+    for(const omi::AttributeMap::value_type& entry : map)
+    {
+        auto f_expected = expected.find(entry.first);
+        if(f_expected == expected.end() ||
+           omi::Int32Attribute(entry.second).get_value() != f_expected->second)
+        {
+            return false;
+        }
+        ++visited;
+    }
+    if(visited != expected.size())
+    {
+        return false;
+    }
+
+    for(const auto& entry : expected)
+    {
+        auto f_entry = map.find(entry.first);
+        if(f_entry == map.end() ||
+           f_entry->first != entry.first ||
+           omi::Int32Attribute(f_entry->second).get_value() != entry.second ||
+           map.count(entry.first) != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//                                     INLINE
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(inline)
+{
+    ARC_TEST_MESSAGE("Checking an empty map");
+    {
+        omi::AttributeMap map;
+        ARC_CHECK_TRUE(map.empty());
+        ARC_CHECK_EQUAL(map.size(), 0);
+        ARC_CHECK_FALSE(map.is_promoted());
+        ARC_CHECK_TRUE(map.begin() == map.end());
+        ARC_CHECK_TRUE(map.find("missing") == map.end());
+        ARC_CHECK_EQUAL(map.count("missing"), 0);
+        ARC_CHECK_EQUAL(map.erase("missing"), 0);
+        ARC_CHECK_TRUE(map.find_mutable("missing") == nullptr);
+    }
+
+    ARC_TEST_MESSAGE("Checking entries are stored inline up to the capacity");
+    {
+        omi::AttributeMap map;
+        Expected expected;
+        for(std::size_t i = 0; i < omi::AttributeMap::kInlineCapacity; ++i)
+        {
+            auto result = map.insert(omi::AttributeMap::value_type(
+                get_name(i),
+                omi::Int32Attribute(static_cast<arc::int32>(i))
+            ));
+            ARC_CHECK_TRUE(result.second);
+            ARC_CHECK_EQUAL(result.first->first, get_name(i));
+            expected[get_name(i)] = static_cast<arc::int32>(i);
+            ARC_CHECK_FALSE(map.is_promoted());
+            ARC_CHECK_TRUE(check_entries(map, expected));
+        }
+
+        // inserting an existing name keeps the existing entry
+        auto result = map.insert(omi::AttributeMap::value_type(
+            get_name(0),
+            omi::Int32Attribute(100)
+        ));
+        ARC_CHECK_FALSE(result.second);
+        ARC_CHECK_EQUAL(
+            omi::Int32Attribute(result.first->second).get_value(),
+            0
+        );
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        // entries are modified through operator[] and find_mutable
+        map[get_name(1)] = omi::Int32Attribute(101);
+        *map.find_mutable(get_name(2)) = omi::Int32Attribute(102);
+        expected[get_name(1)] = 101;
+        expected[get_name(2)] = 102;
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        // erasing
+        ARC_CHECK_EQUAL(map.erase(get_name(1)), 1);
+        ARC_CHECK_EQUAL(map.erase(get_name(1)), 0);
+        expected.erase(get_name(1));
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        // reinserting into the free slot
+        map[get_name(5)] = omi::Int32Attribute(5);
+        expected[get_name(5)] = 5;
+        ARC_CHECK_FALSE(map.is_promoted());
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        map.clear();
+        ARC_CHECK_TRUE(check_entries(map, Expected()));
+    }
+
+    ARC_TEST_MESSAGE("Checking inline entries don't move");
+    {
+        omi::AttributeMap map;
+        map["a"] = omi::Int32Attribute(1);
+        const omi::Attribute* a = map.find_mutable("a");
+        map["b"] = omi::Int32Attribute(2);
+        map["c"] = omi::Int32Attribute(3);
+        map.erase("b");
+        ARC_CHECK_EQUAL(map.find_mutable("a"), a);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                   PROMOTION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(promotion)
+{
+    ARC_TEST_MESSAGE("Checking maps are promoted and demoted");
+    {
+        omi::AttributeMap map;
+        Expected expected;
+        for(std::size_t i = 0; i <= omi::AttributeMap::kInlineCapacity; ++i)
+        {
+            map[get_name(i)] = omi::Int32Attribute(static_cast<arc::int32>(i));
+            expected[get_name(i)] = static_cast<arc::int32>(i);
+        }
+        ARC_CHECK_TRUE(map.is_promoted());
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        std::size_t key = 0;
+        while(map.size() > omi::AttributeMap::kDemoteSize + 1)
+        {
+            map.erase(get_name(key));
+            expected.erase(get_name(key));
+            ++key;
+            ARC_CHECK_TRUE(map.is_promoted());
+            ARC_CHECK_TRUE(check_entries(map, expected));
+        }
+        map.erase(get_name(key));
+        expected.erase(get_name(key));
+        ARC_CHECK_FALSE(map.is_promoted());
+        ARC_CHECK_TRUE(check_entries(map, expected));
+    }
+
+    ARC_TEST_MESSAGE("Checking random insertions and erasures");
+    {
+        omi::AttributeMap map;
+        Expected expected;
+        arc::uint32 state = 12345;
+        // the small range keeps the map around the inline capacity and the
+        // large range grows the trie
+        for(std::size_t range : {8, 2000})
+        {
+            for(std::size_t i = 0; i < 10000; ++i)
+            {
+                state = state * 1664525 + 1013904223;
+                std::size_t key = (state >> 8) % range;
+                if(((state >> 4) & 1) != 0)
+                {
+                    map[get_name(key)] = omi::Int32Attribute(
+                        static_cast<arc::int32>(i)
+                    );
+                    expected[get_name(key)] = static_cast<arc::int32>(i);
+                }
+                else
+                {
+                    ARC_CHECK_EQUAL(
+                        map.erase(get_name(key)),
+                        expected.erase(get_name(key))
+                    );
+                }
+                if(i % 100 == 0)
+                {
+                    ARC_CHECK_TRUE(check_entries(map, expected));
+                }
+            }
+        }
+
+        // erase everything
+        while(!expected.empty())
+        {
+            ARC_CHECK_EQUAL(map.erase(expected.begin()->first), 1);
+            expected.erase(expected.begin());
+            if(expected.size() % 50 == 0)
+            {
+                ARC_CHECK_TRUE(check_entries(map, expected));
+            }
+        }
+        ARC_CHECK_TRUE(check_entries(map, expected));
+        ARC_CHECK_FALSE(map.is_promoted());
+    }
+
+    ARC_TEST_MESSAGE("Checking entries of a promoted map don't move");
+    {
+        omi::AttributeMap map;
+        for(std::size_t i = 0; i < 100; ++i)
+        {
+            map[get_name(i)] = omi::Int32Attribute(static_cast<arc::int32>(i));
+        }
+        const omi::Attribute* entry = map.find_mutable(get_name(50));
+        for(std::size_t i = 100; i < 1000; ++i)
+        {
+            map[get_name(i)] = omi::Int32Attribute(static_cast<arc::int32>(i));
+        }
+        for(std::size_t i = 0; i < 40; ++i)
+        {
+            map.erase(get_name(i));
+        }
+        ARC_CHECK_EQUAL(map.find_mutable(get_name(50)), entry);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                      COPY
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(copy)
+{
+    ARC_TEST_MESSAGE("Checking copies of inline and promoted maps");
+    for(std::size_t size : {0, 3, 4, 5, 100})
+    {
+        omi::AttributeMap map;
+        Expected expected;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            map[get_name(i)] = omi::Int32Attribute(static_cast<arc::int32>(i));
+            expected[get_name(i)] = static_cast<arc::int32>(i);
+        }
+
+        omi::AttributeMap copy(map);
+        ARC_CHECK_TRUE(check_entries(copy, expected));
+        // copies are independent
+        copy["extra"] = omi::Int32Attribute(-1);
+        ARC_CHECK_TRUE(check_entries(map, expected));
+
+        omi::AttributeMap assigned;
+        assigned["other"] = omi::Int32Attribute(-1);
+        assigned = map;
+        ARC_CHECK_TRUE(check_entries(assigned, expected));
+
+        omi::AttributeMap moved(std::move(assigned));
+        ARC_CHECK_TRUE(check_entries(moved, expected));
+        ARC_CHECK_TRUE(assigned.empty());
+
+        omi::AttributeMap move_assigned;
+        move_assigned = std::move(moved);
+        ARC_CHECK_TRUE(check_entries(move_assigned, expected));
+        ARC_CHECK_TRUE(moved.empty());
+
+        Expected copy_expected(expected);
+        copy_expected["extra"] = -1;
+        move_assigned.swap(copy);
+        ARC_CHECK_TRUE(check_entries(move_assigned, copy_expected));
+        ARC_CHECK_TRUE(check_entries(copy, expected));
+
+        omi::AttributeMap ranged(map.begin(), map.end());
+        ARC_CHECK_TRUE(check_entries(ranged, expected));
+    }
+
+    ARC_TEST_MESSAGE("Checking initializer lists");
+    {
+        omi::AttributeMap map = {
+            {"a", omi::Int32Attribute(1)},
+            {"b", omi::Int32Attribute(2)},
+            {"a", omi::Int32Attribute(3)}
+        };
+        Expected expected;
+        expected["a"] = 1;
+        expected["b"] = 2;
+        ARC_CHECK_TRUE(check_entries(map, expected));
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    SHARING
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(sharing)
+{
+    ARC_TEST_MESSAGE("Checking copies of promoted maps share their entries");
+    omi::AttributeMap map;
+    Expected expected;
+    for(std::size_t i = 0; i < 1000; ++i)
+    {
+        map[get_name(i)] = omi::Int32Attribute(static_cast<arc::int32>(i));
+        expected[get_name(i)] = static_cast<arc::int32>(i);
+    }
+    omi::AttributeMap copy(map);
+    ARC_CHECK_EQUAL(
+        &copy.find(get_name(10))->second,
+        &map.find(get_name(10))->second
+    );
+
+    ARC_TEST_MESSAGE("Checking modifying a copy doesn't modify the original");
+    {
+        Expected copy_expected(expected);
+        *copy.find_mutable(get_name(10)) = omi::Int32Attribute(-10);
+        copy_expected[get_name(10)] = -10;
+        copy[get_name(20)] = omi::Int32Attribute(-20);
+        copy_expected[get_name(20)] = -20;
+        copy["extra"] = omi::Int32Attribute(-1);
+        copy_expected["extra"] = -1;
+        copy.erase(get_name(30));
+        copy_expected.erase(get_name(30));
+
+        ARC_CHECK_TRUE(check_entries(map, expected));
+        ARC_CHECK_TRUE(check_entries(copy, copy_expected));
+        // only the modified entries were copied
+        ARC_CHECK_NOT_EQUAL(
+            &copy.find(get_name(10))->second,
+            &map.find(get_name(10))->second
+        );
+        ARC_CHECK_EQUAL(
+            &copy.find(get_name(40))->second,
+            &map.find(get_name(40))->second
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking random modifications of many copies");
+    {
+        std::vector<omi::AttributeMap> versions(1, map);
+        std::vector<Expected> expected_versions(1, expected);
+        arc::uint32 state = 54321;
+        for(std::size_t i = 0; i < 4000; ++i)
+        {
+            state = state * 1664525 + 1013904223;
+            std::size_t from = (state >> 8) % versions.size();
+            std::size_t key = (state >> 4) % 1100;
+
+            // modify a copy of an existing version
+            omi::AttributeMap version(versions[from]);
+            Expected expected_version(expected_versions[from]);
+            if(((state >> 20) & 1) != 0)
+            {
+                version[get_name(key)] = omi::Int32Attribute(
+                    static_cast<arc::int32>(i)
+                );
+                expected_version[get_name(key)] = static_cast<arc::int32>(i);
+            }
+            else
+            {
+                ARC_CHECK_EQUAL(
+                    version.erase(get_name(key)),
+                    expected_version.erase(get_name(key))
+                );
+            }
+
+            // keep a handful of versions alive
+            if(versions.size() < 8)
+            {
+                versions.push_back(version);
+                expected_versions.push_back(expected_version);
+            }
+            else
+            {
+                std::size_t to = (state >> 12) % versions.size();
+                versions[to] = version;
+                expected_versions[to] = expected_version;
+            }
+        }
+        for(std::size_t i = 0; i < versions.size(); ++i)
+        {
+            ARC_CHECK_TRUE(check_entries(versions[i], expected_versions[i]));
+        }
+    }
+    ARC_CHECK_TRUE(check_entries(map, expected));
+}
+
+} // namespace anonymous
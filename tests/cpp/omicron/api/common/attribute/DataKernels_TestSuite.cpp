@@ -0,0 +1,238 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.DataKernels)
+
+#include <limits>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/common/attribute/DataKernels.hpp>
+#include <omicron/api/common/attribute/DoubleAttribute.hpp>
+#include <omicron/api/common/attribute/FloatAttribute.hpp>
+#include <omicron/api/common/attribute/Int32Attribute.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the sizes that are tested so that both the vector and remainder loops are
+// covered
+static const std::size_t kSizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 16, 33, 1001};
+static const std::size_t kSizeCount = sizeof(kSizes) / sizeof(std::size_t);
+
+// returns an array of the given size with varied positive and negative values
+template<typename T_DataType>
+std::vector<T_DataType> make_values(std::size_t size)
+{
+    std::vector<T_DataType> values;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        arc::int32 v = static_cast<arc::int32>((i * 37) % 101) - 50;
+        values.push_back(static_cast<T_DataType>(v));
+    }
+    return values;
+}
+
+//------------------------------------------------------------------------------
+//                                    KERNELS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(kernels)
+{
+    ARC_TEST_MESSAGE("Checking kernels match scalar results");
+    for(std::size_t s = 0; s < kSizeCount; ++s)
+    {
+        std::size_t size = kSizes[s];
+        std::vector<arc::int32> ints = make_values<arc::int32>(size);
+        std::vector<float> floats = make_values<float>(size);
+        std::vector<double> doubles = make_values<double>(size);
+
+        arc::int32 i_min = ints[0];
+        arc::int32 i_max = ints[0];
+        arc::int64 i_sum = 0;
+        for(arc::int32 v : ints)
+        {
+            i_min = v < i_min ? v : i_min;
+            i_max = v > i_max ? v : i_max;
+            i_sum += v;
+        }
+        ARC_CHECK_EQUAL(omi::kernels::min(ints.data(), size), i_min);
+        ARC_CHECK_EQUAL(omi::kernels::max(ints.data(), size), i_max);
+        ARC_CHECK_EQUAL(omi::kernels::sum(ints.data(), size), i_sum);
+        // the values are small integers so the float sums are exact
+        ARC_CHECK_EQUAL(
+            omi::kernels::min(floats.data(), size),
+            static_cast<float>(i_min)
+        );
+        ARC_CHECK_EQUAL(
+            omi::kernels::max(doubles.data(), size),
+            static_cast<double>(i_max)
+        );
+        ARC_CHECK_EQUAL(
+            omi::kernels::sum(floats.data(), size),
+            static_cast<float>(i_sum)
+        );
+        ARC_CHECK_EQUAL(
+            omi::kernels::sum(doubles.data(), size),
+            static_cast<double>(i_sum)
+        );
+
+        std::vector<arc::int32> scaled_ints(ints);
+        omi::kernels::scale(scaled_ints.data(), size, -3);
+        std::vector<double> added_doubles(doubles);
+        omi::kernels::add(added_doubles.data(), doubles.data(), size);
+        std::vector<float> converted_floats(size);
+        omi::kernels::convert(ints.data(), size, converted_floats.data());
+        std::vector<arc::int32> converted_ints(size);
+        omi::kernels::convert(doubles.data(), size, converted_ints.data());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            ARC_CHECK_EQUAL(scaled_ints[i], ints[i] * -3);
+            ARC_CHECK_EQUAL(added_doubles[i], doubles[i] * 2.0);
+            ARC_CHECK_EQUAL(converted_floats[i], floats[i]);
+            ARC_CHECK_EQUAL(converted_ints[i], ints[i]);
+        }
+    }
+
+    ARC_TEST_MESSAGE("Checking truncation");
+    {
+        std::vector<float> floats = {1.9F, -1.9F, 2.5F, -0.5F, 7.99F};
+        std::vector<arc::int32> ints(floats.size());
+        omi::kernels::convert(floats.data(), floats.size(), ints.data());
+        std::vector<arc::int32> expected = {1, -1, 2, 0, 7};
+        ARC_CHECK_ITER_EQUAL(ints, expected);
+    }
+
+    ARC_TEST_MESSAGE("Checking NaN and out of range conversions");
+    {
+        // the same values are repeated so that they are converted by both
+        // the vector and remainder loops
+        const float f_nan = std::numeric_limits<float>::quiet_NaN();
+        const float f_inf = std::numeric_limits<float>::infinity();
+        std::vector<float> floats;
+        std::vector<double> doubles;
+        for(std::size_t i = 0; i < 2; ++i)
+        {
+            floats.insert(floats.end(), {
+                f_nan, 3.0e9F, -3.0e9F, 2147483648.0F, -2147483648.0F, f_inf,
+                -f_inf, 5.5F
+            });
+            doubles.insert(doubles.end(), {
+                static_cast<double>(f_nan), 1.0e300, -2147483649.0,
+                2147483648.0, 2147483647.9, -2147483648.9,
+                static_cast<double>(-f_inf), -5.5
+            });
+        }
+        // make sure the last values are converted by the remainder loops
+        floats.pop_back();
+        doubles.pop_back();
+
+        const arc::int32 i_min = std::numeric_limits<arc::int32>::min();
+        const arc::int32 i_max = std::numeric_limits<arc::int32>::max();
+        std::vector<arc::int32> f_expected = {
+            i_min, i_min, i_min, i_min, i_min, i_min, i_min, 5
+        };
+        std::vector<arc::int32> d_expected = {
+            i_min, i_min, i_min, i_min, i_max, i_min, i_min, -5
+        };
+        for(std::size_t i = 0; i < floats.size(); ++i)
+        {
+            arc::int32 f_converted = 0;
+            arc::int32 d_converted = 0;
+            omi::kernels::convert(floats.data() + i, 1, &f_converted);
+            omi::kernels::convert(doubles.data() + i, 1, &d_converted);
+            ARC_CHECK_EQUAL(f_converted, f_expected[i % f_expected.size()]);
+            ARC_CHECK_EQUAL(d_converted, d_expected[i % d_expected.size()]);
+        }
+
+        std::vector<arc::int32> f_ints(floats.size());
+        omi::kernels::convert(floats.data(), floats.size(), f_ints.data());
+        std::vector<arc::int32> d_ints(doubles.size());
+        omi::kernels::convert(doubles.data(), doubles.size(), d_ints.data());
+        for(std::size_t i = 0; i < floats.size(); ++i)
+        {
+            ARC_CHECK_EQUAL(f_ints[i], f_expected[i % f_expected.size()]);
+            ARC_CHECK_EQUAL(d_ints[i], d_expected[i % d_expected.size()]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                ATTRIBUTE BULK
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(attribute_bulk)
+{
+    ARC_TEST_MESSAGE("Checking fill, scale, and add");
+    {
+        omi::FloatAttribute a({1.0F, 2.0F, 3.0F, 4.0F, 5.0F}, 0, false);
+        omi::FloatAttribute b = a.as_immutable();
+        a.scale(2.0F);
+        a.add(1.0F);
+        std::vector<float> expected = {3.0F, 5.0F, 7.0F, 9.0F, 11.0F};
+        ARC_CHECK_ITER_EQUAL(a.get_values(), expected);
+        // the shared storage is not modified
+        ARC_CHECK_EQUAL(b.at(4), 5.0F);
+
+        a.add(b);
+        ARC_CHECK_EQUAL(a.at(4), 16.0F);
+        a.add(a);
+        ARC_CHECK_EQUAL(a.at(0), 8.0F);
+
+        a.fill(0.5F);
+        ARC_CHECK_EQUAL(a.get_size(), 5);
+        ARC_CHECK_EQUAL(a.get_sum(), 2.5F);
+    }
+
+    ARC_TEST_MESSAGE("Checking reductions");
+    {
+        omi::Int32Attribute a({4, -8, 2147483647, 2147483647, 3}, 0);
+        ARC_CHECK_EQUAL(a.get_min(), -8);
+        ARC_CHECK_EQUAL(a.get_max(), 2147483647);
+        ARC_CHECK_EQUAL(a.get_sum(), 4294967293LL);
+
+        omi::DoubleAttribute empty;
+        ARC_CHECK_THROW(empty.get_min(), arc::ex::IndexOutOfBoundsError);
+        ARC_CHECK_THROW(empty.get_max(), arc::ex::IndexOutOfBoundsError);
+        ARC_CHECK_EQUAL(empty.get_sum(), 0.0);
+    }
+
+    ARC_TEST_MESSAGE("Checking invalid operations");
+    {
+        omi::Int32Attribute a({1, 2, 3}, 0);
+        ARC_CHECK_THROW(a.scale(2), arc::ex::IllegalActionError);
+        ARC_CHECK_THROW(a.fill(2), arc::ex::IllegalActionError);
+
+        omi::Int32Attribute b({1, 2, 3}, 0, false);
+        omi::Int32Attribute c({1, 2}, 0);
+        ARC_CHECK_THROW(b.add(c), arc::ex::ValueError);
+        ARC_CHECK_THROW(
+            b.add(omi::Int32Attribute(omi::Attribute())),
+            arc::ex::StateError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking conversion");
+    {
+        omi::DoubleAttribute a({0.5, 1.5, -2.75, 100.0, 7.0}, 5);
+        omi::FloatAttribute f = omi::FloatAttribute::convert(a);
+        ARC_CHECK_EQUAL(f.get_tuple_size(), 5);
+        ARC_CHECK_TRUE(f.is_immutable());
+        ARC_CHECK_EQUAL(f.at(2), -2.75F);
+
+        omi::Int32Attribute i = omi::Int32Attribute::convert(f, false);
+        ARC_CHECK_FALSE(i.is_immutable());
+        std::vector<arc::int32> expected = {0, 1, -2, 100, 7};
+        ARC_CHECK_ITER_EQUAL(i.get_values(), expected);
+
+        omi::DoubleAttribute d = omi::DoubleAttribute::convert(i);
+        ARC_CHECK_EQUAL(d.at(3), 100.0);
+    }
+}
+
+} // namespace anonymous
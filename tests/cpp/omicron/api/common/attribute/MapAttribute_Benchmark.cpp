@@ -0,0 +1,338 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.MapAttribute)
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/attribute/FloatAttribute.hpp>
+#include <omicron/api/common/attribute/MapAttribute.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of bytes currently allocated through CountingAllocators
+std::size_t g_allocated_bytes = 0;
+
+// allocator which keeps track of the number of bytes allocated through it
+template<typename T_Value>
+struct CountingAllocator
+{
+    typedef T_Value value_type;
+
+    CountingAllocator()
+    {
+    }
+
+    template<typename T_Other>
+    CountingAllocator(const CountingAllocator<T_Other>&)
+    {
+    }
+
+    T_Value* allocate(std::size_t n)
+    {
+        g_allocated_bytes += n * sizeof(T_Value);
+        return static_cast<T_Value*>(::operator new(n * sizeof(T_Value)));
+    }
+
+    void deallocate(T_Value* ptr, std::size_t n)
+    {
+        g_allocated_bytes -= n * sizeof(T_Value);
+        ::operator delete(ptr);
+    }
+
+    template<typename T_Other>
+    bool operator==(const CountingAllocator<T_Other>&) const
+    {
+        return true;
+    }
+
+    template<typename T_Other>
+    bool operator!=(const CountingAllocator<T_Other>&) const
+    {
+        return false;
+    }
+};
+
+// the container MapAttributes used before omi::AttributeMap
+typedef std::unordered_map<
+    arc::str::UTF8String,
+    omi::Attribute,
+    std::hash<arc::str::UTF8String>,
+    std::equal_to<arc::str::UTF8String>,
+    CountingAllocator<std::pair<const arc::str::UTF8String, omi::Attribute>>
+> UnorderedMap;
+
+// builds a tree of maps with the given fan out and depth, appending its leaves
+// to the given vector
+omi::MapAttribute build_tree(
+        std::size_t fan_out,
+        std::size_t depth,
+        std::vector<omi::FloatAttribute>& leaves)
+{
+    omi::MapAttribute map(false);
+    for(std::size_t i = 0; i < fan_out; ++i)
+    {
+        arc::str::UTF8String name;
+        name << "child_" << i;
+        if(depth == 1)
+        {
+            omi::FloatAttribute leaf(static_cast<float>(i), false);
+            map.insert(name, leaf);
+            leaves.push_back(leaf);
+        }
+        else
+        {
+            map.insert(name, build_tree(fan_out, depth - 1, leaves));
+        }
+    }
+    return map;
+}
+
+//------------------------------------------------------------------------------
+//                                    ENTRIES
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(entries)
+{
+    // the number of maps built for each size
+    static const std::size_t kMapCount = 10000;
+    static const std::size_t kSizes[] = {1, 2, 4, 8, 16, 64};
+
+    std::vector<arc::str::UTF8String> names;
+    std::vector<std::size_t> hashes;
+    for(std::size_t i = 0; i < 64; ++i)
+    {
+        arc::str::UTF8String name;
+        name << "attribute_" << i;
+        names.push_back(name);
+        hashes.push_back(omi::AttributeMap::hasher()(name));
+    }
+    omi::FloatAttribute value(1.0F);
+
+    for(std::size_t size : kSizes)
+    {
+        // omi::AttributeMap
+        std::vector<omi::AttributeMap> maps(kMapCount);
+        omi_bench::Timer timer;
+        for(omi::AttributeMap& map : maps)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                map[names[i]] = value;
+            }
+        }
+        double map_build_time = timer.get_nanoseconds(kMapCount);
+
+        std::size_t found = 0;
+        timer.restart();
+        for(const omi::AttributeMap& map : maps)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                found += map.find(names[i]) != map.end();
+            }
+        }
+        double map_find_time = timer.get_nanoseconds(kMapCount * size);
+
+        // lookups using the hashes of the names, as symbols do
+        timer.restart();
+        for(const omi::AttributeMap& map : maps)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                found += map.find(hashes[i], names[i]) != map.end();
+            }
+        }
+        double map_hashed_find_time = timer.get_nanoseconds(kMapCount * size);
+        std::size_t map_bytes = maps[0].get_memory_usage();
+        maps.clear();
+
+        // std::unordered_map
+        std::size_t allocated_before = g_allocated_bytes;
+        std::vector<UnorderedMap> unordered_maps(kMapCount);
+        timer.restart();
+        for(UnorderedMap& map : unordered_maps)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                map[names[i]] = value;
+            }
+        }
+        double unordered_build_time = timer.get_nanoseconds(kMapCount);
+
+        timer.restart();
+        for(const UnorderedMap& map : unordered_maps)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                found += map.find(names[i]) != map.end();
+            }
+        }
+        double unordered_find_time = timer.get_nanoseconds(kMapCount * size);
+        std::size_t unordered_bytes =
+            sizeof(UnorderedMap) +
+            (g_allocated_bytes - allocated_before) / kMapCount;
+        unordered_maps.clear();
+
+        ARC_CHECK_EQUAL(found, kMapCount * size * 3);
+
+        arc::str::UTF8String message;
+        message << "Maps of " << size << " entries - AttributeMap: "
+                << map_bytes << " bytes, build: " << map_build_time
+                << "ns, find: " << map_find_time << "ns ("
+                << map_hashed_find_time << "ns hashed); "
+                << "std::unordered_map: " << unordered_bytes
+                << " bytes, build: " << unordered_build_time << "ns, find: "
+                << unordered_find_time << "ns";
+        ARC_TEST_MESSAGE(message);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                      HASH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(hash)
+{
+    // a tree of 100 groups each with 100 leaves
+    static const std::size_t kGroupCount = 100;
+    static const std::size_t kLeafCount = 100;
+    static const std::size_t kIterations = 1000;
+
+    omi::MapAttribute root(false);
+    std::vector<omi::FloatAttribute> leaves;
+    for(std::size_t i = 0; i < kGroupCount; ++i)
+    {
+        omi::MapAttribute group(false);
+        for(std::size_t j = 0; j < kLeafCount; ++j)
+        {
+            arc::str::UTF8String name;
+            name << "leaf_" << j;
+            omi::FloatAttribute leaf(static_cast<float>(j), false);
+            group.insert(name, leaf);
+            leaves.push_back(leaf);
+        }
+        arc::str::UTF8String name;
+        name << "group_" << i;
+        root.insert(name, group);
+    }
+
+    omi_bench::Timer timer;
+    omi::Hash hash = root.get_hash();
+    double full_time = timer.get_milliseconds();
+
+    timer.restart();
+    for(std::size_t i = 0; i < kIterations; ++i)
+    {
+        omi::FloatAttribute& leaf = leaves[(i * 7919) % leaves.size()];
+        leaf.set_value(leaf.get_value() + 1.0F);
+        ARC_CHECK_NOT_EQUAL(root.get_hash(), hash);
+        leaf.set_value(leaf.get_value() - 1.0F);
+        ARC_CHECK_EQUAL(root.get_hash(), hash);
+    }
+    double incremental_time =
+        timer.get_milliseconds() / static_cast<double>(kIterations * 2);
+
+    arc::str::UTF8String message;
+    message << "Hash of " << (kGroupCount * kLeafCount) << " leaves - full: "
+            << full_time << "ms, after modifying one leaf: "
+            << incremental_time << "ms";
+    ARC_TEST_MESSAGE(message);
+}
+
+ARC_TEST_UNIT(hash_depth)
+{
+    static const std::size_t kFanOut = 10;
+    static const std::size_t kMaxDepth = 5;
+    static const std::size_t kIterations = 1000;
+
+    for(std::size_t depth = 1; depth <= kMaxDepth; ++depth)
+    {
+        std::vector<omi::FloatAttribute> leaves;
+        omi::MapAttribute root = build_tree(kFanOut, depth, leaves);
+
+        omi_bench::Timer timer;
+        omi::Hash hash = root.get_hash();
+        double full_time = timer.get_milliseconds();
+
+        timer.restart();
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            omi::FloatAttribute& leaf = leaves[(i * 7919) % leaves.size()];
+            leaf.set_value(leaf.get_value() + 1.0F);
+            ARC_CHECK_NOT_EQUAL(root.get_hash(), hash);
+            leaf.set_value(leaf.get_value() - 1.0F);
+            ARC_CHECK_EQUAL(root.get_hash(), hash);
+        }
+        double incremental_time = timer.get_nanoseconds(kIterations * 2);
+
+        arc::str::UTF8String message;
+        message << "Hash of depth " << depth << " (" << leaves.size()
+                << " leaves) - full: " << full_time
+                << "ms, after modifying one leaf: " << incremental_time
+                << "ns";
+        ARC_TEST_MESSAGE(message);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                      COPY
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(copy)
+{
+    static const std::size_t kSizes[] = {100, 1000, 10000, 100000};
+    static const std::size_t kIterations = 1000;
+
+    for(std::size_t size : kSizes)
+    {
+        std::vector<arc::str::UTF8String> names;
+        omi::MapAttribute map(false);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            arc::str::UTF8String name;
+            name << "attribute_" << i;
+            map.insert(name, omi::FloatAttribute(static_cast<float>(i)));
+            names.push_back(name);
+        }
+        omi::FloatAttribute value(-1.0F);
+
+        // keep the copies alive so their destruction isn't timed
+        std::vector<omi::MapAttribute> copies;
+        copies.reserve(kIterations * 2);
+
+        omi_bench::Timer timer;
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            copies.push_back(map.copy_with(names[(i * 7919) % size], value));
+        }
+        double with_time = timer.get_nanoseconds(kIterations);
+
+        timer.restart();
+        for(std::size_t i = 0; i < kIterations; ++i)
+        {
+            copies.push_back(map.copy_without(names[(i * 7919) % size]));
+        }
+        double without_time = timer.get_nanoseconds(kIterations);
+
+        ARC_CHECK_EQUAL(copies.back().get_size(), size - 1);
+
+        arc::str::UTF8String message;
+        message << "Maps of " << size << " entries - copy_with: "
+                << with_time << "ns, copy_without: " << without_time << "ns";
+        ARC_TEST_MESSAGE(message);
+    }
+}
+
+} // namespace anonymous
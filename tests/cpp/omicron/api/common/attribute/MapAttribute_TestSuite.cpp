@@ -3,7 +3,12 @@
 ARC_TEST_MODULE(omi.api.common.MapAttribute)
 
 #include <cassert>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include <omicron/api/common/attribute/ArrayAttribute.hpp>
 #include <omicron/api/common/attribute/ByteAttribute.hpp>
 #include <omicron/api/common/attribute/DoubleAttribute.hpp>
 #include <omicron/api/common/attribute/FloatAttribute.hpp>
@@ -1082,6 +1087,182 @@ ARC_TEST_UNIT(hash)
     }
 }
 
+//------------------------------------------------------------------------------
+//                                INCREMENTAL HASH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(incremental_hash)
+{
+    ARC_TEST_MESSAGE("Checking nested modifications");
+    {
+        omi::MapAttribute::DataType leaf_data = {
+            {"value", omi::FloatAttribute(1.0F, false)},
+            {"other", omi::Int32Attribute(4)}
+        };
+        omi::ArrayAttribute::DataType array_data = {
+            omi::Int32Attribute(3, false)
+        };
+        omi::MapAttribute::DataType group_data = {
+            {"leaf", omi::MapAttribute(leaf_data, false)},
+            {"array", omi::ArrayAttribute(array_data, false)}
+        };
+        omi::MapAttribute a(group_data, false);
+        omi::Hash hash1 = a.get_hash();
+
+        omi::FloatAttribute value = a["leaf.value"];
+        value.set_value(2.0F);
+        omi::Hash hash2 = a.get_hash();
+        ARC_CHECK_NOT_EQUAL(hash1, hash2);
+        // modify again without hashing in between
+        value.set_value(5.0F);
+        value.set_value(1.0F);
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+
+        // matches a map built from scratch
+        omi::MapAttribute::DataType leaf_data2 = {
+            {"value", omi::FloatAttribute(2.0F)},
+            {"other", omi::Int32Attribute(4)}
+        };
+        omi::MapAttribute::DataType group_data2 = {
+            {"leaf", omi::MapAttribute(leaf_data2)},
+            {"array", omi::ArrayAttribute(array_data)}
+        };
+        value.set_value(2.0F);
+        omi::MapAttribute b(group_data2);
+        ARC_CHECK_EQUAL(a.get_hash(), b.get_hash());
+        ARC_CHECK_EQUAL(a.get_hash(), hash2);
+
+        omi::ArrayAttribute array = a["array"];
+        omi::Int32Attribute element = array[0];
+        element.set_value(7);
+        ARC_CHECK_NOT_EQUAL(a.get_hash(), hash2);
+        element.set_value(3);
+        ARC_CHECK_EQUAL(a.get_hash(), hash2);
+    }
+
+    ARC_TEST_MESSAGE("Checking reassigned entries");
+    {
+        omi::MapAttribute::DataType group_data = {
+            {"first", omi::FloatAttribute(1.0F, false)},
+            {"second", omi::FloatAttribute(2.0F, false)}
+        };
+        omi::MapAttribute a(group_data, false);
+        omi::Hash hash1 = a.get_hash();
+
+        a.get("first") = omi::FloatAttribute(3.0F);
+        ARC_CHECK_NOT_EQUAL(a.get_hash(), hash1);
+        a.get("first") = omi::FloatAttribute(1.0F);
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+
+        // modifying the new value through another handle
+        omi::FloatAttribute value(1.0F, false);
+        a.get("first") = value;
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+        value.set_value(6.0F);
+        omi::Hash hash2 = a.get_hash();
+        ARC_CHECK_NOT_EQUAL(hash2, hash1);
+        value.set_value(1.0F);
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+    }
+
+    ARC_TEST_MESSAGE("Checking entries shared between maps");
+    {
+        omi::FloatAttribute shared(1.0F, false);
+        omi::MapAttribute::DataType data = {{"shared", shared}};
+        omi::MapAttribute a(data, false);
+        omi::MapAttribute b(data, false);
+        omi::Hash hash1 = a.get_hash();
+        ARC_CHECK_EQUAL(b.get_hash(), hash1);
+
+        shared.set_value(2.0F);
+        ARC_CHECK_NOT_EQUAL(a.get_hash(), hash1);
+        ARC_CHECK_EQUAL(a.get_hash(), b.get_hash());
+    }
+
+    ARC_TEST_MESSAGE("Checking entries shared with copies");
+    {
+        omi::FloatAttribute shared(1.0F, false);
+        omi::MapAttribute::DataType data = {
+            {"shared", shared},
+            {"other", omi::Int32Attribute(2)}
+        };
+        omi::MapAttribute a(data, false);
+        omi::Hash hash1 = a.get_hash();
+
+        omi::MapAttribute b = a.copy_with("other", omi::Int32Attribute(3));
+        omi::MapAttribute c = a.copy_without("other");
+        omi::MapAttribute d = a.as_mutable();
+        d.insert("other", omi::Int32Attribute(4));
+        omi::Hash hash_b = b.get_hash();
+        omi::Hash hash_c = c.get_hash();
+        omi::Hash hash_d = d.get_hash();
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+
+        shared.set_value(2.0F);
+        ARC_CHECK_NOT_EQUAL(a.get_hash(), hash1);
+        ARC_CHECK_NOT_EQUAL(b.get_hash(), hash_b);
+        ARC_CHECK_NOT_EQUAL(c.get_hash(), hash_c);
+        ARC_CHECK_NOT_EQUAL(d.get_hash(), hash_d);
+
+        omi::MapAttribute::DataType data2 = {
+            {"shared", omi::FloatAttribute(2.0F)},
+            {"other", omi::Int32Attribute(3)}
+        };
+        ARC_CHECK_EQUAL(b.get_hash(), omi::MapAttribute(data2).get_hash());
+
+        shared.set_value(1.0F);
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+        ARC_CHECK_EQUAL(b.get_hash(), hash_b);
+        ARC_CHECK_EQUAL(c.get_hash(), hash_c);
+        ARC_CHECK_EQUAL(d.get_hash(), hash_d);
+    }
+
+    ARC_TEST_MESSAGE("Checking elements shared with array copies");
+    {
+        omi::Int32Attribute shared(1, false);
+        omi::ArrayAttribute::DataType data = {shared, omi::Int32Attribute(2)};
+        omi::ArrayAttribute a(data, false);
+        omi::Hash hash1 = a.get_hash();
+
+        omi::ArrayAttribute b = a.copy_with(1, omi::Int32Attribute(3));
+        omi::ArrayAttribute c = a.copy_with_appended(omi::Int32Attribute(4));
+        omi::Hash hash_b = b.get_hash();
+        omi::Hash hash_c = c.get_hash();
+
+        shared.set_value(5);
+        ARC_CHECK_NOT_EQUAL(a.get_hash(), hash1);
+        ARC_CHECK_NOT_EQUAL(b.get_hash(), hash_b);
+        ARC_CHECK_NOT_EQUAL(c.get_hash(), hash_c);
+        shared.set_value(1);
+        ARC_CHECK_EQUAL(a.get_hash(), hash1);
+        ARC_CHECK_EQUAL(b.get_hash(), hash_b);
+        ARC_CHECK_EQUAL(c.get_hash(), hash_c);
+    }
+
+    ARC_TEST_MESSAGE("Checking entry order and names");
+    {
+        omi::MapAttribute a(false);
+        omi::MapAttribute b(false);
+        for(int i = 0; i < 64; ++i)
+        {
+            arc::str::UTF8String name;
+            name << "entry_" << i;
+            a.insert(name, omi::Int32Attribute(i));
+            name = "";
+            name << "entry_" << (63 - i);
+            b.insert(name, omi::Int32Attribute(63 - i));
+        }
+        ARC_CHECK_EQUAL(a.get_hash(), b.get_hash());
+
+        omi::MapAttribute::DataType data1 = {{"x", omi::Int32Attribute(1)}};
+        omi::MapAttribute::DataType data2 = {{"y", omi::Int32Attribute(1)}};
+        ARC_CHECK_NOT_EQUAL(
+            omi::MapAttribute(data1).get_hash(),
+            omi::MapAttribute(data2).get_hash()
+        );
+    }
+}
+
 //------------------------------------------------------------------------------
 //                                 PURE IMMUTABLE
 //------------------------------------------------------------------------------
@@ -1406,6 +1587,147 @@ ARC_TEST_UNIT_FIXTURE(get, MapAttributeFixture)
     );
 }
 
+//------------------------------------------------------------------------------
+//                                  SYMBOL PATH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(symbol_path)
+{
+    ARC_TEST_MESSAGE("Checking symbols");
+    {
+        omi::Symbol a("positions");
+        omi::Symbol b(arc::str::UTF8String("posi") + "tions");
+        omi::Symbol c("normals");
+        ARC_CHECK_EQUAL(a, b);
+        ARC_CHECK_NOT_EQUAL(a, c);
+        ARC_CHECK_EQUAL(a.get_id(), b.get_id());
+        ARC_CHECK_EQUAL(a.get_string(), "positions");
+        ARC_CHECK_EQUAL(omi::Symbol().get_id(), 0);
+        ARC_CHECK_EQUAL(omi::Symbol("").get_id(), 0);
+
+        std::size_t count = omi::Symbol::get_count();
+        omi::Symbol d("positions");
+        ARC_CHECK_EQUAL(omi::Symbol::get_count(), count);
+    }
+
+    ARC_TEST_MESSAGE("Checking paths");
+    {
+        omi::SymbolPath path("geometry.vertex.positions");
+        ARC_CHECK_EQUAL(path.get_symbols().size(), 3);
+        ARC_CHECK_EQUAL(path.get_symbols()[1], omi::Symbol("vertex"));
+        ARC_CHECK_EQUAL(path.get_name(), "geometry.vertex.positions");
+        ARC_CHECK_EQUAL(omi::SymbolPath("single").get_symbols().size(), 1);
+    }
+
+    ARC_TEST_MESSAGE("Checking lookups");
+    {
+        omi::MapAttribute::DataType vertex_data = {
+            {"positions", omi::FloatAttribute({1.0F, 2.0F, 3.0F}, 3, false)}
+        };
+        omi::MapAttribute::DataType geometry_data = {
+            {"vertex", omi::MapAttribute(vertex_data)},
+            {"count", omi::Int32Attribute(1)}
+        };
+        omi::MapAttribute::DataType root_data = {
+            {"geometry", omi::MapAttribute(geometry_data)}
+        };
+        omi::MapAttribute a(root_data, false);
+
+        omi::SymbolPath positions("geometry.vertex.positions");
+        omi::SymbolPath count("geometry.count");
+        omi::SymbolPath missing("geometry.normals");
+        omi::SymbolPath not_map("geometry.count.value");
+        ARC_CHECK_TRUE(a.has(positions));
+        ARC_CHECK_TRUE(a.has(count));
+        ARC_CHECK_FALSE(a.has(missing));
+        ARC_CHECK_FALSE(a.has(not_map));
+        ARC_CHECK_EQUAL(a.get(positions), a.get("geometry.vertex.positions"));
+        ARC_CHECK_EQUAL(omi::Int32Attribute(a[count]).get_value(), 1);
+        ARC_CHECK_THROW(a.get(missing), arc::ex::KeyError);
+        ARC_CHECK_THROW(a.get(not_map), arc::ex::KeyError);
+
+        // the index is updated when the map changes
+        omi::SymbolPath added("added");
+        ARC_CHECK_FALSE(a.has(added));
+        a.insert("added", omi::Int32Attribute(4));
+        ARC_CHECK_TRUE(a.has(added));
+        a.insert("added", omi::Int32Attribute(5));
+        ARC_CHECK_EQUAL(omi::Int32Attribute(a[added]).get_value(), 5);
+        a.erase("geometry");
+        ARC_CHECK_FALSE(a.has(positions));
+        ARC_CHECK_TRUE(a.has(added));
+        a.set_values(root_data);
+        ARC_CHECK_TRUE(a.has(positions));
+        ARC_CHECK_FALSE(a.has(added));
+        a.insert("added", omi::Int32Attribute(6));
+        a.set_values(root_data.begin(), root_data.end());
+        ARC_CHECK_TRUE(a.has(positions));
+        ARC_CHECK_FALSE(a.has(added));
+        a.clear();
+        ARC_CHECK_FALSE(a.has(positions));
+        ARC_CHECK_THROW(
+            omi::MapAttribute(omi::Attribute()).has(added),
+            arc::ex::StateError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking lookups after setting values from iterators");
+    {
+        omi::MapAttribute a(false);
+        a.insert("a", omi::Int32Attribute(1));
+        ARC_CHECK_TRUE(a.has(omi::SymbolPath("a")));
+
+        omi::MapAttribute::DataType d = {{"b", omi::Int32Attribute(2)}};
+        a.set_values(d.begin(), d.end());
+        ARC_CHECK_FALSE(a.has(omi::SymbolPath("a")));
+        ARC_CHECK_TRUE(a.has(omi::SymbolPath("b")));
+        ARC_CHECK_EQUAL(
+            omi::Int32Attribute(a[omi::SymbolPath("b")]).get_value(),
+            2
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking concurrent lookups");
+    {
+        omi::MapAttribute a(false);
+        for(int i = 0; i < 64; ++i)
+        {
+            arc::str::UTF8String name;
+            name << "entry_" << i;
+            a.insert(name, omi::Int32Attribute(i));
+        }
+        const omi::MapAttribute& shared = a;
+
+        std::vector<int> found(4, 0);
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < found.size(); ++t)
+        {
+            threads.emplace_back([&shared, &found, t]()
+            {
+                omi::Symbol empty;
+                for(int i = 0; i < 64; ++i)
+                {
+                    arc::str::UTF8String name;
+                    name << "entry_" << i;
+                    if(shared.has(omi::SymbolPath(name)) &&
+                       !shared.has(omi::SymbolPath(empty)))
+                    {
+                        ++found[t];
+                    }
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        for(int count : found)
+        {
+            ARC_CHECK_EQUAL(count, 64);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 //                                     INSERT
 //------------------------------------------------------------------------------
@@ -1471,6 +1793,15 @@ ARC_TEST_UNIT_FIXTURE(insert, MapAttributeFixture)
     a.insert("map_key.map_key.string_key", str_attr);
     ARC_CHECK_TRUE(a.has("map_key.map_key.string_key"));
     ARC_CHECK_EQUAL(a.get("map_key.map_key.string_key"), str_attr);
+
+    ARC_TEST_MESSAGE("Checking insert keeps the entries of shared storage");
+    omi::MapAttribute b(map_data1);
+    omi::MapAttribute c = b.as_mutable();
+    c.insert("int64_key", omi::Int64Attribute(12));
+    ARC_CHECK_EQUAL(c.get_size(), map_data1.size() + 1);
+    ARC_CHECK_EQUAL(c.get("byte_key"), map_data1["byte_key"]);
+    ARC_CHECK_EQUAL(b.get_size(), map_data1.size());
+    ARC_CHECK_FALSE(b.has("int64_key"));
 }
 
 //------------------------------------------------------------------------------
@@ -1771,4 +2102,147 @@ ARC_TEST_UNIT(as_mutable)
     }
 }
 
+//------------------------------------------------------------------------------
+//                                    BUILDER
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT_FIXTURE(builder, MapAttributeFixture)
+{
+    omi::MapAttribute::DataType map_data = {
+        {"int32_key", omi::Int32Attribute({1, 5, -8, 4}, 2, true)},
+        {"byte_key", omi::ByteAttribute({'x', 'y'}, 0, true)},
+        {"int16_key", omi::Int16Attribute({1, 5, -8, 4}, 4, true)}
+    };
+
+    ARC_TEST_MESSAGE("Checking empty builder");
+    omi::MapAttribute::Builder builder;
+    ARC_CHECK_EQUAL(builder.get_size(), 0);
+    omi::MapAttribute a = builder.build();
+    ARC_CHECK_TRUE(a.is_valid());
+    ARC_CHECK_TRUE(a.is_empty());
+    ARC_CHECK_TRUE(a.is_immutable());
+
+    ARC_TEST_MESSAGE("Checking insert and erase");
+    builder
+        .insert("int32_key", map_data["int32_key"])
+        .insert("byte_key", omi::ByteAttribute('z'))
+        .insert("int16_key", map_data["int16_key"])
+        .insert("string_key", omi::StringAttribute("Hello world"));
+    builder.insert("byte_key", map_data["byte_key"]);
+    ARC_CHECK_EQUAL(builder.get_size(), 4);
+    ARC_CHECK_TRUE(builder.has("string_key"));
+    builder.erase("string_key");
+    ARC_CHECK_FALSE(builder.has("string_key"));
+    ARC_CHECK_THROW(builder.erase("string_key"), arc::ex::KeyError);
+
+    ARC_TEST_MESSAGE("Checking build");
+    omi::MapAttribute b = builder.build(false);
+    ARC_CHECK_EQUAL(builder.get_size(), 0);
+    ARC_CHECK_FALSE(b.is_immutable());
+    ARC_CHECK_TRUE(fixture->compare_maps(b.get_values(), map_data));
+    ARC_CHECK_EQUAL(b, omi::MapAttribute(map_data));
+    ARC_CHECK_EQUAL(b.get_hash(), omi::MapAttribute(map_data).get_hash());
+
+    ARC_TEST_MESSAGE("Checking builder from existing map");
+    omi::MapAttribute::Builder from_b(b);
+    from_b.insert("string_key", omi::StringAttribute("Hello world"));
+    omi::MapAttribute c = from_b.build();
+    ARC_CHECK_EQUAL(c.get_size(), 4);
+    ARC_CHECK_EQUAL(b.get_size(), 3);
+    ARC_CHECK_TRUE(c.is_immutable());
+    ARC_CHECK_EQUAL(c.get("int32_key"), b.get("int32_key"));
+
+    ARC_TEST_MESSAGE("Checking large builds");
+    for(std::size_t i = 0; i < 100; ++i)
+    {
+        arc::str::UTF8String name;
+        name << "key_" << i;
+        builder.insert(name, omi::Int32Attribute(static_cast<arc::int32>(i)));
+    }
+    omi::MapAttribute d = builder.build();
+    ARC_CHECK_EQUAL(d.get_size(), 100);
+    ARC_CHECK_EQUAL(omi::Int32Attribute(d["key_42"]).get_value(), 42);
+}
+
+//------------------------------------------------------------------------------
+//                                   PERSISTENT
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(copy_updates)
+{
+    omi::MapAttribute::DataType map_data1 = {
+        {"byte_key", omi::ByteAttribute('x')},
+        {"int64_key", omi::Int64Attribute(4758257078353)}
+    };
+
+    omi::MapAttribute::DataType map_data2 = {
+        {"int32_key", omi::Int32Attribute({1, 5, -8, 4}, 2, true)},
+        {"map_key", omi::MapAttribute(map_data1, true)},
+        {"int16_key", omi::Int16Attribute({1, 5, -8, 4}, 4, true)}
+    };
+
+    omi::MapAttribute a(map_data2);
+    omi::Hash hash = a.get_hash();
+    omi::StringAttribute str_attr("Hello world");
+
+    ARC_TEST_MESSAGE("Checking copy_with");
+    omi::MapAttribute b = a.copy_with("string_key", str_attr);
+    ARC_CHECK_TRUE(b.is_immutable());
+    ARC_CHECK_EQUAL(b.get_size(), 4);
+    ARC_CHECK_EQUAL(b.get("string_key"), str_attr);
+    ARC_CHECK_FALSE(a.has("string_key"));
+    ARC_CHECK_EQUAL(a.get_hash(), hash);
+    ARC_CHECK_NOT_EQUAL(b.get_hash(), hash);
+    // the unchanged entries are shared
+    ARC_CHECK_EQUAL(
+        omi::Int32Attribute(b["int32_key"]).get_values().data(),
+        omi::Int32Attribute(a["int32_key"]).get_values().data()
+    );
+
+    omi::MapAttribute c = a.copy_with("int32_key", omi::Int32Attribute(7));
+    ARC_CHECK_EQUAL(c.get_size(), 3);
+    ARC_CHECK_EQUAL(omi::Int32Attribute(c["int32_key"]).get_value(), 7);
+    ARC_CHECK_EQUAL(omi::Int32Attribute(a["int32_key"]).get_size(), 4);
+
+    ARC_TEST_MESSAGE("Checking nested copy_with");
+    omi::MapAttribute d = a.copy_with("map_key.string_key", str_attr);
+    ARC_CHECK_TRUE(d.has("map_key.string_key"));
+    ARC_CHECK_TRUE(d["map_key"].is_immutable());
+    ARC_CHECK_FALSE(a.has("map_key.string_key"));
+    ARC_CHECK_EQUAL(a.get_hash(), hash);
+    ARC_CHECK_EQUAL(d.get("map_key.byte_key"), a.get("map_key.byte_key"));
+    ARC_CHECK_THROW(
+        a.copy_with("none.string_key", str_attr),
+        arc::ex::KeyError
+    );
+    ARC_CHECK_THROW(
+        a.copy_with("int32_key.string_key", str_attr),
+        arc::ex::KeyError
+    );
+
+    ARC_TEST_MESSAGE("Checking copy_without");
+    omi::MapAttribute e = a.copy_without("int16_key");
+    ARC_CHECK_EQUAL(e.get_size(), 2);
+    ARC_CHECK_FALSE(e.has("int16_key"));
+    ARC_CHECK_TRUE(a.has("int16_key"));
+    omi::MapAttribute f = a.copy_without("map_key.byte_key");
+    ARC_CHECK_FALSE(f.has("map_key.byte_key"));
+    ARC_CHECK_TRUE(f.has("map_key.int64_key"));
+    ARC_CHECK_TRUE(a.has("map_key.byte_key"));
+    ARC_CHECK_EQUAL(a.get_hash(), hash);
+    ARC_CHECK_THROW(a.copy_without("none"), arc::ex::KeyError);
+    ARC_CHECK_THROW(a.copy_without("map_key.none"), arc::ex::KeyError);
+
+    ARC_TEST_MESSAGE("Checking round trip");
+    ARC_CHECK_EQUAL(b.copy_without("string_key"), a);
+    ARC_CHECK_EQUAL(b.copy_without("string_key").get_hash(), hash);
+
+    ARC_TEST_MESSAGE("Checking mutable maps");
+    omi::MapAttribute g(map_data1, false);
+    omi::MapAttribute h = g.copy_with("string_key", str_attr);
+    ARC_CHECK_FALSE(h.is_immutable());
+    h.erase("byte_key");
+    ARC_CHECK_TRUE(g.has("byte_key"));
+}
+
 } // namespace anonymous
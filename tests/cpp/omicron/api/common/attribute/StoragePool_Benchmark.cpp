@@ -0,0 +1,134 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.StoragePool)
+
+#include <new>
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/attribute/FloatAttribute.hpp>
+#include <omicron/api/common/attribute/MapAttribute.hpp>
+#include <omicron/api/common/attribute/StoragePool.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of entries in the benchmark attribute tree
+static const std::size_t kTreeEntries = 25000;
+
+// the size of an attribute definition
+static const std::size_t kDefinitionSize = 32;
+
+// the sizes of the pooled allocations made for each entry of the benchmark
+// attribute tree: a definition and storage for the entry's map and for the
+// float within it
+static const std::size_t kEntrySizes[] =
+{
+    kDefinitionSize,
+    sizeof(omi::MapAttribute::MapStorage),
+    kDefinitionSize,
+    sizeof(omi::FloatAttribute::FloatStorage)
+};
+static const std::size_t kEntrySizeCount =
+    sizeof(kEntrySizes) / sizeof(std::size_t);
+
+// makes the pooled allocations of the benchmark attribute tree using the given
+// functions and then deallocates them in the same order (as the tree is
+// destroyed)
+template<typename T_Allocate, typename T_Deallocate>
+double benchmark_tree_allocations(
+        T_Allocate allocate,
+        T_Deallocate deallocate)
+{
+    std::vector<void*> nodes(kTreeEntries * kEntrySizeCount);
+    omi_bench::Timer timer;
+    for(std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i] = allocate(kEntrySizes[i % kEntrySizeCount]);
+    }
+    for(std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        deallocate(nodes[i], kEntrySizes[i % kEntrySizeCount]);
+    }
+    return timer.get_milliseconds();
+}
+
+// the benchmark tree's allocations using the global allocator
+double benchmark_global_allocator()
+{
+    return benchmark_tree_allocations(
+        [](std::size_t size)
+        {
+            return ::operator new(size);
+        },
+        [](void* ptr, std::size_t)
+        {
+            ::operator delete(ptr);
+        }
+    );
+}
+
+// the benchmark tree's allocations using the pool
+double benchmark_pool()
+{
+    return benchmark_tree_allocations(
+        [](std::size_t size)
+        {
+            return omi::StoragePool::allocate(size);
+        },
+        [](void* ptr, std::size_t size)
+        {
+            omi::StoragePool::deallocate(ptr, size);
+        }
+    );
+}
+
+// builds and destroys the benchmark attribute tree
+double benchmark_attribute_tree()
+{
+    omi_bench::Timer timer;
+    {
+        omi::MapAttribute root(false);
+        for(std::size_t i = 0; i < kTreeEntries; ++i)
+        {
+            arc::str::UTF8String name;
+            name << "node_" << i;
+            omi::MapAttribute::DataType data =
+            {
+                {"positions", omi::FloatAttribute(1.0F)}
+            };
+            root.insert(name, omi::MapAttribute(data));
+        }
+    }
+    return timer.get_milliseconds();
+}
+
+//------------------------------------------------------------------------------
+//                                  ALLOCATORS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(allocators)
+{
+    // warm up the pool's free lists
+    benchmark_pool();
+
+    double global_time = benchmark_global_allocator();
+    double pool_time = benchmark_pool();
+    double tree_time = benchmark_attribute_tree();
+
+    arc::str::UTF8String message;
+    message << "Attribute tree of " << kTreeEntries << " entries: "
+            << tree_time << "ms, its storage allocations - global allocator: "
+            << global_time << "ms, pool: " << pool_time << "ms";
+    ARC_TEST_MESSAGE(message);
+}
+
+} // namespace anonymous
@@ -0,0 +1,86 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.common.StoragePool)
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <omicron/api/common/attribute/StoragePool.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   ALLOCATION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(allocation)
+{
+    ARC_TEST_MESSAGE("Checking pooled allocations");
+    {
+        std::vector<void*> blocks;
+        for(std::size_t i = 0; i < 1000; ++i)
+        {
+            std::size_t size = i % (omi::StoragePool::kMaxBlockSize + 1);
+            void* block = omi::StoragePool::allocate(size);
+            ARC_CHECK_TRUE(block != nullptr);
+            // write to the whole block
+            std::fill(
+                static_cast<char*>(block),
+                static_cast<char*>(block) + size,
+                static_cast<char>(i)
+            );
+            blocks.push_back(block);
+        }
+        for(std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            std::size_t size = i % (omi::StoragePool::kMaxBlockSize + 1);
+            if(size > 0)
+            {
+                ARC_CHECK_EQUAL(
+                    static_cast<char*>(blocks[i])[size - 1],
+                    static_cast<char>(i)
+                );
+            }
+            omi::StoragePool::deallocate(blocks[i], size);
+        }
+    }
+
+    ARC_TEST_MESSAGE("Checking blocks are aligned to the granularity");
+    {
+        std::vector<void*> blocks;
+        for(std::size_t i = 0; i < omi::StoragePool::kBlocksPerSlab; ++i)
+        {
+            void* block = omi::StoragePool::allocate(24);
+            ARC_CHECK_EQUAL(
+                reinterpret_cast<std::uintptr_t>(block) %
+                    omi::StoragePool::kGranularity,
+                0
+            );
+            blocks.push_back(block);
+        }
+        for(void* block : blocks)
+        {
+            omi::StoragePool::deallocate(block, 24);
+        }
+    }
+
+    ARC_TEST_MESSAGE("Checking memory is reused");
+    {
+        void* block = omi::StoragePool::allocate(48);
+        omi::StoragePool::deallocate(block, 48);
+        ARC_CHECK_EQUAL(omi::StoragePool::allocate(40), block);
+        omi::StoragePool::deallocate(block, 40);
+    }
+
+    ARC_TEST_MESSAGE("Checking large allocations");
+    {
+        void* block = omi::StoragePool::allocate(4096);
+        ARC_CHECK_TRUE(block != nullptr);
+        omi::StoragePool::deallocate(block, 4096);
+    }
+}
+
+} // namespace anonymous
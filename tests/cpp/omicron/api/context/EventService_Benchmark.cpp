@@ -0,0 +1,175 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.context.EventService)
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/context/EventListener.hpp>
+#include <omicron/api/context/EventService.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of events broadcast by each part of the benchmark
+static const std::size_t kEvents = 1000000;
+// the number of events that are posted between each dispatch
+static const std::size_t kBatchSize = 256;
+
+// sums the positions of the mouse move events it receives, so that the
+// events are used without being recorded
+class SummingListener
+    : public omi::context::EventListener
+{
+public:
+
+    arc::int64 position_sum;
+
+    SummingListener()
+        : position_sum(0)
+    {
+    }
+
+    void subscribe(omi::context::Event::TypeId type_id)
+    {
+        subscribe_to_event(type_id);
+    }
+
+    virtual void on_event(const omi::context::Event& event) override
+    {
+        arc::int32 x = 0;
+        arc::int32 y = 0;
+        if(omi::context::Event::mouse_move(event, x, y))
+        {
+            position_sum += x + y;
+        }
+    }
+};
+
+// returns a mouse move event with fixed-layout data
+omi::context::Event make_mouse_move(arc::int32 x, arc::int32 y)
+{
+    omi::context::Event::Payload payload = {};
+    payload.x = x;
+    payload.y = y;
+    return omi::context::Event(
+        omi::context::Event::kTypeIdMouseMove,
+        payload
+    );
+}
+
+// returns a mouse move event with map data
+omi::context::Event make_mouse_move_map(arc::int32 x, arc::int32 y)
+{
+    omi::Int32Attribute::ArrayType position = {x, y};
+    omi::MapAttribute::DataType data =
+    {
+        {
+            omi::context::Event::kDataMousePosition,
+            omi::Int32Attribute(position)
+        }
+    };
+    return omi::context::Event(
+        omi::context::Event::kTypeMouseMove,
+        omi::MapAttribute(data)
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                   DISPATCH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(dispatch)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+
+    SummingListener listener;
+    listener.subscribe(omi::context::Event::kTypeIdMouseMove);
+
+    // the events as they were constructed and broadcast before they had
+    // fixed-layout data
+    omi_bench::Timer timer;
+    for(std::size_t i = 0; i < kEvents; ++i)
+    {
+        arc::int32 x = static_cast<arc::int32>(i);
+        service.broadcast(make_mouse_move_map(x, -x));
+    }
+    double map_time = timer.get_nanoseconds(kEvents);
+    ARC_CHECK_EQUAL(listener.position_sum, 0);
+
+    timer.restart();
+    for(std::size_t i = 0; i < kEvents; ++i)
+    {
+        arc::int32 x = static_cast<arc::int32>(i);
+        service.broadcast(make_mouse_move(x, 1 - x));
+    }
+    double payload_time = timer.get_nanoseconds(kEvents);
+    ARC_CHECK_EQUAL(
+        listener.position_sum,
+        static_cast<arc::int64>(kEvents)
+    );
+
+    // post the events and dispatch them in frame sized batches, first without
+    // coalescing
+    service.set_coalesce_policy(
+        omi::context::Event::kTypeIdMouseMove,
+        omi::context::EventService::kCoalesceNone
+    );
+    timer.restart();
+    for(std::size_t i = 0; i < kEvents; ++i)
+    {
+        arc::int32 x = static_cast<arc::int32>(i);
+        service.post(make_mouse_move(x, 1 - x));
+        if((i + 1) % kBatchSize == 0)
+        {
+            service.dispatch_queued();
+        }
+    }
+    service.dispatch_queued();
+    double queued_time = timer.get_nanoseconds(kEvents);
+    ARC_CHECK_EQUAL(
+        listener.position_sum,
+        static_cast<arc::int64>(kEvents * 2)
+    );
+
+    service.set_coalesce_policy(
+        omi::context::Event::kTypeIdMouseMove,
+        omi::context::EventService::kCoalesceLatest
+    );
+    timer.restart();
+    for(std::size_t i = 0; i < kEvents; ++i)
+    {
+        arc::int32 x = static_cast<arc::int32>(i);
+        service.post(make_mouse_move(x, 1 - x));
+        if((i + 1) % kBatchSize == 0)
+        {
+            service.dispatch_queued();
+        }
+    }
+    service.dispatch_queued();
+    double coalesced_time = timer.get_nanoseconds(kEvents);
+    // only the last event of each batch is dispatched
+    std::size_t batches =
+        (kEvents + kBatchSize - 1) / kBatchSize;
+    ARC_CHECK_EQUAL(
+        listener.position_sum,
+        static_cast<arc::int64>(kEvents * 2 + batches)
+    );
+
+    arc::str::UTF8String message;
+    message << "Broadcast mouse move - map data: " << map_time
+            << "ns per event, fixed-layout data: " << payload_time
+            << "ns per event, queued: " << queued_time
+            << "ns per event, coalesced: " << coalesced_time << "ns per event";
+    ARC_TEST_MESSAGE(message);
+}
+
+} // namespace anonymous
@@ -0,0 +1,624 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.context.EventService)
+
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/context/EventListener.hpp>
+#include <omicron/api/context/EventService.hpp>
+#include <omicron/api/report/stats/StatsDatabase.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// records the events it receives
+class TestListener
+    : public omi::context::EventListener
+{
+public:
+
+    std::vector<omi::context::Event> events;
+
+    void subscribe(const arc::str::UTF8String& type)
+    {
+        subscribe_to_event(type);
+    }
+
+    void subscribe(omi::context::Event::TypeId type_id)
+    {
+        subscribe_to_event(type_id);
+    }
+
+    void unsubscribe(omi::context::Event::TypeId type_id)
+    {
+        unsubsribe_from_event(type_id);
+    }
+
+    virtual void on_event(const omi::context::Event& event) override
+    {
+        events.push_back(event);
+    }
+};
+
+// records every event it receives, including mouse moves
+class RecordingListener
+    : public omi::context::EventListener
+{
+public:
+
+    std::vector<omi::context::Event> events;
+
+    void subscribe(omi::context::Event::TypeId type_id)
+    {
+        subscribe_to_event(type_id);
+    }
+
+    virtual void on_event(const omi::context::Event& event) override
+    {
+        events.push_back(event);
+    }
+};
+
+// records the order listeners are called in, and changes the subscriptions of
+// other listeners when it receives an event
+class MutatingListener
+    : public omi::context::EventListener
+{
+public:
+
+    arc::int32 id;
+    std::vector<arc::int32>* order;
+    // listener to subscribe to key presses
+    MutatingListener* to_subscribe;
+    // listener to unsubscribe from key presses
+    MutatingListener* to_unsubscribe;
+    // listener to destroy
+    MutatingListener* to_delete;
+
+    MutatingListener(arc::int32 id_, std::vector<arc::int32>* order_)
+        : id            (id_)
+        , order         (order_)
+        , to_subscribe  (nullptr)
+        , to_unsubscribe(nullptr)
+        , to_delete     (nullptr)
+    {
+    }
+
+    void subscribe(arc::int32 priority)
+    {
+        subscribe_to_event(omi::context::Event::kTypeIdKeyPress, priority);
+    }
+
+    void unsubscribe()
+    {
+        unsubsribe_from_event(omi::context::Event::kTypeIdKeyPress);
+    }
+
+    virtual void on_event(const omi::context::Event& event) override
+    {
+        order->push_back(id);
+        if(to_subscribe != nullptr)
+        {
+            to_subscribe->subscribe(0);
+            to_subscribe = nullptr;
+        }
+        if(to_unsubscribe != nullptr)
+        {
+            to_unsubscribe->unsubscribe();
+            to_unsubscribe = nullptr;
+        }
+        if(to_delete != nullptr)
+        {
+            delete to_delete;
+            to_delete = nullptr;
+        }
+    }
+};
+
+// returns the current value of the given event stat
+arc::int64 get_stat(const arc::str::UTF8String& name)
+{
+    omi::Int64Attribute stat =
+        omi::report::StatsDatabase::instance()->get_entry(name);
+    return stat.at(0);
+}
+
+// returns a mouse move event with fixed-layout data
+omi::context::Event make_mouse_move(arc::int32 x, arc::int32 y)
+{
+    omi::context::Event::Payload payload = {};
+    payload.x = x;
+    payload.y = y;
+    return omi::context::Event(
+        omi::context::Event::kTypeIdMouseMove,
+        payload
+    );
+}
+
+// returns a mouse move event with map data
+omi::context::Event make_mouse_move_map(arc::int32 x, arc::int32 y)
+{
+    omi::Int32Attribute::ArrayType position = {x, y};
+    omi::MapAttribute::DataType data =
+    {
+        {
+            omi::context::Event::kDataMousePosition,
+            omi::Int32Attribute(position)
+        }
+    };
+    return omi::context::Event(
+        omi::context::Event::kTypeMouseMove,
+        omi::MapAttribute(data)
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                    TYPE IDS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(type_ids)
+{
+    ARC_TEST_MESSAGE("Checking built-in type ids");
+    ARC_CHECK_EQUAL(
+        omi::context::Event::get_type_id(omi::context::Event::kTypeMouseMove),
+        omi::context::Event::kTypeIdMouseMove
+    );
+    ARC_CHECK_EQUAL(
+        omi::context::Event::get_type_id(omi::context::Event::kTypeKeyRelease),
+        omi::context::Event::kTypeIdKeyRelease
+    );
+    ARC_CHECK_EQUAL(
+        omi::context::Event::get_type_id(
+            omi::context::Event::kTypeEngineShutdown
+        ),
+        omi::context::Event::kTypeIdEngineShutdown
+    );
+
+    ARC_TEST_MESSAGE("Checking custom type ids");
+    omi::context::Event::TypeId custom =
+        omi::context::Event::get_type_id("test_custom");
+    ARC_CHECK_TRUE(custom >= omi::context::Event::kBuiltinTypeCount);
+    ARC_CHECK_EQUAL(omi::context::Event::get_type_id("test_custom"), custom);
+    ARC_CHECK_NOT_EQUAL(
+        omi::context::Event::get_type_id("test_other"),
+        custom
+    );
+
+    omi::context::Event event("test_custom", omi::MapAttribute());
+    ARC_CHECK_EQUAL(event.get_type_id(), custom);
+    ARC_CHECK_EQUAL(event.get_type(), "test_custom");
+    ARC_CHECK_FALSE(event.has_payload());
+}
+
+//------------------------------------------------------------------------------
+//                                    PAYLOAD
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(payload)
+{
+    omi::context::Event event = make_mouse_move(12, -7);
+    ARC_CHECK_TRUE(event.has_payload());
+    ARC_CHECK_EQUAL(event.get_type(), omi::context::Event::kTypeMouseMove);
+
+    arc::int32 x = 0;
+    arc::int32 y = 0;
+    ARC_CHECK_TRUE(omi::context::Event::mouse_move(event, x, y));
+    ARC_CHECK_EQUAL(x, 12);
+    ARC_CHECK_EQUAL(y, -7);
+    ARC_CHECK_FALSE(omi::context::Event::window_move(event, x, y));
+
+    ARC_TEST_MESSAGE("Checking the data built from the payload");
+    ARC_CHECK_EQUAL(event.get_data(), make_mouse_move_map(12, -7).get_data());
+    ARC_CHECK_TRUE(event == make_mouse_move_map(12, -7));
+    ARC_CHECK_TRUE(event != make_mouse_move(12, 7));
+
+    ARC_TEST_MESSAGE("Checking key events");
+    omi::context::Event::Payload payload = {};
+    payload.code = omi::context::Event::kKeyCodeW;
+    payload.modifiers = omi::context::Event::kModifierShift;
+    omi::context::Event key(omi::context::Event::kTypeIdKeyPress, payload);
+    omi::context::Event::KeyCode key_code;
+    omi::context::Event::Modifier modifiers;
+    ARC_CHECK_TRUE(omi::context::Event::key_press(key, key_code, modifiers));
+    ARC_CHECK_EQUAL(key_code, omi::context::Event::kKeyCodeW);
+    ARC_CHECK_EQUAL(modifiers, omi::context::Event::kModifierShift);
+    ARC_CHECK_FALSE(omi::context::Event::key_release(key, key_code));
+
+    ARC_TEST_MESSAGE("Checking payloads of custom types");
+    ARC_CHECK_THROW(
+        omi::context::Event(
+            omi::context::Event::get_type_id("test_custom"),
+            payload
+        ),
+        arc::ex::ValueError
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                   BROADCAST
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(broadcast)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+
+    TestListener listener;
+    listener.subscribe(omi::context::Event::kTypeIdKeyPress);
+    listener.subscribe("test_broadcast");
+
+    omi::context::Event::Payload payload = {};
+    payload.code = omi::context::Event::kKeyCodeA;
+    service.broadcast(
+        omi::context::Event(omi::context::Event::kTypeIdKeyRelease, payload)
+    );
+    service.broadcast(
+        omi::context::Event(omi::context::Event::kTypeIdKeyPress, payload)
+    );
+    service.broadcast(
+        omi::context::Event("test_broadcast", omi::MapAttribute())
+    );
+    service.broadcast(
+        omi::context::Event("test_unheard", omi::MapAttribute())
+    );
+
+    ARC_CHECK_EQUAL(listener.events.size(), 2);
+    ARC_CHECK_EQUAL(
+        listener.events[0].get_type_id(),
+        omi::context::Event::kTypeIdKeyPress
+    );
+    ARC_CHECK_EQUAL(listener.events[1].get_type(), "test_broadcast");
+
+    ARC_TEST_MESSAGE("Checking unsubscribing");
+    listener.unsubscribe(omi::context::Event::kTypeIdKeyPress);
+    service.broadcast(
+        omi::context::Event(omi::context::Event::kTypeIdKeyPress, payload)
+    );
+    ARC_CHECK_EQUAL(listener.events.size(), 2);
+}
+
+//------------------------------------------------------------------------------
+//                                    PRIORITY
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(priority)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+    omi::context::Event key_press(
+        omi::context::Event::kTypeIdKeyPress,
+        omi::context::Event::Payload()
+    );
+
+    std::vector<arc::int32> order;
+    MutatingListener a(0, &order);
+    MutatingListener b(1, &order);
+    MutatingListener c(2, &order);
+    MutatingListener d(3, &order);
+    a.subscribe(0);
+    b.subscribe(10);
+    c.subscribe(-5);
+    d.subscribe(10);
+
+    service.broadcast(key_press);
+    std::vector<arc::int32> expected = {1, 3, 0, 2};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+
+    ARC_TEST_MESSAGE("Checking resubscribing");
+    order.clear();
+    b.unsubscribe();
+    b.subscribe(0);
+    service.broadcast(key_press);
+    expected = {3, 0, 1, 2};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+}
+
+//------------------------------------------------------------------------------
+//                              MUTATION DURING DISPATCH
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(mutation_during_dispatch)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+    omi::context::Event key_press(
+        omi::context::Event::kTypeIdKeyPress,
+        omi::context::Event::Payload()
+    );
+
+    std::vector<arc::int32> order;
+    MutatingListener a(0, &order);
+    MutatingListener b(1, &order);
+    MutatingListener c(2, &order);
+    MutatingListener* d = new MutatingListener(3, &order);
+    MutatingListener e(4, &order);
+    a.subscribe(4);
+    b.subscribe(3);
+    c.subscribe(2);
+    d->subscribe(1);
+
+    ARC_TEST_MESSAGE("Checking unsubscribing a later listener");
+    a.to_unsubscribe = &c;
+    // subscribing during dispatch is deferred
+    a.to_subscribe = &e;
+    // the destroyed listener must not be called
+    b.to_delete = d;
+    service.broadcast(key_press);
+    std::vector<arc::int32> expected = {0, 1};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+
+    ARC_TEST_MESSAGE("Checking the deferred changes were applied");
+    order.clear();
+    service.broadcast(key_press);
+    expected = {0, 1, 4};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+
+    ARC_TEST_MESSAGE("Checking unsubscribing itself");
+    order.clear();
+    b.to_unsubscribe = &b;
+    service.broadcast(key_press);
+    service.broadcast(key_press);
+    expected = {0, 1, 4, 0, 4};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+
+    ARC_TEST_MESSAGE("Checking unsubscribing before a deferred subscription");
+    order.clear();
+    a.to_subscribe = &c;
+    a.to_unsubscribe = &c;
+    service.broadcast(key_press);
+    service.broadcast(key_press);
+    expected = {0, 4, 0, 4};
+    ARC_CHECK_ITER_EQUAL(order, expected);
+}
+
+//------------------------------------------------------------------------------
+//                                     QUEUE
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(queue)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+
+    TestListener listener;
+    listener.subscribe(omi::context::Event::kTypeIdKeyPress);
+
+    omi::context::Event::Payload payload = {};
+    for(arc::int32 i = 0; i < 3; ++i)
+    {
+        payload.code = i;
+        ARC_CHECK_TRUE(service.post(
+            omi::context::Event(omi::context::Event::kTypeIdKeyPress, payload)
+        ));
+    }
+    ARC_CHECK_TRUE(listener.events.empty());
+
+    ARC_TEST_MESSAGE("Checking dispatch");
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 3);
+    ARC_CHECK_EQUAL(listener.events.size(), 3);
+    for(std::size_t i = 0; i < listener.events.size(); ++i)
+    {
+        ARC_CHECK_EQUAL(
+            listener.events[i].get_payload().code,
+            static_cast<arc::int32>(i)
+        );
+    }
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 0);
+
+    ARC_TEST_MESSAGE("Checking events with map data");
+    listener.events.clear();
+    TestListener custom_listener;
+    custom_listener.subscribe(
+        omi::context::Event::get_type_id("test_queue_custom")
+    );
+    omi::MapAttribute::DataType custom_data = {
+        {"value", omi::Int32Attribute(7)}
+    };
+    omi::context::Event custom(
+        "test_queue_custom",
+        omi::MapAttribute(custom_data)
+    );
+    ARC_CHECK_TRUE(service.post(custom));
+    // the data of an event with a payload is built by the copy in the queue
+    omi::context::Event built(omi::context::Event::kTypeIdKeyPress, payload);
+    built.get_data();
+    ARC_CHECK_TRUE(service.post(built));
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 2);
+    ARC_CHECK_EQUAL(custom_listener.events.size(), 1);
+    ARC_CHECK_EQUAL(custom_listener.events[0].get_data(), custom.get_data());
+    ARC_CHECK_EQUAL(listener.events.size(), 1);
+    ARC_CHECK_EQUAL(listener.events[0].get_data(), built.get_data());
+
+    ARC_TEST_MESSAGE("Checking a full queue");
+    // fill the queue over multiple laps of the buffer
+    std::size_t capacity = omi::context::EventService::kQueueCapacity;
+    for(std::size_t lap = 0; lap < 3; ++lap)
+    {
+        listener.events.clear();
+        for(std::size_t i = 0; i < capacity; ++i)
+        {
+            ARC_CHECK_TRUE(service.post(
+                omi::context::Event(
+                    omi::context::Event::kTypeIdKeyPress,
+                    payload
+                )
+            ));
+        }
+        ARC_CHECK_FALSE(service.post(
+            omi::context::Event(omi::context::Event::kTypeIdKeyPress, payload)
+        ));
+        ARC_CHECK_EQUAL(service.dispatch_queued(), capacity);
+        ARC_CHECK_EQUAL(listener.events.size(), capacity);
+    }
+}
+
+ARC_TEST_UNIT(queue_threads)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+
+    TestListener listener;
+    listener.subscribe(omi::context::Event::kTypeIdKeyPress);
+
+    // each producer posts events with increasing x values, and its own index
+    // as the code
+    static const arc::int32 kProducers = 4;
+    static const arc::int32 kEventsPerProducer = 20000;
+    std::vector<std::thread> producers;
+    for(arc::int32 p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&service, p]()
+        {
+            omi::context::Event::Payload payload = {};
+            payload.code = p;
+            for(arc::int32 i = 0; i < kEventsPerProducer; ++i)
+            {
+                payload.x = i;
+                omi::context::Event event(
+                    omi::context::Event::kTypeIdKeyPress,
+                    payload
+                );
+                // wait for the consumer if the queue is full
+                while(!service.post(event))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // consume concurrently with the producers
+    std::size_t total = static_cast<std::size_t>(
+        kProducers * kEventsPerProducer
+    );
+    std::size_t dispatched = 0;
+    while(dispatched < total)
+    {
+        dispatched += service.dispatch_queued();
+    }
+    for(std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    ARC_CHECK_EQUAL(listener.events.size(), total);
+    ARC_TEST_MESSAGE("Checking the order of each producer's events");
+    std::vector<arc::int32> next(kProducers, 0);
+    bool in_order = true;
+    for(const omi::context::Event& event : listener.events)
+    {
+        const omi::context::Event::Payload& payload = event.get_payload();
+        if(payload.x != next[payload.code])
+        {
+            in_order = false;
+        }
+        next[payload.code] = payload.x + 1;
+    }
+    ARC_CHECK_TRUE(in_order);
+}
+
+//------------------------------------------------------------------------------
+//                                    COALESCE
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(coalesce)
+{
+    omi::context::EventService& service =
+        omi::context::EventService::instance();
+
+    ARC_TEST_MESSAGE("Checking the default policies");
+    ARC_CHECK_EQUAL(
+        service.get_coalesce_policy(omi::context::Event::kTypeIdMouseMove),
+        omi::context::EventService::kCoalesceLatest
+    );
+    ARC_CHECK_EQUAL(
+        service.get_coalesce_policy(omi::context::Event::kTypeIdMouseScroll),
+        omi::context::EventService::kCoalesceAccumulate
+    );
+    ARC_CHECK_EQUAL(
+        service.get_coalesce_policy(omi::context::Event::kTypeIdKeyPress),
+        omi::context::EventService::kCoalesceNone
+    );
+
+    RecordingListener listener;
+    listener.subscribe(omi::context::Event::kTypeIdMouseMove);
+    listener.subscribe(omi::context::Event::kTypeIdMouseScroll);
+    listener.subscribe(omi::context::Event::kTypeIdKeyPress);
+
+    omi::context::Event::Payload scroll = {};
+    scroll.x = 1;
+    scroll.y = -2;
+    omi::context::Event::Payload key = {};
+    key.code = omi::context::Event::kKeyCodeA;
+
+    arc::int64 received = get_stat("Events.Received");
+    arc::int64 dispatched = get_stat("Events.Dispatched");
+
+    service.post(make_mouse_move(1, 1));
+    service.post(
+        omi::context::Event(omi::context::Event::kTypeIdMouseScroll, scroll)
+    );
+    service.post(make_mouse_move(2, 2));
+    service.post(
+        omi::context::Event(omi::context::Event::kTypeIdKeyPress, key)
+    );
+    service.post(make_mouse_move(3, 3));
+    service.post(
+        omi::context::Event(omi::context::Event::kTypeIdMouseScroll, scroll)
+    );
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 3);
+
+    ARC_TEST_MESSAGE("Checking the coalesced events");
+    ARC_CHECK_EQUAL(listener.events.size(), 3);
+    ARC_CHECK_EQUAL(
+        listener.events[0].get_type_id(),
+        omi::context::Event::kTypeIdKeyPress
+    );
+    ARC_CHECK_TRUE(listener.events[1] == make_mouse_move(3, 3));
+    arc::int32 x = 0;
+    arc::int32 y = 0;
+    ARC_CHECK_TRUE(omi::context::Event::mouse_scroll(listener.events[2], x, y));
+    ARC_CHECK_EQUAL(x, 2);
+    ARC_CHECK_EQUAL(y, -4);
+
+    ARC_TEST_MESSAGE("Checking the stats");
+    ARC_CHECK_EQUAL(get_stat("Events.Received") - received, 6);
+    ARC_CHECK_EQUAL(get_stat("Events.Dispatched") - dispatched, 3);
+
+    ARC_TEST_MESSAGE("Checking that coalescing is reset after dispatch");
+    listener.events.clear();
+    service.post(
+        omi::context::Event(omi::context::Event::kTypeIdMouseScroll, scroll)
+    );
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 1);
+    ARC_CHECK_EQUAL(listener.events.size(), 1);
+    ARC_CHECK_TRUE(omi::context::Event::mouse_scroll(listener.events[0], x, y));
+    ARC_CHECK_EQUAL(x, 1);
+    ARC_CHECK_EQUAL(y, -2);
+
+    ARC_TEST_MESSAGE("Checking disabling coalescing");
+    listener.events.clear();
+    service.set_coalesce_policy(
+        omi::context::Event::kTypeIdMouseMove,
+        omi::context::EventService::kCoalesceNone
+    );
+    service.post(make_mouse_move(1, 1));
+    service.post(make_mouse_move(2, 2));
+    ARC_CHECK_EQUAL(service.dispatch_queued(), 2);
+    ARC_CHECK_EQUAL(listener.events.size(), 2);
+    service.set_coalesce_policy(
+        omi::context::Event::kTypeIdMouseMove,
+        omi::context::EventService::kCoalesceLatest
+    );
+}
+
+} // namespace anonymous
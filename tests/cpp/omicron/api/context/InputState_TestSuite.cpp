@@ -0,0 +1,95 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.context.InputState)
+
+#include <omicron/api/context/InputState.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                      KEYS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(keys)
+{
+    omi::context::InputState& input = omi::context::InputState::instance();
+
+    input.set_key(omi::context::Event::kKeyCodeW, true);
+    input.set_key(omi::context::Event::kKeyCodeMenu, true);
+    ARC_TEST_MESSAGE("Checking the snapshot isn't changed until update");
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeW));
+
+    input.update();
+    ARC_CHECK_TRUE(input.is_key_down(omi::context::Event::kKeyCodeW));
+    ARC_CHECK_TRUE(input.is_key_down(omi::context::Event::kKeyCodeMenu));
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeS));
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeUnkown));
+
+    ARC_TEST_MESSAGE("Checking held keys persist between updates");
+    input.update();
+    ARC_CHECK_TRUE(input.is_key_down(omi::context::Event::kKeyCodeW));
+
+    ARC_TEST_MESSAGE("Checking releasing keys");
+    input.set_key(omi::context::Event::kKeyCodeW, false);
+    input.set_key(omi::context::Event::kKeyCodeMenu, false);
+    // unknown keys are ignored
+    input.set_key(omi::context::Event::kKeyCodeUnkown, true);
+    input.update();
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeW));
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeMenu));
+    ARC_CHECK_FALSE(input.is_key_down(omi::context::Event::kKeyCodeUnkown));
+}
+
+//------------------------------------------------------------------------------
+//                                     MOUSE
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(mouse)
+{
+    omi::context::InputState& input = omi::context::InputState::instance();
+
+    ARC_TEST_MESSAGE("Checking buttons");
+    input.set_mouse_button(omi::context::Event::kMouseLeft, true);
+    input.set_mouse_button(omi::context::Event::kMouse8, true);
+    input.update();
+    ARC_CHECK_TRUE(input.is_mouse_button_down(omi::context::Event::kMouseLeft));
+    ARC_CHECK_FALSE(
+        input.is_mouse_button_down(omi::context::Event::kMouseRight)
+    );
+    ARC_CHECK_EQUAL(input.get_mouse_buttons(), (1U << 0) | (1U << 7));
+    input.set_mouse_button(omi::context::Event::kMouseLeft, false);
+    input.set_mouse_button(omi::context::Event::kMouse8, false);
+    input.update();
+    ARC_CHECK_EQUAL(input.get_mouse_buttons(), 0);
+
+    ARC_TEST_MESSAGE("Checking the position and delta");
+    input.warp_mouse_position(100, 100);
+    input.set_mouse_position(110, 95);
+    input.set_mouse_position(120, 90);
+    input.update();
+    ARC_CHECK_EQUAL(input.get_mouse_x(), 120);
+    ARC_CHECK_EQUAL(input.get_mouse_y(), 90);
+    ARC_CHECK_EQUAL(input.get_mouse_delta_x(), 20);
+    ARC_CHECK_EQUAL(input.get_mouse_delta_y(), -10);
+
+    // the delta is reset each frame, and warping doesn't count as movement
+    input.warp_mouse_position(100, 100);
+    input.update();
+    ARC_CHECK_EQUAL(input.get_mouse_x(), 100);
+    ARC_CHECK_EQUAL(input.get_mouse_delta_x(), 0);
+    ARC_CHECK_EQUAL(input.get_mouse_delta_y(), 0);
+
+    ARC_TEST_MESSAGE("Checking scrolling");
+    input.add_scroll(0, 1);
+    input.add_scroll(2, 3);
+    input.update();
+    ARC_CHECK_EQUAL(input.get_scroll_x(), 2);
+    ARC_CHECK_EQUAL(input.get_scroll_y(), 4);
+    input.update();
+    ARC_CHECK_EQUAL(input.get_scroll_x(), 0);
+    ARC_CHECK_EQUAL(input.get_scroll_y(), 0);
+}
+
+} // namespace anonymous
@@ -0,0 +1,183 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.Compression)
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/res/Compression.hpp>
+#include <omicron/api/res/MappedFile.hpp>
+#include <omicron/api/res/loaders/CookedLoader.hpp>
+#include <omicron/api/res/loaders/OBJLoader.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// returns whether the given data is unchanged by compressing and decompressing
+// it, and writes the compressed length
+bool round_trip(const std::vector<char>& data, std::size_t& compressed_length)
+{
+    std::vector<char> compressed;
+    omi::res::compress(data.data(), data.size(), compressed);
+    compressed_length = compressed.size();
+
+    std::vector<char> decompressed(data.size());
+    omi::res::decompress(
+        compressed.data(),
+        compressed.size(),
+        decompressed.data(),
+        decompressed.size()
+    );
+    return decompressed == data;
+}
+
+// returns the given number of random bytes
+std::vector<char> make_random(std::size_t length)
+{
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::vector<char> data(length);
+    for(char& byte : data)
+    {
+        byte = static_cast<char>(distribution(generator));
+    }
+    return data;
+}
+
+//------------------------------------------------------------------------------
+//                                   ROUND TRIP
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(round_trip)
+{
+    std::size_t compressed_length = 0;
+
+    ARC_TEST_MESSAGE("Checking empty data");
+    ARC_CHECK_TRUE(round_trip(std::vector<char>(), compressed_length));
+    ARC_CHECK_EQUAL(compressed_length, 1);
+
+    ARC_TEST_MESSAGE("Checking data shorter than the minimum match");
+    const char* text = "hello, world";
+    ARC_CHECK_TRUE(round_trip(
+        std::vector<char>(text, text + std::strlen(text)),
+        compressed_length
+    ));
+
+    ARC_TEST_MESSAGE("Checking runs of a single byte");
+    std::vector<char> run(100000, 'x');
+    ARC_CHECK_TRUE(round_trip(run, compressed_length));
+    ARC_CHECK_TRUE(compressed_length < 1000);
+
+    ARC_TEST_MESSAGE("Checking repeated sequences");
+    std::vector<char> repeated;
+    for(std::size_t i = 0; i < 10000; ++i)
+    {
+        const char* word = (i % 3 == 0) ? "alpha " : "beta gamma ";
+        repeated.insert(repeated.end(), word, word + std::strlen(word));
+    }
+    ARC_CHECK_TRUE(round_trip(repeated, compressed_length));
+    ARC_CHECK_TRUE(compressed_length < repeated.size() / 10);
+
+    ARC_TEST_MESSAGE("Checking incompressible data");
+    std::vector<char> random = make_random(100000);
+    ARC_CHECK_TRUE(round_trip(random, compressed_length));
+    ARC_CHECK_TRUE(compressed_length < random.size() + random.size() / 100);
+
+    ARC_TEST_MESSAGE("Checking matches further than the maximum offset");
+    std::vector<char> distant = make_random(70000);
+    distant.insert(distant.end(), distant.begin(), distant.begin() + 70000);
+    ARC_CHECK_TRUE(round_trip(distant, compressed_length));
+}
+
+//------------------------------------------------------------------------------
+//                                    INVALID
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(invalid)
+{
+    std::vector<char> data(1000, 'x');
+    std::vector<char> compressed;
+    omi::res::compress(data.data(), data.size(), compressed);
+
+    ARC_TEST_MESSAGE("Checking the wrong decompressed length");
+    ARC_CHECK_THROW(
+        omi::res::decompress(
+            compressed.data(),
+            compressed.size(),
+            data.data(),
+            data.size() - 1
+        ),
+        arc::ex::ParseError
+    );
+
+    ARC_TEST_MESSAGE("Checking truncated blocks");
+    for(std::size_t length = 0; length < compressed.size(); ++length)
+    {
+        ARC_CHECK_THROW(
+            omi::res::decompress(
+                compressed.data(),
+                length,
+                data.data(),
+                data.size()
+            ),
+            arc::ex::ParseError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking offsets before the start of the data");
+    const char invalid_offset[] = {'\x10', 'x', '\x05', '\x00', '\x00'};
+    ARC_CHECK_THROW(
+        omi::res::decompress(
+            invalid_offset,
+            sizeof(invalid_offset),
+            data.data(),
+            data.size()
+        ),
+        arc::ex::ParseError
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                     COOKED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(cooked)
+{
+    const arc::io::sys::Path path({"res", "builtin", "mesh", "monkey.obj"});
+    std::shared_ptr<omi::res::MappedFile> file =
+        omi::res::MappedFile::open(path);
+    omi::Attribute mesh =
+        omi::res::parse_obj(file->get_data(), file->get_size());
+
+    std::vector<char> cooked;
+    omi::res::encode_cooked(mesh, false, cooked);
+    std::vector<char> compressed;
+    omi::res::encode_cooked(mesh, true, compressed);
+
+    arc::str::UTF8String message;
+    message << "Cooked monkey.obj: " << cooked.size() << " bytes, compressed: "
+            << compressed.size() << " bytes";
+    ARC_TEST_MESSAGE(message);
+    ARC_CHECK_TRUE(compressed.size() < cooked.size());
+
+    ARC_TEST_MESSAGE("Checking data that is not worth compressing");
+    std::vector<char> random = make_random(10000);
+    omi::Attribute noise = omi::ByteAttribute(random.begin(), random.end());
+    std::vector<char> uncompressed;
+    omi::res::encode_cooked(noise, false, uncompressed);
+    std::vector<char> incompressible;
+    omi::res::encode_cooked(noise, true, incompressible);
+    ARC_CHECK_TRUE(incompressible == uncompressed);
+}
+
+} // namespace anonymous
@@ -0,0 +1,203 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.OBJLoader)
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/io/sys/FileReader.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/common/attribute/AttributeCodec.hpp>
+#include <omicron/api/res/MappedFile.hpp>
+#include <omicron/api/res/loaders/OBJLoader.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of times each loader is run
+static const std::size_t kRuns = 10;
+
+// returns the per vertex positions of the given parsed obj data
+omi::FloatAttribute expand_positions(const omi::Attribute& obj)
+{
+    omi::MapAttribute root(obj);
+    omi::MapAttribute geometry(root["geometry"]);
+    omi::FloatAttribute points(geometry["point.positions"]);
+    omi::Int32Attribute indices(geometry["vertex.point_indices"]);
+
+    omi::FloatAttribute::ArrayType positions;
+    positions.reserve(indices.get_size() * 3);
+    for(arc::int32 index : indices.get_values())
+    {
+        for(std::size_t i = 0; i < 3; ++i)
+        {
+            positions.push_back(
+                points.at(static_cast<std::size_t>(index) * 3 + i)
+            );
+        }
+    }
+    return omi::FloatAttribute(std::move(positions), 3, false);
+}
+
+// the line based loader which the current loader replaced, used as the
+// baseline
+omi::Attribute load_obj_legacy(arc::io::sys::FileReader& reader)
+{
+    std::vector<float> point_positions;
+    omi::FloatAttribute::ArrayType vertex_positions;
+
+    while(!reader.eof())
+    {
+        arc::str::UTF8String line;
+        reader.read_line(line);
+
+        if(line.starts_with("v"))
+        {
+            std::vector<arc::str::UTF8String> values = line.split(" ");
+            if(values.size() != 4)
+            {
+                throw arc::ex::ParseError(
+                    "Invalid position line: \"" + line + "\""
+                );
+            }
+            point_positions.push_back(values[1].to_float());
+            point_positions.push_back(values[2].to_float());
+            point_positions.push_back(values[3].to_float());
+        }
+        else if(line.starts_with("f"))
+        {
+            std::vector<arc::str::UTF8String> values = line.split(" ");
+            if(values.size() != 4)
+            {
+                throw arc::ex::ParseError("Non-triangle face line: " + line);
+            }
+
+            for(std::size_t i = 1; i < 4; ++i)
+            {
+                std::size_t index =
+                    static_cast<std::size_t>(values[i].to_uint64() - 1) * 3;
+                vertex_positions.push_back(point_positions[index + 0]);
+                vertex_positions.push_back(point_positions[index + 1]);
+                vertex_positions.push_back(point_positions[index + 2]);
+            }
+        }
+    }
+
+    omi::MapAttribute::DataType vertex_map_data = {
+        {
+            "positions",
+            omi::FloatAttribute(std::move(vertex_positions), 3, false)
+        }
+    };
+    omi::MapAttribute::DataType geometry_map_data = {
+        {"vertex", omi::MapAttribute(vertex_map_data, false)}
+    };
+    omi::MapAttribute::DataType root_data = {
+        {"geometry", omi::MapAttribute(geometry_map_data, false)}
+    };
+    return omi::MapAttribute(root_data, false);
+}
+
+//------------------------------------------------------------------------------
+//                                    LOADERS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(loaders)
+{
+    const arc::io::sys::Path path({"res", "builtin", "mesh", "bunny.obj"});
+
+    omi::Attribute legacy;
+    omi_bench::Timer timer;
+    for(std::size_t i = 0; i < kRuns; ++i)
+    {
+        arc::io::sys::FileReader reader(path);
+        legacy = load_obj_legacy(reader);
+    }
+    double legacy_time = timer.get_milliseconds() / kRuns;
+
+    omi::Attribute single;
+    timer.restart();
+    for(std::size_t i = 0; i < kRuns; ++i)
+    {
+        std::shared_ptr<omi::res::MappedFile> file =
+            omi::res::MappedFile::open(path);
+        single = omi::res::parse_obj(file->get_data(), file->get_size());
+    }
+    double single_time = timer.get_milliseconds() / kRuns;
+
+    std::size_t thread_count =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    omi::Attribute threaded;
+    timer.restart();
+    for(std::size_t i = 0; i < kRuns; ++i)
+    {
+        std::shared_ptr<omi::res::MappedFile> file =
+            omi::res::MappedFile::open(path);
+        threaded = omi::res::parse_obj(
+            file->get_data(),
+            file->get_size(),
+            thread_count
+        );
+    }
+    double threaded_time = timer.get_milliseconds() / kRuns;
+
+    ARC_CHECK_EQUAL(
+        expand_positions(single),
+        omi::MapAttribute(legacy)["geometry.vertex.positions"]
+    );
+    ARC_CHECK_EQUAL(threaded, single);
+
+    arc::str::UTF8String message;
+    message << "Load bunny.obj - legacy: " << legacy_time << "ms, single "
+            << "threaded: " << single_time << "ms, " << thread_count
+            << " threads: " << threaded_time << "ms";
+    ARC_TEST_MESSAGE(message);
+}
+
+//------------------------------------------------------------------------------
+//                                    COOKED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(cooked)
+{
+    // cooked files are the codec encoding of the parsed attributes, so decoding
+    // the encoding in place is the work done by loading a cooked bunny.obj
+    const arc::io::sys::Path path({"res", "builtin", "mesh", "bunny.obj"});
+    std::shared_ptr<omi::res::MappedFile> file =
+        omi::res::MappedFile::open(path);
+    omi::Attribute parsed =
+        omi::res::parse_obj(file->get_data(), file->get_size());
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(parsed, encoded);
+
+    omi::Attribute cooked;
+    omi_bench::Timer timer;
+    for(std::size_t i = 0; i < kRuns; ++i)
+    {
+        cooked = omi::AttributeCodec::decode_borrowed(
+            encoded.data(),
+            encoded.size()
+        );
+    }
+    double cooked_time = timer.get_milliseconds() / kRuns;
+
+    ARC_CHECK_EQUAL(cooked, parsed);
+
+    arc::str::UTF8String message;
+    message << "Load cooked bunny.obj: " << cooked_time << "ms ("
+            << encoded.size() << " bytes)";
+    ARC_TEST_MESSAGE(message);
+}
+
+} // namespace anonymous
@@ -0,0 +1,244 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.OBJLoader)
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/common/attribute/AttributeCodec.hpp>
+#include <omicron/api/res/MappedFile.hpp>
+#include <omicron/api/res/loaders/OBJLoader.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// parses the given null terminated obj data
+omi::MapAttribute parse(const char* data, std::size_t thread_count = 1)
+{
+    return omi::MapAttribute(
+        omi::res::parse_obj(data, std::strlen(data), thread_count)
+    );
+}
+
+// returns obj data for a grid of quads with the given number of rows and
+// columns, with uvs and normals
+std::vector<char> make_grid(std::size_t size)
+{
+    arc::str::UTF8String obj;
+    obj << "# grid\r\n";
+    for(std::size_t y = 0; y <= size; ++y)
+    {
+        for(std::size_t x = 0; x <= size; ++x)
+        {
+            obj << "v " << x << ".25 " << y << ".5e-1 -1.0\r\n";
+            obj << "vt " << x << " " << y << "\r\n";
+        }
+    }
+    obj << "vn 0 0 1\r\n";
+    for(std::size_t y = 0; y < size; ++y)
+    {
+        for(std::size_t x = 0; x < size; ++x)
+        {
+            std::size_t i = y * (size + 1) + x + 1;
+            std::size_t j = i + size + 1;
+            obj << "f " << i << "/" << i << "/1 " << (i + 1) << "/" << (i + 1)
+                << "/1 " << (j + 1) << "/" << (j + 1) << "/1 " << j << "/"
+                << j << "/1\r\n";
+        }
+    }
+    return std::vector<char>(
+        obj.get_raw(),
+        obj.get_raw() + obj.get_byte_length() - 1
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                     PARSE
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(parse)
+{
+    ARC_TEST_MESSAGE("Checking triangles");
+    {
+        omi::MapAttribute a(parse(
+            "# comment\n"
+            "o triangles\n"
+            "v 0 0 0\n"
+            "v 1.5 -2 3e2\n"
+            "  v\t+0.25 .5 -1.E-1\n"
+            "v 4 5 6\n"
+            "f 1 2 3\n"
+            "f 4 3 2\n"
+        ));
+        omi::FloatAttribute points(a["geometry.point.positions"]);
+        ARC_CHECK_EQUAL(points.get_tuple_size(), 3);
+        ARC_CHECK_EQUAL(points.get_size(), 12);
+        ARC_CHECK_EQUAL(points.at(3), 1.5F);
+        ARC_CHECK_EQUAL(points.at(4), -2.0F);
+        ARC_CHECK_EQUAL(points.at(5), 300.0F);
+        ARC_CHECK_EQUAL(points.at(6), 0.25F);
+        ARC_CHECK_EQUAL(points.at(7), 0.5F);
+        ARC_CHECK_EQUAL(points.at(8), -0.1F);
+
+        omi::Int32Attribute indices(a["geometry.vertex.point_indices"]);
+        ARC_CHECK_EQUAL(indices.get_tuple_size(), 3);
+        ARC_CHECK_EQUAL(
+            indices.get_values(),
+            omi::Int32Attribute::ArrayType({0, 1, 2, 3, 2, 1})
+        );
+
+        omi::MapAttribute vertex(a["geometry.vertex"]);
+        ARC_CHECK_FALSE(vertex.has("positions"));
+        ARC_CHECK_FALSE(vertex.has("normals"));
+        ARC_CHECK_FALSE(vertex.has("uvs"));
+    }
+
+    ARC_TEST_MESSAGE("Checking polygons, uvs, normals, and relative indices");
+    {
+        omi::MapAttribute a(parse(
+            "\xEF\xBB\xBFv 0 0 0\r\n"
+            "v 1 0 0\r\n"
+            "v 1 1 0\r\n"
+            "v 0 1 0\r\n"
+            "vt 0 0\r\n"
+            "vt 1\r\n"
+            "vn 0 0 1\r\n"
+            "f 1/1/1 2/2/1 3//1 -1/-2/-1\r\n"
+            "f 1 3 4"
+        ));
+        ARC_CHECK_EQUAL(
+            omi::Int32Attribute(a["geometry.vertex.point_indices"])
+                .get_values(),
+            omi::Int32Attribute::ArrayType({0, 1, 2, 0, 2, 3, 0, 2, 3})
+        );
+        omi::FloatAttribute uvs(a["geometry.vertex.uvs"]);
+        ARC_CHECK_EQUAL(uvs.get_tuple_size(), 2);
+        ARC_CHECK_EQUAL(
+            uvs.get_values(),
+            omi::FloatAttribute::ArrayType({
+                0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F,
+                0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F,
+                0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F
+            })
+        );
+        omi::FloatAttribute normals(a["geometry.vertex.normals"]);
+        ARC_CHECK_EQUAL(normals.get_size(), 27);
+        ARC_CHECK_EQUAL(normals.at(17), 1.0F);
+        ARC_CHECK_EQUAL(normals.at(26), 0.0F);
+    }
+
+    ARC_TEST_MESSAGE("Checking empty data");
+    {
+        omi::MapAttribute a(parse(""));
+        ARC_CHECK_EQUAL(
+            omi::FloatAttribute(a["geometry.point.positions"]).get_size(),
+            0
+        );
+        ARC_CHECK_EQUAL(
+            omi::Int32Attribute(a["geometry.vertex.point_indices"]).get_size(),
+            0
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    THREADED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(threaded)
+{
+    std::vector<char> grid = make_grid(100);
+    omi::Attribute single = omi::res::parse_obj(grid.data(), grid.size(), 1);
+
+    omi::MapAttribute a(single);
+    ARC_CHECK_EQUAL(
+        omi::FloatAttribute(a["geometry.point.positions"]).get_size(),
+        101 * 101 * 3
+    );
+    ARC_CHECK_EQUAL(
+        omi::Int32Attribute(a["geometry.vertex.point_indices"]).get_size(),
+        100 * 100 * 6
+    );
+    ARC_CHECK_EQUAL(
+        omi::FloatAttribute(a["geometry.vertex.uvs"]).get_size(),
+        100 * 100 * 6 * 2
+    );
+
+    for(std::size_t threads : {2, 3, 8, 1000})
+    {
+        ARC_CHECK_EQUAL(
+            omi::res::parse_obj(grid.data(), grid.size(), threads),
+            single
+        );
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    INVALID
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(invalid)
+{
+    ARC_TEST_MESSAGE("Checking invalid elements");
+    ARC_CHECK_THROW(parse("v 0 0\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 x 0\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("vn 0 0 -\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("vt x\n"), arc::ex::ParseError);
+
+    ARC_TEST_MESSAGE("Checking invalid faces");
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1 2\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1 0\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1 -2\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1 1/1\n"), arc::ex::ParseError);
+    ARC_CHECK_THROW(parse("v 0 0 0\nf 1 1 1x\n"), arc::ex::ParseError);
+
+    ARC_TEST_MESSAGE("Checking errors from threads");
+    std::vector<char> grid = make_grid(50);
+    grid.back() = 'x';
+    ARC_CHECK_THROW(
+        omi::res::parse_obj(grid.data(), grid.size(), 4),
+        arc::ex::ParseError
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                    COOKED
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(cooked)
+{
+    // cooked files are the codec encoding of the parsed attributes, so decoding
+    // the encoding in place is the work done by loading a cooked bunny.obj
+    const arc::io::sys::Path path({"res", "builtin", "mesh", "bunny.obj"});
+    std::shared_ptr<omi::res::MappedFile> file =
+        omi::res::MappedFile::open(path);
+    omi::Attribute parsed =
+        omi::res::parse_obj(file->get_data(), file->get_size());
+    std::vector<char> encoded;
+    omi::AttributeCodec::encode(parsed, encoded);
+
+    omi::Attribute cooked =
+        omi::AttributeCodec::decode_borrowed(encoded.data(), encoded.size());
+    ARC_CHECK_EQUAL(cooked, parsed);
+
+    ARC_TEST_MESSAGE("Checking point positions are not copied");
+    const char* positions = reinterpret_cast<const char*>(
+        omi::FloatAttribute(
+            omi::MapAttribute(cooked)["geometry.point.positions"]
+        ).get_values().data()
+    );
+    ARC_CHECK_TRUE(positions >= encoded.data());
+    ARC_CHECK_TRUE(positions < encoded.data() + encoded.size());
+}
+
+} // namespace anonymous
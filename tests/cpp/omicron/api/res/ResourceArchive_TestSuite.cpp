@@ -0,0 +1,236 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.ResourceArchive)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/res/ResourceArchive.hpp>
+
+
+namespace
+{
+
+// the path the archives of the tests are written to
+static const arc::io::sys::Path kArchivePath({"test_resources.archive"});
+
+// the resources which are archived by the tests
+static const std::vector<arc::io::sys::Path> kResources = {
+    arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj"}),
+    arc::io::sys::Path({"res", "builtin", "mesh", "monkey.obj"}),
+    arc::io::sys::Path({"res", "builtin", "mesh", "shapes.obj"})
+};
+
+// the path of the copy of a test resource written by the tests
+static const arc::io::sys::Path kCopyPath({"test_resources_copy.obj"});
+
+// writes an archive of the given resources
+void write_test_archive(
+        const std::vector<arc::io::sys::Path>& resources = kResources,
+        bool compress = false)
+{
+    std::ofstream stream(
+        kArchivePath.to_native().get_raw(),
+        std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    omi::res::ResourceArchive::write(resources, stream, compress);
+}
+
+// returns the size of the written test archive
+std::size_t get_test_archive_size()
+{
+    return omi::res::MappedFile::open(kArchivePath)->get_size();
+}
+
+// returns whether the given view holds the same data as the given resource
+bool same_as_resource(
+        const std::shared_ptr<omi::res::MappedFile>& view,
+        const arc::io::sys::Path& resource)
+{
+    std::shared_ptr<omi::res::MappedFile> file =
+        omi::res::MappedFile::open(resource);
+    return
+        view != nullptr &&
+        view->get_size() == file->get_size() &&
+        std::memcmp(view->get_data(), file->get_data(), file->get_size()) == 0;
+}
+
+//------------------------------------------------------------------------------
+//                                      FIND
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(find)
+{
+    write_test_archive();
+    std::unique_ptr<omi::res::ResourceArchive> archive(
+        new omi::res::ResourceArchive(kArchivePath)
+    );
+    ARC_CHECK_EQUAL(archive->get_count(), kResources.size());
+
+    std::vector<std::shared_ptr<omi::res::MappedFile>> views;
+    bool same = true;
+    bool aligned = true;
+    for(const arc::io::sys::Path& resource : kResources)
+    {
+        std::shared_ptr<omi::res::MappedFile> view = archive->find(resource);
+        ARC_CHECK_TRUE(view != nullptr);
+        std::shared_ptr<omi::res::MappedFile> file =
+            omi::res::MappedFile::open(resource);
+        same = same &&
+            view->get_size() == file->get_size() &&
+            std::memcmp(view->get_data(), file->get_data(), file->get_size())
+                == 0;
+        aligned = aligned &&
+            reinterpret_cast<std::uintptr_t>(view->get_data()) %
+                omi::res::ResourceArchive::kAlignment == 0;
+        ARC_CHECK_EQUAL(view->get_path().to_unix(), resource.to_unix());
+        views.push_back(view);
+    }
+    ARC_CHECK_TRUE(same);
+    ARC_CHECK_TRUE(aligned);
+
+    ARC_TEST_MESSAGE("Checking a resource that isn't archived");
+    ARC_CHECK_TRUE(
+        archive->find(arc::io::sys::Path({"res", "readme"})) == nullptr
+    );
+
+    ARC_TEST_MESSAGE("Checking views outlive the archive");
+    omi::ByteAttribute::ArrayType borrowed = views[0]->borrow(0, 4);
+    archive.reset();
+    views.clear();
+    std::shared_ptr<omi::res::MappedFile> file =
+        omi::res::MappedFile::open(kResources[0]);
+    ARC_CHECK_EQUAL(std::memcmp(borrowed.data(), file->get_data(), 4), 0);
+
+    std::remove(kArchivePath.to_native().get_raw());
+}
+
+//------------------------------------------------------------------------------
+//                                 DEDUPLICATION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(deduplication)
+{
+    ARC_TEST_MESSAGE("Checking identical resources share their data");
+    {
+        std::shared_ptr<omi::res::MappedFile> source =
+            omi::res::MappedFile::open(kResources[0]);
+        {
+            std::ofstream stream(
+                kCopyPath.to_native().get_raw(),
+                std::ios::out | std::ios::binary | std::ios::trunc
+            );
+            stream.write(
+                source->get_data(),
+                static_cast<std::streamsize>(source->get_size())
+            );
+        }
+
+        write_test_archive();
+        std::size_t distinct_size = get_test_archive_size();
+
+        std::vector<arc::io::sys::Path> resources(kResources);
+        resources.push_back(kCopyPath);
+        write_test_archive(resources);
+        std::size_t shared_size = get_test_archive_size();
+        // only the table entry is added
+        ARC_CHECK_TRUE(shared_size < distinct_size + 256);
+
+        omi::res::ResourceArchive archive(kArchivePath);
+        ARC_CHECK_EQUAL(archive.get_count(), resources.size());
+        std::shared_ptr<omi::res::MappedFile> original =
+            archive.find(kResources[0]);
+        std::shared_ptr<omi::res::MappedFile> copy = archive.find(kCopyPath);
+        ARC_CHECK_TRUE(same_as_resource(copy, kResources[0]));
+        ARC_CHECK_EQUAL(copy->get_data(), original->get_data());
+        ARC_CHECK_EQUAL(copy->get_path().to_unix(), kCopyPath.to_unix());
+        ARC_CHECK_TRUE(
+            same_as_resource(archive.find(kResources[1]), kResources[1])
+        );
+    }
+
+    std::remove(kCopyPath.to_native().get_raw());
+    std::remove(kArchivePath.to_native().get_raw());
+}
+
+//------------------------------------------------------------------------------
+//                                  COMPRESSION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(compression)
+{
+    write_test_archive();
+    std::size_t uncompressed_size = get_test_archive_size();
+    write_test_archive(kResources, true);
+    ARC_CHECK_TRUE(get_test_archive_size() < uncompressed_size);
+
+    ARC_TEST_MESSAGE("Checking compressed resources are decompressed");
+    std::unique_ptr<omi::res::ResourceArchive> archive(
+        new omi::res::ResourceArchive(kArchivePath)
+    );
+    ARC_CHECK_EQUAL(archive->get_count(), kResources.size());
+    std::vector<std::shared_ptr<omi::res::MappedFile>> views;
+    for(const arc::io::sys::Path& resource : kResources)
+    {
+        std::shared_ptr<omi::res::MappedFile> view = archive->find(resource);
+        ARC_CHECK_TRUE(same_as_resource(view, resource));
+        ARC_CHECK_EQUAL(view->get_path().to_unix(), resource.to_unix());
+        views.push_back(view);
+    }
+
+    ARC_TEST_MESSAGE("Checking decompressed resources outlive the archive");
+    archive.reset();
+    std::remove(kArchivePath.to_native().get_raw());
+    for(std::size_t i = 0; i < kResources.size(); ++i)
+    {
+        ARC_CHECK_TRUE(same_as_resource(views[i], kResources[i]));
+    }
+}
+
+//------------------------------------------------------------------------------
+//                                    INVALID
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(invalid)
+{
+    ARC_TEST_MESSAGE("Checking an archive with invalid magic");
+    {
+        std::ofstream stream(
+            kArchivePath.to_native().get_raw(),
+            std::ios::out | std::ios::binary | std::ios::trunc
+        );
+        stream << "not a resource archive";
+    }
+    ARC_CHECK_THROW(
+        omi::res::ResourceArchive archive(kArchivePath),
+        arc::ex::ParseError
+    );
+    std::remove(kArchivePath.to_native().get_raw());
+
+    ARC_TEST_MESSAGE("Checking a missing archive");
+    ARC_CHECK_THROW(
+        omi::res::ResourceArchive archive(kArchivePath),
+        arc::ex::IOError
+    );
+
+    ARC_TEST_MESSAGE("Checking duplicate resources");
+    std::vector<arc::io::sys::Path> duplicates = {kResources[0], kResources[0]};
+    std::ofstream stream(
+        kArchivePath.to_native().get_raw(),
+        std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    ARC_CHECK_THROW(
+        omi::res::ResourceArchive::write(duplicates, stream),
+        arc::ex::KeyError
+    );
+    stream.close();
+    std::remove(kArchivePath.to_native().get_raw());
+}
+
+} // namespace anonymous
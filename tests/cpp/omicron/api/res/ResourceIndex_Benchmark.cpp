@@ -0,0 +1,75 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.ResourceIndex)
+
+#include <vector>
+
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/res/ResourceIndex.hpp>
+
+#include "Benchmark.hpp"
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the number of resources in the benchmark index
+static const std::size_t kResourceCount = 100000;
+// the number of resources looked up from the index, as by a level's packs
+static const std::size_t kLookupCount = 1000;
+
+//------------------------------------------------------------------------------
+//                                     OPEN
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(open)
+{
+    std::vector<arc::io::sys::Path> resources;
+    resources.reserve(kResourceCount);
+    for(std::size_t i = 0; i < kResourceCount; ++i)
+    {
+        arc::str::UTF8String group;
+        group << "group_" << (i / 100);
+        arc::str::UTF8String name;
+        name << "resource_" << i << ".obj";
+        resources.push_back(arc::io::sys::Path({"res", group, name}));
+    }
+    std::vector<char> encoded;
+    omi::res::encode_index(resources, encoded);
+
+    omi_bench::Timer timer;
+    std::vector<omi::res::IndexEntry> entries;
+    omi::res::decode_index(encoded.data(), encoded.size(), entries);
+    double decode_time = timer.get_milliseconds();
+    ARC_CHECK_EQUAL(entries.size(), kResourceCount);
+
+    timer.restart();
+    omi::res::ResourceIndex index(encoded.data(), encoded.size());
+    std::size_t found = 0;
+    for(std::size_t i = 0; i < kLookupCount; ++i)
+    {
+        const arc::io::sys::Path& resource =
+            resources[(i * 7919) % kResourceCount];
+        std::size_t position = 0;
+        if(index.find(omi::res::get_id(resource), position) &&
+           index.get_path(position).to_unix() == resource.to_unix())
+        {
+            ++found;
+        }
+    }
+    double lookup_time = timer.get_milliseconds();
+    ARC_CHECK_EQUAL(found, kLookupCount);
+
+    arc::str::UTF8String message;
+    message << "Index of " << kResourceCount << " resources - decode: "
+            << decode_time << "ms, open and look up " << kLookupCount
+            << " resources: " << lookup_time << "ms";
+    ARC_TEST_MESSAGE(message);
+}
+
+} // namespace anonymous
@@ -0,0 +1,165 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.ResourceIndex)
+
+#include <cstring>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+
+#include <omicron/api/res/ResourceIndex.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                   ROUND TRIP
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(round_trip)
+{
+    std::vector<arc::io::sys::Path> resources = {
+        arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj"}),
+        arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj.cooked"}),
+        arc::io::sys::Path({"res", "builtin", "texture", "ibl", "studio.png"}),
+        arc::io::sys::Path({"res", "readme"})
+    };
+
+    std::vector<char> index;
+    omi::res::encode_index(resources, index);
+    std::vector<omi::res::IndexEntry> entries;
+    omi::res::decode_index(index.data(), index.size(), entries);
+
+    ARC_CHECK_EQUAL(entries.size(), resources.size());
+    for(std::size_t i = 0; i < entries.size(); ++i)
+    {
+        const omi::res::IndexEntry& entry = entries[i];
+        ARC_CHECK_TRUE(entry.read_order < resources.size());
+        ARC_CHECK_EQUAL(
+            entry.path.to_unix(),
+            resources[entry.read_order].to_unix()
+        );
+        ARC_CHECK_EQUAL(entry.id, omi::res::get_id(entry.path));
+        if(i > 0)
+        {
+            ARC_CHECK_TRUE(entries[i - 1].id < entry.id);
+        }
+    }
+
+    ARC_TEST_MESSAGE("Checking an empty index");
+    omi::res::encode_index(std::vector<arc::io::sys::Path>(), index);
+    omi::res::decode_index(index.data(), index.size(), entries);
+    ARC_CHECK_TRUE(entries.empty());
+}
+
+//------------------------------------------------------------------------------
+//                                     LOOKUP
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(lookup)
+{
+    std::vector<arc::io::sys::Path> resources = {
+        arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj"}),
+        arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj.cooked"}),
+        arc::io::sys::Path({"res", "builtin", "texture", "ibl", "studio.png"}),
+        arc::io::sys::Path({"res", "readme"})
+    };
+
+    std::vector<char> encoded;
+    omi::res::encode_index(resources, encoded);
+    omi::res::ResourceIndex index(encoded.data(), encoded.size());
+    ARC_CHECK_EQUAL(index.get_count(), resources.size());
+
+    for(std::size_t i = 0; i < resources.size(); ++i)
+    {
+        std::size_t position = resources.size();
+        ARC_CHECK_TRUE(index.find(omi::res::get_id(resources[i]), position));
+        ARC_CHECK_TRUE(position < resources.size());
+        ARC_CHECK_EQUAL(index.get_id(position), omi::res::get_id(resources[i]));
+        ARC_CHECK_EQUAL(index.get_read_order(position), i);
+        ARC_CHECK_EQUAL(
+            index.get_path(position).to_unix(),
+            resources[i].to_unix()
+        );
+
+        std::size_t length = 0;
+        const char* unix_path = index.get_unix_path(position, length);
+        ARC_CHECK_EQUAL(
+            arc::str::UTF8String(unix_path, length),
+            resources[i].to_unix()
+        );
+    }
+
+    std::size_t position = 0;
+    ARC_CHECK_FALSE(index.find(
+        omi::res::get_id(arc::io::sys::Path({"res", "missing"})),
+        position
+    ));
+
+    ARC_TEST_MESSAGE("Checking an empty index");
+    omi::res::encode_index(std::vector<arc::io::sys::Path>(), encoded);
+    omi::res::ResourceIndex empty(encoded.data(), encoded.size());
+    ARC_CHECK_EQUAL(empty.get_count(), 0);
+    ARC_CHECK_FALSE(empty.find(omi::res::get_id(resources[0]), position));
+}
+
+//------------------------------------------------------------------------------
+//                                    INVALID
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(invalid)
+{
+    ARC_TEST_MESSAGE("Checking colliding ids");
+    std::vector<char> index;
+    std::vector<arc::io::sys::Path> duplicates = {
+        arc::io::sys::Path({"res", "bunny.obj"}),
+        arc::io::sys::Path({"res", "bunny.obj"})
+    };
+    ARC_CHECK_THROW(
+        omi::res::encode_index(duplicates, index),
+        arc::ex::KeyError
+    );
+
+    omi::res::encode_index(
+        {arc::io::sys::Path({"res", "builtin", "mesh", "bunny.obj"})},
+        index
+    );
+    std::vector<omi::res::IndexEntry> entries;
+
+    ARC_TEST_MESSAGE("Checking truncated indices");
+    for(std::size_t length = 0; length < index.size(); ++length)
+    {
+        ARC_CHECK_THROW(
+            omi::res::decode_index(index.data(), length, entries),
+            arc::ex::ParseError
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking invalid magic");
+    std::vector<char> invalid(index);
+    invalid[0] = 'X';
+    ARC_CHECK_THROW(
+        omi::res::decode_index(invalid.data(), invalid.size(), entries),
+        arc::ex::ParseError
+    );
+
+    ARC_TEST_MESSAGE("Checking paths are validated when they are requested");
+    std::vector<char> out_of_bounds(index);
+    // (the path offset of the first entry follows its id and read order)
+    arc::uint64 path_offset = 1000;
+    std::memcpy(&out_of_bounds[40], &path_offset, sizeof(path_offset));
+    omi::res::ResourceIndex opened(out_of_bounds.data(), out_of_bounds.size());
+    ARC_CHECK_EQUAL(opened.get_count(), 1);
+    ARC_CHECK_THROW(opened.get_path(0), arc::ex::ParseError);
+    ARC_CHECK_THROW(
+        omi::res::decode_index(
+            out_of_bounds.data(),
+            out_of_bounds.size(),
+            entries
+        ),
+        arc::ex::ParseError
+    );
+}
+
+} // namespace anonymous
@@ -0,0 +1,568 @@
+#include "arcanecore/test/ArcTest.hpp"
+
+ARC_TEST_MODULE(omi.api.res.ResourceRegistry)
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arcanecore/base/Exceptions.hpp>
+#include <arcanecore/base/str/UTF8String.hpp>
+
+#include <omicron/api/common/Attributes.hpp>
+#include <omicron/api/report/stats/StatsDatabase.hpp>
+#include <omicron/api/res/FileWatcher.hpp>
+#include <omicron/api/res/MappedFile.hpp>
+#include <omicron/api/res/ReloadListener.hpp>
+#include <omicron/api/res/ResourceHandle.hpp>
+#include <omicron/api/res/ResourceRegistry.hpp>
+
+
+namespace
+{
+
+//------------------------------------------------------------------------------
+//                                    HELPERS
+//------------------------------------------------------------------------------
+
+// the contents of test resources that fail to load
+static const arc::str::UTF8String kInvalidContents = "invalid";
+
+// the number of resources loaded asynchronously by the tests
+static const std::size_t kAsyncCount = 16;
+// the number of resources in each of the test packs
+static const std::size_t kPackSize = 8;
+// the number of resources used by the memory budget tests
+static const std::size_t kBudgetCount = 3;
+// the longest time in milliseconds the tests wait for a resource to reload
+static const std::size_t kReloadTimeout = 5000;
+// the names of the test packs
+static const std::vector<arc::str::UTF8String> kPackNames = {
+    "test_async",
+    "test_get",
+    "test_blocking"
+};
+
+// returns the path of the test resource with the given name
+arc::io::sys::Path get_test_path(const arc::str::UTF8String& name)
+{
+    arc::str::UTF8String file_name;
+    file_name << "registry_test_" << name << ".omitest";
+    return arc::io::sys::Path({"res", file_name});
+}
+
+// returns the id of the test resource with the given name
+omi::res::ResourceId get_test_id(const arc::str::UTF8String& name)
+{
+    return omi::res::get_id(get_test_path(name));
+}
+
+// returns the contents of the test resource with the given name
+arc::str::UTF8String get_test_contents(const arc::str::UTF8String& name)
+{
+    arc::str::UTF8String contents;
+    contents << "test resource " << name;
+    return contents;
+}
+
+// writes the given contents to the test resource with the given name
+void write_test_resource(
+        const arc::str::UTF8String& name,
+        const arc::str::UTF8String& contents)
+{
+    std::ofstream stream(
+        get_test_path(name).to_native().get_raw(),
+        std::ios::out | std::ios::binary | std::ios::trunc
+    );
+    stream.write(contents.get_raw(), contents.get_byte_length() - 1);
+}
+
+// returns the given number of test resource names with the given prefix
+std::vector<arc::str::UTF8String> get_test_names(
+        const arc::str::UTF8String& prefix,
+        std::size_t count)
+{
+    std::vector<arc::str::UTF8String> names;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        arc::str::UTF8String name;
+        name << prefix << "_" << i;
+        names.push_back(name);
+    }
+    return names;
+}
+
+// returns the ids of the resources in the test pack with the given name
+std::vector<omi::res::ResourceId> get_pack_ids(const arc::str::UTF8String& pack)
+{
+    std::vector<omi::res::ResourceId> ids;
+    for(const arc::str::UTF8String& name : get_test_names(pack, kPackSize))
+    {
+        ids.push_back(get_test_id(name));
+    }
+    return ids;
+}
+
+// returns the names and contents of all of the test resources
+std::vector<std::pair<arc::str::UTF8String, arc::str::UTF8String>>
+get_test_resources()
+{
+    std::vector<std::pair<arc::str::UTF8String, arc::str::UTF8String>>
+        resources;
+    std::vector<arc::str::UTF8String> names =
+        get_test_names("async", kAsyncCount);
+    names.push_back("handle");
+    names.push_back("reload");
+    std::vector<arc::str::UTF8String> budget_names =
+        get_test_names("budget", kBudgetCount);
+    names.insert(names.end(), budget_names.begin(), budget_names.end());
+    for(const arc::str::UTF8String& pack : kPackNames)
+    {
+        std::vector<arc::str::UTF8String> pack_names =
+            get_test_names(pack, kPackSize);
+        names.insert(names.end(), pack_names.begin(), pack_names.end());
+    }
+    for(const arc::str::UTF8String& name : names)
+    {
+        resources.push_back(std::make_pair(name, get_test_contents(name)));
+    }
+    resources.push_back(std::make_pair("async_invalid", kInvalidContents));
+    return resources;
+}
+
+// loads a test resource as a string attribute of its contents
+omi::Attribute load_test_resource(const omi::res::MappedFile& file)
+{
+    arc::str::UTF8String contents(file.get_data(), file.get_size());
+    if(contents == kInvalidContents)
+    {
+        throw arc::ex::ParseError("Invalid test resource");
+    }
+    return omi::StringAttribute(contents);
+}
+
+// returns the current value of the given registry stat
+template<typename T_AttributeType>
+arc::int64 get_stat(const arc::str::UTF8String& name)
+{
+    T_AttributeType stat =
+        omi::report::StatsDatabase::instance()->get_entry(name);
+    return static_cast<arc::int64>(stat.at(0));
+}
+
+// unloads all of the resources without handles and stops unloading resources
+void unload_unreferenced(omi::res::ResourceRegistry* registry)
+{
+    registry->set_memory_budget(1);
+    registry->set_memory_budget(0);
+}
+
+// records the reloads it has been notified of
+class TestReloadListener
+    : public omi::res::ReloadListener
+{
+public:
+
+    std::vector<std::pair<omi::res::ResourceId, omi::Attribute>> reloads;
+
+    virtual void on_reload(
+            omi::res::ResourceId id,
+            const omi::Attribute& data) override
+    {
+        reloads.push_back(std::make_pair(id, data));
+    }
+};
+
+// writes the test resources and starts the registry, which can only be started
+// once per process, and then shuts it down and removes the resources at exit
+class RegistrySession
+{
+public:
+
+    RegistrySession()
+    {
+        // the resources must exist before they're discovered by the registry
+        for(const auto& resource : get_test_resources())
+        {
+            write_test_resource(resource.first, resource.second);
+        }
+
+        omi::res::ResourceRegistry::instance()->startup_routine();
+        omi::res::ResourceRegistry::instance()->define_mapped_loader(
+            &load_test_resource,
+            "omitest"
+        );
+    }
+
+    ~RegistrySession()
+    {
+        omi::res::ResourceRegistry::instance()->shutdown_routine();
+        for(const auto& resource : get_test_resources())
+        {
+            std::remove(get_test_path(resource.first).to_native().get_raw());
+        }
+    }
+};
+
+// returns the registry, starting it with the test resources on first use
+omi::res::ResourceRegistry* get_registry()
+{
+    static RegistrySession session;
+    return omi::res::ResourceRegistry::instance();
+}
+
+//------------------------------------------------------------------------------
+//                                  ASYNC LOADS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(async_loads)
+{
+    omi::res::ResourceRegistry* registry = get_registry();
+    std::vector<arc::str::UTF8String> names =
+        get_test_names("async", kAsyncCount);
+    arc::int64 loads = get_stat<omi::Int32Attribute>("Resources.Loads");
+
+    ARC_TEST_MESSAGE("Checking loads by the worker threads");
+    std::vector<std::shared_future<omi::Attribute>> futures;
+    for(const arc::str::UTF8String& name : names)
+    {
+        futures.push_back(registry->load_async(get_test_id(name)));
+    }
+    // polling for completion publishes the loads
+    bool loading = true;
+    while(loading)
+    {
+        loading = false;
+        for(const arc::str::UTF8String& name : names)
+        {
+            loading = loading || registry->is_loading(get_test_id(name));
+        }
+    }
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        omi::res::ResourceId id = get_test_id(names[i]);
+        ARC_CHECK_TRUE(registry->is_loaded(id));
+        ARC_CHECK_EQUAL(
+            futures[i].get(),
+            omi::StringAttribute(get_test_contents(names[i]))
+        );
+        ARC_CHECK_EQUAL(registry->get(id), futures[i].get());
+    }
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Loads"),
+        loads + static_cast<arc::int64>(names.size())
+    );
+
+    ARC_TEST_MESSAGE("Checking redundant loads");
+    std::shared_future<omi::Attribute> redundant =
+        registry->load_async(get_test_id(names[0]));
+    ARC_CHECK_FALSE(registry->is_loading(get_test_id(names[0])));
+    ARC_CHECK_EQUAL(redundant.get(), futures[0].get());
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Loads"),
+        loads + static_cast<arc::int64>(names.size())
+    );
+
+    ARC_TEST_MESSAGE("Checking errors are returned through the future");
+    omi::res::ResourceId invalid = get_test_id("async_invalid");
+    std::shared_future<omi::Attribute> failed = registry->load_async(invalid);
+    ARC_CHECK_THROW(failed.get(), arc::ex::ParseError);
+    while(registry->is_loading(invalid))
+    {
+    }
+    ARC_CHECK_FALSE(registry->is_loaded(invalid));
+    ARC_CHECK_THROW(registry->load_blocking(invalid), arc::ex::ParseError);
+    ARC_CHECK_FALSE(registry->is_loaded(invalid));
+
+    ARC_TEST_MESSAGE("Checking unknown resources");
+    omi::res::ResourceId unknown = get_test_id("unknown");
+    ARC_CHECK_THROW(registry->load_async(unknown), arc::ex::KeyError);
+    ARC_CHECK_THROW(registry->get(unknown), arc::ex::KeyError);
+}
+
+//------------------------------------------------------------------------------
+//                                     PACKS
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(packs)
+{
+    omi::res::ResourceRegistry* registry = get_registry();
+    for(const arc::str::UTF8String& pack : kPackNames)
+    {
+        registry->define_pack(pack, get_pack_ids(pack));
+        ARC_CHECK_FALSE(registry->is_pack_loaded(pack));
+    }
+    arc::int64 loads = get_stat<omi::Int32Attribute>("Resources.Loads");
+
+    ARC_TEST_MESSAGE("Checking packs are added to the registry together");
+    std::vector<omi::res::ResourceId> ids = get_pack_ids("test_async");
+    registry->load_pack_async("test_async");
+    while(!registry->is_pack_loaded("test_async"))
+    {
+        // polling may add the pack between checks, but a resource can't be
+        // loaded before any of the resources that precede it
+        bool published = false;
+        for(omi::res::ResourceId id : ids)
+        {
+            bool loaded = registry->is_loaded(id);
+            ARC_CHECK_TRUE(loaded || !published);
+            published = published || loaded;
+        }
+    }
+    std::vector<arc::str::UTF8String> names =
+        get_test_names("test_async", kPackSize);
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        ARC_CHECK_EQUAL(
+            registry->get(ids[i]),
+            omi::StringAttribute(get_test_contents(names[i]))
+        );
+    }
+
+    ARC_TEST_MESSAGE("Checking getting a resource waits for its pack");
+    ids = get_pack_ids("test_get");
+    registry->load_pack_async("test_get");
+    ARC_CHECK_EQUAL(
+        registry->get(ids.back()),
+        omi::StringAttribute(get_test_contents(
+            get_test_names("test_get", kPackSize).back()
+        ))
+    );
+    ARC_CHECK_TRUE(registry->is_pack_loaded("test_get"));
+
+    ARC_TEST_MESSAGE("Checking blocking loads");
+    registry->load_pack_blocking("test_blocking");
+    ARC_CHECK_TRUE(registry->is_pack_loaded("test_blocking"));
+    names = get_test_names("test_blocking", kPackSize);
+    ids = get_pack_ids("test_blocking");
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        ARC_CHECK_EQUAL(
+            registry->get(ids[i]),
+            omi::StringAttribute(get_test_contents(names[i]))
+        );
+    }
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Loads"),
+        loads + static_cast<arc::int64>(kPackNames.size() * kPackSize)
+    );
+
+    ARC_TEST_MESSAGE("Checking loaded packs aren't loaded again");
+    registry->load_pack_blocking("test_async");
+    registry->load_pack_async("test_get");
+    ARC_CHECK_TRUE(registry->is_pack_loaded("test_get"));
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Loads"),
+        loads + static_cast<arc::int64>(kPackNames.size() * kPackSize)
+    );
+
+    ARC_TEST_MESSAGE("Checking unknown packs and resources");
+    ARC_CHECK_THROW(registry->is_pack_loaded("unknown"), arc::ex::KeyError);
+    ARC_CHECK_THROW(registry->load_pack_async("unknown"), arc::ex::KeyError);
+    ARC_CHECK_THROW(
+        registry->load_pack_blocking("unknown"),
+        arc::ex::KeyError
+    );
+    std::vector<omi::res::ResourceId> unknown = {get_test_id("unknown")};
+    ARC_CHECK_THROW(
+        registry->define_pack("unknown", unknown),
+        arc::ex::KeyError
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                    HANDLES
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(handles)
+{
+    omi::res::ResourceRegistry* registry = get_registry();
+    omi::res::ResourceId id = get_test_id("handle");
+    omi::StringAttribute contents(get_test_contents("handle"));
+
+    ARC_TEST_MESSAGE("Checking default handles");
+    omi::res::ResourceHandle invalid;
+    ARC_CHECK_FALSE(invalid.is_valid());
+    ARC_CHECK_THROW(invalid.get_id(), arc::ex::StateError);
+    ARC_CHECK_THROW(invalid.get(), arc::ex::StateError);
+    invalid.release();
+
+    ARC_TEST_MESSAGE("Checking handles keep resources loaded");
+    omi::res::ResourceHandle handle = registry->acquire(id);
+    ARC_CHECK_TRUE(handle.is_valid());
+    ARC_CHECK_EQUAL(handle.get_id(), id);
+    ARC_CHECK_EQUAL(handle.get(), contents);
+    unload_unreferenced(registry);
+    ARC_CHECK_TRUE(registry->is_loaded(id));
+
+    ARC_TEST_MESSAGE("Checking copied handles");
+    omi::res::ResourceHandle copy(handle);
+    omi::Attribute data = copy.get();
+    handle.release();
+    ARC_CHECK_FALSE(handle.is_valid());
+    unload_unreferenced(registry);
+    ARC_CHECK_TRUE(registry->is_loaded(id));
+
+    ARC_TEST_MESSAGE("Checking moved handles");
+    omi::res::ResourceHandle moved(std::move(copy));
+    ARC_CHECK_FALSE(copy.is_valid());
+    ARC_CHECK_TRUE(moved.is_valid());
+    unload_unreferenced(registry);
+    ARC_CHECK_TRUE(registry->is_loaded(id));
+
+    ARC_TEST_MESSAGE("Checking releasing the last handle");
+    moved.release();
+    ARC_CHECK_FALSE(moved.is_valid());
+    ARC_CHECK_TRUE(registry->is_loaded(id));
+    unload_unreferenced(registry);
+    ARC_CHECK_FALSE(registry->is_loaded(id));
+    // data taken from a handle outlives the resource
+    ARC_CHECK_EQUAL(data, contents);
+
+    ARC_TEST_MESSAGE("Checking unknown resources");
+    ARC_CHECK_THROW(
+        registry->acquire(get_test_id("unknown")),
+        arc::ex::KeyError
+    );
+}
+
+//------------------------------------------------------------------------------
+//                                   EVICTION
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(eviction)
+{
+    omi::res::ResourceRegistry* registry = get_registry();
+    std::vector<arc::str::UTF8String> names =
+        get_test_names("budget", kBudgetCount);
+    std::vector<omi::res::ResourceId> ids;
+    for(const arc::str::UTF8String& name : names)
+    {
+        ids.push_back(get_test_id(name));
+    }
+    unload_unreferenced(registry);
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int64Attribute>("Resources.Resident Memory (bytes)"),
+        0
+    );
+
+    // the test resources all use the same amount of memory
+    registry->load_blocking(ids[0]);
+    arc::int64 bytes = get_stat<omi::Int64Attribute>(
+        "Resources.Resident Memory (bytes)"
+    );
+    ARC_CHECK_TRUE(bytes > 0);
+
+    ARC_TEST_MESSAGE("Checking the least recently used resource is unloaded");
+    registry->set_memory_budget(static_cast<std::size_t>(bytes * 2));
+    registry->load_blocking(ids[1]);
+    ARC_CHECK_TRUE(registry->is_loaded(ids[0]));
+    ARC_CHECK_TRUE(registry->is_loaded(ids[1]));
+    registry->get(ids[0]);
+    arc::int64 evictions =
+        get_stat<omi::Int32Attribute>("Resources.Evictions");
+    registry->load_blocking(ids[2]);
+    ARC_CHECK_TRUE(registry->is_loaded(ids[0]));
+    ARC_CHECK_FALSE(registry->is_loaded(ids[1]));
+    ARC_CHECK_TRUE(registry->is_loaded(ids[2]));
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Evictions"),
+        evictions + 1
+    );
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int64Attribute>("Resources.Resident Memory (bytes)"),
+        bytes * 2
+    );
+
+    ARC_TEST_MESSAGE("Checking unloaded resources are loaded again");
+    ARC_CHECK_EQUAL(
+        registry->get(ids[1]),
+        omi::StringAttribute(get_test_contents(names[1]))
+    );
+    ARC_CHECK_FALSE(registry->is_loaded(ids[0]));
+    ARC_CHECK_TRUE(registry->is_loaded(ids[1]));
+    ARC_CHECK_TRUE(registry->is_loaded(ids[2]));
+
+    ARC_TEST_MESSAGE("Checking resources with handles aren't unloaded");
+    omi::res::ResourceHandle handle = registry->acquire(ids[2]);
+    registry->set_memory_budget(1);
+    ARC_CHECK_FALSE(registry->is_loaded(ids[1]));
+    ARC_CHECK_TRUE(registry->is_loaded(ids[2]));
+    handle.release();
+    ARC_CHECK_FALSE(registry->is_loaded(ids[2]));
+
+    ARC_TEST_MESSAGE("Checking a budget of 0 never unloads resources");
+    registry->set_memory_budget(0);
+    for(omi::res::ResourceId id : ids)
+    {
+        registry->load_blocking(id);
+    }
+    for(omi::res::ResourceId id : ids)
+    {
+        ARC_CHECK_TRUE(registry->is_loaded(id));
+    }
+    unload_unreferenced(registry);
+}
+
+//------------------------------------------------------------------------------
+//                                  HOT RELOAD
+//------------------------------------------------------------------------------
+
+ARC_TEST_UNIT(hot_reload)
+{
+    if(!omi::res::FileWatcher::is_supported())
+    {
+        ARC_TEST_MESSAGE("Hot reloading is not supported on this platform");
+        return;
+    }
+
+    omi::res::ResourceRegistry* registry = get_registry();
+    omi::res::ResourceId id = get_test_id("reload");
+    // the handle keeps the resource loaded so that it will be reloaded
+    omi::res::ResourceHandle handle = registry->acquire(id);
+    ARC_CHECK_EQUAL(
+        handle.get(),
+        omi::StringAttribute(get_test_contents("reload"))
+    );
+
+    TestReloadListener listener;
+    TestReloadListener removed;
+    registry->add_reload_listener(id, &listener);
+    registry->add_reload_listener(id, &removed);
+    registry->remove_reload_listener(id, &removed);
+    arc::int64 reloads = get_stat<omi::Int32Attribute>("Resources.Reloads");
+
+    ARC_TEST_MESSAGE("Checking modified resources are reloaded");
+    arc::str::UTF8String contents = "reloaded test resource";
+    write_test_resource("reload", contents);
+    for(std::size_t waited = 0;
+        listener.reloads.empty() && waited < kReloadTimeout;
+        ++waited)
+    {
+        registry->frame_routine();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ARC_CHECK_FALSE(listener.reloads.empty());
+    ARC_CHECK_TRUE(removed.reloads.empty());
+    if(!listener.reloads.empty())
+    {
+        ARC_CHECK_EQUAL(listener.reloads.back().first, id);
+        ARC_CHECK_EQUAL(
+            listener.reloads.back().second,
+            omi::StringAttribute(contents)
+        );
+    }
+    ARC_CHECK_EQUAL(registry->get(id), omi::StringAttribute(contents));
+    ARC_CHECK_EQUAL(
+        get_stat<omi::Int32Attribute>("Resources.Reloads"),
+        reloads + static_cast<arc::int64>(listener.reloads.size())
+    );
+
+    registry->remove_reload_listener(id, &listener);
+}
+
+} // namespace anonymous
@@ -1,4 +1,10 @@
 #!/bin/bash
 
+# cook source resources so their (deduplicated and compressed) cooked files are
+# collated alongside them, then index and archive the resources for the
+# ResourceRegistry (which maps the archive rather than reading collated pages)
+build/linux_x86/omicron_cook --compress --index data/resources.index \
+    --archive data/resources.archive res/ || exit 1
+
 ../../ArcaneCore/ArcaneCore/build/linux_x86/arc_collate_tool --table_of_contents data/resources.toc --page_size 4294967296 --collate_begin data/resources.arccol res/ --collate_end
 